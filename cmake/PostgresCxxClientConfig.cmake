@@ -1,3 +1,4 @@
 include(CMakeFindDependencyMacro)
 find_dependency(PostgreSQL REQUIRED)
+find_dependency(Threads REQUIRED)
 include("${CMAKE_CURRENT_LIST_DIR}/PostgresCxxClientTargets.cmake")
@@ -21,7 +21,7 @@ then
     make install
 
     cd ${WORKDIR}/tests/integration
-    cmake -B./build/ -H.
+    cmake -DCMAKE_BUILD_TYPE=Release -B./build/ -H.
     cmake --build ./build/
     cd ./build/
     ctest -V
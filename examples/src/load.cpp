@@ -0,0 +1,301 @@
+// Load generator running a mixed read/write workload through a Client, in the spirit of pgbench.
+// It reports the throughput and latency percentiles, so that the pool settings
+// and execution modes can be compared on the hardware at hand.
+//
+// Usage: PostgresCxxClientLoad [--key=value]...
+//   --uri          connection string, the environment variables are used by default
+//   --init         creates the tables and fills them up before running
+//   --scale        number of accounts, 10000 by default
+//   --connections  max concurrency of the pool, 8 by default
+//   --clients      number of threads sending jobs and waiting for them, 8 by default
+//   --depth        reads or writes in flight per client: pipelined in a single job in job mode,
+//                  or sent as separate commands in command mode, 1 by default
+//   --batch        history rows inserted by each write in an extra statement, 0 by default
+//   --reads        percentage of reads, 80 by default
+//   --prepared     executes prepared statements
+//   --mode         job or command, job by default
+//   --reactor      event loop threads running the commands, see Context::Builder::reactorThreads()
+//   --seconds      duration of the run, 10 by default
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <postgres/Postgres.h>
+
+using postgres::Client;
+using postgres::Command;
+using postgres::Connection;
+using postgres::Context;
+using postgres::PreparedCommand;
+using postgres::PrepareData;
+using postgres::RangeStatement;
+using postgres::Result;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string uri;
+    bool        init        = false;
+    int         scale       = 10000;
+    int         connections = 8;
+    int         clients     = 8;
+    int         depth       = 1;
+    int         batch       = 0;
+    int         reads       = 80;
+    bool        prepared    = false;
+    bool        commands    = false;
+    int         reactor     = 0;
+    int         seconds     = 10;
+};
+
+struct History {
+    int64_t account = 0;
+    int64_t delta   = 0;
+
+    POSTGRES_CXX_TABLE("load_history", account, delta);
+};
+
+auto constexpr READ  = "SELECT balance FROM load_accounts WHERE id = $1";
+auto constexpr WRITE = "UPDATE load_accounts SET balance = balance + $2 WHERE id = $1";
+
+Options parse(int const argc, char const* const* const argv) {
+    Options opts{};
+    for (auto i = 1; i < argc; ++i) {
+        auto const arg = std::string_view{argv[i]};
+        auto const eq  = arg.find('=');
+        auto const key = arg.substr(0, eq);
+        auto const val = (eq == std::string_view::npos) ? std::string{} : std::string{arg.substr(eq + 1)};
+        if (key == "--uri") {
+            opts.uri = val;
+        } else if (key == "--init") {
+            opts.init = true;
+        } else if (key == "--scale") {
+            opts.scale = std::stoi(val);
+        } else if (key == "--connections") {
+            opts.connections = std::stoi(val);
+        } else if (key == "--clients") {
+            opts.clients = std::stoi(val);
+        } else if (key == "--depth") {
+            opts.depth = std::stoi(val);
+        } else if (key == "--batch") {
+            opts.batch = std::stoi(val);
+        } else if (key == "--reads") {
+            opts.reads = std::stoi(val);
+        } else if (key == "--prepared") {
+            opts.prepared = true;
+        } else if (key == "--mode") {
+            opts.commands = (val == "command");
+        } else if (key == "--reactor") {
+            opts.reactor = std::stoi(val);
+        } else if (key == "--seconds") {
+            opts.seconds = std::stoi(val);
+        } else {
+            std::cerr << "unknown option: " << arg << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return opts;
+}
+
+void init(Connection& conn, Options const& opts) {
+    conn.execRaw("DROP TABLE IF EXISTS load_accounts, load_history");
+    conn.execRaw("CREATE TABLE load_accounts (id BIGINT PRIMARY KEY, balance BIGINT NOT NULL)");
+    conn.execRaw("CREATE TABLE load_history (account BIGINT NOT NULL, delta BIGINT NOT NULL)");
+    conn.exec(Command{"INSERT INTO load_accounts SELECT i, 0 FROM generate_series(1, $1) AS i",
+                      int64_t{opts.scale}});
+    conn.execRaw("VACUUM ANALYZE load_accounts");
+}
+
+// Next statement of the workload, either prepared or not.
+class Workload {
+public:
+    explicit Workload(Options const& opts, unsigned const seed)
+        : opts_{opts}, gen_{seed}, ids_{1, opts.scale}, deltas_{-1000, 1000}, pct_{0, 99} {
+    }
+
+    bool isRead() {
+        return pct_(gen_) < opts_.reads;
+    }
+
+    int64_t id() {
+        return ids_(gen_);
+    }
+
+    int64_t delta() {
+        return deltas_(gen_);
+    }
+
+    int64_t count() const {
+        return count_;
+    }
+
+    template <typename F>
+    void next(F&& send) {
+        auto const id = this->id();
+        if (isRead()) {
+            if (opts_.prepared) {
+                send(PreparedCommand{"load_read", id});
+            } else {
+                send(Command{READ, id});
+            }
+            ++count_;
+            return;
+        }
+
+        auto const delta = this->delta();
+        if (opts_.prepared) {
+            send(PreparedCommand{"load_write", id, delta});
+        } else {
+            send(Command{WRITE, id, delta});
+        }
+        ++count_;
+        if (0 < opts_.batch) {
+            history_.assign(static_cast<size_t>(opts_.batch), History{id, delta});
+            auto const rng = std::make_pair(history_.cbegin(), history_.cend());
+            send(Command{RangeStatement::insert(rng.first, rng.second), rng});
+            ++count_;
+        }
+    }
+
+private:
+    Options const&                         opts_;
+    std::mt19937_64                        gen_;
+    std::uniform_int_distribution<int64_t> ids_;
+    std::uniform_int_distribution<int64_t> deltas_;
+    std::uniform_int_distribution<int>     pct_;
+    std::vector<History>                   history_;
+    int64_t                                count_ = 0;
+};
+
+// Each round sends a job running `depth` reads or writes in a single pipeline.
+void runJobs(Client& cl, Options const& opts, Workload& load, std::vector<Clock::duration>& lats) {
+    auto const beg = Clock::now();
+    cl.query([&load, depth = opts.depth](Connection& conn) {
+        auto pipe = conn.pipeline();
+        for (auto i = 0; i < depth; ++i) {
+            load.next([&pipe](auto const& cmd) {
+                pipe.send(cmd);
+            });
+        }
+        pipe.sync();
+
+        auto res = pipe.receive();
+        while (0 < pipe.size()) {
+            res = pipe.receive();
+        }
+        return res;
+    }).get();
+    lats.push_back(Clock::now() - beg);
+}
+
+// Each round sends `depth` reads or writes as separate commands, which the reactor multiplexes over the connections.
+void runCommands(Client& cl, Options const& opts, Workload& load, std::vector<Clock::duration>& lats) {
+    std::vector<std::future<Result>> results{};
+    auto const                       beg = Clock::now();
+    for (auto i = 0; i < opts.depth; ++i) {
+        load.next([&cl, &results](auto&& cmd) {
+            results.push_back(cl.query(std::move(cmd)));
+        });
+    }
+    for (auto& res : results) {
+        res.get();
+    }
+    lats.push_back(Clock::now() - beg);
+}
+
+double percentile(std::vector<Clock::duration> const& lats, double const pct) {
+    auto const idx = static_cast<size_t>(pct * static_cast<double>(lats.size() - 1));
+    return std::chrono::duration<double, std::milli>{lats[idx]}.count();
+}
+
+}  // namespace
+
+int main(int const argc, char const* const* const argv) {
+    auto const opts = parse(argc, argv);
+
+    auto bld = Context::Builder{};
+    if (!opts.uri.empty()) {
+        bld.uri(opts.uri);
+    }
+    bld.maxConcurrency(opts.connections)
+       .minConcurrency(opts.connections)
+       .waitWarmUp(true)
+       .reactorThreads(opts.reactor);
+    if (opts.prepared) {
+        bld.prepare(PrepareData{"load_read", READ})
+           .prepare(PrepareData{"load_write", WRITE});
+    }
+    auto ctx = bld.build();
+
+    if (opts.init) {
+        auto conn = ctx.connect();
+        init(conn, opts);
+    }
+
+    Client                                    cl{std::move(ctx)};
+    std::atomic<bool>                         is_over{false};
+    std::atomic<int64_t>                      errors{0};
+    std::atomic<int64_t>                      statements{0};
+    std::vector<std::vector<Clock::duration>> lats(static_cast<size_t>(opts.clients));
+    std::vector<std::thread>                  clients{};
+
+    auto const beg = Clock::now();
+    for (auto i = 0; i < opts.clients; ++i) {
+        clients.emplace_back([&, i] {
+            Workload load{opts, static_cast<unsigned>(i + 1)};
+            auto&    own = lats[static_cast<size_t>(i)];
+            while (!is_over.load(std::memory_order_relaxed)) {
+                try {
+                    if (opts.commands) {
+                        runCommands(cl, opts, load, own);
+                    } else {
+                        runJobs(cl, opts, load, own);
+                    }
+                } catch (std::exception const& e) {
+                    if (errors.fetch_add(1) == 0) {
+                        std::cerr << e.what() << std::endl;
+                    }
+                }
+            }
+            statements.fetch_add(load.count());
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds{opts.seconds});
+    is_over = true;
+    for (auto& thread : clients) {
+        thread.join();
+    }
+    auto const elapsed = std::chrono::duration<double>{Clock::now() - beg}.count();
+
+    std::vector<Clock::duration> all{};
+    for (auto const& own : lats) {
+        all.insert(all.end(), own.begin(), own.end());
+    }
+    if (all.empty()) {
+        std::cerr << "no rounds completed, errors: " << errors << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::sort(all.begin(), all.end());
+
+    auto const rounds = static_cast<double>(all.size());
+    std::cout << "rounds:      " << all.size() << " (" << rounds / elapsed << "/s)" << std::endl
+              << "statements:  " << static_cast<double>(statements) / elapsed << "/s" << std::endl
+              << "errors:      " << errors << std::endl
+              << "latency ms:  p50 " << percentile(all, 0.5)
+              << ", p90 " << percentile(all, 0.9)
+              << ", p99 " << percentile(all, 0.99)
+              << ", max " << percentile(all, 1) << std::endl;
+    return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -19,22 +19,34 @@ void args(Connection& conn);
 void argsOid(Connection& conn);
 void argsNull(Connection& conn);
 void argsLarge(Connection& conn);
+void argsBytes(Connection& conn);
+void argsArray(Connection& conn);
+void argsDecimal(Connection& conn);
+void argsUuid(Connection& conn);
 void argsRange(Connection& conn);
 void argsAfter(Connection& conn);
 void argsTime(Connection& conn);
 
 void prepare(Connection& conn);
+void prepareRebind(Connection& conn);
 
 void execMultiBad(Connection& conn);
 void execMultiOk(Connection& conn);
 
 void transact(Connection& conn);
 void transactManual(Connection& conn);
+void transactRetry(Connection& conn);
 
 void result(Connection& conn);
 void resultVars(Connection& conn);
 void resultNull(Connection& conn);
 void resultBadCast(Connection& conn);
+void resultColumn(Connection& conn);
+void resultArrow(Connection& conn);
+void resultTuple(Connection& conn);
+void resultView(Connection& conn);
+void resultGrid(Connection& conn);
+void resultShare(Connection& conn);
 void resultTime(Connection& conn);
 void resultTimeZone(Connection& conn);
 void resultExtractEpoch(Connection& conn);
@@ -45,13 +57,43 @@ void escape(Connection& conn);
 void send(Connection& conn);
 void sendTWice(Connection& conn);
 void sendRowByRow(Connection& conn);
+void sendChunks(Connection& conn);
+void stream(Connection& conn);
+void cursor(Connection& conn);
+void largeObject(Connection& conn);
+void sendPipeline(Connection& conn);
+void sendNonBlocking();
 
 void myTableUpdate(Connection& conn);
 void myTableVisit(Connection& conn);
+void myTableCopyIn(Connection& conn);
+void myTableCopyOut(Connection& conn);
+void myTableRefresh(Connection& conn);
+void myTableReplicate();
 
 void pool();
+void poolPriority();
+void poolDeadline();
+void poolAffinity();
+void poolBatch();
+void poolShared();
 void poolConfig();
 void poolPrepare();
+void poolPrepareTables();
+void poolAutoPrepare();
+void poolOnConnect();
+void poolStatements();
+void poolReplicas();
+void poolSharded();
+void poolParallelSelect();
+void poolIngest();
+void poolCoalesce();
+void poolCached();
+void poolListen();
+void poolReactor();
+void poolMetrics();
+void poolTrace();
+void poolSlowLog();
 void poolBehaviour();
 
 int main() {
@@ -75,22 +117,34 @@ int main() {
     argsOid(conn);
     argsNull(conn);
     argsLarge(conn);
+    argsBytes(conn);
+    argsArray(conn);
+    argsDecimal(conn);
+    argsUuid(conn);
     argsRange(conn);
     argsAfter(conn);
     argsTime(conn);
 
     prepare(conn);
+    prepareRebind(conn);
 
     execMultiBad(conn);
     execMultiOk(conn);
 
     transact(conn);
     transactManual(conn);
+    transactRetry(conn);
 
     result(conn);
     resultVars(conn);
     resultNull(conn);
     resultBadCast(conn);
+    resultColumn(conn);
+    resultArrow(conn);
+    resultTuple(conn);
+    resultView(conn);
+    resultGrid(conn);
+    resultShare(conn);
     resultTime(conn);
     resultTimeZone(conn);
     resultExtractEpoch(conn);
@@ -101,12 +155,42 @@ int main() {
     send(conn);
     sendTWice(conn);
     sendRowByRow(conn);
+    sendChunks(conn);
+    stream(conn);
+    cursor(conn);
+    largeObject(conn);
+    sendPipeline(conn);
+    sendNonBlocking();
 
     myTableUpdate(conn);
     myTableVisit(conn);
+    myTableCopyIn(conn);
+    myTableCopyOut(conn);
+    myTableRefresh(conn);
+    myTableReplicate();
 
     pool();
+    poolPriority();
+    poolDeadline();
+    poolAffinity();
+    poolBatch();
+    poolShared();
     poolConfig();
     poolPrepare();
+    poolPrepareTables();
+    poolAutoPrepare();
+    poolOnConnect();
+    poolStatements();
+    poolReplicas();
+    poolSharded();
+    poolParallelSelect();
+    poolIngest();
+    poolCoalesce();
+    poolCached();
+    poolListen();
+    poolReactor();
+    poolMetrics();
+    poolTrace();
+    poolSlowLog();
     poolBehaviour();
 }
@@ -9,8 +9,12 @@
 /// Each feature is explained in detail in its corresponding section below.
 /// ```cpp
 #include <chrono>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 #include <postgres/Postgres.h>
 
@@ -259,14 +263,64 @@ void argsNull(Connection& conn) {
 /// The `Command` stores all the arguments into its internal buffer.
 /// But there are cases when it is desirable to avoid copying, e.g. for a large piece of text.
 /// This can be achieved by passing pointer to underlying C-style string
-/// or by using a `std::string_view`, but keep an eye on lifetimes.
-/// The same is true for statements as well.
-/// The both ways are shown below:
+/// or by borrowing a `std::string_view` along with its length, but keep an eye on lifetimes.
+/// Borrowed values are sent in binary format with the type given, `TEXT` by default,
+/// while ordinary views are copied, since they don't necessarily end with a terminating zero.
+/// Statements passed as views and C-style strings are not copied either.
+/// Both ways are shown below:
 /// ```cpp
+using postgres::borrow;
+
 void argsLarge(Connection& conn) {
     std::string      text = "SOME VERY LONG TEXT...";
     std::string_view view = text;
-    conn.exec(Command{"SELECT $1, $2", text.data(), view});
+    conn.exec(Command{"SELECT $1, $2, $3", text.data(), borrow(view), borrow(view.substr(5, 4))});
+}
+/// ```
+/// Binary data is passed as `std::vector<uint8_t>` or borrowed as a pointer with a length,
+/// and read into the vector back.
+/// It is sent in binary format as `BYTEA` avoiding the hex encoding, which doubles the size:
+/// ```cpp
+void argsBytes(Connection& conn) {
+    std::vector<uint8_t> const blob{0xde, 0xad, 0xbe, 0xef};
+
+    auto const res = conn.exec(Command{"SELECT $1, $2", blob, borrow(blob.data(), 2)});
+    auto const out = res[0][0].as<std::vector<uint8_t>>();
+}
+/// ```
+/// Vectors of numbers and strings are sent as binary arrays,
+/// which fits statements like `= ANY($1)` better than a long list of arguments:
+/// ```cpp
+void argsArray(Connection& conn) {
+    std::vector<int32_t> const ids{1, 2, 3};
+
+    auto const res = conn.exec(Command{"SELECT array_agg(n) FROM generate_series(1, 5) n WHERE n = ANY($1)", ids});
+    auto const out = res[0][0].as<std::vector<int32_t>>();
+}
+/// ```
+/// Exact amounts of money are kept in `NUMERIC` columns. Those map to `Decimal`,
+/// an integer with the number of digits after the point, both as arguments and as results:
+/// ```cpp
+using postgres::Decimal;
+
+void argsDecimal(Connection& conn) {
+    auto const res = conn.exec(Command{"SELECT $1 * 2", Decimal{1999, 2}});
+
+    // Prints '39.98'.
+    std::cout << res[0][0].as<Decimal>().toString() << std::endl;
+}
+/// ```
+/// Identifiers of type `UUID` travel as 16 raw bytes of `Uuid`, and `JSONB` documents are read as plain text,
+/// so a `std::string_view` of such a field points right into the result:
+/// ```cpp
+using postgres::Uuid;
+
+void argsUuid(Connection& conn) {
+    auto const id  = Uuid::parse("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    auto const res = conn.exec(Command{"SELECT $1, jsonb_build_object('id', $1)", id});
+
+    res[0][0].as<Uuid>().toString();
+    std::cout << res[0][1].as<std::string_view>() << std::endl;
 }
 /// ```
 /// That's how you can pass arguments stored in a container:
@@ -289,15 +343,17 @@ void argsAfter(Connection& conn) {
 /// which represents a number of microseconds since Postgres epoch in UTC.
 /// Instances of `std::chrono::system_clock::time_point` are easily converted to that type
 /// and are accepted by the `Command` as arguments.
-/// Of course you can work with timestamps that include time zone information as well,
-/// but PgCC won't help you here, just pass them as strings.
-/// Well, almost won't help - actually you can preserve your local time zone:
+/// Timestamps with time zone are sent in binary as well, being the same UTC microseconds,
+/// along with dates and durations, which become `DATE` and `INTERVAL` respectively:
 /// ```cpp
 using postgres::Time;
 
 void argsTime(Connection& conn) {
     auto now = std::chrono::system_clock::now();
     conn.exec(Command{"SELECT $1", Time{now, true}});
+
+    auto today = std::chrono::time_point_cast<Time::Days>(now);
+    conn.exec(Command{"SELECT $1, $2", Time::Date{today}, std::chrono::minutes{5}});
 }
 /// ```
 
@@ -316,6 +372,16 @@ void prepare(Connection& conn) {
     conn.exec(PreparedCommand{"my_select", 123});
 }
 /// ```
+/// A command executed over and over again can be rebound to new arguments.
+/// It keeps the memory it has already allocated, so the loop below allocates nothing after the first iteration:
+/// ```cpp
+void prepareRebind(Connection& conn) {
+    PreparedCommand cmd{"my_select", 0};
+    for (auto i = 1; i <= 3; ++i) {
+        conn.exec(cmd.rebind(i));
+    }
+}
+/// ```
 /// Beware that the `Connection` is intentionally just a thin wrapper around native libpq handle
 /// and doesn't keep any additional state.
 /// Consequently, statements must be prepared again every time a connection's been reestablished.
@@ -377,6 +443,8 @@ void transact(Connection& conn) {
 /// The `transact()` accepts anything the `exec()` does:
 /// strings, `Command`*s*, `PreparedCommand`*s* and `PrepareData` in any combination.
 /// Either all of them succeed or none have any effect.
+/// The statements are pipelined together with `BEGIN` and `COMMIT`, so the whole transaction takes a single round trip.
+/// Once one of them fails, the rest are skipped and the transaction is rolled back.
 /// Again the example is a bit ridiculous, but imagine statements to be more meaningful,
 /// for instance, inserting data to two different tables when one insert without the other
 /// would leave a system in inconsistent state.
@@ -394,6 +462,29 @@ void transactManual(Connection& conn) {
 /// and build more complex and flexible transactions.
 /// When a transaction handle goes out of scope it rollbacks the transaction
 /// unless it has been explicitly committed already.
+///
+/// At `SERIALIZABLE` isolation transactions may fail with serialization errors or deadlocks,
+/// which go away when the transaction is simply run again.
+/// Both `transact()` and any job can be retried on such failures,
+/// telling them apart by the SQLSTATE available from `RuntimeError::code()`:
+/// ```cpp
+using postgres::RetryPolicy;
+
+void transactRetry(Connection& conn) {
+    RetryPolicy const policy{10, 1ms, 50ms};
+
+    conn.transact(policy, "SELECT 1", "SELECT 2");
+
+    conn.retry(policy, [](Connection& conn) {
+        auto tx = conn.begin();
+        conn.exec("SELECT 1");
+        tx.commit();
+        return conn.exec("SELECT 2");
+    });
+}
+/// ```
+/// Each attempt but the last is followed by a random pause up to the delay doubled after each one,
+/// so that contending transactions don't collide again.
 
 /// ### Reading the Result
 ///
@@ -481,6 +572,110 @@ void resultBadCast(Connection& conn) {
     }
 }
 /// ```
+/// The same rules apply to reading a whole numeric column at once.
+/// The type is checked once per column instead of once per field, which pays off for large results:
+/// ```cpp
+void resultColumn(Connection& conn) {
+    auto const res = conn.exec("SELECT i, NULLIF(i, 2) FROM generate_series(1, 3) i");
+
+    std::vector<int64_t> ids{};
+    res.column(0, ids);
+
+    // NULLs are stored either as empty optionals or as default values marked in a separate vector.
+    std::vector<std::optional<int32_t>> opts{};
+    res.column(1, opts);
+
+    std::vector<int32_t> vals{};
+    std::vector<bool>    nulls{};
+    res.column(1, vals, nulls);
+}
+/// ```
+/// Results can also be handed over to Apache Arrow through its C data interface, without depending on Arrow.
+/// Each result becomes a record batch with a child array per column, and the results of a query iterated by chunks
+/// become a stream of batches. The exported structures own copies of the data and are freed by their release callbacks,
+/// so that they can be imported with `arrow::ImportRecordBatch()` or `pyarrow`:
+/// ```cpp
+using postgres::Arrow;
+
+void resultArrow(Connection& conn) {
+    auto const  res = conn.exec("SELECT i, i::TEXT AS s FROM generate_series(1, 3) i");
+    ArrowSchema schema{};
+    ArrowArray  batch{};
+    Arrow::exportSchema(res, &schema);
+    Arrow::exportBatch(res, &batch);
+    std::cout << batch.length << " rows of " << schema.n_children << " columns" << std::endl;
+    batch.release(&batch);
+    schema.release(&schema);
+
+    ArrowArrayStream stream{};
+    Arrow::exportStream(conn.iter("SELECT generate_series(1, 10)", 4), &stream);
+    for (ArrowArray next{}; (stream.get_next(&stream, &next) == 0) && next.release; next.release(&next)) {
+        std::cout << next.length << " rows in a batch" << std::endl;
+    }
+    stream.release(&stream);
+}
+/// ```
+/// Ad-hoc queries without a visitable type can be decoded into tuples, row by row or for the whole result.
+/// Either way the columns are matched against the tuple in one go:
+/// ```cpp
+void resultTuple(Connection& conn) {
+    auto const res = conn.exec("SELECT i, i::TEXT FROM generate_series(1, 3) i");
+
+    auto const [id, name] = res[0].as<std::tuple<int64_t, std::string>>();
+
+    for (auto const [i, s] : res.as<std::tuple<int64_t, std::string>>()) {
+        std::cout << i << ' ' << s << std::endl;
+    }
+}
+/// ```
+/// The hottest loops may go further with a view, which insists on exact binary types of the columns.
+/// Once they are checked, reading a cell takes no more than fetching its bytes:
+/// ```cpp
+void resultView(Connection& conn) {
+    auto const res  = conn.exec("SELECT i::INT8, i::TEXT FROM generate_series(1, 3) i");
+    auto const view = res.view<int64_t, std::string_view>();
+
+    auto sum = int64_t{0};
+    for (auto const cells : view) {
+        sum += cells.get<0>();
+    }
+    std::cout << sum << ' ' << view[0].get<1>() << std::endl;
+}
+/// ```
+/// When the columns are not known up front, a grid reads their count, types and formats once for the whole result.
+/// Its cells are accessed inline, with `at()` checking the indices and the call operator trusting them:
+/// ```cpp
+void resultGrid(Connection& conn) {
+    auto const res  = conn.exec("SELECT i::INT8, i::TEXT FROM generate_series(1, 3) i");
+    auto const grid = res.grid();
+
+    auto sum = int64_t{0};
+    for (auto row = 0; row < grid.rows(); ++row) {
+        sum += grid(row, 0).as<int64_t>();
+    }
+    std::cout << sum << ' ' << grid.at(0, 1).as<std::string_view>() << std::endl;
+}
+/// ```
+/// Large text values can be read without copying into `std::string_view`.
+/// Such views point into the result, so share it to keep the data alive
+/// for as long as the views are needed:
+/// ```cpp
+struct Document {
+    std::shared_ptr<PGresult const> data;
+    std::string_view                body;
+};
+
+void resultShare(Connection& conn) {
+    Document doc{};
+    {
+        auto const res = conn.exec("SELECT repeat('foo', 1000)");
+        doc.data = res.share();
+        res[0][0] >> doc.body;
+    }
+
+    std::cout << doc.body.size() << std::endl;
+}
+/// ```
 /// Also the library is able to read timestamps without time zones:
 /// ```cpp
 void resultTime(Connection& conn) {
@@ -494,14 +689,18 @@ void resultTime(Connection& conn) {
     fld.as<Time>().toUnix();
 }
 /// ```
-/// Timestamps **with** time zone have to be converted to `TEXT` and then read into `std::string`:
+/// Timestamps **with** time zone are read the same way, as well as dates and intervals.
+/// Intervals containing months are rejected though, since their length varies:
 /// ```cpp
 void resultTimeZone(Connection& conn) {
-    auto const res = conn.exec("SELECT now()::TEXT");
-    auto const fld = res[0][0];
+    auto const res = conn.exec("SELECT now(), current_date, '1 day 2 hours'::INTERVAL");
 
-    // Prints something like '2019-03-21 12:58:13.256812+03'.
-    std::cout << fld.as<std::string>() << std::endl;
+    // Keeps the time zone flag.
+    res[0][0].as<Time>().hasZone();
+
+    auto const date = res[0][1].as<Time::Date>();
+    auto const dur  = res[0][2].as<std::chrono::hours>();
+    std::cout << date.time_since_epoch().count() << ' ' << dur.count() << std::endl;
 }
 /// ```
 /// And a small caveat about `extract(EPOCH FROM ...`-like statements.
@@ -625,6 +824,122 @@ void sendRowByRow(Connection& conn) {
 /// ```
 /// Notice that the result is checked for emptiness inside the loop body -
 /// this is because of how libpq works, and you always have to do the same thing.
+///
+/// A result per row is costly for really large datasets.
+/// Passing a chunk size lets each result hold up to that many rows:
+/// ```cpp
+void sendChunks(Connection& conn) {
+    for (auto const& res : conn.iter("SELECT generate_series(1, 10)", 4)) {
+        for (auto const& row : res) {
+            std::cout << row[0].as<int>() << std::endl;
+        }
+    }
+}
+/// ```
+/// Chunks require libpq 17 or newer, older versions fall back to a row per result.
+/// Breaking out of such a loop is cheap: the statement is cancelled rather than its rows transferred to be dropped.
+/// Inside a transaction block the rows are still drained, since the cancellation would abort the transaction.
+///
+/// Rows can also be streamed straight into a value, which is reused for each of them,
+/// so that a row costs just decoding its fields.
+/// ```cpp
+void stream(Connection& conn) {
+    for (auto const val : conn.stream<int>("SELECT generate_series(1, 10)", 4)) {
+        std::cout << val << std::endl;
+    }
+}
+/// ```
+/// Any visitable type works the same way, with column indices looked up once per stream.
+///
+/// A server-side cursor is another way to receive a large dataset in constant memory.
+/// Rows are fetched in batches of a given size with a round trip per batch,
+/// and the connection stays free between them, which matters when working through a pooler.
+/// The cursor runs in a transaction of its own, committed when it is closed,
+/// unless there is a transaction in progress already.
+/// ```cpp
+void cursor(Connection& conn) {
+    for (auto const& res : conn.cursor("SELECT generate_series(1, 10)", 4)) {
+        for (auto const& row : res) {
+            std::cout << row[0].as<int>() << std::endl;
+        }
+    }
+}
+/// ```
+///
+/// Blobs too large for a BYTEA are kept as large objects and streamed by ranges.
+/// Like a cursor, an opened object runs in a transaction of its own unless there is one in progress:
+/// ```cpp
+using postgres::LargeObject;
+
+void largeObject(Connection& conn) {
+    auto const id = conn.createLargeObject();
+    {
+        auto obj = conn.openLargeObject(id, LargeObject::Mode::WRITE);
+        obj.write("hello world", 11);
+    }
+
+    // Pass the object to a socket or a file by chunks, without holding all of it.
+    auto obj = conn.openLargeObject(id);
+    obj.readChunks([](char const* data, size_t len) {
+        std::cout.write(data, static_cast<std::streamsize>(len));
+    });
+    obj.close();
+    conn.removeLargeObject(id);
+}
+/// ```
+///
+/// Only one statement at a time can be in flight in the modes above,
+/// so every statement costs a full network round trip.
+/// A pipeline lifts that limitation: it lets you queue many statements,
+/// send them all at once and then receive their results in the same order.
+/// ```cpp
+void sendPipeline(Connection& conn) {
+    auto pipe = conn.pipeline();
+
+    // Queue the statements and mark the end of the batch.
+    for (auto i = 0; i < 3; ++i) {
+        pipe.send(Command{"SELECT $1::INT", i});
+    }
+    pipe.sync();
+
+    // Receive one result per statement.
+    for (auto const& res : pipe) {
+        std::cout << res[0][0].as<int>() << std::endl;
+    }
+}
+/// ```
+/// A failed statement makes all the following statements of the same batch fail too,
+/// up to the `sync()` call, which makes the batch an implicit transaction.
+/// Pipeline mode requires libpq 14 or newer,
+/// and the connection can't be used for anything else until the pipeline is destroyed.
+///
+/// Finally, a connection can be driven by an external event loop such as epoll or asio,
+/// so that a few threads are able to serve lots of connections.
+/// Nothing blocks in this case, and the loop waits on the connection socket instead.
+/// ```cpp
+void sendNonBlocking() {
+    // Start connecting and keep polling until it is done.
+    // Wait for the socket to get readable or writable as requested between the polls.
+    auto conn = Connection::start();
+    auto st   = PGRES_POLLING_WRITING;
+    while ((st != PGRES_POLLING_OK) && (st != PGRES_POLLING_FAILED)) {
+        st = conn.poll();
+    }
+
+    // Sending may leave some data unsent, so flush it when the socket is writable.
+    conn.setNonBlocking(true);
+    auto rec = conn.send("SELECT 123::INT");
+    while (!conn.flush()) {
+    }
+
+    // Check for the result when the socket is readable.
+    auto res = rec.tryReceive();
+    while (!res) {
+        res = rec.tryReceive();
+    }
+    std::cout << (*res)[0][0].as<int>() << std::endl;
+}
+/// ```
 
 /// ### Generating Statements
 ///
@@ -671,9 +986,9 @@ void myTableUpdate(Connection& conn) {
 
     // Generate an upsert statement.
     auto const upsert = "INSERT INTO "
-                        + Statement<MyTable>::table()
+                        + std::string{Statement<MyTable>::table()}
                         + " ("
-                        + Statement<MyTable>::fields()
+                        + std::string{Statement<MyTable>::fields()}
                         + ") VALUES "
                         + RangeStatement::placeholders(range.first, range.second)
                         + " ON CONFLICT (id) DO UPDATE SET info = EXCLUDED.info";
@@ -690,6 +1005,14 @@ void myTableUpdate(Connection& conn) {
 /// 3  | ham  | 2019-03-21 13:46:04.580402
 /// 4  | eggs | 2019-03-21 13:46:04.693358
 ///
+/// Rows are updated in bulk by their keys as well,
+/// once the key field is declared next to the table with `POSTGRES_CXX_TABLE_KEY(id);`.
+/// Then `conn.update(data.begin(), data.end())` sends a single `UPDATE ... FROM (SELECT ...)` statement,
+/// which matches the rows by the key and sets the rest of the fields.
+/// Similarly, `conn.upsert(data.begin(), data.end())` inserts the objects updating the ones with existing keys.
+/// It sends every field as a single array and unnests them on the server side,
+/// so the statement stays the same for any number of objects.
+///
 /// Recall the definition of MyTable:
 /// ```cpp
 /// struct MyTable {
@@ -754,6 +1077,104 @@ void myTableVisit(Connection& conn) {
 /// The design decision for table generation was to utilize unsigned integers
 /// to create auto-incremented fields, which are useful for producing unique identifiers.
 
+/// ### Bulk Copying
+///
+/// The multi-row insert shown above sends the whole range as a single statement,
+/// which the server has to parse, and the number of its parameters is limited.
+/// For large amounts of data the binary COPY protocol is much faster:
+/// ```cpp
+void myTableCopyIn(Connection& conn) {
+    auto const now = std::chrono::system_clock::now();
+
+    // Copy the whole range at once.
+    std::vector<MyTable> data{{5, "foo", now},
+                              {6, "bar", now}};
+    conn.copyIn(data.begin(), data.end());
+
+    // Or stream the rows one by one.
+    auto writer = conn.copyIn<MyTable>();
+    for (auto i = 7; i < 10; ++i) {
+        writer << MyTable{i, "baz", now};
+    }
+    writer.finish();
+}
+/// ```
+/// The data is sent in chunks while the rows are being written,
+/// and the copying is aborted unless `finish()` is called.
+/// Keep in mind that the server does not convert binary COPY data,
+/// so the field types must exactly match the column types.
+///
+/// Copying in the opposite direction decodes the rows as they arrive,
+/// so only one row is kept in memory regardless of the table size:
+/// ```cpp
+void myTableCopyOut(Connection& conn) {
+    // Handle each row with a callback.
+    conn.copyOut<MyTable>([](MyTable const& row) {
+        std::cout << row.info << std::endl;
+    });
+
+    // Or read the rows one by one.
+    auto    reader = conn.copyOut<MyTable>();
+    MyTable row{};
+    while (reader.read(row)) {
+        std::cout << row.id << std::endl;
+    }
+    reader.finish();
+}
+/// ```
+/// The fields are matched to the columns by their position,
+/// and their types must be wide enough to hold the copied values.
+///
+/// A cache of a table reloaded every now and then can decode the rows over the objects it already holds.
+/// Strings are compared with the columns in place and overwritten only when changed, reusing their storage,
+/// so that reloading a table that has hardly changed allocates next to nothing.
+/// The rows are matched to the objects by position, and the indices of those changed are reported:
+/// ```cpp
+void myTableRefresh(Connection& conn) {
+    std::vector<MyTable> cache{};
+    conn.refresh(cache);
+
+    // Some time later.
+    std::vector<size_t> changed{};
+    conn.refresh(cache, &changed);
+    for (auto const idx : changed) {
+        std::cout << cache[idx].info << std::endl;
+    }
+}
+/// ```
+
+/// ### Logical Replication
+///
+/// Changes committed to the tables of a publication can be streamed from a logical replication slot,
+/// which keeps the log on the server until the changes are acknowledged.
+/// The slot and the publication are created beforehand, and the connection is made in the replication mode.
+/// Rows come in binary, which takes PostgreSQL 14 or later, and decode into the same types as the selected ones.
+/// Values of large columns left unchanged by an update are not sent, so they come as nulls.
+/// `ack()` can be called from any thread, and the position is reported with the next status update:
+/// ```cpp
+using postgres::Change;
+
+void myTableReplicate() {
+    // CREATE PUBLICATION my_pub FOR TABLE my_table
+    // SELECT pg_create_logical_replication_slot('my_slot', 'pgoutput')
+    Connection conn{Config::Builder{}.replication(true).build()};
+
+    try {
+        auto   changes = conn.replicate("my_slot", {"my_pub"});
+        Change chg{};
+        while (changes.read(chg, 1s)) {
+            if ((chg.kind == Change::Kind::INSERT) && (chg.table == "my_table")) {
+                std::cout << chg.as<MyTable>().info << std::endl;
+            } else if (chg.kind == Change::Kind::COMMIT) {
+                changes.ack(chg.lsn);
+            }
+        }
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+/// ```
+
 /// ### Connection Pool
 ///
 /// Now that you know how to use a connection let’s move on to a higher-level feature.
@@ -776,6 +1197,100 @@ void pool() {
     std::cout << res.get().size() << std::endl;
 }
 /// ```
+/// A request can be given a priority,
+/// so that latency-critical ones don't wait behind a batch of heavy ones sent earlier.
+/// ```cpp
+using postgres::Priority;
+
+void poolPriority() {
+    Client cl{};
+
+    auto report = cl.query([](Connection& conn) {
+        return conn.exec("SELECT COUNT(*) FROM pg_class");
+    }, Priority::LOW);
+    auto lookup = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, Priority::HIGH);
+
+    std::cout << lookup.get().size() << report.get().size() << std::endl;
+}
+/// ```
+/// Each priority has its own queue.
+/// The queues are served in weighted round robin: four high priority requests,
+/// then two normal and one low, so that the low priority ones are delayed but not starved.
+/// With `strictPriority(true)` in the context a request waits until no more urgent ones are left.
+/// Sharded and work stealing queues described below ignore priorities.
+///
+/// A request can also be given a deadline.
+/// If it doesn't start by then, the future gets an error instead,
+/// and if it is still running, its query is canceled on the server, letting the thread move on.
+/// ```cpp
+void poolDeadline() {
+    Client cl{};
+
+    auto res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT pg_sleep(1)");
+    }, std::chrono::steady_clock::now() + 100ms);
+
+    try {
+        res.get();
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+/// ```
+///
+/// Jobs relying on the state of a connection, like temporary tables or prepared statements,
+/// can be given an affinity key. Jobs with the same key run on the same thread and connection
+/// whenever it is idle, and on any other one otherwise:
+/// ```cpp
+using postgres::Affinity;
+
+void poolAffinity() {
+    Client cl{};
+
+    auto const user_id = size_t{42};
+    cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, Affinity{user_id});
+}
+/// ```
+/// The affinity is ignored by the sharded and work stealing queues described below.
+///
+/// Sending lots of requests at once, like a fan-out of a request handler, takes just one pass over the queue
+/// with `execBatch()` and `queryBatch()`, which give a future per job of the range:
+/// ```cpp
+void poolBatch() {
+    Client cl{};
+
+    std::vector<std::function<Result(Connection&)>> jobs{};
+    for (auto i = 0; i < 10; ++i) {
+        jobs.emplace_back([i](Connection& conn) {
+            return conn.exec(Command{"SELECT $1", i});
+        });
+    }
+    for (auto& res : cl.queryBatch(jobs.begin(), jobs.end())) {
+        std::cout << res.get()[0][0].as<int32_t>() << std::endl;
+    }
+}
+/// ```
+/// Jobs that don't fit in a full queue fail through their futures instead of throwing.
+///
+/// When lots of callers are likely to send the very same read at once, say on a cache miss,
+/// `queryShared()` lets the commands with the same statement and arguments sent while one of them
+/// is still running wait for its result instead of taking connections of their own:
+/// ```cpp
+void poolShared() {
+    Client cl{};
+
+    auto const first  = cl.queryShared(Command{"SELECT $1", 42});
+    auto const second = cl.queryShared(Command{"SELECT $1", 42});
+
+    // Both refer to the same result.
+    std::cout << first.get()[0][0].as<int32_t>() + second.get()[0][0].as<int32_t>() << std::endl;
+}
+/// ```
+///
 /// The `Client` implements single-producer-multiple-consumers pattern
 /// and is not thread-safe by itself: protect it with a mutex for concurrent access.
 /// The interface is quite straightforward to use,
@@ -805,14 +1320,320 @@ void poolPrepare() {
     Client cl{Context::Builder{}.prepare({"my_select", "SELECT 1"}).build()};
 }
 /// ```
+/// Registered statements are prepared in a single round trip whenever a new connection is made.
+/// If there are lots of them, and each connection uses just a few,
+/// `lazyPrepare(true)` makes a connection prepare a statement on the first use of its name.
+///
+/// Statements of visitable types are registered in one call,
+/// which prepares the insert, update and select of `Statement<T>` for each type,
+/// named after its table like `my_table_insert`.
+/// Their parameters are typed by the fields, so the server never takes binary values for other types:
+/// ```cpp
+void poolPrepareTables() {
+    Client cl{Context::Builder{}.prepareTables<MyTable>().build()};
+}
+/// ```
+///
+/// Alternatively, statements can be prepared automatically.
+/// Each connection then keeps a number of recently executed commands,
+/// and prepares those executed more than once, deallocating the least recent ones.
+/// ```cpp
+void poolAutoPrepare() {
+    Client cl{Context::Builder{}.autoPrepare(100).build()};
+}
+/// ```
+/// Statements setting up the session, like `SET` of the search path or the statement timeout,
+/// are run by every new connection before the statements are prepared:
+/// ```cpp
+void poolOnConnect() {
+    Client cl{Context::Builder{}.onConnect({"SET search_path TO public", "SET statement_timeout = '5s'"})
+                                .build()};
+}
+/// ```
+/// Plain `SET` commands are passed to the server along with the connection request, unless the context uses an URI,
+/// and the rest are sent in the same round trip as the preparations.
+///
+/// A pooler in the transaction mode, like PgBouncer, may run each transaction in another server session,
+/// which knows nothing of the statements prepared in the others.
+/// With `transactionPooler(true)` the statements reported missing are prepared again and retried,
+/// unless they run in a transaction, which fails as usual.
+/// Statements prepared automatically rely on the pooler supporting protocol level prepared statements,
+/// since their names would clash between the connections sharing a server session otherwise.
+///
+/// Rows are decoded into visitable types by looking the fields up among the columns of each result.
+/// With `describePrepared(true)` the registered statements are also described when prepared,
+/// so that the results of each of them share the mapping of the fields, looked up just once.
+/// The descriptions ride in the same round trip as the preparations, unless these are lazy.
+///
+/// Clients of several tenants preparing the same statements can share them through a registry,
+/// which keeps the statements once per process rather than once per context and connection.
+/// With `describePrepared(true)` each statement is described by the first connection preparing it,
+/// and the connections of all the pools take that description instead of asking the server again.
+/// Results not matching it, say of a tenant whose table differs, map their columns on their own:
+/// ```cpp
+using postgres::StatementRegistry;
+
+void poolStatements() {
+    auto const reg = std::make_shared<StatementRegistry>();
+    reg->addTables<MyTable>().add(PrepareData{"my_select", "SELECT info FROM my_table WHERE id = $1"});
+
+    std::vector<std::unique_ptr<Client>> tenants{};
+    for (auto const db : {"tenant1", "tenant2"}) {
+        tenants.push_back(std::make_unique<Client>(Context::Builder{}.uri(std::string{"postgresql:///"} + db)
+                                                                     .statements(reg)
+                                                                     .describePrepared(true)
+                                                                     .lazyPrepare(true)
+                                                                     .build()));
+    }
+}
+/// ```
+///
+/// A context can also describe replicas, each with a pool of its own configured by its own context.
+/// Jobs sent with `read()` go to the replica having the fewest outstanding jobs,
+/// while all the others still go to the primary server:
+/// ```cpp
+void poolReplicas() {
+    Client cl{Context::Builder{}.uri("postgresql://primary/cxx_client")
+                                .replica(Context::Builder{}.uri("postgresql://replica1/cxx_client").build())
+                                .replica(Context::Builder{}.uri("postgresql://replica2/cxx_client").build())
+                                .build()};
+
+    cl.read([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    });
+}
+/// ```
+/// An occasional slow replica, busy with a vacuum or a checkpoint, can dominate the tail latency.
+/// With `hedgeQuantile(0.95)` a read job still running after 95% of the recent ones would have finished
+/// gets a copy sent to another replica. The first one to finish wins, and the other is cancelled.
+/// Thus hedged jobs have to be safe to run twice, even concurrently.
+///
+/// Data sharded across several clusters is served by a `ShardedClient`,
+/// which keeps a pool per shard and routes each job by its key.
+/// Keys are hashed onto the shards unless given a function telling the shard of a key.
+/// A job can also be run on all the shards in parallel, getting either their results or their rows merged:
+/// ```cpp
+using postgres::ShardedClient;
+
+void poolSharded() {
+    std::vector<Context> shards{};
+    shards.push_back(Context::Builder{}.uri("postgresql://shard1/cxx_client").build());
+    shards.push_back(Context::Builder{}.uri("postgresql://shard2/cxx_client").build());
+
+    ShardedClient<int64_t> cl{std::move(shards), [](int64_t const customer) {
+        return static_cast<size_t>(customer / 1000);
+    }};
+
+    cl.query(42, [](Connection& conn) {
+        return conn.exec(Command{"SELECT * FROM orders WHERE customer = $1", int64_t{42}});
+    });
+
+    try {
+        auto const counts = cl.merge<int64_t>([](Connection& conn) {
+            return conn.exec("SELECT count(*) FROM orders");
+        });
+        std::cout << counts.size() << " shards counted" << std::endl;
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+/// ```
+/// A large table is exported faster by splitting its scan into ranges of pages,
+/// which are decoded concurrently by different connections.
+/// The rows are either merged in the order of the ranges or passed to a callback range by range.
+/// The ranges don't share a snapshot, so rows changed during the scan may be missed or seen twice:
+/// ```cpp
+void poolParallelSelect() {
+    Client cl{Context::Builder{}.maxConcurrency(4).build()};
+
+    auto const rows = cl.parallelSelect<MyTable>(4).get();
+    std::cout << rows.size() << " rows selected" << std::endl;
+
+    cl.parallelSelect<MyTable>(4, [](int const range, std::vector<MyTable>& part) {
+        std::cout << part.size() << " rows in range " << range << std::endl;
+    }).get();
+}
+/// ```
+/// Loading is sped up the other way around by `ingest()`, which copies the rows given to it
+/// over a number of connections at once, each by a COPY stream of its own.
+/// The streams take the rows in batches from a bounded buffer, and writing waits while it is full,
+/// so that a fast producer doesn't run out of memory:
+/// ```cpp
+void poolIngest() {
+    Client cl{Context::Builder{}.maxConcurrency(4).build()};
+
+    auto ing = cl.ingest<MyTable>(4);
+    for (auto i = 0; i < 100'000; ++i) {
+        ing << MyTable{i, "info", std::chrono::system_clock::now()};
+    }
+    for (auto const& stream : ing.progress()) {
+        std::cout << stream.rows << " rows copied by a stream" << std::endl;
+    }
+    std::cout << ing.finish() << " rows ingested" << std::endl;
+}
+/// ```
+/// Each stream copies its rows in a single transaction, unless given a number of rows to commit after.
+/// A failure of any stream aborts the others, though the transactions already committed stay.
+/// The streams hold their connections until finished, so the pool has to have enough of them.
+///
+/// Lots of small independent writes spend most of their time waiting for their commits.
+/// Coalescing runs them in shared transactions of up to `coalesceLimit()` jobs,
+/// each batch waiting at most `coalesceWindow()` to fill up, so that they share a commit.
+/// The window defaults to zero, batching only the jobs already queued.
+/// A batch hit by a failure is rolled back and replayed job by job,
+/// so that a bad job fails alone, which requires the jobs be safe to run again.
+/// ```cpp
+using postgres::Status;
+
+void poolCoalesce() {
+    Client cl{Context::Builder{}.coalesceWindow(1ms).coalesceLimit(32).build()};
+
+    std::vector<std::future<Status>> results{};
+    for (auto i = 0; i < 10; ++i) {
+        results.push_back(cl.coalesce([i](Connection& conn) {
+            return conn.exec(Command{"INSERT INTO my_table (id, info, create_time) VALUES ($1, 'spam', now())",
+                                     100 + i});
+        }));
+    }
+    for (auto& res : results) {
+        res.get();
+    }
+}
+/// ```
+/// Results of frequent reads can be cached on the client side with `queryCached()`,
+/// which serves the commands with the same statement and arguments from the cache for `cacheTtl()`.
+/// The cache is bounded in size by `cacheCapacity()` evicting the least recently used results,
+/// and can be emptied with `invalidate()` or by a notification on `cacheChannel()`
+/// sent by the writers, say from a trigger:
+/// ```cpp
+void poolCached() {
+    Client cl{Context::Builder{}.cacheTtl(10s).cacheChannel("my_table_changed").build()};
+
+    try {
+        auto const res = cl.queryCached(Command{"SELECT info FROM my_table WHERE id = $1", 1});
+        std::cout << res.get().size() << " rows cached" << std::endl;
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    // NOTIFY my_table_changed
+    cl.invalidate();
+}
+/// ```
+/// The notifications are received by a `Listener`, which can be used on its own.
+/// It waits for them on a connection of its own, without sending any query,
+/// and runs the callbacks subscribed to their channels on a pool of threads.
+/// The notifications sent while its connection was lost are missed, which `onGap()` is called on:
+/// ```cpp
+using postgres::Listener;
+using postgres::Notification;
+
+void poolListen() {
+    Listener lis{Context{}, 2};
+    lis.onGap([] {
+        std::cout << "some notifications may have been missed" << std::endl;
+    });
+    lis.subscribe("my_table_changed", [](Notification const& note) {
+        std::cout << note.channel << ": " << note.payload << std::endl;
+    });
+}
+/// ```
+/// A thread per connection spends most of its time blocked in libpq,
+/// which gets costly with hundreds of connections.
+/// With `reactorThreads()` commands sent to a client are instead run by that many event loop threads,
+/// each driving its share of `maxConcurrency()` connections in non-blocking mode.
+/// The other jobs can't be multiplexed like this and still take a thread of their own:
+/// ```cpp
+void poolReactor() {
+    Client cl{Context::Builder{}.maxConcurrency(500).reactorThreads(4).build()};
+
+    std::vector<std::future<Result>> results{};
+    for (auto i = 0; i < 10; ++i) {
+        results.push_back(cl.query(Command{"SELECT info FROM my_table WHERE id = $1", i}));
+    }
+    for (auto& res : results) {
+        try {
+            std::cout << res.get().size() << " rows selected" << std::endl;
+        } catch (std::exception const& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
+/// ```
+/// To tune the pool from data, a client counts the jobs sent, queued and run,
+/// the time they wait in the queue and run for, the workers connected and recycled, and the time to connect.
+/// The counters are cheap to update and summed up only when `metrics()` is called,
+/// or every period if a sink is given to the context:
+/// ```cpp
+using postgres::Metrics;
+
+void poolMetrics() {
+    Client cl{Context::Builder{}.metricsSink(10s, [](Metrics const& met) {
+        std::cout << met.queued << " jobs queued" << std::endl;
+    }).build()};
+
+    cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }).get();
+
+    auto const met = cl.metrics();
+    std::cout << met.finished << " jobs done, "
+              << met.workers << " workers, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(met.wait.quantile(0.99)).count()
+              << "us waited by 99% of jobs" << std::endl;
+}
+/// ```
+/// With `accountMemory(true)` set in the context, the metrics also count the commands executed, results received
+/// and jobs run by the pool along with the bytes they hold, the results being sized by `PQresultMemorySize()`.
+/// Each statement a connection executes can also be reported to a tracer,
+/// with its text, parameters, time to the first and the last result, rows and SQLSTATE on failure.
+/// It is set for the connections of a pool by the context, or on a connection with `trace()`,
+/// and costs nothing but a check when not set:
+/// ```cpp
+using postgres::Trace;
+using postgres::Tracer;
+
+struct MyTracer : Tracer {
+    void trace(Trace const& trace) override {
+        std::cout << trace.statement << " took "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(trace.total).count() << "us" << std::endl;
+    }
+};
+
+void poolTrace() {
+    Client cl{Context::Builder{}.tracer(std::make_shared<MyTracer>()).build()};
+    cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }).get();
+}
+/// ```
+/// A built-in tracer, `SlowLog`, aggregates statements by their fingerprints with literals and lists of values
+/// replaced by placeholders, counting the time spent waiting in the queue of a pool too.
+/// It keeps a bounded number of fingerprints and reports the worst of them by total latency:
+/// ```cpp
+using postgres::SlowLog;
+
+void poolSlowLog() {
+    auto const log = std::make_shared<SlowLog>(std::chrono::milliseconds{1});
+    Client     cl{Context::Builder{}.tracer(log).build()};
+    for (auto i = 0; i < 10; ++i) {
+        cl.exec([i](Connection& conn) {
+            return conn.exec(Command{"SELECT pg_sleep($1)", i * 0.001});
+        }).get();
+    }
+    log->dump(std::cout, 5);
+}
+/// ```
 /// And finally there are parameters affecting the behaviour of a connection pool:
 /// ```cpp
 using postgres::ShutdownPolicy;
 
 void poolBehaviour() {
     Client cl{Context::Builder{}.idleTimeout(1min)
+                                .minConcurrency(1)
                                 .maxConcurrency(2)
                                 .maxQueueSize(30)
+                                .queueShards(4)
                                 .shutdownPolicy(ShutdownPolicy::DROP)
                                 .build()};
 }
@@ -828,6 +1649,58 @@ void poolBehaviour() {
 /// Also the internal queue size can be limited.
 /// Exceeding the limit results in an exception in a thread calling the client methods.
 /// By default the queue is allowed to grow until application runs out of memory and crashes.
+/// Instead of throwing, `overflowPolicy(OverflowPolicy::BLOCK)` makes the calling thread wait
+/// for the room in the queue, at most for `overflowTimeout()` if specified.
+/// Requests sent to a client from inside its own pool never wait, as that could deadlock it, and throw instead.
+///
+/// Results waiting in the futures can be limited too, by the memory they take as told by `PQresultMemorySize()`.
+/// With `resultBudget(bytes, OverflowPolicy::THROW)` a result which would exceed the budget fails its request,
+/// while `OverflowPolicy::BLOCK` keeps the thread which has obtained it waiting until earlier results are released,
+/// at most for `overflowTimeout()` if specified. A result larger than the whole budget passes once nothing else is held.
+/// A result counts against the budget until the last of the views shared from it is gone.
+///
+/// Minimum concurrency makes the client open that many connections in parallel on construction
+/// and keep them regardless of the idle timeout, which avoids a latency spike on the first requests.
+/// With `waitWarmUp(true)` the constructor returns once all of them are either connected or failed.
+/// The failed ones are reconnected on demand.
+///
+/// A connection broken by a failover or a restart of the server normally makes its thread quit,
+/// and the next request waits for a new connection to be made.
+/// With `reconnect(attempts, backoff)` the thread replaces the connection itself instead,
+/// waiting for the backoff after the first failed attempt and twice as long after each next one.
+/// Connections closed while idle are noticed only by the requests running on them,
+/// unless `healthCheck(idle)` makes the threads check the sockets of connections idle for that long
+/// before running the next requests, which takes no round trip to the server.
+///
+/// Threads of the pool can be named by `threadName(name)` to tell them apart in profilers,
+/// get stacks of `stackSize(bytes)` and stay on the CPUs given to `cpuAffinity(cpus, pin_each)`,
+/// say those of the NUMA node running the threads that send the requests.
+/// With `pin_each` set each thread runs on a single CPU of the list, taken in turn,
+/// so alternating CPUs of different nodes spreads the threads across the nodes instead.
+///
+/// After a failover every request may find the pool empty and ask for a connection,
+/// and a burst of handshakes can keep the recovering server busy with authentication.
+/// `connectThrottle(max_connecting, interval)` caps the connection attempts in progress,
+/// so that requests over it wait in the queue for the connections under way rather than start more,
+/// and spaces the attempts by the interval plus a random jitter of up to a half of it,
+/// so that several pools restarting together don't connect in lockstep.
+/// The initial connections and reconnects are spaced too, but not capped.
+///
+/// The maximum can also serve as a ceiling for an adaptive limit, enabled by `adaptiveConcurrency(true)`.
+/// The limit then starts at the minimum and grows while requests take about as long as they used to,
+/// and shrinks when they slow down, so that a load spike doesn't drive the database into contention.
+/// Threads above the limit quit after finishing their current requests.
+///
+/// The queue is guarded by a single lock, which can become contended
+/// when many threads submit short requests at once.
+/// Splitting it into several shards lets them proceed independently,
+/// at the cost of requests from different threads being executed in no particular order.
+///
+/// Work stealing suits requests that send follow-up ones to the same client from inside the pool.
+/// Such requests are queued locally to the thread sending them,
+/// so that they are likely to run on the same warm thread and connection,
+/// while idle threads take the oldest requests from busy ones.
+/// It is enabled with `workStealing(true)` and takes precedence over sharding.
 ///
 /// Shutdown policy regulates how to handle the queue on shutdown.
 /// Default policy is to stop gracefully: all requests waiting in the queue will be executed.
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace postgres {
+
+// Jobs with the same key run on the same worker whenever it is idle,
+// so that they share the state of its connection like prepared statements, temporary tables and caches.
+// Otherwise they are taken by any worker as usual.
+struct Affinity {
+    size_t key;
+};
+
+}  // namespace postgres
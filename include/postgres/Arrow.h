@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+// Arrow C data interface, so that results are handed over to Arrow without depending on it.
+// See https://arrow.apache.org/docs/format/CDataInterface.html and CStreamInterface.html.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char*          format;
+    const char*          name;
+    const char*          metadata;
+    int64_t              flags;
+    int64_t              n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema*  dictionary;
+    void (* release)(struct ArrowSchema*);
+    void*                private_data;
+};
+
+struct ArrowArray {
+    int64_t             length;
+    int64_t             null_count;
+    int64_t             offset;
+    int64_t             n_buffers;
+    int64_t             n_children;
+    const void**        buffers;
+    struct ArrowArray** children;
+    struct ArrowArray*  dictionary;
+    void (* release)(struct ArrowArray*);
+    void*               private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+    int (* get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+    int (* get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+    const char* (* get_last_error)(struct ArrowArrayStream*);
+    void (* release)(struct ArrowArrayStream*);
+    void*       private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+namespace postgres {
+
+class Receiver;
+class Result;
+
+// Exports results as Arrow record batches, which are struct arrays with a child per column.
+// Types map as follows, others being exported as their binary representation:
+//  BOOL, INT2, INT4, INT8, FLOAT4 and FLOAT8 to the same Arrow types;
+//  TEXT, VARCHAR, BPCHAR, NAME, JSON, JSONB and NUMERIC to UTF-8 strings;
+//  BYTEA to binary, UUID to 16 bytes fixed size binary;
+//  DATE to date32, TIMESTAMP and TIMESTAMPTZ to microsecond timestamps, the latter in UTC.
+// Columns of results in the text format are exported as strings.
+// The exported structures own copies of the data, released by their release callbacks.
+class Arrow {
+public:
+    static void exportSchema(Result const& res, ArrowSchema* out);
+    static void exportBatch(Result const& res, ArrowArray* out);
+
+    // Turns the results of a query into a stream of batches, taking over the receiver.
+    // Iterating over the rows by chunks, see Connection::iter(), keeps a batch from taking the whole result.
+    static void exportStream(Receiver rcvr, ArrowArrayStream* out);
+};
+
+}  // namespace postgres
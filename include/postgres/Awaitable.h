@@ -0,0 +1,101 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "Awaitable requires C++20 coroutines"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <postgres/internal/Dispatcher.h>
+#include <postgres/internal/Pool.h>
+#include <postgres/Client.h>
+#include <postgres/Connection.h>
+
+namespace postgres {
+
+// Submits a job to the connection pool when awaited.
+// The awaiting coroutine is resumed on the worker thread once the job is done,
+// and occupies the worker until its next suspension.
+template <typename T, typename F>
+class Awaitable {
+public:
+    explicit Awaitable(internal::Dispatcher& disp, F job)
+        : disp_{&disp},
+          state_{std::allocate_shared<State>(internal::PoolAllocator<State>{}, std::move(job))} {
+    }
+
+    Awaitable(Awaitable const& other) = delete;
+    Awaitable& operator=(Awaitable const& other) = delete;
+    Awaitable(Awaitable&& other) noexcept = delete;
+    Awaitable& operator=(Awaitable&& other) noexcept = delete;
+    ~Awaitable() noexcept = default;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> const handle) {
+        try {
+            disp_->post(Task{state_, handle});
+        } catch (...) {
+            // The job may be queued anyway, e.g. if a worker fails to start.
+            if (!state_->is_claimed.exchange(true)) {
+                throw;
+            }
+        }
+    }
+
+    T await_resume() {
+        if (state_->err) {
+            std::rethrow_exception(state_->err);
+        }
+        return std::move(*state_->res);
+    }
+
+private:
+    struct State;
+
+    // Whoever comes first resumes the coroutine.
+    struct Task {
+        void operator()(Connection& conn) {
+            try {
+                state->res.emplace(state->job(conn));
+            } catch (...) {
+                state->err = std::current_exception();
+            }
+            resume();
+        }
+
+        void fail(std::exception_ptr const& err) {
+            state->err = err;
+            resume();
+        }
+
+        void resume() {
+            if (!state->is_claimed.exchange(true)) {
+                handle.resume();
+            }
+        }
+
+        std::shared_ptr<State>  state;
+        std::coroutine_handle<> handle;
+    };
+
+    struct State {
+        explicit State(F fn) : job{std::move(fn)} {
+        }
+
+        F                  job;
+        std::optional<T>   res;
+        std::exception_ptr err;
+        std::atomic<bool>  is_claimed{false};
+    };
+
+    internal::Dispatcher*  disp_;
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace postgres
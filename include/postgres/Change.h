@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <postgres/Error.h>
+#include <postgres/Result.h>
+#include <postgres/Row.h>
+
+namespace postgres {
+
+// Change decoded from the logical replication stream, see ChangeStream.
+// Rows come as results of a single row, which decode into visitable types by the column names.
+// Large values left unchanged by an update are not sent by the server, so they come as NULLs.
+struct Change {
+    enum class Kind {
+        BEGIN,
+        COMMIT,
+        INSERT,
+        UPDATE,
+        DELETE,
+        TRUNCATE,
+    };
+
+    // Decodes the new row, or the old one of a deletion.
+    template <typename T>
+    T as() const {
+        auto const& res = row ? row : old;
+        _POSTGRES_CXX_ASSERT(LogicError, res, "change of kind " << static_cast<int>(kind) << " has no row");
+        T   val{};
+        Row cur = (*res)[0];
+        cur >> val;
+        return val;
+    }
+
+    Kind kind = Kind::BEGIN;
+    // Position of the change in the log. That of a commit is the end of the transaction,
+    // to be acknowledged once the transaction is handled.
+    uint64_t lsn = 0;
+    // Transaction started by a begin.
+    uint32_t xid = 0;
+
+    std::string schema;
+    std::string table;
+    // New row of an insert or an update.
+    std::optional<Result> row;
+    // Old row of an update or a delete, being either the key of the replica identity or the whole row.
+    std::optional<Result> old;
+};
+
+}  // namespace postgres
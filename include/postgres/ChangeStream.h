@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <libpq-fe.h>
+#include <postgres/internal/Pgoutput.h>
+#include <postgres/Change.h>
+
+namespace postgres {
+
+// Streams the changes of the publications from a logical replication slot decoded by pgoutput,
+// on a connection made in the replication mode, see Connection::replicate().
+// Values are sent in binary, which takes PostgreSQL 14 or later.
+// Changes are acknowledged by the position of their commit from any thread, and the position
+// is reported with the next status update sent while reading, so that the server may recycle the log.
+class ChangeStream {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+
+    ChangeStream(ChangeStream const& other) = delete;
+    ChangeStream& operator=(ChangeStream const& other) = delete;
+    ChangeStream(ChangeStream&& other) noexcept;
+    ChangeStream& operator=(ChangeStream&& other) = delete;
+    // Reports the last acknowledged position and ends the replication.
+    ~ChangeStream() noexcept;
+
+    // Waits for the next change, giving false once the server has ended the replication.
+    bool read(Change& out);
+    // Same as above giving false also when there is no change within the timeout.
+    bool read(Change& out, Duration timeout);
+
+    // Changes up to the position are handled and need not be sent again.
+    void ack(uint64_t lsn);
+    uint64_t acked() const;
+    // End of the log received so far.
+    uint64_t received() const;
+    bool isOver() const;
+
+    // Position in the textual form of the server, like 16/B374D848.
+    static std::string format(uint64_t lsn);
+
+private:
+    friend class Connection;
+
+    explicit ChangeStream(std::shared_ptr<PGconn> handle, std::string const& stmt, Duration status_interval);
+
+    // Tells whether a message has been received, waiting for it up to the deadline.
+    bool receive(Clock::time_point deadline);
+    void handle(char const* data, size_t len);
+    void report();
+    PGconn* native() const;
+
+    std::shared_ptr<PGconn> handle_;
+    internal::Pgoutput      decoder_;
+    std::deque<Change>      changes_;
+    Duration                interval_;
+    Clock::time_point       next_report_;
+    uint64_t                received_ = 0;
+    std::atomic<uint64_t>   acked_{0};
+    bool                    is_over_ = false;
+};
+
+}  // namespace postgres
@@ -1,24 +1,48 @@
 #pragma once
 
-#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <future>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Dispatcher.h>
+#include <postgres/internal/Hedger.h>
+#include <postgres/internal/Race.h>
+#include <postgres/Affinity.h>
+#include <postgres/Ingester.h>
+#include <postgres/Priority.h>
+#include <postgres/Result.h>
+#include <postgres/RetryPolicy.h>
+#include <postgres/Status.h>
 
 namespace postgres::internal {
 
-class Dispatcher;
+class Flights;
+class Reactor;
+class ResultCache;
 
 }  // namespace postgres::internal
 
 namespace postgres {
 
+class Command;
 class Connection;
 class Context;
-class Result;
-class Status;
+class Listener;
+class PreparedCommand;
+
+template <typename T, typename F>
+class Awaitable;
 
 class Client {
 public:
+    using Deadline = internal::Watchdog::Deadline;
+
     explicit Client();
     explicit Client(Context ctx);
     Client(Client const& other) = delete;
@@ -27,13 +51,358 @@ public:
     Client& operator=(Client&& other) noexcept;
     ~Client() noexcept;
 
-    std::future<Status> exec(std::function<Status(Connection&)> job);
-    std::future<Result> query(std::function<Result(Connection&)> job);
+    template <typename F>
+    std::future<Status> exec(F&& job, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Status>(std::forward<F>(job), prio);
+    }
+
+    template <typename F>
+    std::future<Result> query(F&& job, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Result>(std::forward<F>(job), prio);
+    }
+
+    // Sends the jobs of the range at once, taking the queue and waking the idle workers in one pass.
+    // Jobs overflowing the queue fail through their futures rather than throwing.
+    template <typename Iter>
+    std::vector<std::future<Status>> execBatch(Iter beg, Iter end, Priority const prio = Priority::NORMAL) {
+        return impl_->sendBatch<Status>(beg, end, prio);
+    }
+
+    template <typename Iter>
+    std::vector<std::future<Result>> queryBatch(Iter beg, Iter end, Priority const prio = Priority::NORMAL) {
+        return impl_->sendBatch<Result>(beg, end, prio);
+    }
+
+    // Commands are multiplexed over the connections by the event loops in the reactor mode,
+    // see Context::Builder::reactorThreads(), and run like any other job otherwise.
+    std::future<Status> exec(Command cmd, Priority prio = Priority::NORMAL);
+    std::future<Status> exec(PreparedCommand cmd, Priority prio = Priority::NORMAL);
+    std::future<Result> query(Command cmd, Priority prio = Priority::NORMAL);
+    std::future<Result> query(PreparedCommand cmd, Priority prio = Priority::NORMAL);
+
+    // Related jobs are kept on the same connection while it is idle, see Affinity.
+    // Sharded and work stealing queues ignore the affinity.
+    template <typename F>
+    std::future<Status> exec(F&& job, Affinity const aff, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Status>(std::forward<F>(job), aff, prio);
+    }
+
+    template <typename F>
+    std::future<Result> query(F&& job, Affinity const aff, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Result>(std::forward<F>(job), aff, prio);
+    }
+
+    // Identical commands sent while one of them is still running share its result,
+    // so that a herd of the same reads takes just one connection.
+    std::shared_future<Result> queryShared(Command cmd, Priority prio = Priority::NORMAL);
+
+    // Same as above, but the results are also cached, see Context::Builder::cacheTtl().
+    // Hits are served right away, without taking a connection.
+    std::shared_future<Result> queryCached(Command cmd, Priority prio = Priority::NORMAL);
+    // Drops all the cached results.
+    void invalidate();
+
+    // Counters of the primary pool, without the commands run by the reactor.
+    // See also Context::Builder::metricsSink() for periodic reports.
+    Metrics metrics() const;
+
+    // Read-only jobs go to the replica with the fewest outstanding ones,
+    // or to the primary if there are no replicas. See Context::Builder::replica().
+    // With hedging enabled a job still running after the usual time gets a copy sent to another replica,
+    // and the slower one is cancelled, so the job has to be safe to run twice, even concurrently.
+    template <typename F>
+    std::future<Result> read(F&& job, Priority const prio = Priority::NORMAL) {
+        if (replicas_.empty()) {
+            return query(std::forward<F>(job), prio);
+        }
+        if (hedger_ && (1 < replicas_.size())) {
+            return hedge(std::forward<F>(job), prio);
+        }
+
+        auto&           rep = pick(nullptr);
+        std::lock_guard guard{rep.mtx};
+        rep.load.fetch_add(1, std::memory_order_relaxed);
+        return rep.impl->send<Result>([job   = std::forward<F>(job),
+                                       lease = Lease{&rep.load}](Connection& conn) mutable {
+            return job(conn);
+        }, prio);
+    }
+
+    // Jobs not started before the deadline are dropped with an error,
+    // and the running ones get their queries cancelled on the server.
+    template <typename F>
+    std::future<Status> exec(F&& job, Deadline const deadline, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Status>(std::forward<F>(job), deadline, prio);
+    }
+
+    template <typename F>
+    std::future<Result> query(F&& job, Deadline const deadline, Priority const prio = Priority::NORMAL) {
+        return impl_->send<Result>(std::forward<F>(job), deadline, prio);
+    }
+
+    // Reruns the job on serialization failures and deadlocks, see Connection::retry().
+    template <typename F>
+    std::future<Result> retry(RetryPolicy const& policy, F&& job, Priority const prio = Priority::NORMAL) {
+        return query([policy, job = std::forward<F>(job)](auto& conn) mutable {
+            return conn.retry(policy, job);
+        }, prio);
+    }
+
+    // Small independent writes, like single inserts, share transactions with each other,
+    // trading a short delay for fewer commits. See Context::Builder::coalesceWindow().
+    // A batch hit by a failure is replayed job by job, so the jobs have to be safe to run again.
+    template <typename F>
+    std::future<Status> coalesce(F&& job) {
+        return impl_->coalesce(std::forward<F>(job));
+    }
+
+    // Splits a scan of the table of T into ranges of pages decoded concurrently by different connections,
+    // and merges the rows in the order of the ranges. The size of the table is looked up before returning.
+    // The ranges don't share a snapshot, so rows changed during the scan may be missed or seen twice.
+    template <typename T>
+    std::future<std::vector<T>> parallelSelect(int const partitions) {
+        auto const parts = std::make_shared<std::vector<std::vector<T>>>(static_cast<size_t>(partitions));
+        auto const prom  = std::make_shared<std::promise<std::vector<T>>>();
+        auto       res   = prom->get_future();
+        scan<T>(partitions, [parts](int const idx, std::vector<T>& rows) {
+            (*parts)[static_cast<size_t>(idx)] = std::move(rows);
+        }, [parts, prom](std::exception_ptr const& err) {
+            if (err) {
+                prom->set_exception(err);
+                return;
+            }
+
+            auto size = size_t{0};
+            for (auto const& part : *parts) {
+                size += part.size();
+            }
+            std::vector<T> all{};
+            all.reserve(size);
+            for (auto& part : *parts) {
+                std::move(part.begin(), part.end(), std::back_inserter(all));
+            }
+            prom->set_value(std::move(all));
+        });
+        return res;
+    }
+
+    // Same as above, but passes the rows of each range along with its index to the callback,
+    // which is called concurrently by the workers as soon as the ranges are decoded.
+    template <typename T, typename F>
+    std::future<void> parallelSelect(int const partitions, F&& each) {
+        auto const prom = std::make_shared<std::promise<void>>();
+        auto       res  = prom->get_future();
+        scan<T>(partitions, std::forward<F>(each), [prom](std::exception_ptr const& err) {
+            err ? prom->set_exception(err) : prom->set_value();
+        });
+        return res;
+    }
+
+    // Loads rows of the table T by binary COPY over the given number of pool connections, see Ingester.
+    // Each stream takes a connection until finished, so the pool has to have enough of them.
+    // A stream copies its rows in a single transaction, or commits every given number of rows.
+    template <typename T>
+    Ingester<T> ingest(int const streams, int64_t const commit_rows = 0) {
+        _POSTGRES_CXX_ASSERT(LogicError, 0 < streams, "bad ingestion streams: " << streams);
+        _POSTGRES_CXX_ASSERT(LogicError, 0 <= commit_rows, "bad ingestion commit rows: " << commit_rows);
+        auto res = Ingester<T>{streams, commit_rows};
+        for (auto i = 0; i < streams; ++i) {
+            impl_->post(typename Ingester<T>::Stream{res.state_,
+                                                     {res.state_.get(), typename Ingester<T>::Leave{}},
+                                                     i});
+        }
+        return res;
+    }
+
+    // Awaitable variants require C++20 and including <postgres/Awaitable.h>.
+    template <typename F>
+    Awaitable<Status, std::decay_t<F>> asyncExec(F&& job) {
+        return Awaitable<Status, std::decay_t<F>>{*impl_, std::forward<F>(job)};
+    }
+
+    template <typename F>
+    Awaitable<Result, std::decay_t<F>> asyncQuery(F&& job) {
+        return Awaitable<Result, std::decay_t<F>>{*impl_, std::forward<F>(job)};
+    }
 
 private:
     using Impl = internal::Dispatcher;
 
-    std::unique_ptr<Impl> impl_;
+    // Sent to by both the calling thread and the hedging one.
+    struct Replica {
+        std::mutex            mtx;
+        std::atomic<int>      load{0};
+        std::unique_ptr<Impl> impl;
+    };
+
+    struct Release {
+        void operator()(std::atomic<int>* const load) const noexcept {
+            load->fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    // Counts a job as outstanding until it is destroyed, which is after it is done or dropped.
+    using Lease = std::unique_ptr<std::atomic<int>, Release>;
+
+    template <typename F>
+    struct Attempt {
+        template <typename C>
+        void operator()(C& conn) {
+            if (!race->enter(idx, *conn.native())) {
+                return;
+            }
+
+            auto const start = internal::Hedger::Clock::now();
+            try {
+                auto res = (*job)(conn);
+                race->leave(idx);
+                hedger->record(internal::Hedger::Clock::now() - start);
+                race->finish(std::move(res));
+            } catch (...) {
+                race->leave(idx);
+                race->finish(std::current_exception());
+            }
+        }
+
+        void fail(std::exception_ptr const& err) {
+            race->finish(err);
+        }
+
+        std::shared_ptr<F>              job;
+        std::shared_ptr<internal::Race> race;
+        internal::Hedger*               hedger;
+        Lease                           lease;
+        int                             idx;
+    };
+
+    template <typename F>
+    static void attempt(Replica&                               rep,
+                        std::shared_ptr<F> const&              job,
+                        std::shared_ptr<internal::Race> const& race,
+                        internal::Hedger&                      hedger,
+                        int const                              idx,
+                        Priority const                         prio) {
+        std::lock_guard guard{rep.mtx};
+        rep.load.fetch_add(1, std::memory_order_relaxed);
+        rep.impl->post(Attempt<F>{job, race, &hedger, Lease{&rep.load}, idx}, prio);
+    }
+
+    template <typename F>
+    std::future<Result> hedge(F&& job, Priority const prio) {
+        auto const race  = std::make_shared<internal::Race>();
+        auto       res   = race->future();
+        auto const fn    = std::make_shared<std::decay_t<F>>(std::forward<F>(job));
+        auto&      first = pick(nullptr);
+        attempt(first, fn, race, *hedger_, 0, prio);
+
+        auto const delay = hedger_->delay();
+        if (!delay) {
+            return res;
+        }
+        hedger_->schedule(internal::Hedger::Clock::now() + *delay,
+                          [fn, race, rep = &pick(&first), hedger = hedger_.get(), prio] {
+                              if (!race->isOver()) {
+                                  attempt(*rep, fn, race, *hedger, 1, prio);
+                              }
+                          });
+        return res;
+    }
+
+    // Counts the ranges of a scan down, the last one to finish completing the scan.
+    template <typename F, typename D>
+    struct Scan {
+        Scan(F each, D done, int const left)
+            : each{std::move(each)}, done{std::move(done)}, left{left} {
+        }
+
+        void finish(std::exception_ptr const& err) {
+            if (err) {
+                std::lock_guard guard{mtx};
+                if (!first_err) {
+                    first_err = err;
+                }
+            }
+            if (left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                done(first_err);
+            }
+        }
+
+        F                  each;
+        D                  done;
+        std::atomic<int>   left;
+        std::mutex         mtx;
+        std::exception_ptr first_err;
+    };
+
+    template <typename T, typename S>
+    struct ScanRange {
+        template <typename C>
+        void operator()(C& conn) {
+            try {
+                std::vector<T> rows{};
+                auto const     res = conn.selectPages(rows, beg, end);
+                _POSTGRES_CXX_ASSERT(RuntimeError, res.isOk(), res.message());
+                scan->each(idx, rows);
+                scan->finish(nullptr);
+            } catch (...) {
+                scan->finish(std::current_exception());
+            }
+        }
+
+        void fail(std::exception_ptr const& err) {
+            scan->finish(err);
+        }
+
+        std::shared_ptr<S> scan;
+        int64_t            beg;
+        int64_t            end;
+        int                idx;
+    };
+
+    template <typename T, typename F, typename D>
+    void scan(int const partitions, F&& each, D&& done) {
+        _POSTGRES_CXX_ASSERT(LogicError, 0 < partitions, "bad partition count: " << partitions);
+        auto const pages = impl_->send<int64_t>([](auto& conn) {
+            return conn.template pages<T>();
+        }).get();
+
+        using S = Scan<std::decay_t<F>, std::decay_t<D>>;
+        auto const scan = std::make_shared<S>(std::forward<F>(each), std::forward<D>(done), partitions);
+        for (auto idx = 0; idx < partitions; ++idx) {
+            // The last range is open to take the pages added since the size was looked up.
+            auto const beg = pages * idx / partitions;
+            auto const end = (idx + 1 == partitions) ? MAX_PAGES : pages * (idx + 1) / partitions;
+            try {
+                impl_->post(ScanRange<T, S>{scan, beg, end, idx});
+            } catch (...) {
+                // The ranges already posted complete the scan with the failure of those never run.
+                for (auto rest = idx; rest < partitions; ++rest) {
+                    scan->finish(std::current_exception());
+                }
+                throw;
+            }
+        }
+    }
+
+    static auto constexpr MAX_PAGES = int64_t{0xFFFFFFFF};
+
+    template <typename T, typename C>
+    std::future<T> run(C cmd, Priority prio);
+
+    static std::unique_ptr<Impl> makeImpl(std::shared_ptr<Context const> ctx);
+
+    // Picks any replica but the skipped one.
+    Replica& pick(Replica const* skip);
+
+    // Hedges are stopped first, and their durations are recorded until the replicas are done.
+    std::unique_ptr<Impl>                  impl_;
+    std::unique_ptr<internal::Reactor>     reactor_;
+    std::unique_ptr<internal::Hedger>      hedger_;
+    std::vector<std::unique_ptr<Replica>>  replicas_;
+    size_t                                 next_ = 0;
+    std::shared_ptr<internal::Flights>     flights_;
+    std::shared_ptr<internal::ResultCache> cache_;
+    std::unique_ptr<Listener>              listener_;
 };
 
 }  // namespace postgres
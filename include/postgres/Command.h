@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <iterator>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -8,11 +10,26 @@
 #include <vector>
 #include <postgres/internal/Bytes.h>
 #include <postgres/internal/Classifier.h>
+#include <postgres/internal/Columnar.h>
+#include <postgres/Decimal.h>
 #include <postgres/Oid.h>
 #include <postgres/Time.h>
+#include <postgres/Uuid.h>
 
 namespace postgres {
 
+// Range of visitable objects sent as one array per field rather than as fields of each object.
+template <typename Iter>
+struct Transposed {
+    Iter beg;
+    Iter end;
+};
+
+template <typename Iter>
+Transposed<Iter> transpose(Iter const beg, Iter const end) {
+    return Transposed<Iter>{beg, end};
+}
+
 class Command {
 public:
     template <typename Stmt, typename... Args>
@@ -39,10 +56,21 @@ public:
         return *this;
     }
 
+    // Replaces the arguments keeping the statement and the memory allocated,
+    // so that executing the same command in a loop doesn't allocate anything.
+    template <typename... Args>
+    Command& rebind(Args&& ... args) {
+        clear();
+        unwind(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    void clear();
+
     // Visitor interface.
     template <typename T>
     void accept(char const*, T& arg) {
-        add(std::forward<T>(arg));
+        add(arg);
     };
 
     // libpq interface adapters.
@@ -53,6 +81,9 @@ public:
     int const* lengths() const;
     int const* formats() const;
 
+    // Bytes reserved by the buffers of the command.
+    size_t memorySize() const;
+
 private:
     template <typename T, typename... Ts>
     void unwind(T&& arg, Ts&& ... args) {
@@ -65,11 +96,123 @@ private:
 
     template <typename Iter>
     void add(std::pair<Iter, Iter> const rng) {
-        for (auto it = rng.first; it != rng.second; ++it) {
+        auto it = rng.first;
+        if (it == rng.second) {
+            return;
+        }
+
+        // Reserve the space for the rest of the range after its first element.
+        auto const count = values_.size();
+        auto const len   = buf_.size();
+        add(*it);
+        ++it;
+        using Category = typename std::iterator_traits<Iter>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            auto const rest = static_cast<size_t>(std::distance(it, rng.second));
+            reserve(rest * (values_.size() - count), rest * (buf_.size() - len));
+        }
+
+        for (; it != rng.second; ++it) {
             add(*it);
         }
     };
 
+    template <typename Iter>
+    void add(Transposed<Iter> const rng) {
+        ColumnsAdder<Iter> coll{*this, rng, static_cast<size_t>(std::distance(rng.beg, rng.end))};
+        using T = std::remove_pointer_t<typename std::iterator_traits<Iter>::value_type>;
+        T::visitPostgresDefinition(coll);
+    }
+
+    // Adds an array of the field at the given index of each object.
+    template <typename Iter>
+    struct ColumnsAdder {
+        template <typename T>
+        void accept(char const*) {
+            auto const start = cmd.beginArray(itemOid(static_cast<T*>(nullptr)), count, count * itemSize<T>());
+            for (auto it = rng.beg; it != rng.end; ++it) {
+                ItemAdder item{cmd, idx};
+                deref(*it).visitPostgresFields(item);
+            }
+            cmd.endArray(start);
+            ++idx;
+        }
+
+        template <typename T>
+        static T const& deref(T const& val) {
+            return val;
+        }
+
+        template <typename T>
+        static T const& deref(T const* const val) {
+            return *val;
+        }
+
+        Command&            cmd;
+        Transposed<Iter>    rng;
+        size_t              count;
+        int                 idx = 0;
+    };
+
+    struct ItemAdder {
+        template <typename T>
+        void accept(char const*, T const& val) {
+            if (num++ == idx) {
+                cmd.addItem(val);
+            }
+        }
+
+        Command& cmd;
+        int      idx;
+        int      num = 0;
+    };
+
+    template <typename T>
+    static constexpr std::enable_if_t<std::is_arithmetic_v<T>, Oid> itemOid(T*) {
+        return internal::arithmeticOid<T>();
+    }
+
+    template <typename T>
+    static constexpr Oid itemOid(std::optional<T>*) {
+        return itemOid(static_cast<T*>(nullptr));
+    }
+
+    static constexpr Oid itemOid(std::string*) {
+        return TEXTOID;
+    }
+
+    static constexpr Oid itemOid(std::chrono::system_clock::time_point*) {
+        return TIMESTAMPOID;
+    }
+
+    static constexpr Oid itemOid(Uuid*) {
+        return UUIDOID;
+    }
+
+    template <typename T>
+    static constexpr size_t itemSize() {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return sizeof(T);
+        } else {
+            return 0;
+        }
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> addItem(T const val) {
+        auto const item = internal::orderBytes(val);
+        putItem(&item, sizeof(item));
+    }
+
+    template <typename T>
+    void addItem(std::optional<T> const& val) {
+        val.has_value() ? addItem(val.value()) : putNull();
+    }
+
+    void addItem(std::string const& s);
+    void addItem(std::chrono::system_clock::time_point t);
+    void addItem(Uuid const& id);
+
     // Use mutable reference to disallow temporaries.
     template <typename T>
     std::enable_if_t<internal::isVisitable<T>()> add(T& arg) {
@@ -95,20 +238,7 @@ private:
     template <typename T>
     std::enable_if_t<std::is_arithmetic_v<T>> add(T arg) {
         auto constexpr LEN = sizeof(arg);
-        static_assert(LEN <= 8, "Unexpected arithmetic argument type length");
-
-        auto constexpr ID = []() -> Oid {
-            if (std::is_same_v<T, bool>) {
-                return BOOLOID;
-            }
-            if (std::is_integral_v<T>) {
-                return ((Oid[]) {INT2OID, INT4OID, INT8OID})[LEN / 4];
-            }
-            if (std::is_floating_point_v<T>) {
-                return ((Oid[]) {UNKNOWNOID, FLOAT4OID, FLOAT8OID})[LEN / 4];
-            }
-            return UNKNOWNOID;
-        }();
+        auto constexpr ID  = internal::arithmeticOid<T>();
         static_assert(ID != UNKNOWNOID, "Unexpected arithmetic argument type");
 
         arg = internal::orderBytes(arg);
@@ -116,15 +246,49 @@ private:
         storeData(&arg, LEN);
     };
 
+    // Vectors are sent as one-dimensional arrays in binary format.
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> add(std::vector<T> const& arr) {
+        auto constexpr LEN = sizeof(T);
+        auto constexpr ID  = internal::arithmeticOid<T>();
+        static_assert((ID != UNKNOWNOID) && ((LEN == 1) == std::is_same_v<T, bool>),
+                      "Unexpected arithmetic array element type");
+
+        auto const start = beginArray(ID, arr.size(), arr.size() * LEN);
+        for (T const val : arr) {
+            auto const item = internal::orderBytes(val);
+            putItem(&item, LEN);
+        }
+        endArray(start);
+    }
+
     void add(std::nullptr_t);
     void add(std::chrono::system_clock::time_point t);
     void add(Time const& t);
+    void add(Time::Date d);
+
+    template <typename Rep, typename Period>
+    void add(std::chrono::duration<Rep, Period> const dur) {
+        addInterval(std::chrono::duration_cast<std::chrono::microseconds>(dur));
+    }
+
+    void addInterval(std::chrono::microseconds dur);
+    void add(Decimal val);
+    void add(Uuid const& id);
     void add(std::string const& s);
     void add(std::string_view s);
+    void add(Borrowed arg);
+    void add(std::vector<uint8_t> const& bytes);
+    void add(std::vector<std::string> const& arr);
     void add(char const* s);
     void addText(char const* s, size_t len);
     void setMeta(Oid id, int len, int fmt);
     void storeData(void const* arg, size_t len);
+    void reserve(size_t count, size_t len);
+    size_t beginArray(Oid elem, size_t count, size_t len);
+    void putItem(void const* data, size_t len);
+    void putNull();
+    void endArray(size_t start);
 
     void setStatement(std::string stmt);
     void setStatement(std::string_view stmt);
@@ -133,10 +297,18 @@ private:
     char const* stmt_ = nullptr;
     std::string              stmt_buf_;
     std::vector<Oid>         types_;
-    std::vector<char const*> values_;
     std::vector<int>         lengths_;
     std::vector<int>         formats_;
     std::vector<char>        buf_;
+
+    // Values stored in the buffer are pointed to lazily,
+    // so that growing the buffer doesn't require to fix up all the previous ones.
+    mutable std::vector<char const*> values_;
+    // Indices of borrowed values, which have non-zero lengths but aren't stored.
+    std::vector<size_t>              borrowed_;
+    mutable char const*              base_     = nullptr;
+    mutable size_t                   resolved_ = 0;
+    mutable size_t                   offset_   = 0;
 };
 
 }  // namespace postgres
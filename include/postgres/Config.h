@@ -40,8 +40,14 @@ public:
     char const* const* values() const;
 
 private:
+    friend class Context;
+
     explicit Config();
 
+    // Appends to the startup options, see Context::Builder::onConnect().
+    void addOptions(std::string const& val);
+    void index();
+
     std::vector<char const*>           keys_;
     std::vector<char const*>           vals_;
     std::map<std::string, std::string> params_;
@@ -75,6 +81,8 @@ public:
     Builder& passfile(std::string const& val);
     Builder& password(std::string const& val);
     Builder& port(int val);
+    // Connects in the logical replication mode, see Connection::replicate().
+    Builder& replication(bool val);
     Builder& requirepeer(std::string const& val);
     Builder& requiressl(bool val);
     Builder& service(std::string const& val);
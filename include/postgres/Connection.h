@@ -1,25 +1,51 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory_resource>
 #include <memory>
+#include <thread>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <libpq-fe.h>
+#include <postgres/internal/Parallel.h>
+#include <postgres/ChangeStream.h>
 #include <postgres/Command.h>
+#include <postgres/PrepareData.h>
+#include <postgres/CopyReader.h>
+#include <postgres/CopyWriter.h>
+#include <postgres/Cursor.h>
+#include <postgres/Error.h>
+#include <postgres/LargeObject.h>
+#include <postgres/Pipeline.h>
+#include <postgres/PreparedCommand.h>
 #include <postgres/Result.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Row.h>
 #include <postgres/Statement.h>
+#include <postgres/StatementRegistry.h>
+#include <postgres/Stream.h>
 #include <postgres/Transaction.h>
 
+namespace postgres::internal {
+
+class Columns;
+class Span;
+class StatementCache;
+
+}  // namespace postgres::internal
+
 namespace postgres {
 
 class Config;
 class Consumer;
-class PreparedCommand;
 class Receiver;
-struct PrepareData;
+class Tracer;
 
 class Connection {
 public:
@@ -27,6 +53,11 @@ public:
     static PGPing ping(Config const& cfg);
     static PGPing ping(std::string const& uri);
 
+    // Non-blocking connect, to be completed by polling.
+    static Connection start();
+    static Connection start(Config const& cfg);
+    static Connection start(std::string const& uri);
+
     explicit Connection();
     explicit Connection(Config const& cfg);
     explicit Connection(std::string const& uri);
@@ -36,6 +67,37 @@ public:
     Connection& operator=(Connection&& other) noexcept;
     ~Connection() noexcept;
 
+    // Commands frequently executed are prepared on the server transparently,
+    // keeping up to the given number of recent statements. Zero turns it off.
+    // Keep in mind that changing a table may invalidate statements depending on it.
+    void autoPrepare(int size);
+
+    // Deferred statements are prepared on the first use of their names,
+    // or all at once in a single round trip by calling prepareDeferred().
+    void defer(PrepareData prep);
+    // Same as above sharing the statement, say with the other connections of a registry.
+    void defer(std::shared_ptr<PrepareData const> prep);
+    void prepareDeferred();
+    // Same as above running the statements first in the same round trip, say to set up the session.
+    void prepareDeferred(std::vector<std::string> const& inits);
+
+    // Statements the server lost, as happens behind a transaction pooler switching the server sessions,
+    // are prepared again and retried by exec() outside of transactions.
+    // Statements prepared or deferred since turning it on are remembered for that.
+    void reprepare(bool val);
+
+    // Statements prepared since turning it on are described in the same round trip,
+    // so that their results share the columns of the fields of visitable types,
+    // looked up once per statement rather than once per result.
+    void describe(bool val);
+
+    // Descriptions of the statements of the registry are taken from it when there are any,
+    // saving the round trip, and passed on to it otherwise. Null turns it off.
+    void share(std::shared_ptr<StatementRegistry> reg);
+
+    // Every statement executed or sent is reported to the tracer, see Tracer. Null turns it off.
+    void trace(std::shared_ptr<Tracer> tracer);
+
     template <typename T>
     Status create() {
         return exec(Statement<T>::create());
@@ -53,7 +115,12 @@ public:
 
     template <typename Iter>
     Status insert(Iter const it, Iter const end) {
-        return exec(Command{RangeStatement::insert(it, end), std::make_pair(it, end)});
+        auto const  rng = std::make_pair(it, end);
+        std::string spare{};
+        if (auto const stmt = RangeStatement::insertCached(it, end, spare); !stmt.empty()) {
+            return exec(Command{stmt, rng});
+        }
+        return exec(Command{std::move(spare), rng});
     }
 
     template <typename T>
@@ -61,6 +128,51 @@ public:
         return exec(Command{Statement<T>::update(), val});
     }
 
+    template <typename Iter>
+    Status update(Iter const it, Iter const end) {
+        auto const  rng = std::make_pair(it, end);
+        std::string spare{};
+        if (auto const stmt = RangeStatement::updateCached(it, end, spare); !stmt.empty()) {
+            return exec(Command{stmt, rng});
+        }
+        return exec(Command{std::move(spare), rng});
+    }
+
+    // Sends a range of any size as a single statement of constant text, which is worth preparing.
+    template <typename Iter>
+    Status upsert(Iter const it, Iter const end) {
+        using T = std::remove_pointer_t<typename std::iterator_traits<Iter>::value_type>;
+        return exec(Command{Statement<T>::upsert(), transpose(it, end)});
+    }
+
+    template <typename T>
+    CopyWriter copyIn() {
+        return copyIn(Statement<T>::copyIn());
+    }
+
+    template <typename Iter>
+    Status copyIn(Iter const it, Iter const end) {
+        using T = std::remove_pointer_t<typename std::iterator_traits<Iter>::value_type>;
+        auto wr = copyIn<T>();
+        wr.write(it, end);
+        return wr.finish();
+    }
+
+    template <typename T>
+    CopyReader copyOut() {
+        return copyOut(Statement<T>::copyOut());
+    }
+
+    template <typename T, typename F>
+    Status copyOut(F&& f) {
+        auto rd  = copyOut<T>();
+        auto row = T{};
+        while (rd.read(row)) {
+            f(row);
+        }
+        return rd.finish();
+    }
+
     template <typename T>
     Result select(std::vector<T>& out) {
         auto res = exec(Statement<T>::select());
@@ -76,14 +188,138 @@ public:
         return res;
     }
 
-    template <typename... Ts>
-    std::enable_if_t<(1 < sizeof... (Ts)), Result> transact(Ts&& ... args) {
-        auto tx  = begin();
-        auto res = exec(std::forward<Ts>(args)...);
-        tx.commit();
+    // Text fields of type std::pmr::string are allocated from the given memory resource,
+    // like a monotonic arena released all at once.
+    template <typename T>
+    Result select(std::vector<T>& out, std::pmr::memory_resource& mem) {
+        auto res = exec(Statement<T>::select());
+        if (!res.isOk()) {
+            return res;
+        }
+
+        out.reserve(out.size() + res.size());
+        for (auto row : res) {
+            out.emplace_back();
+            row.read(out.back(), mem);
+        }
         return res;
     }
 
+    // Same as select() but decodes the rows over the objects already in the vector, resized to the rows,
+    // so that those unchanged allocate nothing. Rows are matched to the objects by position,
+    // which pays off while the table keeps its order. Indices of the objects changed or added are appended.
+    template <typename T>
+    Result refresh(std::vector<T>& out, std::vector<size_t>* const changed = nullptr) {
+        auto res = exec(Statement<T>::select());
+        if (!res.isOk()) {
+            return res;
+        }
+
+        auto const kept = std::min(out.size(), static_cast<size_t>(res.size()));
+        out.resize(static_cast<size_t>(res.size()));
+        auto idx = size_t{0};
+        for (auto row : res) {
+            auto const is_changed = row.refresh(out[idx]) || (kept <= idx);
+            if (changed && is_changed) {
+                changed->push_back(idx);
+            }
+            ++idx;
+        }
+        return res;
+    }
+
+    // Large results are split between the given number of threads decoding their rows in place.
+    template <typename T>
+    Result select(std::vector<T>& out, int const threads) {
+        _POSTGRES_CXX_ASSERT(LogicError, 0 < threads, "bad thread count: " << threads);
+        auto res = exec(Statement<T>::select());
+        if (!res.isOk() || res.isEmpty()) {
+            return res;
+        }
+
+        auto const beg  = out.size();
+        auto const cols = res[0].template columns<T>();
+        out.resize(beg + static_cast<size_t>(res.size()));
+        auto const read = [&res, &out, &cols, beg](int const it, int const end) {
+            for (auto idx = it; idx < end; ++idx) {
+                res[idx].visit(out[beg + idx], cols);
+            }
+        };
+        internal::parallelFor(res.size(), threads, PARALLEL_GRAIN, read);
+        return res;
+    }
+
+    // Rows stored in a range of pages of the table, which splits a scan, see Client::parallelSelect().
+    template <typename T>
+    Result selectPages(std::vector<T>& out, int64_t const beg, int64_t const end) {
+        auto res = exec(Command{Statement<T>::selectPages(), beg, end});
+        if (!res.isOk()) {
+            return res;
+        }
+
+        out.reserve(out.size() + res.size());
+        for (auto row : res) {
+            out.emplace_back();
+            row >> out.back();
+        }
+        return res;
+    }
+
+    template <typename T>
+    int64_t pages() {
+        auto const res = exec(Statement<T>::pages());
+        _POSTGRES_CXX_ASSERT(RuntimeError, res.isOk(), res.message());
+        return res[0][0].template as<int64_t>();
+    }
+
+    // Rows of a large dataset are decoded one at a time into the same instance.
+    template <typename T>
+    Stream<T> stream(Command const& cmd, int const chunk = 1) {
+        return Stream<T>{iter(cmd, chunk)};
+    }
+
+    template <typename T>
+    Stream<T> stream(PreparedCommand const& cmd, int const chunk = 1) {
+        return Stream<T>{iter(cmd, chunk)};
+    }
+
+    // The whole transaction is sent at once and takes a single round trip.
+    // Statements following a failed one are skipped, and the transaction is rolled back.
+    template <typename T, typename... Ts>
+    std::enable_if_t<(0 < sizeof... (Ts)) && !std::is_same_v<std::decay_t<T>, RetryPolicy>, Result>
+    transact(T&& arg, Ts&& ... args) {
+        auto pipe = pipeline();
+        pipe.send(Command{"BEGIN"});
+        pipe.send(std::forward<T>(arg));
+        (pipe.send(std::forward<Ts>(args)), ...);
+        pipe.send(Command{"COMMIT"});
+        return commit(std::move(pipe));
+    }
+
+    // The whole transaction is rerun on serialization failures and deadlocks.
+    template <typename... Ts>
+    std::enable_if_t<(1 < sizeof... (Ts)), Result> transact(RetryPolicy const& policy, Ts const& ... args) {
+        return retry(policy, [&args...](Connection& conn) {
+            return conn.transact(args...);
+        });
+    }
+
+    // Reruns the job on serialization failures and deadlocks, pausing between the attempts.
+    // The job has to start a transaction of its own, since a failed one can only be rolled back.
+    template <typename F>
+    auto retry(RetryPolicy const& policy, F&& job) -> decltype(job(*this)) {
+        for (auto attempt = 1;; ++attempt) {
+            try {
+                return job(*this);
+            } catch (RuntimeError const& err) {
+                if ((policy.attempts <= attempt) || !RetryPolicy::isTransient(err)) {
+                    throw;
+                }
+            }
+            std::this_thread::sleep_for(policy.backoff(attempt));
+        }
+    }
+
     Result exec(PrepareData const& prep);
     Result exec(Command const& cmd);
     Result exec(PreparedCommand const& cmd);
@@ -94,22 +330,60 @@ public:
     Receiver send(PreparedCommand const& cmd);
     Consumer sendRaw(std::string_view stmt);
 
+    CopyWriter copyIn(std::string_view stmt);
+    CopyReader copyOut(std::string_view stmt);
+
+    // Streams the changes of the publications from the logical replication slot, starting at the position
+    // given or at the one last acknowledged. Takes a connection made with Config::Builder::replication(),
+    // which serves nothing else until the stream is dropped.
+    ChangeStream replicate(std::string const&              slot,
+                           std::vector<std::string> const& publications,
+                           uint64_t                        start_lsn       = 0,
+                           ChangeStream::Duration          status_interval = std::chrono::seconds{10});
+
     Receiver iter(Command const& cmd);
     Receiver iter(PreparedCommand const& cmd);
+    // Each result holds up to the given number of rows, or a single one with libpq before 17.
+    // Abandoning the receiver midway cancels the statement unless it runs in a transaction block,
+    // so that the rows left are not transferred just to be dropped.
+    Receiver iter(Command const& cmd, int chunk);
+    Receiver iter(PreparedCommand const& cmd, int chunk);
+
+    // Fetches the rows in batches of the given size.
+    Cursor cursor(Command const& cmd, int size);
+
+    // Large objects are created empty and streamed by ranges once opened.
+    Oid createLargeObject();
+    LargeObject openLargeObject(Oid id, LargeObject::Mode mode = LargeObject::Mode::READ);
+    void removeLargeObject(Oid id);
 
+    Pipeline pipeline();
     Transaction begin();
 
     bool reset();
     bool isOk();
+    // Unlike isOk(), notices the connection closed by the server while idle, checking its socket.
+    bool isAlive();
     std::string message();
 
+    // Event loop integration.
+    PostgresPollingStatusType poll();
+    void setNonBlocking(bool is_on);
+    bool isNonBlocking();
+    bool flush();
+    int socket();
+
     std::string esc(std::string const& in);
     std::string escId(std::string const& in);
 
     PGconn* native() const;
 
 private:
+    // Rows per thread worth spawning it for.
+    static int constexpr PARALLEL_GRAIN = 4096;
+
     explicit Connection(PGconn* handle);
+    explicit Connection(PGconn* handle, bool is_started);
 
     template <typename T, typename... Ts>
     std::enable_if_t<(0 < sizeof... (Ts)), Result> exec(T&& arg, Ts&& ... args) {
@@ -124,7 +398,29 @@ private:
     template <typename F>
     std::string doEsc(std::string const& in, F f);
 
-    std::shared_ptr<PGconn> handle_;
+    // Gives the result of the last statement before COMMIT.
+    Result commit(Pipeline pipe);
+    char const* prepare(Command const& cmd);
+    void prepare(PreparedCommand const& cmd);
+    void deallocate(std::string const& name);
+    // Keeps the columns of a prepared statement from its description, forgetting them on a failure.
+    void remember(PrepareData const& prep, PGresult const* desc);
+    // Takes the columns of a statement described by another connection of the registry, if any.
+    bool reuse(PrepareData const& prep);
+    // Tells whether the statement failed for having been lost by the server and can be retried.
+    bool isLost(PGresult* res) const;
+    // Reports the result, unless tracing is off.
+    static PGresult* finish(std::unique_ptr<internal::Span> span, PGresult* res);
+
+    std::shared_ptr<PGconn>                                                handle_;
+    std::shared_ptr<Tracer>                                                tracer_;
+    std::unique_ptr<internal::StatementCache>                              stmts_;
+    std::map<std::string, std::shared_ptr<PrepareData const>, std::less<>> deferred_;
+    std::map<std::string, std::shared_ptr<PrepareData const>, std::less<>> known_;
+    bool                                                                   reprepares_ = false;
+    std::map<std::string, std::shared_ptr<internal::Columns>, std::less<>> described_;
+    bool                                                                   describes_ = false;
+    std::shared_ptr<StatementRegistry>                                     registry_;
 };
 
 }  // namespace postgres
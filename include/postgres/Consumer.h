@@ -1,12 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <libpq-fe.h>
+#include <postgres/Status.h>
 
 namespace postgres {
 
-class Status;
-
 class Consumer {
 public:
     Consumer(Consumer const& other) = delete;
@@ -16,16 +16,26 @@ public:
     ~Consumer() noexcept;
 
     Status consume();
+    // Returns nothing instead of waiting while the server is busy.
+    std::optional<Status> tryConsume();
     bool isOk() const;
     bool isBusy();
 
+    // Asks the server to stop the statement, whose remaining results end with an error then.
+    void cancel();
+
 protected:
     friend class Connection;
 
     explicit Consumer(std::shared_ptr<PGconn> handle, int is_ok);
 
+    // Skips the results left. Unless they are already buffered, cancels the statement first when allowed.
+    void drain();
+
     std::shared_ptr<PGconn> handle_;
     bool                    is_ok_ = false;
+    // Set for rows streamed outside of transaction blocks, which are not worth transferring once abandoned.
+    bool                    cancels_ = false;
 };
 
 }  // namespace postgres
@@ -1,15 +1,26 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <postgres/Config.h>
 #include <postgres/PrepareData.h>
+#include <postgres/Statement.h>
+#include <postgres/StatementRegistry.h>
 
 namespace postgres {
 
 class Connection;
+class Tracer;
+struct Metrics;
+
+enum class OverflowPolicy {
+    THROW,
+    BLOCK,
+};
 
 enum class ShutdownPolicy {
     GRACEFUL,
@@ -21,6 +32,7 @@ class Context {
 public:
     class Builder;
     using Duration = std::chrono::high_resolution_clock::duration;
+    using MetricsSink = std::function<void(Metrics const&)>;
 
     explicit Context();
     Context(Context const& other) = delete;
@@ -30,19 +42,96 @@ public:
     ~Context() noexcept;
 
     Connection connect() const;
+    std::vector<std::string> const& onConnect() const;
     Duration idleTimeout() const;
+    int minConcurrency() const;
+    bool waitWarmUp() const;
     int maxConcurrency() const;
+    bool adaptiveConcurrency() const;
     int maxQueueSize() const;
+    OverflowPolicy overflowPolicy() const;
+    Duration overflowTimeout() const;
+    int queueShards() const;
+    bool strictPriority() const;
+    bool workStealing() const;
+    int reactorThreads() const;
+    int autoPrepare() const;
+    bool lazyPrepare() const;
+    bool transactionPooler() const;
+    bool describePrepared() const;
+    std::shared_ptr<StatementRegistry> const& statements() const;
+    Duration coalesceWindow() const;
+    int coalesceLimit() const;
     ShutdownPolicy shutdownPolicy() const;
+    double hedgeQuantile() const;
+    Duration cacheTtl() const;
+    size_t cacheCapacity() const;
+    std::string const& cacheChannel() const;
+    Duration metricsPeriod() const;
+    MetricsSink const& metricsSink() const;
+    bool accountMemory() const;
+    size_t resultBudget() const;
+    OverflowPolicy budgetPolicy() const;
+    Duration healthCheck() const;
+    int reconnectAttempts() const;
+    Duration reconnectBackoff() const;
+    int maxConnecting() const;
+    Duration connectInterval() const;
+    std::vector<int> const& cpuAffinity() const;
+    bool pinEach() const;
+    std::string const& threadName() const;
+    size_t stackSize() const;
+    std::shared_ptr<Tracer> const& tracer() const;
+    std::vector<std::shared_ptr<Context const>> const& replicas() const;
 
 private:
+    void foldOptions();
+
     Config                   cfg_;
     std::string              uri_;
-    std::vector<PrepareData> preparings_;
+    std::vector<std::string> inits_;
     Duration                 max_idle_;
+    int                      min_concur_;
+    bool                     wait_warm_;
     int                      max_concur_;
+    bool                     adapt_concur_;
     int                      max_queue_;
+    OverflowPolicy           over_pol_;
+    Duration                 over_timeout_;
+    int                      queue_shards_;
+    bool                     strict_prio_;
+    bool                     work_steal_;
+    int                      reactor_threads_;
+    int                      auto_prep_;
+    bool                     lazy_prep_;
+    bool                     tx_pooler_;
+    bool                     describe_prep_;
+    Duration                 coal_window_;
+    int                      coal_limit_;
     ShutdownPolicy           shut_pol_;
+    double                   hedge_quant_;
+    Duration                 cache_ttl_;
+    size_t                   cache_cap_;
+    std::string              cache_chan_;
+    Duration                 metrics_period_;
+    MetricsSink              metrics_sink_;
+    bool                     account_mem_;
+    size_t                   budget_;
+    OverflowPolicy           budget_pol_;
+    Duration                 health_check_;
+    int                      reconn_attempts_;
+    Duration                 reconn_backoff_;
+    int                      max_connecting_;
+    Duration                 conn_interval_;
+    std::vector<int>         cpus_;
+    bool                     pin_each_;
+    std::string              thread_name_;
+    size_t                   stack_size_;
+    std::shared_ptr<Tracer>  tracer_;
+
+    std::vector<std::shared_ptr<PrepareData const>> preparings_;
+    std::shared_ptr<StatementRegistry>              registry_;
+    std::vector<std::shared_ptr<Context const>>     replicas_;
 };
 
 class Context::Builder {
@@ -57,10 +146,88 @@ public:
     Builder& config(Config cfg);
     Builder& uri(std::string uri);
     Builder& prepare(PrepareData prep);
+
+    // Prepares the statements of Statement<T>::prepareData() for each of the tables.
+    template <typename... Ts>
+    Builder& prepareTables() {
+        auto const add = [this](std::vector<PrepareData> preps) {
+            for (auto& prep : preps) {
+                prepare(std::move(prep));
+            }
+        };
+        (add(Statement<Ts>::prepareData()), ...);
+        return *this;
+    }
+
+    // Statements setting up every new connection, run in order before the statements are prepared.
+    // Plain SET commands of a context configured without an URI are passed in the startup options,
+    // and the rest are sent in the same round trip as the preparations.
+    Builder& onConnect(std::vector<std::string> stmts);
     Builder& idleTimeout(Context::Duration val);
+    Builder& minConcurrency(int val);
+    Builder& waitWarmUp(bool val);
     Builder& maxConcurrency(int val);
+    Builder& adaptiveConcurrency(bool val);
     Builder& maxQueueSize(int val);
+    // Requests sent to the client from its own pool throw on overflow regardless, as waiting could deadlock it.
+    Builder& overflowPolicy(OverflowPolicy val);
+    Builder& overflowTimeout(Context::Duration val);
+    Builder& queueShards(int val);
+    Builder& strictPriority(bool val);
+    Builder& workStealing(bool val);
+    // Commands sent to a client are run by this many event loop threads,
+    // sharing the max concurrency of connections between them. Zero gives each connection a thread.
+    Builder& reactorThreads(int val);
+    Builder& autoPrepare(int size);
+    Builder& lazyPrepare(bool val);
+    // Connections made through a pooler in the transaction mode prepare statements again
+    // once the server reports them missing, see Connection::reprepare().
+    Builder& transactionPooler(bool val);
+    // Prepared statements are also described, see Connection::describe().
+    Builder& describePrepared(bool val);
+    // Statements of the registry, which may be shared by several contexts, are prepared along with
+    // those of the context, which take over the ones of the same names. See Connection::share().
+    Builder& statements(std::shared_ptr<StatementRegistry> reg);
+    // Coalesced jobs wait up to the window for the batch to fill up to the limit.
+    Builder& coalesceWindow(Context::Duration val);
+    Builder& coalesceLimit(int val);
     Builder& shutdownPolicy(ShutdownPolicy val);
+    // Each replica gets a pool of its own, configured by its context, for read-only jobs.
+    Builder& replica(Context ctx);
+    // Read jobs running longer than this quantile of the recent ones are hedged on another replica.
+    // Zero disables hedging.
+    Builder& hedgeQuantile(double val);
+    // Cached results are kept for the TTL, which being zero disables the cache,
+    // until their total size exceeds the capacity in bytes, or a notification arrives on the channel.
+    Builder& cacheTtl(Context::Duration val);
+    Builder& cacheCapacity(size_t val);
+    Builder& cacheChannel(std::string val);
+    // Snapshots of the pool, same as Client::metrics() returns, are passed to the sink every period.
+    Builder& metricsSink(Context::Duration period, Context::MetricsSink sink);
+    // Commands, results and jobs of the pool are counted along with the bytes they allocate, see Metrics.
+    Builder& accountMemory(bool val);
+    // Results of the jobs sent to a client hold up to this many bytes at once, zero meaning no limit.
+    // Those over the budget fail, or keep their workers waiting for the earlier ones to be released
+    // up to the overflow timeout, so that results waiting in the futures do not pile up.
+    Builder& resultBudget(size_t bytes, OverflowPolicy pol);
+    // Connections idle for this long get their sockets checked before the next job, zero disabling the checks.
+    // The checks take no round trip, noticing just the connections closed or reset by the server.
+    Builder& healthCheck(Context::Duration idle);
+    // Broken connections are replaced by their workers in the background, waiting for the backoff
+    // after the first failed attempt and twice as long after each next one. Zero attempts give up at once.
+    Builder& reconnect(int attempts, Context::Duration backoff);
+    // Caps the connection attempts in progress, leaving the jobs over it in the queue instead of connecting more,
+    // and spaces the attempts by the interval plus a random jitter of up to a half of it. Zeros disable either.
+    Builder& connectThrottle(int max_connecting, Context::Duration interval);
+    // Threads of the pool run on the given CPUs, or each on a single one of them taken in turn,
+    // so listing CPUs of different NUMA nodes alternately spreads the threads across the nodes.
+    Builder& cpuAffinity(std::vector<int> cpus, bool pin_each);
+    // Threads of the pool get the name, cut to 15 characters, to show up in profilers and debuggers.
+    Builder& threadName(std::string val);
+    // Stack size of the threads of the pool in bytes, zero keeping the system default.
+    Builder& stackSize(size_t bytes);
+    // Connections made by the context report their statements to the tracer, called from many threads.
+    Builder& tracer(std::shared_ptr<Tracer> val);
 
     Context build();
     std::shared_ptr<Context> share();
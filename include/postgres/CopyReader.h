@@ -0,0 +1,182 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Classifier.h>
+#include <postgres/Decimal.h>
+#include <postgres/Error.h>
+#include <postgres/Time.h>
+#include <postgres/Uuid.h>
+
+namespace postgres {
+
+class Status;
+
+// Receives rows from the server in the binary COPY format.
+// The data carries no type information, so fields are decoded by position
+// according to their C++ types and the lengths of the received values.
+class CopyReader {
+public:
+    CopyReader(CopyReader const& other) = delete;
+    CopyReader& operator=(CopyReader const& other) = delete;
+    CopyReader(CopyReader&& other) noexcept;
+    CopyReader& operator=(CopyReader&& other) = delete;
+    ~CopyReader() noexcept;
+
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>(), bool> read(T& row) {
+        if (!next()) {
+            return false;
+        }
+
+        row.visitPostgresFields(*this);
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             col_ == cols_,
+                             "copied row has " << cols_ << " fields, " << col_ << " expected");
+        ++rows_;
+        return true;
+    }
+
+    // Visitor interface.
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>()> accept(char const*, T& arg) {
+        arg.visitPostgresFields(*this);
+    }
+
+    template <typename T>
+    std::enable_if_t<!internal::isVisitable<T>()> accept(char const* const name, T& arg) {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             col_ < cols_,
+                             "copied row has no field for '" << name << "'");
+        ++col_;
+        auto const len = field();
+        read(name, len, arg);
+        pos_ += (0 < len) ? len : 0;
+    }
+
+    Status finish();
+    int size() const;
+
+private:
+    friend class Connection;
+
+    explicit CopyReader(std::shared_ptr<PGconn> handle, std::string_view stmt);
+
+    template <typename T>
+    void read(char const* const name, int const len, std::optional<T>& out) {
+        if (len < 0) {
+            out.reset();
+            return;
+        }
+        out.emplace();
+        read(name, len, out.value());
+    }
+
+    template <typename T>
+    void read(char const* const name, int const len, T*& out) {
+        if (len < 0) {
+            out = nullptr;
+            return;
+        }
+        read(name, len, *out);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> read(char const* const name,
+                                                   int const len,
+                                                   T& out) {
+        check(name, len);
+        auto const is_ok = [this, len, &out] {
+            if (std::is_floating_point_v<T>) {
+                switch (len) {
+                    case 4: {
+                        return readNum<float>(out);
+                    }
+                    case 8: {
+                        return readNum<double>(out);
+                    }
+                    default: {
+                        break;
+                    }
+                }
+                return false;
+            }
+
+            switch (len) {
+                case 1: {
+                    return readNum<int8_t>(out);
+                }
+                case 2: {
+                    return readNum<int16_t>(out);
+                }
+                case 4: {
+                    return readNum<int32_t>(out);
+                }
+                case 8: {
+                    return readNum<int64_t>(out);
+                }
+                default: {
+                    break;
+                }
+            }
+            return false;
+        }();
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             is_ok,
+                             "cannot cast copied field '"
+                                 << name
+                                 << "' of length "
+                                 << len
+                                 << " to desired arithmetic type");
+    }
+
+    template <typename In, typename Out>
+    bool readNum(Out& out) const {
+        if (sizeof(Out) < sizeof(In)) {
+            return false;
+        }
+
+        auto const val = internal::orderBytes<In>(&buf_[pos_]);
+        if (std::is_unsigned_v<Out> && (val < 0)) {
+            return false;
+        }
+
+        out = static_cast<Out>(val);
+        return true;
+    }
+
+    void read(char const* name, int len, Time& out);
+    void read(char const* name, int len, Time::Point& out);
+    void read(char const* name, int len, std::string& out);
+    void read(char const* name, int len, std::vector<uint8_t>& out);
+    void read(char const* name, int len, Decimal& out);
+    void read(char const* name, int len, Uuid& out);
+
+    void check(char const* name, int len) const;
+    bool next();
+    int field();
+    bool need(size_t len);
+    void drain();
+    // Cancels the copying unless it is over, then drops whatever has been sent so far.
+    void abort();
+    PGconn* native() const;
+
+    std::shared_ptr<PGconn> handle_;
+    std::vector<char>       buf_;
+    size_t                  pos_  = 0;
+    int16_t                 cols_ = 0;
+    int16_t                 col_  = 0;
+    int                     rows_ = 0;
+    bool                    is_over_ = false;
+    bool                    is_end_  = false;
+};
+
+}  // namespace postgres
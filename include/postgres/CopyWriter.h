@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Classifier.h>
+#include <postgres/Decimal.h>
+#include <postgres/Time.h>
+#include <postgres/Uuid.h>
+
+namespace postgres {
+
+class Status;
+
+// Streams rows to the server in the binary COPY format.
+// Unlike statement parameters binary COPY data is not coerced by the server,
+// so the field types must exactly match the column types.
+class CopyWriter {
+public:
+    CopyWriter(CopyWriter const& other) = delete;
+    CopyWriter& operator=(CopyWriter const& other) = delete;
+    CopyWriter(CopyWriter&& other) noexcept;
+    CopyWriter& operator=(CopyWriter&& other) = delete;
+    ~CopyWriter() noexcept;
+
+    template <typename T>
+    CopyWriter& operator<<(T const& row) {
+        return write(row);
+    }
+
+    template <typename Iter>
+    CopyWriter& write(Iter const it, Iter const end) {
+        for (auto i = it; i != end; ++i) {
+            write(*i);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>(), CopyWriter&> write(T const& row) {
+        auto const pos = buf_.size();
+        put(int16_t{0});
+        cols_ = 0;
+        row.visitPostgresFields(*this);
+
+        auto const cols = internal::orderBytes(cols_);
+        std::copy_n(reinterpret_cast<char const*>(&cols), sizeof(cols), &buf_[pos]);
+        ++rows_;
+        if (CHUNK_SIZE <= buf_.size()) {
+            flush();
+        }
+        return *this;
+    }
+
+    template <typename T>
+    CopyWriter& write(T const* const row) {
+        return write(*row);
+    }
+
+    // Visitor interface.
+    template <typename T>
+    void accept(char const*, T const& arg) {
+        add(arg);
+    }
+
+    Status finish();
+    int size() const;
+
+private:
+    friend class Connection;
+
+    static auto constexpr CHUNK_SIZE = size_t{1} << 16;
+
+    explicit CopyWriter(std::shared_ptr<PGconn> handle, std::string_view stmt);
+
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>()> add(T const& arg) {
+        arg.visitPostgresFields(*this);
+    }
+
+    template <typename T>
+    void add(std::optional<T> const& arg) {
+        arg.has_value() ? add(arg.value()) : add(nullptr);
+    }
+
+    template <typename T>
+    void add(T const* const arg) {
+        arg ? add(*arg) : add(nullptr);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> add(T const arg) {
+        static_assert(sizeof(arg) <= 8, "Unexpected arithmetic argument type length");
+        putLength(sizeof(arg));
+        put(arg);
+    }
+
+    void add(std::nullptr_t);
+    void add(std::chrono::system_clock::time_point t);
+    void add(Time const& t);
+    void add(std::string const& s);
+    void add(std::string_view s);
+    void add(std::vector<uint8_t> const& bytes);
+    void add(Decimal val);
+    void add(Uuid const& id);
+    void add(char const* s);
+
+    template <typename T>
+    void put(T val) {
+        val = internal::orderBytes(val);
+        append(&val, sizeof(val));
+    }
+
+    void putLength(size_t len);
+    void append(void const* data, size_t len);
+    void flush();
+    PGconn* native() const;
+
+    std::shared_ptr<PGconn> handle_;
+    std::vector<char>       buf_;
+    int16_t                 cols_ = 0;
+    int                     rows_ = 0;
+};
+
+}  // namespace postgres
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+class Connection;
+
+// Server-side cursor fetching rows in batches of a fixed size.
+// It runs in a transaction of its own unless there is one in progress,
+// which is committed when the cursor is closed.
+class Cursor {
+public:
+    class iterator;
+
+    Cursor(Cursor const& other) = delete;
+    Cursor& operator=(Cursor const& other) = delete;
+    Cursor(Cursor&& other) noexcept;
+    Cursor& operator=(Cursor&& other) = delete;
+    ~Cursor() noexcept;
+
+    // Gives an empty result once all the rows are fetched.
+    Result fetch();
+    void close();
+    iterator begin();
+    iterator end();
+
+private:
+    friend class Connection;
+
+    explicit Cursor(Connection& conn, std::string name, int size, bool is_owner);
+
+    Connection* conn_;
+    std::string name_;
+    std::string fetch_;
+    bool        is_owner_;
+};
+
+class Cursor::iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Result;
+    using pointer = Result*;
+    using reference = Result&;
+
+    iterator(iterator const& other) = delete;
+    iterator& operator=(iterator const& other) = delete;
+    iterator(iterator&& other) noexcept;
+    iterator& operator=(iterator&& other) noexcept;
+    ~iterator() noexcept;
+
+    bool operator==(iterator const& other) const;
+    bool operator!=(iterator const& other) const;
+    void operator++();
+    Result operator*();
+
+private:
+    friend class Cursor;
+
+    explicit iterator(Cursor& cur, bool is_done);
+
+    Cursor* cur_;
+    Result  res_;
+    bool    is_done_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace postgres {
+
+// Exact decimal number as an integer value with the given number of digits after the point,
+// so that 12.34 is {1234, 2}. Scales from 0 to 18 are supported.
+struct Decimal {
+    std::string toString() const;
+    double toDouble() const;
+
+    int64_t value = 0;
+    int     scale = 0;
+};
+
+}  // namespace postgres
@@ -34,22 +34,39 @@ public:
 class RuntimeError : public Error {
 public:
     explicit RuntimeError(std::string msg);
+    explicit RuntimeError(std::string msg, std::string code);
     RuntimeError(RuntimeError const& other);
     RuntimeError& operator=(RuntimeError const& other);
     RuntimeError(RuntimeError&& other) noexcept;
     RuntimeError& operator=(RuntimeError&& other) noexcept;
     ~RuntimeError() noexcept override;
+
+    // SQLSTATE of a failure reported by the server, empty otherwise.
+    char const* code() const noexcept;
+
+private:
+    std::string code_;
 };
 
 }  // namespace postgres
 
+#define _POSTGRES_CXX_PREFIX "PostgreSQL client error: "
+
 #define _POSTGRES_CXX_FAIL(T, msg) \
     { \
         std::stringstream stream{}; \
-        stream << "PostgreSQL client error: " << msg; \
+        stream << _POSTGRES_CXX_PREFIX << msg; \
         throw postgres::T{stream.str()}; \
     }
 
+// Same as _POSTGRES_CXX_FAIL() for a failure reported by the server with its SQLSTATE.
+#define _POSTGRES_CXX_FAIL_CODE(T, code, msg) \
+    { \
+        std::stringstream stream{}; \
+        stream << _POSTGRES_CXX_PREFIX << msg; \
+        throw postgres::T{stream.str(), code}; \
+    }
+
 #define _POSTGRES_CXX_ASSERT(T, cond, msg) \
     if (!(cond)) { \
         _POSTGRES_CXX_FAIL(T, msg); \
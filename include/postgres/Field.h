@@ -1,15 +1,21 @@
 #pragma once
 
 #include <chrono>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 #include <libpq-fe.h>
+#include <postgres/internal/Array.h>
 #include <postgres/internal/Bytes.h>
+#include <postgres/internal/Columnar.h>
+#include <postgres/Decimal.h>
 #include <postgres/Error.h>
 #include <postgres/Oid.h>
 #include <postgres/Time.h>
+#include <postgres/Uuid.h>
 
 namespace postgres {
 
@@ -37,13 +43,16 @@ public:
         read(*out);
     }
 
+    // The value present is read over, reusing its storage.
     template <typename T>
     void operator>>(std::optional<T>& out) const {
         if (isNull()) {
             out.reset();
             return;
         }
-        out.emplace();
+        if (!out) {
+            out.emplace();
+        }
         read(out.value());
     }
 
@@ -57,18 +66,73 @@ public:
         read(out);
     }
 
-    bool isNull() const;
-    char const* name() const;
-    char const* value() const;
-    Oid type() const;
-    int length() const;
-    int format() const;
+    // Accessors are inlined into the decoding loops.
+    bool isNull() const {
+        return PQgetisnull(res_, row_idx_, col_idx_) == 1;
+    }
+
+    char const* name() const {
+        return PQfname(res_, col_idx_);
+    }
+
+    char const* value() const {
+        return PQgetvalue(res_, row_idx_, col_idx_);
+    }
+
+    Oid type() const {
+        return PQftype(res_, col_idx_);
+    }
+
+    int length() const {
+        return PQgetlength(res_, row_idx_, col_idx_);
+    }
+
+    int format() const {
+        return PQfformat(res_, col_idx_);
+    }
 
 private:
+    friend class Grid;
     friend class Row;
 
     explicit Field(PGresult& res, int row_idx, int col_idx);
 
+    // Replaces the string with one allocated from the given memory resource.
+    void readIn(std::pmr::string& out, std::pmr::memory_resource& mem) const;
+    void readIn(std::optional<std::pmr::string>& out, std::pmr::memory_resource& mem) const;
+
+    // Reads a value whose column type is known to match exactly.
+    template <typename T>
+    void readExact(std::optional<T>& out) const {
+        if (isNull()) {
+            out.reset();
+            return;
+        }
+        if (!out) {
+            out.emplace();
+        }
+        readExact(out.value());
+    }
+
+    template <typename T>
+    void readExact(T& out) const {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             !isNull(),
+                             "cannot store NULL value of field '"
+                                 << name()
+                                 << "' into variable of non-optional type");
+        if constexpr (std::is_same_v<T, bool>) {
+            out = (*value() != 0);
+        } else if constexpr (std::is_same_v<T, Time::Point>) {
+            out = Time::EPOCH;
+            out += std::chrono::microseconds{internal::orderBytes<int64_t>(value())};
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            out = internal::orderBytes<T>(value());
+        } else {
+            read(out);
+        }
+    }
+
     template <typename T>
     std::enable_if_t<std::is_arithmetic_v<T>> read(T& out) const {
         auto const is_ok = [this, &out] {
@@ -106,6 +170,66 @@ private:
                                  << " to desired arithmetic type");
     };
 
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> read(std::vector<T>& out) const {
+        checkArray();
+        internal::ArrayReader arr{value(), length()};
+
+        out.clear();
+        out.reserve(static_cast<size_t>(arr.size()));
+        auto const is_ok = [this, &arr, &out] {
+            switch (arr.type()) {
+                case BOOLOID: {
+                    return readItems<int8_t>(arr, out);
+                }
+                case INT2OID: {
+                    return readItems<int16_t>(arr, out);
+                }
+                case INT4OID: {
+                    return readItems<int32_t>(arr, out);
+                }
+                case INT8OID: {
+                    return readItems<int64_t>(arr, out);
+                }
+                case FLOAT4OID: {
+                    return readItems<float>(arr, out);
+                }
+                case FLOAT8OID: {
+                    return readItems<double>(arr, out);
+                }
+                default: {
+                    break;
+                }
+            }
+            return false;
+        }();
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             is_ok,
+                             "cannot cast elements of field '"
+                                 << name()
+                                 << "' of type "
+                                 << arr.type()
+                                 << " to desired arithmetic type");
+    }
+
+    template <typename In, typename Out>
+    bool readItems(internal::ArrayReader& arr, std::vector<Out>& out) const {
+        if constexpr (!internal::isCastable<In, Out>()) {
+            return false;
+        } else {
+            for (auto i = 0; i < arr.size(); ++i) {
+                auto const val = internal::orderBytes<In>(item(arr));
+                if constexpr (std::is_unsigned_v<Out> && std::is_signed_v<In>) {
+                    if (val < 0) {
+                        return false;
+                    }
+                }
+                out.push_back(static_cast<Out>(val));
+            }
+            return true;
+        }
+    }
+
     template <typename In, typename Out>
     bool readNum(Out& out) const {
         if (std::is_integral_v<In> == std::is_floating_point_v<Out>) {
@@ -127,8 +251,30 @@ private:
 
     void read(Time& out) const;
     void read(Time::Point& out) const;
+    void read(Time::Date& out) const;
+
+    // Intervals with months are rejected, since their length in time varies.
+    template <typename Rep, typename Period>
+    void read(std::chrono::duration<Rep, Period>& out) const {
+        out = std::chrono::duration_cast<std::chrono::duration<Rep, Period>>(readInterval());
+    }
+
+    std::chrono::microseconds readInterval() const;
+
+    // Binary JSONB is prefixed with a version byte, which is skipped by all the string types.
+    // Views point right into the result.
     void read(std::string& out) const;
+    void read(std::pmr::string& out) const;
     void read(std::string_view& out) const;
+    void read(std::vector<uint8_t>& out) const;
+    void read(Decimal& out) const;
+    void read(Uuid& out) const;
+    void read(std::vector<std::string>& out) const;
+
+    std::string_view text() const;
+    void checkArray() const;
+    char const* item(internal::ArrayReader& arr, int& len) const;
+    char const* item(internal::ArrayReader& arr) const;
 
     PGresult* res_;
     int row_idx_;
@@ -2,23 +2,50 @@
 
 namespace postgres {
 
+class Arrow;
+class ChangeStream;
 class Client;
 class Command;
 class Config;
 class Connection;
 class Consumer;
 class Context;
+class CopyReader;
+class CopyWriter;
+class Cursor;
 class Error;
 class Field;
+class Grid;
+class LargeObject;
+class Listener;
 class LogicError;
+class Pipeline;
 class PreparedCommand;
 class Receiver;
 class Result;
 class Row;
 class RuntimeError;
+class SlowLog;
+class StatementRegistry;
 class Status;
 class Time;
+class Tracer;
 class Transaction;
+struct Affinity;
+struct Change;
+struct Decimal;
+struct Histogram;
+struct Metrics;
+struct Notification;
 struct PrepareData;
+struct RetryPolicy;
+struct Trace;
+struct Uuid;
+
+template <typename T>
+class Ingester;
+
+template <typename Key>
+class ShardedClient;
 
 }  // namespace postgres
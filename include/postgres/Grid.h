@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/Error.h>
+#include <postgres/Field.h>
+#include <postgres/View.h>
+
+namespace postgres {
+
+// Cells of a result for hot decoding loops. The number of rows and columns, their types and formats
+// are read once here, and the cell accessors are inlined. at() checks the indices,
+// while operator() trusts them and costs just the lookup of the cell.
+// Must not outlive the result, unlike cells, which may outlive the grid.
+class Grid {
+public:
+    class Cell;
+
+    int rows() const {
+        return rows_;
+    }
+
+    int columns() const {
+        return static_cast<int>(cols_.size());
+    }
+
+    int column(char const* const col_name) const {
+        auto const col_idx = PQfnumber(res_, col_name);
+        _POSTGRES_CXX_ASSERT(LogicError, (0 <= col_idx), "column '" << col_name << "' does not exist");
+        return col_idx;
+    }
+
+    Cell at(int row_idx, int col_idx) const;
+    Cell operator()(int row_idx, int col_idx) const;
+
+private:
+    friend class Result;
+
+    struct Column {
+        Oid type;
+        int format;
+    };
+
+    static Field field(PGresult& res, int const row_idx, int const col_idx) {
+        return Field{res, row_idx, col_idx};
+    }
+
+    explicit Grid(PGresult& res)
+        : res_{&res}, rows_{PQntuples(&res)} {
+        cols_.reserve(static_cast<size_t>(PQnfields(&res)));
+        for (auto i = 0; i < PQnfields(&res); ++i) {
+            cols_.push_back(Column{PQftype(&res, i), PQfformat(&res, i)});
+        }
+    }
+
+    PGresult*           res_;
+    int                 rows_;
+    std::vector<Column> cols_;
+};
+
+class Grid::Cell {
+public:
+    bool isNull() const {
+        return PQgetisnull(res_, row_idx_, col_idx_) == 1;
+    }
+
+    char const* value() const {
+        return PQgetvalue(res_, row_idx_, col_idx_);
+    }
+
+    int length() const {
+        return PQgetlength(res_, row_idx_, col_idx_);
+    }
+
+    Oid type() const {
+        return col_.type;
+    }
+
+    int format() const {
+        return col_.format;
+    }
+
+    // Exactly matching binary types, as well as views of text and bytes, are read right from the result.
+    // Other types are decoded like a field.
+    template <typename T>
+    T as() const {
+        if constexpr (internal::isViewable(static_cast<T*>(nullptr))) {
+            if ((format() == 1) && internal::ViewCell<T>::accepts(type())) {
+                return internal::ViewCell<T>::read(*res_, row_idx_, col_idx_);
+            }
+        }
+        return field().as<T>();
+    }
+
+    Field field() const {
+        return Grid::field(*res_, row_idx_, col_idx_);
+    }
+
+private:
+    friend class Grid;
+
+    // The column is copied, so that a cell of a temporary grid stays valid.
+    explicit Cell(PGresult& res, int const row_idx, int const col_idx, Column const col)
+        : res_{&res}, row_idx_{row_idx}, col_idx_{col_idx}, col_{col} {
+    }
+
+    PGresult* res_;
+    int       row_idx_;
+    int       col_idx_;
+    Column    col_;
+};
+
+inline Grid::Cell Grid::at(int const row_idx, int const col_idx) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 <= row_idx) && (row_idx < rows_),
+                         "row index " << row_idx << " is out of range");
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 <= col_idx) && (col_idx < columns()),
+                         "column index " << col_idx << " is out of range");
+    return (*this)(row_idx, col_idx);
+}
+
+inline Grid::Cell Grid::operator()(int const row_idx, int const col_idx) const {
+    return Cell{*res_, row_idx, col_idx, cols_[static_cast<size_t>(col_idx)]};
+}
+
+}  // namespace postgres
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <postgres/Connection.h>
+#include <postgres/CopyWriter.h>
+#include <postgres/Error.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+class Client;
+
+// Loads rows of the table T by binary COPY over a number of pool connections, see Client::ingest().
+// Rows are passed to the streams in batches through a bounded buffer, so that the faster streams take more,
+// and writing waits while the buffer is full. A failure of any stream aborts the others.
+template <typename T>
+class Ingester {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Rows copied by a stream so far and the time it has been copying them.
+    struct Progress {
+        int64_t         rows    = 0;
+        Clock::duration elapsed = {};
+    };
+
+    Ingester(Ingester const& other) = delete;
+    Ingester& operator=(Ingester const& other) = delete;
+    Ingester(Ingester&& other) noexcept = default;
+    Ingester& operator=(Ingester&& other) = delete;
+
+    // Streams left unfinished are aborted.
+    ~Ingester() noexcept {
+        if (state_) {
+            state_->fail(std::make_exception_ptr(LogicError{"ingestion is aborted"}));
+        }
+    }
+
+    Ingester& operator<<(T row) {
+        return write(std::move(row));
+    }
+
+    // Throws the failure of a stream, if any.
+    Ingester& write(T row) {
+        _POSTGRES_CXX_ASSERT(LogicError, state_, "ingestion is finished");
+        batch_.push_back(std::move(row));
+        if (BATCH_SIZE <= batch_.size()) {
+            state_->push(std::move(batch_));
+            batch_ = std::vector<T>{};
+            batch_.reserve(BATCH_SIZE);
+        }
+        return *this;
+    }
+
+    template <typename Iter>
+    Ingester& write(Iter const it, Iter const end) {
+        for (auto i = it; i != end; ++i) {
+            write(*i);
+        }
+        return *this;
+    }
+
+    // Waits for the streams to copy the rest of the rows and commit, giving the total number of rows.
+    int64_t finish() {
+        _POSTGRES_CXX_ASSERT(LogicError, state_, "ingestion is finished");
+        auto const state = std::move(state_);
+        if (!batch_.empty()) {
+            state->push(std::move(batch_));
+        }
+        state->close();
+
+        auto rows = int64_t{0};
+        for (auto const& prog : state->progress()) {
+            rows += prog.rows;
+        }
+        return rows;
+    }
+
+    std::vector<Progress> progress() const {
+        _POSTGRES_CXX_ASSERT(LogicError, state_, "ingestion is finished");
+        return state_->progress();
+    }
+
+private:
+    friend class Client;
+
+    static auto constexpr BATCH_SIZE = size_t{1024};
+    // Batches buffered per stream.
+    static auto constexpr DEPTH      = size_t{4};
+
+    class State {
+    public:
+        explicit State(int const streams, int64_t const commit_rows)
+            : counters_{new Counter[static_cast<size_t>(streams)]},
+              streams_{streams},
+              running_{streams},
+              commit_rows_{commit_rows} {
+        }
+
+        // Copies batches until the buffer is closed and drained, or any stream fails.
+        void run(Connection& conn, int const idx) {
+            auto&      cnt = counters_[static_cast<size_t>(idx)];
+            auto const beg = Clock::now();
+            try {
+                std::optional<CopyWriter> wr{};
+                std::vector<T>            batch{};
+                auto                      uncommitted = int64_t{0};
+                while (pop(batch)) {
+                    for (auto const& row : batch) {
+                        if (!wr) {
+                            wr.emplace(conn.copyIn<T>());
+                        }
+                        *wr << row;
+                        if (++uncommitted == commit_rows_) {
+                            commit(*wr);
+                            wr.reset();
+                            uncommitted = 0;
+                        }
+                    }
+                    cnt.rows.fetch_add(static_cast<int64_t>(batch.size()), std::memory_order_relaxed);
+                    cnt.nanos.store((Clock::now() - beg).count(), std::memory_order_relaxed);
+                }
+                if (wr && !isFailed()) {
+                    commit(*wr);
+                }
+            } catch (...) {
+                fail(std::current_exception());
+            }
+            leave();
+        }
+
+        // Aborts all the streams, keeping the first failure.
+        void fail(std::exception_ptr const& err) {
+            std::lock_guard guard{mtx_};
+            if (!err_) {
+                err_ = err;
+            }
+            batches_.clear();
+            room_.notify_all();
+            data_.notify_all();
+        }
+
+        void leave() {
+            std::lock_guard guard{mtx_};
+            --running_;
+            done_.notify_all();
+        }
+
+        void push(std::vector<T> batch) {
+            std::unique_lock guard{mtx_};
+            room_.wait(guard, [this] {
+                return err_ || (batches_.size() < static_cast<size_t>(streams_) * DEPTH);
+            });
+            if (err_) {
+                std::rethrow_exception(err_);
+            }
+            batches_.push_back(std::move(batch));
+            data_.notify_one();
+        }
+
+        void close() {
+            std::unique_lock guard{mtx_};
+            is_closed_ = true;
+            data_.notify_all();
+            done_.wait(guard, [this] {
+                return running_ == 0;
+            });
+            if (err_) {
+                std::rethrow_exception(err_);
+            }
+        }
+
+        std::vector<Progress> progress() const {
+            std::vector<Progress> res(static_cast<size_t>(streams_));
+            for (auto i = size_t{0}; i < res.size(); ++i) {
+                res[i].rows    = counters_[i].rows.load(std::memory_order_relaxed);
+                res[i].elapsed = Clock::duration{counters_[i].nanos.load(std::memory_order_relaxed)};
+            }
+            return res;
+        }
+
+    private:
+        struct Counter {
+            std::atomic<int64_t> rows{0};
+            std::atomic<int64_t> nanos{0};
+        };
+
+        bool pop(std::vector<T>& batch) {
+            std::unique_lock guard{mtx_};
+            data_.wait(guard, [this] {
+                return err_ || is_closed_ || !batches_.empty();
+            });
+            if (err_ || batches_.empty()) {
+                return false;
+            }
+            batch = std::move(batches_.front());
+            batches_.pop_front();
+            room_.notify_one();
+            return true;
+        }
+
+        bool isFailed() {
+            std::lock_guard guard{mtx_};
+            return static_cast<bool>(err_);
+        }
+
+        static void commit(CopyWriter& wr) {
+            auto const st = wr.finish();
+            _POSTGRES_CXX_ASSERT(RuntimeError, st.isOk(), "fail to copy: " << st.message());
+        }
+
+        std::unique_ptr<Counter[]>  counters_;
+        int const                   streams_;
+        int                         running_;
+        int64_t const               commit_rows_;
+        std::mutex                  mtx_;
+        std::condition_variable     room_;
+        std::condition_variable     data_;
+        std::condition_variable     done_;
+        std::deque<std::vector<T>>  batches_;
+        bool                        is_closed_ = false;
+        std::exception_ptr          err_;
+    };
+
+    struct Leave {
+        void operator()(State* const state) const noexcept {
+            state->fail(std::make_exception_ptr(RuntimeError{"ingestion stream is dropped"}));
+            state->leave();
+        }
+    };
+
+    // Job of a stream, which fails the others unless it runs, say for a failure to connect.
+    struct Stream {
+        void operator()(Connection& conn) {
+            static_cast<void>(lease.release());
+            state->run(conn, idx);
+        }
+
+        void fail(std::exception_ptr const& err) {
+            state->fail(err);
+        }
+
+        std::shared_ptr<State>        state;
+        std::unique_ptr<State, Leave> lease;
+        int                           idx;
+    };
+
+    explicit Ingester(int const streams, int64_t const commit_rows)
+        : state_{std::make_shared<State>(streams, commit_rows)} {
+        batch_.reserve(BATCH_SIZE);
+    }
+
+    std::shared_ptr<State> state_;
+    std::vector<T>         batch_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <libpq-fe.h>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+// Large object opened by a connection, read and written by ranges without holding it in memory.
+// It runs in a transaction of its own unless there is one in progress,
+// which is committed when the object is closed.
+class LargeObject {
+public:
+    enum class Mode {
+        READ,
+        WRITE,
+        READ_WRITE,
+    };
+
+    LargeObject(LargeObject const& other) = delete;
+    LargeObject& operator=(LargeObject const& other) = delete;
+    LargeObject(LargeObject&& other) noexcept;
+    LargeObject& operator=(LargeObject&& other) = delete;
+    ~LargeObject() noexcept;
+
+    Oid oid() const;
+
+    // Reads up to len bytes from the current position, giving fewer at the end of the object.
+    size_t read(char* buf, size_t len);
+    void write(char const* data, size_t len);
+
+    // Same as above starting at the given offset.
+    size_t read(int64_t offset, char* buf, size_t len);
+    void write(int64_t offset, char const* data, size_t len);
+
+    // Passes the rest of the object to the sink(char const*, size_t) by chunks of the given size.
+    template <typename F>
+    int64_t readChunks(F&& sink, size_t const chunk = CHUNK_SIZE) {
+        auto const buf   = std::make_unique<char[]>(chunk);
+        auto       total = int64_t{0};
+        for (auto len = read(buf.get(), chunk); len != 0; len = read(buf.get(), chunk)) {
+            sink(static_cast<char const*>(buf.get()), len);
+            total += static_cast<int64_t>(len);
+        }
+        return total;
+    }
+
+    // Writes chunks filled by the source(char*, size_t) until it gives zero bytes.
+    template <typename F>
+    int64_t writeChunks(F&& source, size_t const chunk = CHUNK_SIZE) {
+        auto const buf   = std::make_unique<char[]>(chunk);
+        auto       total = int64_t{0};
+        for (size_t len = source(buf.get(), chunk); len != 0; len = source(buf.get(), chunk)) {
+            write(buf.get(), len);
+            total += static_cast<int64_t>(len);
+        }
+        return total;
+    }
+
+    int64_t seek(int64_t offset, int whence = SEEK_SET);
+    int64_t tell();
+    int64_t size();
+    void truncate(int64_t len);
+    // Throws if the descriptor fails to close or the transaction of its own fails to commit.
+    void close();
+
+private:
+    friend class Connection;
+
+    explicit LargeObject(PGconn& conn, Oid id, Mode mode, bool is_owner);
+
+    void check(bool is_ok, char const* action) const;
+    // Same as close() but ignores failures.
+    void release() noexcept;
+
+    // Reads and writes of the server are limited to int lengths.
+    static auto constexpr CHUNK_SIZE = size_t{256 * 1024};
+    static auto constexpr MAX_CALL   = size_t{1} << 30;
+
+    PGconn* conn_;
+    Oid     oid_;
+    int     fd_       = -1;
+    bool    is_owner_ = false;
+};
+
+}  // namespace postgres
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace postgres {
+
+class Connection;
+class Context;
+
+struct Notification {
+    std::string channel;
+    std::string payload;
+    int         pid = 0;
+};
+
+// Listens to the subscribed channels on a connection of its own, waiting for its socket to be readable,
+// and runs the callbacks of the notifications on a pool of threads.
+// Notifications sent while the connection was lost are missed, which the gap callback is told of.
+class Listener {
+public:
+    using Callback = std::function<void(Notification const&)>;
+
+    explicit Listener();
+    explicit Listener(Context ctx, int threads = 1);
+    explicit Listener(std::shared_ptr<Context const> ctx, int threads = 1);
+    Listener(Listener const& other) = delete;
+    Listener& operator=(Listener const& other) = delete;
+    Listener(Listener&& other) noexcept = delete;
+    Listener& operator=(Listener&& other) noexcept = delete;
+    ~Listener() noexcept;
+
+    // Starts listening to the channel shortly after, replacing a callback subscribed before.
+    void subscribe(std::string channel, Callback cb);
+    void unsubscribe(std::string const& channel);
+    // Called on losing the connection and once listening again.
+    void onGap(std::function<void()> cb);
+
+private:
+    using Task = std::function<void()>;
+
+    void run();
+    void listen(Connection& conn);
+    // Brings the channels listened to on the connection in line with the subscribed ones.
+    void sync(Connection& conn, std::unordered_set<std::string>& listened);
+    void receive(Connection& conn);
+    void gap();
+    void post(Task task);
+    void serve();
+    // Tells whether woken, rather than having waited for the socket or the timeout.
+    bool wait(int socket, int timeout_ms);
+    void wake();
+
+    std::shared_ptr<Context const> ctx_;
+
+    std::mutex                                                       mtx_;
+    std::unordered_map<std::string, std::shared_ptr<Callback const>> subs_;
+    std::shared_ptr<std::function<void()> const>                     gap_;
+    bool                                                             is_stopped_ = false;
+
+    std::condition_variable  cond_;
+    std::deque<Task>         tasks_;
+    std::vector<std::thread> pool_;
+
+    int         wake_[2]{-1, -1};
+    std::thread thread_;
+};
+
+}  // namespace postgres
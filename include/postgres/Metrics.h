@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace postgres {
+
+// Durations counted by buckets of powers of two microseconds, the last bucket taking all the longer ones.
+struct Histogram {
+    using Duration = std::chrono::nanoseconds;
+
+    static auto constexpr SIZE = 32;
+
+    std::array<int64_t, SIZE> counts{};
+    int64_t                   count = 0;
+    Duration                  total{0};
+
+    static int bucket(Duration dur);
+
+    void add(Duration dur);
+    Duration mean() const;
+    // Upper bound of the bucket the quantile falls into.
+    Duration quantile(double q) const;
+};
+
+// Snapshot of a connection pool, see Client::metrics().
+struct Metrics {
+    // Jobs sent, waiting in the queue, taken by the workers, done, and failed without running.
+    int64_t sent     = 0;
+    int64_t queued   = 0;
+    int64_t started  = 0;
+    int64_t finished = 0;
+    int64_t dropped  = 0;
+    // Connected workers, those of them running a job and the rest.
+    int     workers  = 0;
+    int     active   = 0;
+    int     idle     = 0;
+    // Connection attempts, failed ones, and workers gone due to the idle timeout, the limiter or a broken connection.
+    int64_t connects = 0;
+    int64_t failures = 0;
+    int64_t recycled = 0;
+    // Allocations made by the jobs when accounted, see Context::Builder::accountMemory():
+    // commands executed with the bytes of their buffers, results received with their size as told by libpq,
+    // and jobs run with the bytes of those stored out of line.
+    int64_t commands      = 0;
+    int64_t command_bytes = 0;
+    int64_t results       = 0;
+    int64_t result_bytes  = 0;
+    int64_t jobs          = 0;
+    int64_t job_bytes     = 0;
+
+    Histogram wait;
+    Histogram exec;
+    Histogram connect;
+};
+
+}  // namespace postgres
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <utility>
 #include <libpq-fe.h>
 
@@ -40,13 +43,19 @@
 #define MACADDROID 829
 #define INETOID 869
 #define CIDROID 650
+#define BOOLARRAYOID 1000
 #define INT2ARRAYOID 1005
 #define INT4ARRAYOID 1007
 #define TEXTARRAYOID 1009
+#define VARCHARARRAYOID 1015
+#define INT8ARRAYOID 1016
 #define OIDARRAYOID 1028
 #define FLOAT4ARRAYOID 1021
+#define FLOAT8ARRAYOID 1022
+#define TIMESTAMPARRAYOID 1115
 #define ACLITEMOID 1033
 #define CSTRINGARRAYOID 1263
+#define UUIDARRAYOID 2951
 #define BPCHAROID 1042
 #define VARCHAROID 1043
 #define DATEOID 1082
@@ -107,4 +116,20 @@ OidBinding<T> bindOid(T&& param, Oid const type) {
     return OidBinding<T>{std::forward<T>(param), type};
 }
 
+// Refers to memory owned by the caller, which must outlive the command.
+// It is sent as is in binary format, so the type has to be the one whose binary form is raw bytes,
+// like TEXT, VARCHAR, JSON or BYTEA.
+struct Borrowed {
+    std::string_view data;
+    Oid const        type;
+};
+
+inline Borrowed borrow(std::string_view const data, Oid const type = TEXTOID) {
+    return Borrowed{data, type};
+}
+
+inline Borrowed borrow(uint8_t const* const data, size_t const len) {
+    return Borrowed{std::string_view{reinterpret_cast<char const*>(data), len}, BYTEAOID};
+}
+
 }  // namespace postgres
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <libpq-fe.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+class Command;
+class PreparedCommand;
+struct PrepareData;
+
+class Pipeline {
+public:
+    class iterator;
+
+    Pipeline(Pipeline const& other) = delete;
+    Pipeline& operator=(Pipeline const& other) = delete;
+    Pipeline(Pipeline&& other) noexcept;
+    Pipeline& operator=(Pipeline&& other) = delete;
+    ~Pipeline() noexcept;
+
+    Pipeline& send(PrepareData const& prep);
+    Pipeline& send(Command const& cmd);
+    Pipeline& send(PreparedCommand const& cmd);
+    Pipeline& sync();
+
+    Result receive();
+    iterator begin();
+    iterator end();
+
+    int size() const;
+
+private:
+    friend class Connection;
+
+    explicit Pipeline(std::shared_ptr<PGconn> handle);
+
+    // Requests the columns of the results of a prepared statement.
+    Pipeline& describe(std::string const& name);
+    void enqueue(int is_ok);
+    void flush();
+    PGresult* next();
+    PGconn* native() const;
+
+    std::shared_ptr<PGconn> handle_;
+    // Statements whose results are not received yet.
+    int queued_   = 0;
+    // Statements sent after the last synchronization or flush request.
+    int unsynced_ = 0;
+    // Synchronization points not consumed yet.
+    int syncs_    = 0;
+};
+
+class Pipeline::iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Result;
+    using pointer = Result*;
+    using reference = Result&;
+
+    iterator(iterator const& other) = delete;
+    iterator& operator=(iterator const& other) = delete;
+    iterator(iterator&& other) noexcept;
+    iterator& operator=(iterator&& other) noexcept;
+    ~iterator() noexcept;
+
+    bool operator==(iterator const& other) const;
+    bool operator!=(iterator const& other) const;
+    void operator++();
+    iterator const operator++(int);
+    Result operator->();
+    Result operator*();
+
+private:
+    friend class Pipeline;
+
+    explicit iterator(Pipeline& pipe, Result res);
+
+    Pipeline* pipe_;
+    Result res_;
+    bool   is_;
+};
+
+}  // namespace postgres
@@ -1,21 +1,45 @@
 #pragma once
 
+#include <postgres/Affinity.h>
+#include <postgres/Arrow.h>
+#include <postgres/Change.h>
+#include <postgres/ChangeStream.h>
 #include <postgres/Client.h>
 #include <postgres/Command.h>
 #include <postgres/Config.h>
 #include <postgres/Connection.h>
 #include <postgres/Consumer.h>
 #include <postgres/Context.h>
+#include <postgres/CopyReader.h>
+#include <postgres/CopyWriter.h>
+#include <postgres/Cursor.h>
+#include <postgres/Decimal.h>
 #include <postgres/Error.h>
 #include <postgres/Field.h>
+#include <postgres/Grid.h>
+#include <postgres/Ingester.h>
+#include <postgres/LargeObject.h>
+#include <postgres/Listener.h>
+#include <postgres/Metrics.h>
 #include <postgres/Oid.h>
+#include <postgres/Pipeline.h>
 #include <postgres/PreparedCommand.h>
+#include <postgres/Priority.h>
 #include <postgres/PrepareData.h>
 #include <postgres/Receiver.h>
 #include <postgres/Result.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Row.h>
+#include <postgres/ShardedClient.h>
+#include <postgres/SlowLog.h>
 #include <postgres/Statement.h>
+#include <postgres/StatementRegistry.h>
+#include <postgres/Stream.h>
 #include <postgres/Status.h>
 #include <postgres/Time.h>
+#include <postgres/Tracer.h>
 #include <postgres/Transaction.h>
+#include <postgres/Tuples.h>
+#include <postgres/Uuid.h>
+#include <postgres/View.h>
 #include <postgres/Visitable.h>
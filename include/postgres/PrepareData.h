@@ -9,7 +9,7 @@ namespace postgres {
 struct PrepareData {
     std::string      name;
     std::string      statement;
-    std::vector<Oid> types;
+    std::vector<Oid> types{};
 };
 
 }  // namespace postgres
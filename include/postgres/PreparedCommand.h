@@ -17,6 +17,12 @@ public:
     PreparedCommand(PreparedCommand&& other) noexcept;
     PreparedCommand& operator=(PreparedCommand&& other) noexcept;
     ~PreparedCommand() noexcept;
+
+    template <typename... Ts>
+    PreparedCommand& rebind(Ts&& ... args) {
+        Command::rebind(std::forward<Ts>(args)...);
+        return *this;
+    }
 };
 
 }  // namespace postgres
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace postgres {
+
+// Requests of a higher priority are taken from the queue first.
+enum class Priority {
+    HIGH,
+    NORMAL,
+    LOW,
+};
+
+}  // namespace postgres
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <postgres/Consumer.h>
 #include <postgres/Result.h>
 
+namespace postgres::internal {
+
+class Span;
+
+}  // namespace postgres::internal
+
 namespace postgres {
 
 class Receiver : public Consumer {
@@ -16,6 +24,8 @@ public:
     ~Receiver() noexcept;
 
     Result receive();
+    // Returns nothing instead of waiting while the server is busy.
+    std::optional<Result> tryReceive();
     iterator begin();
     iterator end();
 
@@ -24,7 +34,10 @@ private:
 
     explicit Receiver(std::shared_ptr<PGconn> handle, int is_ok);
 
-    void iter();
+    void iter(int chunk);
+
+    // Set while tracing until the last result is received.
+    std::unique_ptr<internal::Span> span_;
 };
 
 class Receiver::iterator {
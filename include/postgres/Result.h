@@ -1,15 +1,30 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include <postgres/internal/Columnar.h>
+#include <postgres/Error.h>
+#include <postgres/Grid.h>
 #include <postgres/Status.h>
+#include <postgres/Tuples.h>
+#include <postgres/View.h>
 
 namespace postgres {
+namespace internal {
 
-class Row;
+class Columns;
+
+}  // namespace internal
 
 class Result : public Status {
 public:
     class iterator;
 
+    // Takes over a result obtained from libpq by other means, failing on an error status.
+    static Result adopt(PGresult* handle);
+
     Result(Result const& other) = delete;
     Result& operator=(Result const& other) = delete;
     Result(Result&& other) noexcept;
@@ -20,12 +35,114 @@ public:
     iterator end() const;
     Row operator[](int idx) const;
 
+    // Keeps the data alive after the result is gone,
+    // so that views obtained from its fields stay valid as long as the handle.
+    using Status::share;
+
+    // Appends a whole column of numbers at once, checking its type just once.
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> column(int const col_idx, std::vector<T>& out) const {
+        auto const beg = out.size();
+        out.resize(beg + static_cast<size_t>(size()));
+        readColumn(col_idx, [this, col_idx, &out, beg] {
+            return readInto(col_idx, out, beg, [this, col_idx](int) {
+                _POSTGRES_CXX_FAIL(LogicError,
+                                   "cannot store NULL value of column '"
+                                       << PQfname(native(), col_idx)
+                                       << "' into vector of non-optional type");
+            });
+        });
+    }
+
+    template <typename T>
+    void column(int const col_idx, std::vector<std::optional<T>>& out) const {
+        auto const beg = out.size();
+        out.resize(beg + static_cast<size_t>(size()));
+        readColumn(col_idx, [this, col_idx, &out, beg] {
+            return internal::readColumn<T>(*native(), col_idx, [&out, beg](int const row, T const val) {
+                out[beg + row] = val;
+            }, [](int) {
+            });
+        });
+    }
+
+    // Stores NULLs as default values, marking them in a separate bitmap.
+    template <typename T>
+    void column(int const col_idx, std::vector<T>& out, std::vector<bool>& nulls) const {
+        auto const beg = out.size();
+        out.resize(beg + static_cast<size_t>(size()));
+        nulls.resize(beg + static_cast<size_t>(size()));
+        readColumn(col_idx, [this, col_idx, &out, &nulls, beg] {
+            return readInto(col_idx, out, beg, [&nulls, beg](int const row) {
+                nulls[beg + row] = true;
+            });
+        });
+    }
+
+    template <typename... Ts>
+    void column(char const* const col_name, Ts& ... out) const {
+        column(columnIndex(col_name), out...);
+    }
+
+    // Iterates over rows decoded into tuples of the leading columns.
+    template <typename T>
+    std::enable_if_t<internal::isTuple<T>(), Tuples<T>> as() const {
+        check();
+        return Tuples<T>{*native()};
+    }
+
+    // Cells of the leading columns read without any type dispatch, checked once here.
+    template <typename... Ts>
+    View<Ts...> view() const {
+        check();
+        return View<Ts...>{*native()};
+    }
+
+    // Cells of any columns, whose types and formats are read once here.
+    Grid grid() const;
+
 private:
     friend class Connection;
+    friend class Cursor;
+    friend class Pipeline;
     friend class Receiver;
 
     explicit Result(PGresult* handle);
     explicit Result(PGresult* handle, Consumer* consumer);
+    explicit Result(PGresult* handle, Consumer* consumer, std::shared_ptr<internal::Columns> cols);
+
+    // Shares the columns described for a prepared statement, unless the result doesn't match them.
+    static Result prepared(PGresult* handle, std::shared_ptr<internal::Columns> const& cols);
+
+    int columnIndex(char const* col_name) const;
+
+    template <typename F>
+    void readColumn(int const col_idx, F&& read) const {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             (0 <= col_idx) && (col_idx < PQnfields(native())),
+                             "column " << col_idx << " does not exist");
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             read(),
+                             "cannot cast column '"
+                                 << PQfname(native(), col_idx)
+                                 << "' of type "
+                                 << PQftype(native(), col_idx)
+                                 << " to desired arithmetic type");
+    }
+
+    // Packed bits of vector<bool> have no data() to copy into, so they are stored one by one.
+    template <typename T, typename Null>
+    bool readInto(int const col_idx, std::vector<T>& out, size_t const beg, Null&& null) const {
+        if constexpr (std::is_same_v<T, bool>) {
+            return internal::readColumn<bool>(*native(), col_idx, [&out, beg](int const row, bool const val) {
+                out[beg + row] = val;
+            }, null);
+        } else {
+            return internal::readDense(*native(), col_idx, out.data() + beg, null);
+        }
+    }
+
+    std::shared_ptr<internal::Columns> cols_;
 };
 
 class Result::iterator {
@@ -52,10 +169,11 @@ public:
 private:
     friend class Result;
 
-    explicit iterator(PGresult& handle, int idx);
+    explicit iterator(PGresult& handle, int idx, internal::Columns* cols);
 
     PGresult* handle_ = nullptr;
     int idx_ = 0;
+    internal::Columns* cols_ = nullptr;
 };
 
 }  // namespace postgres
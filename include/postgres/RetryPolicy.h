@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+
+namespace postgres {
+
+class RuntimeError;
+
+// Serialization failures and deadlocks are expected at SERIALIZABLE isolation,
+// and a transaction failed by them is likely to succeed once rerun.
+struct RetryPolicy {
+    // Tells whether a failure is one of the above, judging by its SQLSTATE.
+    static bool isTransient(RuntimeError const& err);
+
+    // Random pause before the given retry, counted from one, up to the delay doubled after each retry.
+    // The randomness keeps the contending transactions from colliding again in lockstep.
+    std::chrono::microseconds backoff(int retry) const;
+
+    int                       attempts  = 5;
+    std::chrono::microseconds delay     = std::chrono::milliseconds{1};
+    std::chrono::microseconds max_delay = std::chrono::milliseconds{100};
+};
+
+}  // namespace postgres
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <libpq-fe.h>
+#include <vector>
 #include <postgres/internal/Classifier.h>
+#include <postgres/internal/Columns.h>
+#include <postgres/Error.h>
 #include <postgres/Field.h>
 
 namespace postgres {
@@ -18,16 +25,73 @@ public:
 
     template <typename T>
     std::enable_if_t<internal::isVisitable<T>(), Row&> operator>>(T& val) {
-        val.visitPostgresFields(*this);
+        if (!cols_) {
+            val.visitPostgresFields(*this);
+            return *this;
+        }
+
+        Cursor cur{*this, cols_->get<T>()};
+        val.visitPostgresFields(cur);
         return *this;
     };
 
+    // Text fields of type std::pmr::string are allocated from the given memory resource.
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>(), Row&> read(T& val, std::pmr::memory_resource& mem) {
+        if (cols_) {
+            Cursor cur{*this, cols_->get<T>(), 0, &mem};
+            val.visitPostgresFields(cur);
+            return *this;
+        }
+
+        internal::ColumnsCollector coll{res_};
+        T::visitPostgresDefinition(coll);
+        Cursor cur{*this, coll.res, 0, &mem};
+        val.visitPostgresFields(cur);
+        return *this;
+    }
+
+    // Decodes the fields over those of the object, reusing the storage of its strings,
+    // and tells whether any of them has changed.
     template <typename T>
-    std::enable_if_t<!internal::isVisitable<T>(), Row&> operator>>(T& val) {
+    std::enable_if_t<internal::isVisitable<T>(), bool> refresh(T& val) const {
+        if (cols_) {
+            Refresher ref{*this, cols_->get<T>()};
+            val.visitPostgresFields(ref);
+            return ref.is_changed;
+        }
+
+        internal::ColumnsCollector coll{res_};
+        T::visitPostgresDefinition(coll);
+        Refresher ref{*this, coll.res};
+        val.visitPostgresFields(ref);
+        return ref.is_changed;
+    }
+
+    template <typename T>
+    std::enable_if_t<!internal::isVisitable<T>() && !internal::isTuple<T>(), Row&> operator>>(T& val) {
         (*this)[col_idx_++] >> val;
         return *this;
     }
 
+    // Decodes the next columns into the tuple elements, checking their count just once.
+    template <typename... Ts>
+    Row& operator>>(std::tuple<Ts...>& val) {
+        checkTuple(*res_, col_idx_, sizeof... (Ts));
+        auto const cols = internal::makeColumns<Ts...>(res_, col_idx_);
+        readTuple(val, cols.data(), std::index_sequence_for<Ts...>{});
+        col_idx_ += static_cast<int>(sizeof... (Ts));
+        return *this;
+    }
+
+    // Decodes the leading columns.
+    template <typename T>
+    std::enable_if_t<internal::isTuple<T>(), T> as() const {
+        T val{};
+        Row{*res_, row_idx_, nullptr} >> val;
+        return val;
+    }
+
     template <typename T>
     void accept(char const* const name, T& val) {
         (*this)[name] >> val;
@@ -35,18 +99,140 @@ public:
 
     Field operator[](std::string const& col_name) const;
     Field operator[](char const* col_name) const;
-    Field operator[](int col_idx) const;
 
-    int size() const;
+    Field operator[](int const col_idx) const {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             (0 <= col_idx) && (col_idx < size()),
+                             "column index " << col_idx << " is out of range");
+        return Field{*res_, row_idx_, col_idx};
+    }
+
+    int size() const {
+        return PQnfields(res_);
+    }
 
 private:
+    friend class Connection;
     friend class Result;
 
-    explicit Row(PGresult& res, int row_idx);
+    template <typename T>
+    friend class Stream;
+
+    template <typename T>
+    friend class Tuples;
+
+    // Visits fields in the same order as the cached column indices.
+    struct Cursor {
+        template <typename T>
+        void accept(char const* const name, T& val) {
+            auto const& col = cols[idx++];
+            _POSTGRES_CXX_ASSERT(LogicError, (0 <= col.idx), "column '" << name << "' does not exist");
+            if constexpr (std::is_same_v<T, std::pmr::string> || std::is_same_v<T, std::optional<std::pmr::string>>) {
+                if (mem) {
+                    Field{*row.res_, row.row_idx_, col.idx}.readIn(val, *mem);
+                    return;
+                }
+            }
+            row.decode(val, col);
+        }
+
+        Row const&                           row;
+        std::vector<internal::Column> const& cols;
+        size_t                               idx = 0;
+        std::pmr::memory_resource*           mem = nullptr;
+    };
+
+    // Same as the cursor telling whether any field has changed.
+    struct Refresher {
+        template <typename T>
+        void accept(char const* const name, T& val) {
+            auto const& col = cols[idx++];
+            _POSTGRES_CXX_ASSERT(LogicError, (0 <= col.idx), "column '" << name << "' does not exist");
+            is_changed = row.update(val, col) || is_changed;
+        }
+
+        Row const&                           row;
+        std::vector<internal::Column> const& cols;
+        size_t                               idx        = 0;
+        bool                                 is_changed = false;
+    };
+
+    static void checkTuple(PGresult const& res, int col_idx, size_t size);
+
+    // Columns of the fields resolved once for all the rows, which are then decoded without locking.
+    template <typename T>
+    std::vector<internal::Column> columns() const {
+        if (cols_) {
+            return cols_->get<T>();
+        }
+        internal::ColumnsCollector coll{res_};
+        T::visitPostgresDefinition(coll);
+        return std::move(coll.res);
+    }
+
+    template <typename T>
+    void visit(T& val, std::vector<internal::Column> const& cols) const {
+        Cursor cur{*this, cols};
+        val.visitPostgresFields(cur);
+    }
+
+    explicit Row(PGresult& res, int row_idx, internal::Columns* cols);
+
+    template <typename T>
+    void decode(T& val, internal::Column const col) const {
+        auto const fld = Field{*res_, row_idx_, col.idx};
+        if (col.is_exact) {
+            fld.readExact(val);
+            return;
+        }
+        fld >> val;
+    }
+
+    // Strings are compared with the text in place, and other values decoded aside unless incomparable.
+    template <typename T>
+    bool update(T& val, internal::Column const col) const {
+        auto const fld = Field{*res_, row_idx_, col.idx};
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::pmr::string>) {
+            if (!fld.isNull() && (fld.text() == val)) {
+                return false;
+            }
+            fld >> val;
+        } else if constexpr (internal::isComparable<T>() && std::is_default_constructible_v<T>) {
+            T tmp{};
+            decode(tmp, col);
+            if (tmp == val) {
+                return false;
+            }
+            val = std::move(tmp);
+        } else {
+            decode(val, col);
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool update(std::optional<T>& val, internal::Column const col) const {
+        if (Field{*res_, row_idx_, col.idx}.isNull()) {
+            auto const is_changed = val.has_value();
+            val.reset();
+            return is_changed;
+        }
+        if (!val) {
+            decode(val, col);
+            return true;
+        }
+        return update(*val, col);
+    }
+
+    template <typename... Ts, size_t... Is>
+    void readTuple(std::tuple<Ts...>& val, internal::Column const* const cols, std::index_sequence<Is...>) const {
+        (decode(std::get<Is>(val), cols[Is]), ...);
+    }
 
     PGresult* res_;
     int row_idx_;
     int col_idx_;
+    internal::Columns* cols_;
 };
 
 }  // namespace postgres
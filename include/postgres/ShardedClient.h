@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <utility>
+#include <vector>
+#include <postgres/Client.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Priority.h>
+#include <postgres/Result.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+// Routes jobs to the pools of the shards owning their keys, as told by a function of the key.
+// Like a Client, it is not thread-safe by itself.
+template <typename Key>
+class ShardedClient {
+public:
+    using Router = std::function<size_t(Key const&)>;
+
+    // Keys are hashed onto the shards by default.
+    explicit ShardedClient(std::vector<Context> ctxs)
+        : ShardedClient{std::move(ctxs), std::hash<Key>{}} {
+    }
+
+    explicit ShardedClient(std::vector<Context> ctxs, Router route)
+        : route_{std::move(route)} {
+        _POSTGRES_CXX_ASSERT(LogicError, !ctxs.empty(), "no shards to route to");
+        shards_.reserve(ctxs.size());
+        for (auto& ctx : ctxs) {
+            shards_.emplace_back(std::move(ctx));
+        }
+    }
+
+    ShardedClient(ShardedClient const& other) = delete;
+    ShardedClient& operator=(ShardedClient const& other) = delete;
+    ShardedClient(ShardedClient&& other) noexcept = default;
+    ShardedClient& operator=(ShardedClient&& other) noexcept = default;
+    ~ShardedClient() noexcept = default;
+
+    size_t size() const {
+        return shards_.size();
+    }
+
+    // Whatever the router returns is folded into the range of the shards.
+    Client& shard(Key const& key) {
+        auto const idx = route_(key) % shards_.size();
+        return shards_[idx];
+    }
+
+    template <typename F>
+    std::future<Status> exec(Key const& key, F&& job, Priority const prio = Priority::NORMAL) {
+        return shard(key).exec(std::forward<F>(job), prio);
+    }
+
+    template <typename F>
+    std::future<Result> query(Key const& key, F&& job, Priority const prio = Priority::NORMAL) {
+        return shard(key).query(std::forward<F>(job), prio);
+    }
+
+    // Sends the job to every shard at once, so that they run it in parallel.
+    template <typename F>
+    std::vector<std::future<Result>> scatter(F const& job, Priority const prio = Priority::NORMAL) {
+        std::vector<std::future<Result>> res{};
+        res.reserve(shards_.size());
+        for (auto& cl : shards_) {
+            res.push_back(cl.query(job, prio));
+        }
+        return res;
+    }
+
+    // Waits for the results of all the shards, in their order.
+    template <typename F>
+    std::vector<Result> gather(F const& job, Priority const prio = Priority::NORMAL) {
+        auto                futures = scatter(job, prio);
+        std::vector<Result> res{};
+        res.reserve(futures.size());
+        for (auto& fut : futures) {
+            res.push_back(fut.get());
+        }
+        return res;
+    }
+
+    // Merges the rows of all the shards into one vector, in the order of the shards.
+    template <typename T, typename F>
+    std::vector<T> merge(F const& job, Priority const prio = Priority::NORMAL) {
+        std::vector<T> out{};
+        for (auto const& res : gather(job, prio)) {
+            auto const beg = out.size();
+            out.resize(beg + static_cast<size_t>(res.size()));
+            for (auto i = 0; i < res.size(); ++i) {
+                res[i] >> out[beg + static_cast<size_t>(i)];
+            }
+        }
+        return out;
+    }
+
+private:
+    Router              route_;
+    std::vector<Client> shards_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <postgres/Metrics.h>
+#include <postgres/Tracer.h>
+
+namespace postgres {
+
+// Aggregates the traces of statements by their fingerprints, so that the ones costing the most can be found.
+// The latency is counted from sending a job to a pool till the last result, including the time in the queue.
+// Set it as the tracer of a context or a connection.
+class SlowLog : public Tracer {
+public:
+    using Duration = Trace::Clock::duration;
+
+    struct Entry {
+        std::string fingerprint;
+        int64_t     calls  = 0;
+        int64_t     errors = 0;
+        int64_t     rows   = 0;
+        Duration    max{0};
+        Histogram   latency;
+        Histogram   wait;
+    };
+
+    // Statements faster than the threshold are skipped. Up to about the capacity of fingerprints are kept,
+    // the one with the least total latency giving way to a new one.
+    explicit SlowLog(Duration threshold = Duration{0}, size_t capacity = 1024);
+    SlowLog(SlowLog const& other) = delete;
+    SlowLog& operator=(SlowLog const& other) = delete;
+    SlowLog(SlowLog&& other) noexcept = delete;
+    SlowLog& operator=(SlowLog&& other) noexcept = delete;
+    ~SlowLog() noexcept override;
+
+    void trace(Trace const& trace) override;
+
+    // The worst fingerprints by total latency, up to the given number.
+    std::vector<Entry> top(size_t count) const;
+    // Writes the top as a table, a line per fingerprint.
+    void dump(std::ostream& out, size_t count) const;
+    void clear();
+
+    // Replaces literals, parameters and lists of them with a placeholder, and collapses the whitespace,
+    // so that statements differing in values only share the fingerprint.
+    static std::string fingerprint(std::string_view stmt);
+
+private:
+    static auto constexpr SHARDS = 16;
+
+    struct Shard {
+        mutable std::mutex                     mtx;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    static void evict(Shard& shard);
+
+    Duration const              threshold_;
+    size_t const                shard_cap_;
+    std::array<Shard, SHARDS>   shards_;
+};
+
+}  // namespace postgres
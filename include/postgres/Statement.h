@@ -1,72 +1,265 @@
 #pragma once
 
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Texts.h>
 #include <postgres/internal/Visitors.h>
+#include <postgres/PrepareData.h>
 
 namespace postgres {
 
+// Fixed statements are generated at compile time.
 template <typename T>
 struct Statement {
-    static std::string const& create() {
-        static auto const cache = "CREATE TABLE " + table() + " (" + typedFields() + ")";
-        return cache;
+    static constexpr std::string_view create() {
+        return view<Create>();
     }
 
-    static std::string const& drop() {
-        static auto const cache = "DROP TABLE " + table();
-        return cache;
+    static constexpr std::string_view drop() {
+        return view<Drop>();
     }
 
-    static std::string const& insert() {
-        static auto const cache = "INSERT INTO "
-                                  + table()
-                                  + " ("
-                                  + fields()
-                                  + ") VALUES ("
-                                  + placeholders()
-                                  + ")";
-        return cache;
+    static constexpr std::string_view insert() {
+        return view<Insert>();
     }
 
-    static std::string const& update() {
-        static auto const cache = "UPDATE " + table() + " SET " + assignments();
-        return cache;
+    static constexpr std::string_view update() {
+        return view<Update>();
     }
 
-    static std::string const& select() {
-        static auto const cache = "SELECT " + fields() + " FROM " + table();
-        return cache;
+    // Inserts objects sent as arrays of fields, see transpose(), updating those with the same key.
+    static constexpr std::string_view upsert() {
+        return view<Upsert>();
     }
 
-    static std::string const& fields() {
-        static auto const cache = collect(internal::FieldsCollector{});
-        return cache;
+    static constexpr std::string_view select() {
+        return view<Select>();
     }
 
-    static std::string const& typedFields() {
-        static auto const cache = collect(internal::TypedFieldsCollector{});
-        return cache;
+    // Rows stored in the pages of the table from $1 up to $2, the latter being excluded.
+    static constexpr std::string_view selectPages() {
+        return view<SelectPages>();
+    }
+
+    // Number of pages taken by the table.
+    static constexpr std::string_view pages() {
+        return view<Pages>();
+    }
+
+    static constexpr std::string_view copyIn() {
+        return view<CopyIn>();
+    }
+
+    static constexpr std::string_view copyOut() {
+        return view<CopyOut>();
+    }
+
+    static constexpr std::string_view fields() {
+        return view<Fields>();
+    }
+
+    static constexpr std::string_view typedFields() {
+        return view<TypedFields>();
+    }
+
+    static constexpr std::string_view table() {
+        return T::_POSTGRES_CXX_TABLE_NAME;
     }
 
     static std::string placeholders(int const offset = 0) {
-        return collect(internal::PlaceholdersCollector{offset});
+        std::string res{};
+        internal::PlaceholdersBuilder<std::string> coll{res, offset};
+        T::visitPostgresDefinition(coll);
+        return res;
     }
 
     static std::string assignments(int const offset = 0) {
-        return collect(internal::AssignmentsCollector{offset});
+        std::string res{};
+        internal::AssignmentsBuilder<std::string> coll{res, offset};
+        T::visitPostgresDefinition(coll);
+        return res;
     }
 
-    static std::string table() {
-        return T::_POSTGRES_CXX_TABLE_NAME;
+    // Types of the fields in the order of the placeholders of insert() and update().
+    static std::vector<Oid> types() {
+        std::vector<Oid> res{};
+        internal::ParamTypesCollector coll{res};
+        T::visitPostgresDefinition(coll);
+        return res;
+    }
+
+    // Insert, update and select named after the table, say "my_table_insert", with the parameters typed,
+    // so that binary values are never taken for other types. Conditions appended to the update
+    // are better prepared by hand though, since the types of their parameters are left to the server.
+    // The update is left out when there is nothing to set.
+    static std::vector<PrepareData> prepareData() {
+        auto const name  = std::string{table()};
+        auto const typed = types();
+
+        std::vector<PrepareData> res{};
+        res.push_back({name + "_insert", std::string{insert()}, typed});
+        if (!typed.empty()) {
+            res.push_back({name + "_update", std::string{update()}, typed});
+        }
+        res.push_back({name + "_select", std::string{select()}, {}});
+        return res;
     }
 
 private:
-    template <typename C>
-    static std::string collect(C coll) {
+    struct Create {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "CREATE TABLE ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " (";
+            visit<internal::TypedFieldsBuilder>(res);
+            res += ")";
+        }
+    };
+
+    struct Drop {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "DROP TABLE ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+        }
+    };
+
+    struct Insert {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "INSERT INTO ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " (";
+            visit<internal::FieldsBuilder>(res);
+            res += ") VALUES (";
+            visit<internal::PlaceholdersBuilder>(res);
+            res += ")";
+        }
+    };
+
+    struct Update {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "UPDATE ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " SET ";
+            visit<internal::AssignmentsBuilder>(res);
+        }
+    };
+
+    struct Upsert {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "INSERT INTO ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " (";
+            visit<internal::FieldsBuilder>(res);
+            res += ") SELECT * FROM unnest(";
+            visit<internal::PlaceholdersBuilder>(res);
+            res += ") ON CONFLICT (";
+            res += T::_POSTGRES_CXX_TABLE_KEY;
+            res += ") DO UPDATE SET ";
+            internal::JoinedAssignmentsBuilder<B> coll{res, T::_POSTGRES_CXX_TABLE_KEY, "EXCLUDED"};
+            T::visitPostgresDefinition(coll);
+        }
+    };
+
+    struct Select {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "SELECT ";
+            visit<internal::FieldsBuilder>(res);
+            res += " FROM ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+        }
+    };
+
+    struct SelectPages {
+        template <typename B>
+        static constexpr void build(B& res) {
+            Select::build(res);
+            res += " WHERE ctid >= ('(' || $1::BIGINT || ',0)')::TID";
+            res += " AND ctid < ('(' || $2::BIGINT || ',0)')::TID";
+        }
+    };
+
+    struct Pages {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "SELECT pg_relation_size('";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += "') / current_setting('block_size')::BIGINT";
+        }
+    };
+
+    struct CopyIn {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "COPY ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " (";
+            visit<internal::FieldsBuilder>(res);
+            res += ") FROM STDIN (FORMAT BINARY)";
+        }
+    };
+
+    struct CopyOut {
+        template <typename B>
+        static constexpr void build(B& res) {
+            res += "COPY ";
+            res += T::_POSTGRES_CXX_TABLE_NAME;
+            res += " (";
+            visit<internal::FieldsBuilder>(res);
+            res += ") TO STDOUT (FORMAT BINARY)";
+        }
+    };
+
+    struct Fields {
+        template <typename B>
+        static constexpr void build(B& res) {
+            visit<internal::FieldsBuilder>(res);
+        }
+    };
+
+    struct TypedFields {
+        template <typename B>
+        static constexpr void build(B& res) {
+            visit<internal::TypedFieldsBuilder>(res);
+        }
+    };
+
+    template <template <typename> class C, typename B>
+    static constexpr void visit(B& res) {
+        C<B> coll{res};
         T::visitPostgresDefinition(coll);
-        return coll.res;
     }
+
+    // The statement is built twice: to measure its length and then to fill the storage.
+    template <typename S>
+    static constexpr auto make() {
+        auto constexpr LEN = [] {
+            internal::SqlBuilder<0> res{};
+            S::build(res);
+            return res.len;
+        }();
+
+        internal::SqlBuilder<LEN> res{};
+        S::build(res);
+        return res;
+    }
+
+    template <typename S>
+    static constexpr std::string_view view() {
+        return {SQL<S>.res, SQL<S>.len};
+    }
+
+    template <typename S>
+    static constexpr auto SQL = make<S>();
 };
 
 struct RangeStatement {
@@ -77,26 +270,105 @@ struct RangeStatement {
         return "INSERT INTO "
                + std::string{S::table()}
                + " ("
-               + S::fields()
+               + std::string{S::fields()}
                + ") VALUES "
                + placeholders(beg, end);
     }
 
+    // Same as insert() but cached by the number of rows for each type.
+    // Gives an empty view once there are too many different numbers, leaving the text built in the spare.
+    template <typename Iter>
+    static std::string_view insertCached(Iter const beg, Iter const end, std::string& spare) {
+        static internal::Texts cache{CACHE_SIZE};
+
+        auto const rows = static_cast<size_t>(std::distance(beg, end));
+        if (auto const stmt = cache.find(rows); !stmt.empty()) {
+            return stmt;
+        }
+        spare = insert(beg, end);
+        return cache.add(rows, std::move(spare));
+    }
+
+    template <typename Iter>
+    static std::string_view insertCached(Iter const beg, Iter const end) {
+        std::string spare{};
+        return insertCached(beg, end, spare);
+    }
+
+    // Updates the rows matching the objects by the key declared with POSTGRES_CXX_TABLE_KEY.
+    // The values are joined as a whole, so that a single statement updates the whole range.
+    // They are appended to an empty selection from the table to take the types of its columns,
+    // which a column of NULLs sent without a type would not get otherwise.
+    template <typename Iter>
+    static std::string update(Iter const beg, Iter const end) {
+        using T = std::remove_pointer_t<typename Iter::value_type>;
+        using S = Statement<T>;
+        auto constexpr key = T::_POSTGRES_CXX_TABLE_KEY;
+
+        std::string res{"UPDATE "};
+        res += S::table();
+        res += " SET ";
+        internal::JoinedAssignmentsBuilder<std::string> coll{res, key, "v"};
+        T::visitPostgresDefinition(coll);
+        res += " FROM (SELECT ";
+        res += S::fields();
+        res += " FROM ";
+        res += S::table();
+        res += " WHERE false";
+
+        auto idx = 0;
+        for (auto it = beg; it != end; ++it) {
+            res += " UNION ALL SELECT ";
+            internal::PlaceholdersBuilder<std::string> vals{res, idx};
+            T::visitPostgresDefinition(vals);
+            idx = vals.idx;
+        }
+        res += ") AS v WHERE ";
+        res += S::table();
+        res += ".";
+        res += key;
+        res += "=v.";
+        res += key;
+        return res;
+    }
+
+    // Same as update() but cached like insertCached().
+    template <typename Iter>
+    static std::string_view updateCached(Iter const beg, Iter const end, std::string& spare) {
+        static internal::Texts cache{CACHE_SIZE};
+
+        auto const rows = static_cast<size_t>(std::distance(beg, end));
+        if (auto const stmt = cache.find(rows); !stmt.empty()) {
+            return stmt;
+        }
+        spare = update(beg, end);
+        return cache.add(rows, std::move(spare));
+    }
+
+    template <typename Iter>
+    static std::string_view updateCached(Iter const beg, Iter const end) {
+        std::string spare{};
+        return updateCached(beg, end, spare);
+    }
+
     template <typename Iter>
     static std::string placeholders(Iter const beg, Iter const end, int const offset = 0) {
         using T = std::remove_pointer_t<typename Iter::value_type>;
-        internal::PlaceholdersCollector coll{offset};
-        std::string                     res{};
+        auto        idx = offset;
+        std::string res{};
 
         for (auto it = beg; it != end; ++it) {
-            T::visitPostgresDefinition(coll);
             res += res.empty() ? "(" : ",(";
-            res += coll.res;
+            internal::PlaceholdersBuilder<std::string> coll{res, idx};
+            T::visitPostgresDefinition(coll);
             res += ")";
-            coll.res.clear();
+            idx = coll.idx;
         }
         return res;
     }
+
+private:
+    static auto constexpr CACHE_SIZE = size_t{64};
 };
 
 }  // namespace postgres
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <postgres/PrepareData.h>
+#include <postgres/Statement.h>
+
+namespace postgres::internal {
+
+class Columns;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+// Statements prepared by the connections of several contexts, say of a client per tenant,
+// kept once per process rather than copied into every context and connection.
+// Descriptions of their results are taken by the first connection describing them
+// and shared with all the others, see Context::Builder::describePrepared().
+// Statements added later are prepared by the connections made afterwards.
+class StatementRegistry {
+public:
+    explicit StatementRegistry();
+    StatementRegistry(StatementRegistry const& other) = delete;
+    StatementRegistry& operator=(StatementRegistry const& other) = delete;
+    StatementRegistry(StatementRegistry&& other) = delete;
+    StatementRegistry& operator=(StatementRegistry&& other) = delete;
+    ~StatementRegistry() noexcept;
+
+    // Replaces the statement of the same name, if any.
+    StatementRegistry& add(PrepareData prep);
+
+    // Adds the statements of Statement<T>::prepareData() for each of the tables.
+    template <typename... Ts>
+    StatementRegistry& addTables() {
+        auto const add = [this](std::vector<PrepareData> preps) {
+            for (auto& prep : preps) {
+                this->add(std::move(prep));
+            }
+        };
+        (add(Statement<Ts>::prepareData()), ...);
+        return *this;
+    }
+
+    std::vector<std::shared_ptr<PrepareData const>> statements() const;
+    // Gives null if there is no such statement.
+    std::shared_ptr<PrepareData const> find(std::string_view name) const;
+    size_t size() const;
+
+private:
+    friend class Connection;
+
+    struct Entry {
+        std::shared_ptr<PrepareData const> prep;
+        std::shared_ptr<internal::Columns> cols;
+    };
+
+    // Gives null unless the statement is registered and described.
+    std::shared_ptr<internal::Columns> described(PrepareData const& prep) const;
+    // Keeps the first description of the registered statement, giving the one kept.
+    std::shared_ptr<internal::Columns> describe(PrepareData const& prep, std::shared_ptr<internal::Columns> cols);
+
+    mutable std::shared_mutex                  mtx_;
+    std::map<std::string, Entry, std::less<>> entries_;
+};
+
+}  // namespace postgres
@@ -4,6 +4,11 @@
 #include <libpq-fe.h>
 
 namespace postgres {
+namespace internal {
+
+class Budget;
+
+}  // namespace internal
 
 class Consumer;
 
@@ -30,14 +35,19 @@ public:
 protected:
     friend class Connection;
     friend class Consumer;
+    friend class CopyReader;
+    friend class CopyWriter;
+    friend class internal::Budget;
 
     explicit Status(PGresult* handle);
     explicit Status(PGresult* handle, Consumer*);
 
     void check() const;
 
+    std::shared_ptr<PGresult const> share() const;
+
 private:
-    std::unique_ptr<PGresult, void (*)(PGresult*)> handle_;
+    std::shared_ptr<PGresult> handle_;
 };
 
 }  // namespace postgres
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Classifier.h>
+#include <postgres/internal/Visitors.h>
+#include <postgres/Receiver.h>
+#include <postgres/Result.h>
+#include <postgres/Row.h>
+
+namespace postgres {
+
+// Decodes streamed rows one by one into the same instance of T.
+// Column indices of visitable types are looked up once per stream rather than per result.
+template <typename T>
+class Stream {
+public:
+    class iterator;
+
+    Stream(Stream const& other) = delete;
+    Stream& operator=(Stream const& other) = delete;
+    Stream(Stream&& other) noexcept = default;
+    Stream& operator=(Stream&& other) noexcept = default;
+    ~Stream() noexcept = default;
+
+    iterator begin() {
+        return iterator{*this, !next()};
+    }
+
+    iterator end() {
+        return iterator{*this, true};
+    }
+
+private:
+    friend class Connection;
+
+    explicit Stream(Receiver rec)
+        : rec_{std::move(rec)} {
+    }
+
+    bool next() {
+        while (!res_ || (res_->size() <= row_idx_)) {
+            auto res = rec_.receive();
+            if (res.isDone()) {
+                res_.reset();
+                return false;
+            }
+            if (res.isEmpty()) {
+                continue;
+            }
+
+            if constexpr (internal::isVisitable<T>()) {
+                if (cols_.empty()) {
+                    internal::ColumnsCollector coll{res.native()};
+                    T::visitPostgresDefinition(coll);
+                    cols_ = std::move(coll.res);
+                }
+            }
+            res_.emplace(std::move(res));
+            row_idx_ = 0;
+        }
+
+        auto row = Row{*res_->native(), row_idx_++, nullptr};
+        if constexpr (internal::isVisitable<T>()) {
+            Row::Cursor cur{row, cols_};
+            val_.visitPostgresFields(cur);
+        } else {
+            row >> val_;
+        }
+        return true;
+    }
+
+    Receiver                      rec_;
+    std::optional<Result>         res_;
+    int                           row_idx_ = 0;
+    std::vector<internal::Column> cols_;
+    T                             val_{};
+};
+
+template <typename T>
+class Stream<T>::iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = T const*;
+    using reference = T const&;
+
+    bool operator==(iterator const& other) const {
+        return (strm_ == other.strm_) && (is_done_ == other.is_done_);
+    }
+
+    bool operator!=(iterator const& other) const {
+        return !(*this == other);
+    }
+
+    void operator++() {
+        is_done_ = !strm_->next();
+    }
+
+    T const& operator*() const {
+        return strm_->val_;
+    }
+
+    T const* operator->() const {
+        return &strm_->val_;
+    }
+
+private:
+    friend class Stream;
+
+    explicit iterator(Stream& strm, bool const is_done)
+        : strm_{&strm}, is_done_{is_done} {
+    }
+
+    Stream* strm_;
+    bool    is_done_;
+};
+
+}  // namespace postgres
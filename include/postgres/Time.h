@@ -1,7 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace postgres {
 
@@ -9,25 +12,35 @@ class Time {
 public:
     using Clock = std::chrono::system_clock;
     using Point = Clock::time_point;
+    using Days  = std::chrono::duration<int32_t, std::ratio<86400>>;
+    using Date  = std::chrono::time_point<Clock, Days>;
 
     explicit Time();
     explicit Time(time_t uni, bool has_zone = false);
     explicit Time(Point pnt, bool has_zone = false);
-    explicit Time(std::string const& s);
+    explicit Time(std::string_view s);
     Time(Time const& other) noexcept;
     Time& operator=(Time const& other) noexcept;
     Time(Time&& other) noexcept;
     Time& operator=(Time&& other) noexcept;
     ~Time() noexcept;
 
+    // Parses the same formats as the constructor without throwing, reporting malformed input instead.
+    static bool parse(std::string_view s, Point& out);
+
     time_t toUnix() const;
     time_t toPostgres() const;
     std::string toString() const;
+    // Writes up to MAX_STRING_LEN characters without the terminator, returning their count.
+    size_t format(char* out) const;
     Point point() const;
     bool hasZone() const;
 
     // 2000-01-01 00:00:00
-    static auto constexpr EPOCH = Point{std::chrono::seconds{946684800}};
+    static auto constexpr EPOCH      = Point{std::chrono::seconds{946684800}};
+    static auto constexpr EPOCH_DATE = Date{Days{10957}};
+
+    static size_t constexpr MAX_STRING_LEN = 48;
 
 private:
     Point pnt_;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace postgres {
+
+// What a statement executed on a connection took, reported once its last result is received.
+struct Trace {
+    using Clock = std::chrono::steady_clock;
+
+    // Text of the statement, or the name of a prepared one.
+    std::string_view  statement;
+    bool              is_prepared = false;
+    int               params      = 0;
+    size_t            bytes       = 0;
+    Clock::time_point start{};
+    // Spent by the job running the statement in the queue of a pool, for its first statement only.
+    Clock::duration   wait{0};
+    // Till the first result is received, and till the last one.
+    Clock::duration   first{0};
+    Clock::duration   total{0};
+    int64_t           rows        = 0;
+    // SQLSTATE of the first error, empty on success.
+    std::string_view  code;
+};
+
+// Hook called by a connection for every statement it executes or sends, see Connection::trace().
+// Statements of pipelines, COPY and cursors are not traced.
+// The trace and its strings are only valid during the call, so an exporter has to copy what it keeps.
+class Tracer {
+public:
+    virtual ~Tracer() noexcept;
+
+    virtual void trace(Trace const& trace) = 0;
+};
+
+}  // namespace postgres
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <libpq-fe.h>
+#include <postgres/internal/Visitors.h>
+#include <postgres/Row.h>
+
+namespace postgres {
+
+template <typename T>
+class Tuples;
+
+// Decodes rows of a result into tuples of its leading columns,
+// which are matched against the element types once for the whole result.
+// Must not outlive the result.
+template <typename... Ts>
+class Tuples<std::tuple<Ts...>> {
+public:
+    class iterator;
+
+    iterator begin() const {
+        return iterator{*this, 0};
+    }
+
+    iterator end() const {
+        return iterator{*this, PQntuples(res_)};
+    }
+
+private:
+    friend class Result;
+
+    explicit Tuples(PGresult& res)
+        : res_{&res} {
+        Row::checkTuple(res, 0, sizeof... (Ts));
+        cols_ = internal::makeColumns<Ts...>(res_, 0);
+    }
+
+    std::tuple<Ts...> read(int const row_idx) const {
+        std::tuple<Ts...> val{};
+        Row{*res_, row_idx, nullptr}.readTuple(val, cols_.data(), std::index_sequence_for<Ts...>{});
+        return val;
+    }
+
+    PGresult*                                    res_;
+    std::array<internal::Column, sizeof... (Ts)> cols_{};
+};
+
+template <typename... Ts>
+class Tuples<std::tuple<Ts...>>::iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::tuple<Ts...>;
+    using pointer = value_type const*;
+    using reference = value_type;
+
+    bool operator==(iterator const& other) const {
+        return (tpls_ == other.tpls_) && (idx_ == other.idx_);
+    }
+
+    bool operator!=(iterator const& other) const {
+        return !(*this == other);
+    }
+
+    void operator++() {
+        ++idx_;
+    }
+
+    std::tuple<Ts...> operator*() const {
+        return tpls_->read(idx_);
+    }
+
+private:
+    friend class Tuples;
+
+    explicit iterator(Tuples const& tpls, int const idx)
+        : tpls_{&tpls}, idx_{idx} {
+    }
+
+    Tuples const* tpls_;
+    int           idx_;
+};
+
+}  // namespace postgres
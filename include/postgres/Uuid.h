@@ -0,0 +1,28 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace postgres {
+
+// Sent and received as 16 raw bytes rather than 36 characters of text.
+struct Uuid {
+    // Accepts the canonical form of 8-4-4-4-12 hexadecimal digits in either case.
+    static Uuid parse(std::string_view s);
+
+    std::string toString() const;
+
+    bool operator==(Uuid const& other) const {
+        return bytes == other.bytes;
+    }
+
+    bool operator!=(Uuid const& other) const {
+        return bytes != other.bytes;
+    }
+
+    std::array<uint8_t, 16> bytes{};
+};
+
+}  // namespace postgres
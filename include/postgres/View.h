@@ -0,0 +1,215 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <libpq-fe.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Visitors.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Time.h>
+
+namespace postgres::internal {
+
+// Column types a cell is allowed to be viewed from, and its decoding once they are checked.
+template <typename T>
+struct ViewCell {
+    static_assert(exactOid(static_cast<T*>(nullptr)) != InvalidOid, "Unexpected view cell type");
+
+    static bool accepts(Oid const oid) {
+        return oid == exactOid(static_cast<T*>(nullptr));
+    }
+
+    static T read(PGresult const& res, int const row_idx, int const col_idx) {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             !PQgetisnull(&res, row_idx, col_idx),
+                             "cannot store NULL value of column '"
+                                 << PQfname(&res, col_idx)
+                                 << "' into variable of non-optional type");
+
+        auto const data = PQgetvalue(&res, row_idx, col_idx);
+        if constexpr (std::is_same_v<T, bool>) {
+            return *data != 0;
+        } else if constexpr (std::is_same_v<T, Time::Point>) {
+            return Time::EPOCH + std::chrono::microseconds{orderBytes<int64_t>(data)};
+        } else {
+            return orderBytes<T>(data);
+        }
+    }
+};
+
+template <>
+struct ViewCell<std::string_view> {
+    static bool accepts(Oid const oid) {
+        return (oid == TEXTOID) || (oid == VARCHAROID) || (oid == BPCHAROID) || (oid == NAMEOID) || (oid == BYTEAOID);
+    }
+
+    static std::string_view read(PGresult const& res, int const row_idx, int const col_idx) {
+        return std::string_view{PQgetvalue(&res, row_idx, col_idx),
+                                static_cast<size_t>(PQgetlength(&res, row_idx, col_idx))};
+    }
+};
+
+template <typename T>
+struct ViewCell<std::optional<T>> {
+    static bool accepts(Oid const oid) {
+        return ViewCell<T>::accepts(oid);
+    }
+
+    static std::optional<T> read(PGresult const& res, int const row_idx, int const col_idx) {
+        if (PQgetisnull(&res, row_idx, col_idx)) {
+            return std::nullopt;
+        }
+        return ViewCell<T>::read(res, row_idx, col_idx);
+    }
+};
+
+// Types of cells a view can be made of.
+template <typename T>
+constexpr bool isViewable(T*) {
+    return exactOid(static_cast<T*>(nullptr)) != InvalidOid;
+}
+
+constexpr bool isViewable(std::string_view*) {
+    return true;
+}
+
+template <typename T>
+constexpr bool isViewable(std::optional<T>*) {
+    return isViewable(static_cast<T*>(nullptr));
+}
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+// Leading columns of a result, whose types and formats are checked against the given ones just once.
+// Their cells are then read right from the result without any type dispatch.
+// Only exactly matching binary types are accepted, as well as views of text and bytes.
+// Must not outlive the result.
+template <typename... Ts>
+class View {
+public:
+    class Cells;
+    class iterator;
+
+    int size() const {
+        return PQntuples(res_);
+    }
+
+    Cells operator[](int const row_idx) const {
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             (0 <= row_idx) && (row_idx < size()),
+                             "row index " << row_idx << " is out of range");
+        return Cells{*res_, row_idx};
+    }
+
+    iterator begin() const {
+        return iterator{*res_, 0};
+    }
+
+    iterator end() const {
+        return iterator{*res_, size()};
+    }
+
+private:
+    friend class Result;
+
+    explicit View(PGresult& res)
+        : res_{&res} {
+        check(std::index_sequence_for<Ts...>{});
+    }
+
+    template <size_t... Is>
+    void check(std::index_sequence<Is...>) const {
+        (checkColumn<Ts>(static_cast<int>(Is)), ...);
+    }
+
+    template <typename T>
+    void checkColumn(int const col_idx) const {
+        _POSTGRES_CXX_ASSERT(LogicError, col_idx < PQnfields(res_), "column " << col_idx << " does not exist");
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             (PQfformat(res_, col_idx) == 1) && internal::ViewCell<T>::accepts(PQftype(res_, col_idx)),
+                             "cannot view column '"
+                                 << PQfname(res_, col_idx)
+                                 << "' of type "
+                                 << PQftype(res_, col_idx)
+                                 << " as desired type");
+    }
+
+    PGresult* res_;
+};
+
+template <typename... Ts>
+class View<Ts...>::Cells {
+public:
+    template <size_t I>
+    std::tuple_element_t<I, std::tuple<Ts...>> get() const {
+        return internal::ViewCell<std::tuple_element_t<I, std::tuple<Ts...>>>::read(*res_,
+                                                                                  row_idx_,
+                                                                                  static_cast<int>(I));
+    }
+
+    std::tuple<Ts...> tuple() const {
+        return tuple(std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    friend class View;
+
+    explicit Cells(PGresult& res, int const row_idx)
+        : res_{&res}, row_idx_{row_idx} {
+    }
+
+    template <size_t... Is>
+    std::tuple<Ts...> tuple(std::index_sequence<Is...>) const {
+        return std::tuple<Ts...>{get<Is>()...};
+    }
+
+    PGresult* res_;
+    int       row_idx_;
+};
+
+template <typename... Ts>
+class View<Ts...>::iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Cells;
+    using pointer = Cells const*;
+    using reference = Cells;
+
+    bool operator==(iterator const& other) const {
+        return (res_ == other.res_) && (idx_ == other.idx_);
+    }
+
+    bool operator!=(iterator const& other) const {
+        return !(*this == other);
+    }
+
+    void operator++() {
+        ++idx_;
+    }
+
+    Cells operator*() const {
+        return Cells{*res_, idx_};
+    }
+
+private:
+    friend class View;
+
+    explicit iterator(PGresult& res, int const idx)
+        : res_{&res}, idx_{idx} {
+    }
+
+    PGresult* res_;
+    int       idx_;
+};
+
+}  // namespace postgres
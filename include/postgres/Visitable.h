@@ -398,7 +398,7 @@
     static auto constexpr _POSTGRES_CXX_VISITABLE = true; \
     static auto constexpr _POSTGRES_CXX_TABLE_NAME = name; \
     template <typename V> \
-    static void visitPostgresDefinition(V& visitor) { \
+    static constexpr void visitPostgresDefinition(V& visitor) { \
         _POSTGRES_CXX_VISIT(_POSTGRES_CXX_ACCEPT_DEF, __VA_ARGS__) \
     } \
     template <typename V> \
@@ -410,3 +410,6 @@
         _POSTGRES_CXX_VISIT(_POSTGRES_CXX_ACCEPT_FLD, __VA_ARGS__) \
     }
 
+// Declares the field rows are matched by when updated in bulk, see RangeStatement::update().
+#define POSTGRES_CXX_TABLE_KEY(field) \
+    static auto constexpr _POSTGRES_CXX_TABLE_KEY = #field
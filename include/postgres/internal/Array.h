@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <libpq-fe.h>
+
+namespace postgres::internal {
+
+// Type of one-dimensional arrays of the given elements, or zero if not supported.
+Oid arrayOid(Oid elem);
+Oid elementOid(Oid arr);
+
+// Walks over elements of a binary array, as sent by the server.
+// Only one-dimensional arrays are supported, but empty ones have no dimensions at all.
+class ArrayReader {
+public:
+    explicit ArrayReader(char const* data, int len);
+    ArrayReader(ArrayReader const& other) = delete;
+    ArrayReader& operator=(ArrayReader const& other) = delete;
+    ArrayReader(ArrayReader&& other) = delete;
+    ArrayReader& operator=(ArrayReader&& other) = delete;
+    ~ArrayReader() noexcept;
+
+    Oid type() const;
+    int size() const;
+
+    // Gives null value for NULL elements.
+    char const* next(int& len);
+
+private:
+    int32_t readInt();
+
+    char const*       pos_;
+    char const* const end_;
+    Oid               type_ = 0;
+    int               size_ = 0;
+};
+
+}  // namespace postgres::internal
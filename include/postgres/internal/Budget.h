@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <postgres/Context.h>
+
+namespace postgres {
+
+class Result;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Bytes held by the results of a pool which are still alive, as told by libpq.
+// A result over the budget either fails, or keeps its worker waiting until the earlier ones are gone.
+// A result larger than the whole budget is let through once nothing else is held, unless failing.
+class Budget : public std::enable_shared_from_this<Budget> {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    explicit Budget(size_t capacity, OverflowPolicy pol, Duration timeout);
+    Budget(Budget const& other) = delete;
+    Budget& operator=(Budget const& other) = delete;
+    Budget(Budget&& other) noexcept = delete;
+    Budget& operator=(Budget&& other) noexcept = delete;
+    ~Budget() noexcept;
+
+    // Charges the result to the budget of the job the calling thread runs, if any,
+    // until the result and all the views shared from it are gone.
+    static void charge(Result& res);
+
+    size_t used() const;
+
+    // Makes the budget the one of the calling thread while alive.
+    class Scope {
+    public:
+        explicit Scope(Budget& budget) noexcept;
+        Scope(Scope const& other) = delete;
+        Scope& operator=(Scope const& other) = delete;
+        Scope(Scope&& other) noexcept = delete;
+        Scope& operator=(Scope&& other) noexcept = delete;
+        ~Scope() noexcept;
+
+    private:
+        Budget* prev_;
+    };
+
+private:
+    void acquire(size_t bytes);
+    void release(size_t bytes);
+
+    size_t const            cap_;
+    OverflowPolicy const    pol_;
+    Duration const          timeout_;
+    mutable std::mutex      mtx_;
+    std::condition_variable room_;
+    size_t                  used_ = 0;
+};
+
+}  // namespace postgres::internal
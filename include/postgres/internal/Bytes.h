@@ -1,34 +1,83 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <utility>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <cstdlib>
+#endif
 
 namespace postgres::internal {
 
+// The network byte order is big endian.
+#if defined(__BYTE_ORDER__)
+bool constexpr IS_NET_ORDER = (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__);
+#else
+bool constexpr IS_NET_ORDER = false;
+#endif
+
+inline uint8_t swapBytes(uint8_t const val) {
+    return val;
+}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+inline uint16_t swapBytes(uint16_t const val) {
+    return _byteswap_ushort(val);
+}
+
+inline uint32_t swapBytes(uint32_t const val) {
+    return _byteswap_ulong(val);
+}
+
+inline uint64_t swapBytes(uint64_t const val) {
+    return _byteswap_uint64(val);
+}
+#else
+inline uint16_t swapBytes(uint16_t const val) {
+    return __builtin_bswap16(val);
+}
+
+inline uint32_t swapBytes(uint32_t const val) {
+    return __builtin_bswap32(val);
+}
+
+inline uint64_t swapBytes(uint64_t const val) {
+    return __builtin_bswap64(val);
+}
+#endif
+
+template <size_t LEN>
+using Word = std::conditional_t<LEN == 1, uint8_t,
+                                std::conditional_t<LEN == 2, uint16_t,
+                                                   std::conditional_t<LEN == 4, uint32_t, uint64_t>>>;
+
 template <typename T>
 T orderBytes(T val) {
-    union {
-        uint16_t value;
-        uint8_t  bytes[2];
-    } constexpr TEST = {0x0102};
-
-    auto constexpr    LEN   = sizeof(T);
-    static auto const is_ok = (LEN == 1) || (TEST.bytes[0] == 0x01);
-    if (is_ok) {
+    static_assert((sizeof(T) == 1) || (sizeof(T) == 2) || (sizeof(T) == 4) || (sizeof(T) == 8),
+                  "unsupported size");
+    if constexpr (IS_NET_ORDER || (sizeof(T) == 1)) {
+        return val;
+    } else {
+        Word<sizeof(T)> word;
+        std::memcpy(&word, &val, sizeof(T));
+        word = swapBytes(word);
+        std::memcpy(&val, &word, sizeof(T));
         return val;
     }
-
-    auto bytes = reinterpret_cast<uint8_t*>(&val);
-
-    for (auto i = 0u; i < LEN / 2; ++i) {
-        std::swap(bytes[i], bytes[LEN - 1 - i]);
-    }
-    return val;
 }
 
 template <typename T>
 T orderBytes(const char* const buf) {
-    return orderBytes(*(reinterpret_cast<const T*>(buf)));
+    // Values in a buffer are not necessarily aligned.
+    T val;
+    std::memcpy(&val, buf, sizeof(T));
+    return orderBytes(val);
 }
 
+// Reorders an array of values of size 2, 4 or 8 in place,
+// using the widest vector instructions supported by the CPU.
+void orderBytes(void* data, size_t count, size_t size);
+
 }  // namespace postgres::internal
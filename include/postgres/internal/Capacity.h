@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <postgres/Context.h>
+
+namespace postgres::internal {
+
+// Holds senders back from a full queue according to the overflow policy.
+// The queue keeps counting its jobs itself and tells when some are taken.
+class Capacity {
+public:
+    explicit Capacity(Context const& ctx);
+    Capacity(Capacity const& other) = delete;
+    Capacity& operator=(Capacity const& other) = delete;
+    Capacity(Capacity&& other) = delete;
+    Capacity& operator=(Capacity&& other) = delete;
+    ~Capacity() noexcept;
+
+    // Returns once there is room for one more job, or throws on overflow.
+    // Waiting is disabled for senders which are to free the room themselves.
+    void acquire(std::atomic<int> const& queued, bool may_wait);
+    // Wakes a sender waiting for room.
+    void release();
+    // Wakes all the waiting senders.
+    void releaseAll();
+
+private:
+    int const               lim_;
+    OverflowPolicy const    pol_;
+    Context::Duration const timeout_;
+
+    std::atomic<int>        waiters_;
+    std::mutex              mtx_;
+    std::condition_variable room_;
+};
+
+}  // namespace postgres::internal
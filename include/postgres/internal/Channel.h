@@ -1,11 +1,11 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
-#include <set>
 #include <vector>
 #include <postgres/internal/IChannel.h>
+#include <postgres/internal/Lanes.h>
 
 namespace postgres {
 
@@ -25,19 +25,31 @@ public:
     ~Channel() noexcept override;
 
     std::tuple<bool, Worker*> send(Job job) override;
+    std::tuple<bool, Worker*> send(Job job, Priority prio) override;
+    std::tuple<bool, Worker*> send(Job job, Priority prio, Affinity aff) override;
+    // Takes the lock once for the jobs, which fail when overflowing the queue instead of throwing.
+    // Waits for room only for the first job, since the jobs queued before it in the call are yet to get their workers.
+    std::vector<std::tuple<bool, Worker*>> send(std::vector<Job>& jobs, Priority prio) override;
     void receive(Slot& slot) override;
+    bool poll(Slot& slot) override;
     void recycle(Worker& worker) override;
+    void requeue(Job job) override;
     void drop() override;
     void quit(int count) override;
 
 private:
-    std::tuple<bool, Worker*> send(Job job, int lim);
+    // Prefers the idle worker the key maps to, if any.
+    std::tuple<bool, Worker*> dispatch(Job job, Priority prio, Affinity const* aff);
+    void reserve(std::unique_lock<std::mutex>& guard, int lim);
 
     std::shared_ptr<Context const> ctx_;
-    std::queue<Job>                queue_;
-    std::set<Slot*>                slots_;
+    Lanes                          queue_;
+    std::vector<Slot*>             slots_;
     std::vector<Worker*>           recreation_;
+    int                            quits_;
+    int                            ids_;
     std::mutex                     mtx_;
+    std::condition_variable        room_;
 };
 
 }  // namespace postgres::internal
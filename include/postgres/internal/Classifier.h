@@ -1,5 +1,9 @@
 #pragma once
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace postgres::internal {
 
 template <int N>
@@ -35,4 +39,31 @@ constexpr bool isVisitable() {
     return isTagged<T, VisitableTag>();
 }
 
+template <typename T>
+struct IsTuple : std::false_type {
+};
+
+template <typename... Ts>
+struct IsTuple<std::tuple<Ts...>> : std::true_type {
+};
+
+template <typename T>
+constexpr bool isTuple() {
+    return IsTuple<T>::value;
+}
+
+template <typename T, typename = void>
+struct IsComparable : std::false_type {
+};
+
+template <typename T>
+struct IsComparable<T, std::void_t<decltype(std::declval<T const&>() == std::declval<T const&>())>>
+    : std::true_type {
+};
+
+template <typename T>
+constexpr bool isComparable() {
+    return IsComparable<T>::value;
+}
+
 }  // namespace postgres::internal
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+#include <postgres/Context.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+class Connection;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Gathers small independent jobs to run them in a single transaction, so that they share a commit.
+// A batch hit by a failure is rolled back and replayed job by job, which requires the jobs be safe to run again.
+// Only one worker runs the batches at a time.
+class Coalescer {
+public:
+    struct Item {
+        std::function<Status(Connection&)> job;
+        std::promise<Status>               prom;
+    };
+
+    explicit Coalescer(Context::Duration window, int limit);
+    Coalescer(Coalescer const& other) = delete;
+    Coalescer& operator=(Coalescer const& other) = delete;
+    Coalescer(Coalescer&& other) noexcept = delete;
+    Coalescer& operator=(Coalescer&& other) noexcept = delete;
+    ~Coalescer() noexcept;
+
+    // Tells whether the item starts a new batch, which is up to the caller to schedule for run().
+    bool add(Item item);
+    // Keeps running batches until there are no items left, up to a cap and while the connection is fine.
+    // Tells whether the items left are still scheduled, for the caller to run them again.
+    bool run(Connection& conn);
+    void fail(std::exception_ptr const& err);
+
+private:
+    std::vector<Item> take();
+    static void runBatch(std::vector<Item>& batch, Connection& conn);
+    static void runAlone(Item& item, Connection& conn);
+
+    Context::Duration const window_;
+    size_t const            limit_;
+    std::mutex              mtx_;
+    std::condition_variable full_;
+    std::vector<Item>       items_;
+    bool                    is_scheduled_ = false;
+};
+
+}  // namespace postgres::internal
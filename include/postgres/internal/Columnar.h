@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <libpq-fe.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Oid.h>
+
+namespace postgres::internal {
+
+// Same conversions as for a single field: no mixing of integers and floating point numbers,
+// no narrowing, and no negative values stored as unsigned.
+template <typename In, typename Out>
+constexpr bool isCastable() {
+    return (std::is_integral_v<In> != std::is_floating_point_v<Out>) && (sizeof(In) <= sizeof(Out));
+}
+
+// Reads binary numbers of a column passing them to store(row, val) and NULLs to null(row).
+// Returns false if the type of the column doesn't fit.
+template <typename In, typename Out, typename Store, typename Null>
+bool readColumn(PGresult const& res, int const col, Store& store, Null& null) {
+    if constexpr (!isCastable<In, Out>()) {
+        return false;
+    } else {
+        auto const rows = PQntuples(&res);
+        for (auto row = 0; row < rows; ++row) {
+            if (PQgetisnull(&res, row, col) == 1) {
+                null(row);
+                continue;
+            }
+
+            auto const val = orderBytes<In>(PQgetvalue(&res, row, col));
+            if constexpr (std::is_unsigned_v<Out> && std::is_signed_v<In>) {
+                if (val < 0) {
+                    return false;
+                }
+            }
+            store(row, static_cast<Out>(val));
+        }
+        return true;
+    }
+}
+
+template <typename Out, typename Store, typename Null>
+bool readColumn(PGresult const& res, int const col, Store&& store, Null&& null) {
+    switch (PQftype(&res, col)) {
+        case BOOLOID: {
+            return readColumn<int8_t, Out>(res, col, store, null);
+        }
+        case INT2OID: {
+            return readColumn<int16_t, Out>(res, col, store, null);
+        }
+        case INT4OID: {
+            return readColumn<int32_t, Out>(res, col, store, null);
+        }
+        case INT8OID: {
+            return readColumn<int64_t, Out>(res, col, store, null);
+        }
+        case FLOAT4OID: {
+            return readColumn<float, Out>(res, col, store, null);
+        }
+        case FLOAT8OID: {
+            return readColumn<double, Out>(res, col, store, null);
+        }
+        default: {
+            break;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+constexpr Oid nativeOid() {
+    if constexpr (std::is_same_v<T, int16_t>) {
+        return INT2OID;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return INT4OID;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return INT8OID;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return FLOAT4OID;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return FLOAT8OID;
+    } else {
+        return InvalidOid;
+    }
+}
+
+// Type of arithmetic values sent in binary, shared by commands and the statements prepared for them.
+template <typename T>
+constexpr Oid arithmeticOid() {
+    auto constexpr LEN = sizeof(T);
+    static_assert(LEN <= 8, "Unexpected arithmetic argument type length");
+
+    if (std::is_same_v<T, bool>) {
+        return BOOLOID;
+    }
+    if (std::is_integral_v<T>) {
+        return ((Oid[]) {INT2OID, INT4OID, INT8OID})[LEN / 4];
+    }
+    if (std::is_floating_point_v<T>) {
+        return ((Oid[]) {UNKNOWNOID, FLOAT4OID, FLOAT8OID})[LEN / 4];
+    }
+    return UNKNOWNOID;
+}
+
+// Reads a column into a contiguous array, leaving elements of NULLs untouched.
+// Values of the exactly matching type are copied as they are and reordered in bulk afterwards.
+template <typename Out, typename Null>
+bool readDense(PGresult const& res, int const col, Out* const out, Null&& null) {
+    if (PQftype(&res, col) != nativeOid<Out>()) {
+        return readColumn<Out>(res, col, [out](int const row, Out const val) {
+            out[row] = val;
+        }, null);
+    }
+
+    auto const rows = PQntuples(&res);
+    for (auto row = 0; row < rows; ++row) {
+        if (PQgetisnull(&res, row, col) == 1) {
+            null(row);
+            continue;
+        }
+        std::memcpy(out + row, PQgetvalue(&res, row, col), sizeof(Out));
+    }
+    orderBytes(out, static_cast<size_t>(rows), sizeof(Out));
+    return true;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/internal/Visitors.h>
+
+namespace postgres::internal {
+
+template <typename T>
+inline char const TYPE_KEY = 0;
+
+// Maps fields of visitable types to column indices of a result,
+// so that its rows are decoded without looking the columns up by name.
+class Columns {
+public:
+    explicit Columns(PGresult const& res);
+    // Layout of the results of a prepared statement received in the given format, taken from its description.
+    explicit Columns(PGresult const& desc, int format);
+    Columns(Columns const& other) = delete;
+    Columns& operator=(Columns const& other) = delete;
+    Columns(Columns&& other) = delete;
+    Columns& operator=(Columns&& other) = delete;
+    ~Columns() noexcept;
+
+    template <typename T>
+    std::vector<Column> const& get() {
+        std::lock_guard lock{mtx_};
+        for (auto const& [key, cols] : cache_) {
+            if (key == &TYPE_KEY<T>) {
+                return cols;
+            }
+        }
+
+        ColumnsCollector coll{res_};
+        T::visitPostgresDefinition(coll);
+        return cache_.emplace_back(&TYPE_KEY<T>, std::move(coll.res)).second;
+    }
+
+    // Tells whether the result has the same columns, so that the mapping applies to it too.
+    bool matches(PGresult const& res) const;
+
+private:
+    struct Clear {
+        void operator()(PGresult* const res) const noexcept {
+            PQclear(res);
+        }
+    };
+
+    std::unique_ptr<PGresult, Clear> own_;
+    PGresult const* const            res_;
+
+    std::mutex                                             mtx_;
+    std::deque<std::pair<void const*, std::vector<Column>>> cache_;
+};
+
+}  // namespace postgres::internal
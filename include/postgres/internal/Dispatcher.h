@@ -1,21 +1,34 @@
 #pragma once
 
-#include <functional>
+#include <exception>
 #include <future>
 #include <memory>
 #include <utility>
+#include <type_traits>
 #include <vector>
+#include <postgres/internal/Budget.h>
+#include <postgres/internal/Coalescer.h>
 #include <postgres/internal/IChannel.h>
+#include <postgres/internal/Pool.h>
+#include <postgres/internal/Watchdog.h>
+#include <postgres/Affinity.h>
+#include <postgres/Metrics.h>
+#include <postgres/Priority.h>
 
 namespace postgres {
 
 class Connection;
 class Context;
+class Result;
 
 }  // namespace postgres
 
 namespace postgres::internal {
 
+class Limiter;
+class Reporter;
+class Stats;
+class Throttle;
 class Worker;
 
 class Dispatcher {
@@ -27,22 +40,170 @@ public:
     Dispatcher& operator=(Dispatcher&& other) noexcept = delete;
     ~Dispatcher() noexcept;
 
-    template <typename T>
-    std::future<T> send(std::function<T(Connection&)> job) {
-        auto task = std::make_shared<std::packaged_task<T(Connection&)>>(std::move(job));
-        scale(chan_->send([task](Connection& conn) {
-            (*task)(conn);
-        }));
-        return task->get_future();
+    template <typename T, typename F>
+    std::future<T> send(F&& job, Priority const prio = Priority::NORMAL) {
+        std::promise<T> prom{std::allocator_arg, PoolAllocator<char>{}};
+        auto            res = prom.get_future();
+        scale(chan_->send(Task<T, std::decay_t<F>>{std::forward<F>(job), std::move(prom)}, prio));
+        return res;
     }
 
+    template <typename T, typename F>
+    std::future<T> send(F&& job, Affinity const aff, Priority const prio) {
+        std::promise<T> prom{std::allocator_arg, PoolAllocator<char>{}};
+        auto            res = prom.get_future();
+        scale(chan_->send(Task<T, std::decay_t<F>>{std::forward<F>(job), std::move(prom)}, prio, aff));
+        return res;
+    }
+
+    // An expired job is not run, and a running one is cancelled on the deadline.
+    template <typename T, typename F>
+    std::future<T> send(F&& job, Watchdog::Deadline const deadline, Priority const prio) {
+        if (!dog_) {
+            dog_ = std::make_unique<Watchdog>();
+        }
+
+        std::promise<T> prom{std::allocator_arg, PoolAllocator<char>{}};
+        auto            res = prom.get_future();
+        scale(chan_->send(TimedTask<T, std::decay_t<F>>{std::forward<F>(job),
+                                                        std::move(prom),
+                                                        deadline,
+                                                        dog_.get()}, prio));
+        return res;
+    }
+
+    // Sends the jobs of the range in one go, so that the queue is taken just once.
+    template <typename T, typename Iter>
+    std::vector<std::future<T>> sendBatch(Iter beg, Iter const end, Priority const prio) {
+        using F = std::decay_t<decltype(*beg)>;
+
+        std::vector<std::future<T>> res{};
+        std::vector<Job>            jobs{};
+        for (; beg != end; ++beg) {
+            std::promise<T> prom{std::allocator_arg, PoolAllocator<char>{}};
+            res.push_back(prom.get_future());
+            jobs.emplace_back(Task<T, F>{*beg, std::move(prom)});
+        }
+        while (!jobs.empty()) {
+            for (auto const& params : chan_->send(jobs, prio)) {
+                scale(params);
+            }
+        }
+        return res;
+    }
+
+    template <typename F>
+    std::future<Status> coalesce(F&& job) {
+        std::promise<Status> prom{std::allocator_arg, PoolAllocator<char>{}};
+        auto                 res = prom.get_future();
+        if (coal_->add(Coalescer::Item{std::forward<F>(job), std::move(prom)})) {
+            post(Flush{coal_.get(), chan_.get()});
+        }
+        return res;
+    }
+
+    // Sends a job which reports its result by itself,
+    // including a failure to connect if the job has a fail(std::exception_ptr const&) method.
+    template <typename F>
+    void post(F&& job, Priority const prio = Priority::NORMAL) {
+        scale(chan_->send(std::forward<F>(job), prio));
+    }
+
+    Metrics metrics() const;
+
 private:
+    template <typename T, typename F>
+    struct Task {
+        void operator()(Connection& conn) {
+            fulfil(prom, job, conn);
+        }
+
+        void fail(std::exception_ptr const& err) {
+            prom.set_exception(err);
+        }
+
+        F               job;
+        std::promise<T> prom;
+    };
+
+    template <typename T, typename F>
+    struct TimedTask {
+        void operator()(Connection& conn) {
+            try {
+                auto const watch = dog->watch(conn, deadline);
+                fulfil(prom, job, conn);
+            } catch (...) {
+                prom.set_exception(std::current_exception());
+            }
+        }
+
+        void fail(std::exception_ptr const& err) {
+            prom.set_exception(err);
+        }
+
+        F                  job;
+        std::promise<T>    prom;
+        Watchdog::Deadline deadline;
+        Watchdog*          dog;
+    };
+
+    struct Flush {
+        // Gives the items left back to the channel, so that other jobs and workers get their turn.
+        void operator()(Connection& conn) {
+            if (coal->run(conn)) {
+                chan->requeue(Flush{coal, chan});
+            }
+        }
+
+        void fail(std::exception_ptr const& err) {
+            coal->fail(err);
+        }
+
+        Coalescer* coal;
+        IChannel*  chan;
+    };
+
+    template <typename T, typename F>
+    static void fulfil(std::promise<T>& prom, F& job, Connection& conn) {
+        try {
+            if constexpr (std::is_same_v<T, Result>) {
+                auto res = job(conn);
+                Budget::charge(res);
+                prom.set_value(std::move(res));
+            } else {
+                prom.set_value(job(conn));
+            }
+        } catch (...) {
+            prom.set_exception(std::current_exception());
+        }
+    }
+
+    template <typename F>
+    static void fulfil(std::promise<void>& prom, F& job, Connection& conn) {
+        try {
+            job(conn);
+            prom.set_value();
+        } catch (...) {
+            prom.set_exception(std::current_exception());
+        }
+    }
+
+    void warmUp();
     void scale(std::tuple<bool, Worker*> params);
     int size() const;
 
     std::shared_ptr<Context const>       ctx_;
     std::shared_ptr<IChannel>            chan_;
+    std::shared_ptr<Limiter>             lim_;
+    std::shared_ptr<Stats>               stats_;
+    std::shared_ptr<Budget>              budget_;
+    std::shared_ptr<Throttle>            throttle_;
+    std::unique_ptr<Watchdog>            dog_;
+    // Outlives the workers, which may be running its batches.
+    std::unique_ptr<Coalescer>           coal_;
     std::vector<std::unique_ptr<Worker>> workers_;
+    // Stops reporting before the workers are gone.
+    std::unique_ptr<Reporter>            reporter_;
 };
 
 }  // namespace postgres::internal
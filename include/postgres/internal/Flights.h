@@ -0,0 +1,44 @@
+#pragma once
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+class Command;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Lets identical commands sent while one of them is running share its result.
+class Flights {
+public:
+    using Key = std::string;
+
+    explicit Flights();
+    Flights(Flights const& other) = delete;
+    Flights& operator=(Flights const& other) = delete;
+    Flights(Flights&& other) noexcept = delete;
+    Flights& operator=(Flights&& other) noexcept = delete;
+    ~Flights() noexcept;
+
+    // The statement along with the types, formats and bytes of all the arguments.
+    static Key keyOf(Command const& cmd);
+
+    // Returns the flight already running with the key, or registers the given one,
+    // telling which is the case.
+    std::pair<std::shared_future<Result>, bool> join(Key const& key, std::shared_future<Result> const& flight);
+    // Makes the next command with the key take off anew.
+    void land(Key const& key);
+
+private:
+    std::mutex                                          mtx_;
+    std::unordered_map<Key, std::shared_future<Result>> flights_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace postgres::internal {
+
+// Times jobs to tell when one has been running for too long, and schedules their hedges.
+// A single thread waits for the nearest one.
+class Hedger {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Deadline = Clock::time_point;
+
+    explicit Hedger(double quantile);
+    Hedger(Hedger const& other) = delete;
+    Hedger& operator=(Hedger const& other) = delete;
+    Hedger(Hedger&& other) = delete;
+    Hedger& operator=(Hedger&& other) = delete;
+    ~Hedger() noexcept;
+
+    // The quantile of recent job durations, or nothing until enough of them are timed.
+    std::optional<std::chrono::microseconds> delay() const;
+    void record(Clock::duration took);
+    // Pending calls are dropped on destruction.
+    void schedule(Deadline deadline, std::function<void()> call);
+    // Drops the pending calls and waits for the running one, if any.
+    void stop();
+
+private:
+    using Key = std::pair<Deadline, uint64_t>;
+
+    static size_t constexpr SAMPLES = 128;
+    static size_t constexpr REFRESH = 16;
+
+    void run();
+
+    double const                         quantile_;
+    std::mutex                           mtx_;
+    std::array<int64_t, SAMPLES>         samples_{};
+    size_t                               count_ = 0;
+    std::atomic<int64_t>                 delay_{-1};
+    std::condition_variable              signal_;
+    std::map<Key, std::function<void()>> calls_;
+    uint64_t                             next_    = 0;
+    bool                                 is_done_ = false;
+    std::thread                          thread_;
+};
+
+}  // namespace postgres::internal
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <tuple>
+#include <vector>
 #include <postgres/internal/Job.h>
+#include <postgres/Affinity.h>
+#include <postgres/Priority.h>
 
 namespace postgres::internal {
 
@@ -13,8 +16,21 @@ public:
 
     virtual void quit(int count) = 0;
     virtual std::tuple<bool, Worker*> send(Job job) = 0;
+    // Channels without priority lanes ignore the priority.
+    virtual std::tuple<bool, Worker*> send(Job job, Priority prio);
+    // Channels without affinity ignore the key.
+    virtual std::tuple<bool, Worker*> send(Job job, Priority prio, Affinity aff);
+    // Same as sending the jobs one by one, which channels may do at once.
+    // Takes the jobs from the front, and may leave the rest once one of them is to wait for room in the queue.
+    virtual std::vector<std::tuple<bool, Worker*>> send(std::vector<Job>& jobs, Priority prio);
     virtual void receive(Slot& slot) = 0;
+    // Same as receive() but doesn't wait, meant for a worker which is going to quit.
+    virtual bool poll(Slot& slot) = 0;
     virtual void recycle(Worker& worker) = 0;
+    // Gives back a job taken by a worker, to be taken soon by a running one.
+    // Channels let it past the limit of the queue where they can, since it has been admitted once.
+    // No worker is started for it, so the worker giving it back must keep running.
+    virtual void requeue(Job job);
     virtual void drop() = 0;
 };
 
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <exception>
 #include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <postgres/internal/Pool.h>
 
 namespace postgres {
 
@@ -12,12 +18,148 @@ class Connection;
 
 namespace postgres::internal {
 
-using Job = std::function<void(Connection&)>;
+// Move-only callable similar to std::function<void(Connection&)>.
+// Small callables are stored in place, larger ones in pooled memory,
+// so that submitting a job does not hit the heap in a steady state.
+class Job {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Job() noexcept;
+    Job(std::nullptr_t) noexcept;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Job>>>
+    Job(F&& fn) {
+        using T = std::decay_t<F>;
+        if constexpr (isInline<T>()) {
+            new (&buf_) T(std::forward<F>(fn));
+            ops_ = &INLINE_OPS<T>;
+        } else {
+            auto const ptr = PoolAllocator<T>{}.allocate(1);
+            new (ptr) T(std::forward<F>(fn));
+            new (&buf_) T*(ptr);
+            ops_ = &POOLED_OPS<T>;
+        }
+    }
+
+    Job(Job const& other) = delete;
+    Job& operator=(Job const& other) = delete;
+    Job(Job&& other) noexcept;
+    Job& operator=(Job&& other) noexcept;
+    Job& operator=(std::nullptr_t) noexcept;
+    ~Job() noexcept;
+
+    explicit operator bool() const noexcept;
+    void operator()(Connection& conn) const;
+
+    // Reports that the job is not going to run,
+    // provided the callable has a fail(std::exception_ptr const&) method.
+    void fail(std::exception_ptr const& err) const;
+    void swap(Job& other) noexcept;
+    // Marks the time the job is queued, so that jobs handed to idle workers right away don't read the clock.
+    void stamp() noexcept;
+    // Time spent in the queue until the given moment, zero for a job never queued.
+    Clock::duration waited(Clock::time_point now) const noexcept;
+    // Bytes of the callable stored in pooled memory, zero when stored in place.
+    size_t pooledSize() const noexcept;
+
+    template <typename T>
+    T* target() const noexcept {
+        if (ops_ == &INLINE_OPS<T>) {
+            return reinterpret_cast<T*>(const_cast<Storage*>(&buf_));
+        }
+        if (ops_ == &POOLED_OPS<T>) {
+            return *reinterpret_cast<T* const*>(&buf_);
+        }
+        return nullptr;
+    }
+
+private:
+    static auto constexpr SIZE = size_t{64};
+
+    using Storage = std::aligned_storage_t<SIZE, alignof(std::max_align_t)>;
+
+    struct Ops {
+        void (* call)(void* buf, Connection& conn);
+        void (* fail)(void* buf, std::exception_ptr const& err);
+        void (* move)(void* from, void* to) noexcept;
+        void (* destroy)(void* buf) noexcept;
+        size_t pooled;
+    };
+
+    template <typename T, typename = void>
+    struct CanFail : std::false_type {
+    };
+
+    template <typename T>
+    struct CanFail<T, std::void_t<decltype(std::declval<T&>().fail(std::exception_ptr{}))>>
+        : std::true_type {
+    };
+
+    template <typename T>
+    static void doFail(T& fn, std::exception_ptr const& err) {
+        if constexpr (CanFail<T>::value) {
+            fn.fail(err);
+        }
+    }
+
+    template <typename T>
+    static constexpr bool isInline() {
+        return (sizeof(T) <= SIZE)
+               && (alignof(T) <= alignof(std::max_align_t))
+               && std::is_nothrow_move_constructible_v<T>;
+    }
+
+    template <typename T>
+    static inline Ops const INLINE_OPS{
+        [](void* const buf, Connection& conn) {
+            (*static_cast<T*>(buf))(conn);
+        },
+        [](void* const buf, std::exception_ptr const& err) {
+            doFail(*static_cast<T*>(buf), err);
+        },
+        [](void* const from, void* const to) noexcept {
+            new (to) T(std::move(*static_cast<T*>(from)));
+            static_cast<T*>(from)->~T();
+        },
+        [](void* const buf) noexcept {
+            static_cast<T*>(buf)->~T();
+        },
+        0,
+    };
+
+    template <typename T>
+    static inline Ops const POOLED_OPS{
+        [](void* const buf, Connection& conn) {
+            (**static_cast<T**>(buf))(conn);
+        },
+        [](void* const buf, std::exception_ptr const& err) {
+            doFail(**static_cast<T**>(buf), err);
+        },
+        [](void* const from, void* const to) noexcept {
+            new (to) T*(*static_cast<T**>(from));
+        },
+        [](void* const buf) noexcept {
+            auto const ptr = *static_cast<T**>(buf);
+            ptr->~T();
+            PoolAllocator<T>{}.deallocate(ptr, 1);
+        },
+        sizeof(T),
+    };
+
+    Storage           buf_;
+    Ops const*        ops_ = nullptr;
+    Clock::time_point queued_{};
+};
 
 struct Slot {
     Job                     job;
     std::condition_variable signal;
     std::mutex              mtx;
+    bool                    is_woken = false;
+    bool                    is_persistent = false;
+    // Assigned by channels routing jobs by affinity.
+    int                     id = -1;
 };
 
 }  // namespace postgres::internal
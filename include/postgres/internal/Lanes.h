@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <queue>
+#include <postgres/internal/Job.h>
+#include <postgres/Priority.h>
+
+namespace postgres::internal {
+
+// Job queue with a lane per priority.
+// Lanes are served in weighted round robin, so that low priority jobs are delayed but not starved,
+// or strictly in order of priority.
+class Lanes {
+public:
+    explicit Lanes(bool is_strict);
+    Lanes(Lanes const& other) = delete;
+    Lanes& operator=(Lanes const& other) = delete;
+    Lanes(Lanes&& other) noexcept = delete;
+    Lanes& operator=(Lanes&& other) noexcept = delete;
+    ~Lanes() noexcept;
+
+    bool empty() const;
+    size_t size() const;
+    void push(Job job, Priority prio);
+    // Swaps the next job with the given one, the lanes must not be empty.
+    void pop(Job& job);
+    void clear();
+
+private:
+    static auto constexpr COUNT = size_t{3};
+
+    // Number of jobs taken from a lane per round.
+    static constexpr std::array<int, COUNT> WEIGHTS{4, 2, 1};
+
+    bool const                         is_strict_;
+    std::array<std::queue<Job>, COUNT> queues_;
+    std::array<int, COUNT>             credits_;
+    size_t                             size_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace postgres::internal {
+
+// Adaptive concurrency limit driven by the latency of executed jobs.
+// The limit grows by one while the latency stays near the lowest one observed,
+// and shrinks multiplicatively once the database starts to queue requests.
+class Limiter {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    explicit Limiter(int min, int max);
+    Limiter(Limiter const& other) = delete;
+    Limiter& operator=(Limiter const& other) = delete;
+    Limiter(Limiter&& other) = delete;
+    Limiter& operator=(Limiter&& other) = delete;
+    ~Limiter() noexcept;
+
+    int limit() const;
+    int running() const;
+
+    // Tells whether one more worker is allowed to run.
+    bool allows() const;
+    void enter();
+    void leave();
+    // Leaves if the limit is exceeded.
+    bool keep();
+    void record(Duration latency);
+
+private:
+    // Latency tolerated relative to the baseline one before backing off.
+    static auto constexpr TOLERANCE = 2;
+
+    int const min_;
+    int const max_;
+
+    std::atomic<int> limit_;
+    std::atomic<int> running_;
+
+    std::mutex mtx_;
+    Duration   base_;
+    Duration   sum_;
+    int        count_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <postgres/Decimal.h>
+
+namespace postgres::internal {
+
+// Binary NUMERIC consists of the count of base 10000 digits, the weight of the first one,
+// sign and display scale, followed by the digits themselves.
+// Values of Decimal never take more than that, since int64 holds up to 19 decimal digits.
+inline size_t constexpr NUMERIC_MAX_LEN = 8 + 2 * 10;
+
+// Rejects NaN, infinities and numbers not fitting into int64 at their display scale.
+Decimal readNumeric(char const* data, int len);
+
+// Returns the count of bytes written.
+size_t writeNumeric(Decimal val, char* out);
+
+}  // namespace postgres::internal
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <functional>
+
+namespace postgres::internal {
+
+// Splits the range [0, size) into contiguous parts processed by up to the given number of threads,
+// the calling one included. Parts are never smaller than the grain, so small ranges stay on one thread.
+// The first exception thrown by any part is rethrown once all of them are finished.
+void parallelFor(int size, int threads, int grain, std::function<void(int beg, int end)> const& f);
+
+}  // namespace postgres::internal
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/Change.h>
+
+namespace postgres::internal {
+
+// Decodes the messages of the pgoutput plugin, keeping the relations the server describes
+// before sending their first changes.
+class Pgoutput {
+public:
+    explicit Pgoutput();
+    Pgoutput(Pgoutput const& other) = delete;
+    Pgoutput& operator=(Pgoutput const& other) = delete;
+    Pgoutput(Pgoutput&& other) noexcept;
+    Pgoutput& operator=(Pgoutput&& other) noexcept;
+    ~Pgoutput() noexcept;
+
+    // Appends the changes carried by a message at the given position of the log, if any.
+    void decode(char const* data, size_t len, uint64_t lsn, std::deque<Change>& out);
+
+private:
+    struct Relation {
+        std::string              schema;
+        std::string              table;
+        std::vector<std::string> names;
+        std::vector<Oid>         types;
+    };
+
+    class Reader;
+
+    void describe(Reader& rd);
+    Relation const& relation(Oid id) const;
+    static Result tuple(Reader& rd, Relation const& rel);
+
+    std::unordered_map<Oid, Relation> rels_;
+};
+
+}  // namespace postgres::internal
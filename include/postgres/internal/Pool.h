@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace postgres::internal {
+
+// Recycles small memory blocks on the thread releasing them,
+// so that a steady flow of equally sized allocations does not reach the heap.
+class Pool {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size) noexcept;
+};
+
+template <typename T>
+struct PoolAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const&) noexcept {
+    }
+
+    T* allocate(size_t const count) {
+        return static_cast<T*>(Pool::allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* const ptr, size_t const count) noexcept {
+        Pool::deallocate(ptr, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(PoolAllocator<U> const&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(PoolAllocator<U> const&) const noexcept {
+        return false;
+    }
+};
+
+}  // namespace postgres::internal
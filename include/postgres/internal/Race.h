@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <libpq-fe.h>
+#include <postgres/Result.h>
+
+namespace postgres::internal {
+
+// Shared by the attempts of a hedged job: the first one to finish sets the result
+// and cancels the other one on the server.
+class Race {
+public:
+    static int constexpr ATTEMPTS = 2;
+
+    explicit Race();
+    Race(Race const& other) = delete;
+    Race& operator=(Race const& other) = delete;
+    Race(Race&& other) = delete;
+    Race& operator=(Race&& other) = delete;
+    ~Race() noexcept;
+
+    std::future<Result> future();
+    bool isOver();
+
+    // Makes the attempt cancellable until it leaves, unless the race is already over.
+    bool enter(int attempt, PGconn& conn);
+    void leave(int attempt);
+
+    // Tell whether the attempt has won.
+    bool finish(Result res);
+    bool finish(std::exception_ptr const& err);
+
+private:
+    // Takes the handles of the other attempts over for cancel().
+    bool win();
+    // Sends the cancel requests without holding the lock, as they wait for the server.
+    void cancel();
+
+    std::mutex              mtx_;
+    std::condition_variable cancelled_;
+    std::promise<Result>    prom_;
+    PGcancel*               cancels_[ATTEMPTS]{};
+    PGcancel*               cancelling_[ATTEMPTS]{};
+    bool                    is_over_ = false;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <postgres/internal/Pool.h>
+#include <postgres/Command.h>
+#include <postgres/Priority.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/Result.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+class Context;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Runs commands on a fixed set of event loop threads, each driving its share of the connections
+// in non-blocking mode, instead of a thread per connection blocking in libpq.
+class Reactor {
+public:
+    explicit Reactor(std::shared_ptr<Context const> ctx);
+    Reactor(Reactor const& other) = delete;
+    Reactor& operator=(Reactor const& other) = delete;
+    Reactor(Reactor&& other) noexcept = delete;
+    Reactor& operator=(Reactor&& other) noexcept = delete;
+    ~Reactor() noexcept;
+
+    template <typename T, typename C>
+    std::future<T> send(C cmd, Priority const prio) {
+        std::promise<T> prom{std::allocator_arg, PoolAllocator<char>{}};
+        auto            res = prom.get_future();
+        submit(Request{std::move(cmd), std::move(prom)}, prio);
+        return res;
+    }
+
+private:
+    class Loop;
+
+    struct Request {
+        std::variant<Command, PreparedCommand>                   cmd;
+        std::variant<std::promise<Status>, std::promise<Result>> prom;
+    };
+
+    void submit(Request req, Priority prio);
+
+    std::shared_ptr<Context const>     ctx_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::atomic<size_t>                next_{0};
+};
+
+}  // namespace postgres::internal
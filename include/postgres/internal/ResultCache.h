@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <postgres/Result.h>
+
+namespace postgres::internal {
+
+// Keeps results of commands for a while, evicting the least recently used ones
+// once their total size exceeds the capacity.
+class ResultCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Key   = std::string;
+
+    explicit ResultCache(Clock::duration ttl, size_t capacity);
+    ResultCache(ResultCache const& other) = delete;
+    ResultCache& operator=(ResultCache const& other) = delete;
+    ResultCache(ResultCache&& other) noexcept = delete;
+    ResultCache& operator=(ResultCache&& other) noexcept = delete;
+    ~ResultCache() noexcept;
+
+    // Approximate memory taken by the result.
+    static size_t sizeOf(Result const& res);
+
+    std::optional<std::shared_future<Result>> find(Key const& key);
+    // Results obtained before the last clear() are discarded, as they may be stale.
+    void insert(Key const& key, std::shared_future<Result> res, uint64_t gen);
+    void clear();
+    uint64_t generation();
+
+private:
+    struct Entry {
+        std::shared_future<Result> res;
+        Clock::time_point          expiry;
+        size_t                     size;
+        std::list<Key>::iterator   use;
+    };
+
+    void erase(std::unordered_map<Key, Entry>::iterator it);
+
+    Clock::duration const          ttl_;
+    size_t const                   capacity_;
+    std::mutex                     mtx_;
+    std::unordered_map<Key, Entry> entries_;
+    std::list<Key>                 uses_;
+    size_t                         used_ = 0;
+    uint64_t                       gen_  = 0;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <postgres/internal/Capacity.h>
+#include <postgres/internal/IChannel.h>
+
+namespace postgres {
+
+class Context;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Spreads jobs over several queues with their own locks,
+// so that concurrent senders and workers rarely contend with each other.
+// Workers take jobs from every queue before waiting for new ones.
+class ShardedChannel : public IChannel {
+public:
+    explicit ShardedChannel(std::shared_ptr<Context const> ctx);
+    ShardedChannel(ShardedChannel const& other) = delete;
+    ShardedChannel& operator=(ShardedChannel const& other) = delete;
+    ShardedChannel(ShardedChannel&& other) noexcept = delete;
+    ShardedChannel& operator=(ShardedChannel&& other) noexcept = delete;
+    ~ShardedChannel() noexcept override;
+
+    std::tuple<bool, Worker*> send(Job job) override;
+    void receive(Slot& slot) override;
+    bool poll(Slot& slot) override;
+    void recycle(Worker& worker) override;
+    void requeue(Job job) override;
+    void drop() override;
+    void quit(int count) override;
+
+private:
+    struct alignas(64) Shard {
+        std::deque<Job>    queue;
+        std::vector<Slot*> slots;
+        std::mutex         mtx;
+    };
+
+    bool take(Slot& slot, size_t idx);
+    bool wake(size_t idx);
+    bool wait(Slot& slot, size_t idx);
+    bool forget(Slot& slot, size_t idx);
+    bool isPending() const;
+
+    std::shared_ptr<Context const> ctx_;
+    std::vector<Shard>             shards_;
+    std::atomic<int>               queued_;
+    Capacity                       room_;
+    std::atomic<int>               idle_;
+    std::atomic<int>               quits_;
+    std::vector<Worker*>           recreation_;
+    std::mutex                     mtx_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <libpq-fe.h>
+#include <postgres/Tracer.h>
+
+namespace postgres {
+
+class Command;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Collects the trace of a statement from its results, and hands it over to the tracer.
+class Span {
+public:
+    // Sets the queue wait of the job the calling thread is about to run, taken by its first span.
+    static void queued(Trace::Clock::duration wait);
+
+    explicit Span(std::shared_ptr<Tracer> tracer, std::string stmt);
+    explicit Span(std::shared_ptr<Tracer> tracer, Command const& cmd, bool is_prepared);
+    Span(Span const& other) = delete;
+    Span& operator=(Span const& other) = delete;
+    Span(Span&& other) noexcept = delete;
+    Span& operator=(Span&& other) noexcept = delete;
+    ~Span() noexcept;
+
+    void add(PGresult const* res);
+    void finish();
+
+private:
+    std::shared_ptr<Tracer> tracer_;
+    std::string             stmt_;
+    std::string             code_;
+    Trace                   trace_;
+    bool                    is_first_ = true;
+};
+
+}  // namespace postgres::internal
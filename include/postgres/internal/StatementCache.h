@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace postgres::internal {
+
+// Bounded LRU of statements executed by a connection,
+// which tells when a statement is worth preparing and gives it a server-side name.
+class StatementCache {
+public:
+    struct Entry {
+        std::string key;
+        std::string name;
+        int         uses        = 0;
+        bool        is_prepared = false;
+    };
+
+    explicit StatementCache(size_t capacity);
+    StatementCache(StatementCache const& other) = delete;
+    StatementCache& operator=(StatementCache const& other) = delete;
+    StatementCache(StatementCache&& other) = delete;
+    StatementCache& operator=(StatementCache&& other) = delete;
+    ~StatementCache() noexcept;
+
+    // Registers one more use of the statement.
+    // The name of a prepared statement evicted to make room is put into stale.
+    Entry& use(std::string_view key, std::string& stale);
+
+    // Forgets all the statements giving the names of prepared ones.
+    std::vector<std::string> clear();
+
+    size_t size() const;
+
+private:
+    size_t const capacity_;
+    size_t       count_ = 0;
+
+    std::list<Entry>                                                 entries_;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace postgres::internal
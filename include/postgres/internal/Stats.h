@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <postgres/Metrics.h>
+
+namespace postgres::internal {
+
+// Counters of a pool, updated by the senders and the workers without locking.
+// Each thread sticks to one of the shards, which are summed up on reading.
+class Stats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Stats();
+    Stats(Stats const& other) = delete;
+    Stats& operator=(Stats const& other) = delete;
+    Stats(Stats&& other) noexcept = delete;
+    Stats& operator=(Stats&& other) noexcept = delete;
+    ~Stats() noexcept;
+
+    void send();
+    void start(Clock::duration wait);
+    void finish(Clock::duration exec);
+    // The job failed without running, the worker being unable to connect.
+    void drop();
+    void connect(Clock::duration dur);
+    void fail(Clock::duration dur);
+    void recycle();
+
+    // Allocations made by the jobs the calling thread runs, when accounted.
+    static Stats* accounting() noexcept;
+    void command(size_t bytes);
+    void result(size_t bytes);
+    void job(size_t bytes);
+
+    Metrics snapshot() const;
+
+    // Attributes the allocations of the calling thread to the stats while alive.
+    class Account {
+    public:
+        explicit Account(Stats& stats) noexcept;
+        Account(Account const& other) = delete;
+        Account& operator=(Account const& other) = delete;
+        Account(Account&& other) noexcept = delete;
+        Account& operator=(Account&& other) noexcept = delete;
+        ~Account() noexcept;
+
+    private:
+        Stats* prev_;
+    };
+
+private:
+    static auto constexpr SHARDS = 16;
+
+    struct Buckets {
+        std::array<std::atomic<int64_t>, Histogram::SIZE> counts{};
+        std::atomic<int64_t>                              total{0};
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<int64_t> sent{0};
+        std::atomic<int64_t> started{0};
+        std::atomic<int64_t> finished{0};
+        std::atomic<int64_t> dropped{0};
+        std::atomic<int64_t> connects{0};
+        std::atomic<int64_t> failures{0};
+        std::atomic<int64_t> recycled{0};
+        std::atomic<int64_t> commands{0};
+        std::atomic<int64_t> command_bytes{0};
+        std::atomic<int64_t> results{0};
+        std::atomic<int64_t> result_bytes{0};
+        std::atomic<int64_t> jobs{0};
+        std::atomic<int64_t> job_bytes{0};
+        Buckets              wait;
+        Buckets              exec;
+        Buckets              connect;
+    };
+
+    static void add(Buckets& to, Clock::duration dur);
+    static void read(Buckets const& from, Histogram& to);
+    Shard& local();
+
+    std::array<Shard, SHARDS> shards_;
+};
+
+// Passes the snapshots to the sink periodically on a thread of its own.
+class Reporter {
+public:
+    using Sink = std::function<void(Metrics const&)>;
+
+    explicit Reporter(std::shared_ptr<Stats const> stats, Stats::Clock::duration period, Sink sink);
+    Reporter(Reporter const& other) = delete;
+    Reporter& operator=(Reporter const& other) = delete;
+    Reporter(Reporter&& other) noexcept = delete;
+    Reporter& operator=(Reporter&& other) noexcept = delete;
+    ~Reporter() noexcept;
+
+private:
+    std::shared_ptr<Stats const> stats_;
+    std::mutex                   mtx_;
+    std::condition_variable      signal_;
+    bool                         is_stopped_ = false;
+    std::thread                  thread_;
+};
+
+}  // namespace postgres::internal
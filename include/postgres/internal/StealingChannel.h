@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Capacity.h>
+#include <postgres/internal/IChannel.h>
+
+namespace postgres {
+
+class Context;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Gives every worker a local queue for the jobs it sends itself,
+// so that follow-up requests stay on the same thread and connection.
+// Jobs from other threads go to a shared queue.
+// Workers run their own newest jobs first and steal the oldest ones from peers once idle.
+class StealingChannel : public IChannel {
+public:
+    explicit StealingChannel(std::shared_ptr<Context const> ctx);
+    StealingChannel(StealingChannel const& other) = delete;
+    StealingChannel& operator=(StealingChannel const& other) = delete;
+    StealingChannel(StealingChannel&& other) noexcept = delete;
+    StealingChannel& operator=(StealingChannel&& other) noexcept = delete;
+    ~StealingChannel() noexcept override;
+
+    std::tuple<bool, Worker*> send(Job job) override;
+    void receive(Slot& slot) override;
+    bool poll(Slot& slot) override;
+    void recycle(Worker& worker) override;
+    void requeue(Job job) override;
+    void drop() override;
+    void quit(int count) override;
+
+private:
+    struct alignas(64) Local {
+        std::deque<Job> queue;
+        std::mutex      mtx;
+        Slot*           owner = nullptr;
+    };
+
+    Local& local(Slot& slot);
+    bool take(Slot& slot, Local& own);
+    bool wake();
+    bool wait(Slot& slot);
+    bool forget(Slot& slot);
+    bool isPending() const;
+
+    static thread_local std::pair<StealingChannel const*, Local*> current_;
+
+    std::shared_ptr<Context const> ctx_;
+    std::vector<Local>             locals_;
+    std::atomic<int>               owners_;
+    std::deque<Job>                queue_;
+    std::vector<Slot*>             slots_;
+    std::vector<Worker*>           recreation_;
+    std::atomic<int>               queued_;
+    Capacity                       room_;
+    std::atomic<int>               idle_;
+    std::atomic<int>               quits_;
+    std::mutex                     mtx_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace postgres::internal {
+
+// Bounded cache of generated statements keyed by a number, like the number of rows.
+// Cached texts are never evicted and live as long as the cache,
+// so that views to them can be safely passed around.
+class Texts {
+public:
+    explicit Texts(size_t limit);
+    Texts(Texts const& other) = delete;
+    Texts& operator=(Texts const& other) = delete;
+    Texts(Texts&& other) = delete;
+    Texts& operator=(Texts&& other) = delete;
+    ~Texts() noexcept;
+
+    // Gives an empty view if the text is not cached.
+    std::string_view find(size_t key) const;
+
+    // Gives an empty view if there is no room left, leaving the text as it is then.
+    std::string_view add(size_t key, std::string&& text);
+
+private:
+    size_t const limit_;
+
+    mutable std::shared_mutex     mtx_;
+    std::map<size_t, std::string> cache_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <pthread.h>
+
+namespace postgres {
+
+class Context;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Thread of a pool placed as its context describes, see Context::Builder::cpuAffinity().
+// Otherwise the same as std::thread, which offers no control over the stack size.
+class Thread {
+public:
+    explicit Thread() = default;
+
+    template <typename F>
+    explicit Thread(Context const& ctx, F&& body)
+        : Thread{ctx, std::unique_ptr<IBody>{new Body<std::decay_t<F>>{std::forward<F>(body)}}} {
+    }
+
+    Thread(Thread const& other) = delete;
+    Thread& operator=(Thread const& other) = delete;
+    Thread(Thread&& other) noexcept;
+    Thread& operator=(Thread&& other) noexcept;
+    ~Thread() noexcept;
+
+    bool joinable() const;
+    void join();
+    void detach();
+
+private:
+    struct IBody {
+        virtual ~IBody() noexcept = default;
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct Body : IBody {
+        explicit Body(F body)
+            : body_{std::move(body)} {
+        }
+
+        void run() override {
+            body_();
+        }
+
+        F body_;
+    };
+
+    explicit Thread(Context const& ctx, std::unique_ptr<IBody> body);
+
+    static void* run(void* body) noexcept;
+
+    pthread_t handle_{};
+    bool      is_joinable_ = false;
+};
+
+}  // namespace postgres::internal
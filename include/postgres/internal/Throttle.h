@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+
+namespace postgres::internal {
+
+// Caps the connection attempts in progress and paces their starts,
+// so that a pool recovering from a failover doesn't flood the server with handshakes.
+class Throttle {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+
+    // Zero max means no cap, and zero interval no pacing.
+    explicit Throttle(int max, Duration interval);
+    Throttle(Throttle const& other) = delete;
+    Throttle& operator=(Throttle const& other) = delete;
+    Throttle(Throttle&& other) = delete;
+    Throttle& operator=(Throttle&& other) = delete;
+    ~Throttle() noexcept;
+
+    int pending() const;
+    // Tells whether no attempt is in progress and no connection is open, so nothing is left to take the queued jobs.
+    bool isIdle() const;
+
+    // Counts one more attempt in unless the cap is reached.
+    bool admit();
+    // Counts one more attempt in regardless of the cap.
+    void enter();
+    void leave();
+    // Counts the connections open, to be done before leaving on success.
+    void open();
+    void close();
+    // Waits for the turn of the next attempt, spaced by the interval plus a jitter of up to a half of it.
+    void pace();
+
+private:
+    int const      max_;
+    Duration const interval_;
+
+    std::atomic<int> pending_;
+    std::atomic<int> open_;
+
+    std::mutex        mtx_;
+    Clock::time_point next_;
+    std::minstd_rand  rand_;
+};
+
+}  // namespace postgres::internal
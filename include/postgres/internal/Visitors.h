@@ -1,27 +1,66 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/internal/Columnar.h>
+#include <postgres/Decimal.h>
+#include <postgres/Oid.h>
+#include <postgres/Uuid.h>
 
 namespace postgres::internal {
 
-struct FieldsCollector {
+// Compile-time string builder, which only measures the result when of zero capacity.
+// The builders below also work with std::string.
+template <size_t N>
+struct SqlBuilder {
+    constexpr void operator+=(char const* str) {
+        for (; *str != '\0'; ++str) {
+            if (len < N) {
+                res[len] = *str;
+            }
+            ++len;
+        }
+    }
+
+    char   res[N + 1]{};
+    size_t len = 0;
+};
+
+template <typename B>
+constexpr void buildNumber(B& res, int const n) {
+    char buf[12]{};
+    auto pos = sizeof(buf) - 1;
+    for (auto i = n; i != 0; i /= 10) {
+        buf[--pos] = static_cast<char>('0' + i % 10);
+    }
+    res += buf + pos;
+}
+
+template <typename B>
+struct FieldsBuilder {
     template <typename T>
-    void accept(char const* const name) {
-        if (!res.empty()) {
+    constexpr void accept(char const* const name) {
+        if (idx++ != 0) {
             res += ",";
         }
         res += name;
     }
 
-    std::string res;
+    B&  res;
+    int idx = 0;
 };
 
-struct TypedFieldsCollector {
+template <typename B>
+struct TypedFieldsBuilder {
     template <typename T>
-    void accept(char const* const name) {
-        if (!res.empty()) {
+    constexpr void accept(char const* const name) {
+        if (idx++ != 0) {
             res += ",";
         }
         res += name;
@@ -29,11 +68,12 @@ struct TypedFieldsCollector {
         res += type(static_cast<T*>(nullptr));
     }
 
-    std::string res;
+    B&  res;
+    int idx = 0;
 
 private:
     template <typename T>
-    std::enable_if_t<std::is_arithmetic_v<T>, char const*> type(T*) {
+    static constexpr std::enable_if_t<std::is_arithmetic_v<T>, char const*> type(T*) {
         if (std::is_same_v<T, bool>) {
             return "BOOL";
         }
@@ -65,39 +105,175 @@ private:
         return "BIGSERIAL";
     }
 
-    char const* type(std::string*) {
+    static constexpr char const* type(std::string*) {
+        return "TEXT";
+    }
+
+    static constexpr char const* type(std::pmr::string*) {
         return "TEXT";
     }
 
-    char const* type(std::chrono::system_clock::time_point*) {
+    static constexpr char const* type(std::vector<uint8_t>*) {
+        return "BYTEA";
+    }
+
+    static constexpr char const* type(Decimal*) {
+        return "NUMERIC";
+    }
+
+    static constexpr char const* type(Uuid*) {
+        return "UUID";
+    }
+
+    static constexpr char const* type(std::chrono::system_clock::time_point*) {
         return "TIMESTAMP";
     }
 };
 
-struct PlaceholdersCollector {
+// Types of the parameters bound from the fields, matching those sent by Command.
+// Fields of other types are left for the server to infer.
+struct ParamTypesCollector {
     template <typename T>
-    void accept(char const* const name) {
-        res += res.empty() ? "$" : ",$";
-        res += std::to_string(++idx);
+    void accept(char const* const) {
+        res.push_back(type(static_cast<T*>(nullptr)));
     }
 
-    int         idx = 0;
-    std::string res;
+    std::vector<Oid>& res;
+
+private:
+    template <typename T>
+    static constexpr Oid type(T*) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return arithmeticOid<T>();
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::pmr::string>) {
+            return TEXTOID;
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+            return BYTEAOID;
+        } else if constexpr (std::is_same_v<T, Decimal>) {
+            return NUMERICOID;
+        } else if constexpr (std::is_same_v<T, Uuid>) {
+            return UUIDOID;
+        } else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+            return TIMESTAMPOID;
+        } else {
+            return InvalidOid;
+        }
+    }
+
+    template <typename T>
+    static constexpr Oid type(std::optional<T>*) {
+        return type(static_cast<T*>(nullptr));
+    }
 };
 
-struct AssignmentsCollector {
+template <typename B>
+struct PlaceholdersBuilder {
     template <typename T>
-    void accept(char const* const name) {
-        if (!res.empty()) {
+    constexpr void accept(char const* const) {
+        res += (num++ == 0) ? "$" : ",$";
+        buildNumber(res, ++idx);
+    }
+
+    B&  res;
+    int idx = 0;
+    int num = 0;
+};
+
+template <typename B>
+struct AssignmentsBuilder {
+    template <typename T>
+    constexpr void accept(char const* const name) {
+        if (num++ != 0) {
             res += ",";
         }
         res += name;
         res += "=$";
-        res += std::to_string(++idx);
+        buildNumber(res, ++idx);
+    }
+
+    B&  res;
+    int idx = 0;
+    int num = 0;
+};
+
+constexpr bool isSameName(char const* lhs, char const* rhs) {
+    for (; (*lhs != '\0') && (*lhs == *rhs); ++lhs, ++rhs) {
+    }
+    return *lhs == *rhs;
+}
+
+// Assigns fields from a joined source except the key, which stays untouched.
+template <typename B>
+struct JoinedAssignmentsBuilder {
+    template <typename T>
+    constexpr void accept(char const* const name) {
+        if (isSameName(name, key)) {
+            return;
+        }
+        if (num++ != 0) {
+            res += ",";
+        }
+        res += name;
+        res += "=";
+        res += source;
+        res += ".";
+        res += name;
+    }
+
+    B&          res;
+    char const* key;
+    char const* source;
+    int         num = 0;
+};
+
+// The only type of binary values decoded without any checks or conversions.
+template <typename T>
+constexpr Oid exactOid(T*) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return BOOLOID;
+    } else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+        return TIMESTAMPOID;
+    } else {
+        return nativeOid<T>();
+    }
+}
+
+template <typename T>
+constexpr Oid exactOid(std::optional<T>*) {
+    return exactOid(static_cast<T*>(nullptr));
+}
+
+// Position of a field in a result, validated against the field type once per result.
+// Exactly matching fields skip the type dispatch when decoded.
+struct Column {
+    int  idx      = -1;
+    bool is_exact = false;
+};
+
+template <typename T>
+Column makeColumn(PGresult const* const handle, int const idx) {
+    if ((idx < 0) || (PQnfields(handle) <= idx)) {
+        return Column{};
+    }
+
+    auto const oid = exactOid(static_cast<T*>(nullptr));
+    return Column{idx, (oid != InvalidOid) && (PQftype(handle, idx) == oid) && (PQfformat(handle, idx) == 1)};
+}
+
+// Consecutive columns starting from the given one.
+template <typename... Ts>
+std::array<Column, sizeof... (Ts)> makeColumns(PGresult const* const handle, int idx) {
+    return {makeColumn<Ts>(handle, idx++)...};
+}
+
+struct ColumnsCollector {
+    template <typename T>
+    void accept(char const* const name) {
+        res.push_back(makeColumn<T>(handle, PQfnumber(handle, name)));
     }
 
-    int         idx = 0;
-    std::string res;
+    PGresult const*     handle = nullptr;
+    std::vector<Column> res{};
 };
 
 }  // namespace postgres::internal
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <libpq-fe.h>
+
+namespace postgres {
+
+class Connection;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Cancels queries running past their deadlines on the server side.
+// A single thread waits for the nearest deadline.
+class Watchdog {
+public:
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    class Watch;
+
+    explicit Watchdog();
+    Watchdog(Watchdog const& other) = delete;
+    Watchdog& operator=(Watchdog const& other) = delete;
+    Watchdog(Watchdog&& other) = delete;
+    Watchdog& operator=(Watchdog&& other) = delete;
+    ~Watchdog() noexcept;
+
+    // Cancels whatever the connection is doing on the deadline, until the watch is destroyed.
+    // Throws if the deadline has already passed.
+    Watch watch(Connection& conn, Deadline deadline);
+
+private:
+    using Key = std::pair<Deadline, uint64_t>;
+
+    void run();
+    void forget(Key const& key);
+
+    std::mutex               mtx_;
+    std::condition_variable  signal_;
+    std::condition_variable  cancelled_;
+    std::map<Key, PGcancel*> watches_;
+    // Expired watches, whose queries are being cancelled without the lock.
+    std::vector<Key>         cancelling_;
+    uint64_t                 next_;
+    bool                     is_done_;
+    std::thread              thread_;
+};
+
+class Watchdog::Watch {
+public:
+    Watch(Watch const& other) = delete;
+    Watch& operator=(Watch const& other) = delete;
+    Watch(Watch&& other) noexcept;
+    Watch& operator=(Watch&& other) noexcept = delete;
+    ~Watch() noexcept;
+
+private:
+    friend class Watchdog;
+
+    explicit Watch(Watchdog& dog, Key key);
+
+    Watchdog* dog_;
+    Key       key_;
+};
+
+}  // namespace postgres::internal
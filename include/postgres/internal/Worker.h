@@ -1,18 +1,26 @@
 #pragma once
 
+#include <exception>
+#include <future>
 #include <memory>
-#include <thread>
+#include <optional>
 #include <postgres/internal/Job.h>
+#include <postgres/internal/Thread.h>
 
 namespace postgres {
 
+class Connection;
 class Context;
 
 }  // namespace postgres
 
 namespace postgres::internal {
 
+class Budget;
 class IChannel;
+class Limiter;
+class Stats;
+class Throttle;
 
 class Worker {
 public:
@@ -23,13 +31,42 @@ public:
     Worker& operator=(Worker&& other) noexcept = delete;
     ~Worker() noexcept;
 
-    void run();
+    // Tells whether the calling thread is a worker taking jobs from the channel.
+    static bool serves(IChannel const& chan);
+    // Tells whether the calling thread is the one of the worker.
+    bool isCurrent() const;
+
+    // The future gets ready once connected.
+    std::future<void> run();
+    // Makes the worker ignore the idle timeout.
+    void keepAlive();
+    // Makes the worker quit when running above the limit.
+    void limitBy(std::shared_ptr<Limiter> lim);
+    void reportTo(std::shared_ptr<Stats> stats);
+    // Charges the results of the jobs to the budget.
+    void chargeTo(std::shared_ptr<Budget> budget);
+    // Paces the connection attempts, which have been let in by the throttle before running the worker.
+    void throttleBy(std::shared_ptr<Throttle> throttle);
 
 private:
+    void fail(std::exception_ptr const& err);
+    // Fails the queued jobs when no connection is open or under way to take them.
+    void drain(std::exception_ptr const& err);
+    // Closes the connection, telling the throttle.
+    void disconnect(std::optional<Connection>& conn);
+    // Replaces a broken connection as configured, giving the last error when all the attempts fail.
+    std::exception_ptr reconnect(std::optional<Connection>& conn);
+    // Recycles the worker, telling the limiter unless it already knows.
+    void quit(bool is_counted);
+
     std::shared_ptr<Context const> ctx_;
     std::shared_ptr<IChannel>      chan_;
+    std::shared_ptr<Limiter>       lim_;
+    std::shared_ptr<Stats>         stats_;
+    std::shared_ptr<Budget>        budget_;
+    std::shared_ptr<Throttle>      throttle_;
     Slot                           slot_;
-    std::thread                    thread_;
+    Thread                         thread_;
 };
 
 }  // namespace postgres::internal
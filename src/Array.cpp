@@ -0,0 +1,133 @@
+#include <postgres/internal/Array.h>
+
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+
+namespace postgres::internal {
+
+Oid arrayOid(Oid const elem) {
+    switch (elem) {
+        case BOOLOID: {
+            return BOOLARRAYOID;
+        }
+        case INT2OID: {
+            return INT2ARRAYOID;
+        }
+        case INT4OID: {
+            return INT4ARRAYOID;
+        }
+        case INT8OID: {
+            return INT8ARRAYOID;
+        }
+        case FLOAT4OID: {
+            return FLOAT4ARRAYOID;
+        }
+        case FLOAT8OID: {
+            return FLOAT8ARRAYOID;
+        }
+        case TEXTOID: {
+            return TEXTARRAYOID;
+        }
+        case VARCHAROID: {
+            return VARCHARARRAYOID;
+        }
+        case TIMESTAMPOID: {
+            return TIMESTAMPARRAYOID;
+        }
+        case UUIDOID: {
+            return UUIDARRAYOID;
+        }
+        default: {
+            break;
+        }
+    }
+    return 0;
+}
+
+Oid elementOid(Oid const arr) {
+    switch (arr) {
+        case BOOLARRAYOID: {
+            return BOOLOID;
+        }
+        case INT2ARRAYOID: {
+            return INT2OID;
+        }
+        case INT4ARRAYOID: {
+            return INT4OID;
+        }
+        case INT8ARRAYOID: {
+            return INT8OID;
+        }
+        case FLOAT4ARRAYOID: {
+            return FLOAT4OID;
+        }
+        case FLOAT8ARRAYOID: {
+            return FLOAT8OID;
+        }
+        case TEXTARRAYOID: {
+            return TEXTOID;
+        }
+        case VARCHARARRAYOID: {
+            return VARCHAROID;
+        }
+        case TIMESTAMPARRAYOID: {
+            return TIMESTAMPOID;
+        }
+        case UUIDARRAYOID: {
+            return UUIDOID;
+        }
+        default: {
+            break;
+        }
+    }
+    return 0;
+}
+
+ArrayReader::ArrayReader(char const* const data, int const len)
+    : pos_{data}, end_{data + len} {
+    auto const dims = readInt();
+    _POSTGRES_CXX_ASSERT(LogicError, (0 <= dims) && (dims <= 1), "unsupported array dimensions: " << dims);
+
+    // Flag telling if there are NULLs is not needed.
+    readInt();
+    type_ = static_cast<Oid>(readInt());
+    if (dims == 0) {
+        return;
+    }
+
+    size_ = readInt();
+    // Lower bound doesn't matter.
+    readInt();
+}
+
+ArrayReader::~ArrayReader() noexcept = default;
+
+Oid ArrayReader::type() const {
+    return type_;
+}
+
+int ArrayReader::size() const {
+    return size_;
+}
+
+char const* ArrayReader::next(int& len) {
+    len = readInt();
+    if (len < 0) {
+        return nullptr;
+    }
+
+    _POSTGRES_CXX_ASSERT(RuntimeError, len <= end_ - pos_, "array is truncated");
+    auto const val = pos_;
+    pos_ += len;
+    return val;
+}
+
+int32_t ArrayReader::readInt() {
+    _POSTGRES_CXX_ASSERT(RuntimeError, 4 <= end_ - pos_, "array is truncated");
+    auto const val = orderBytes<int32_t>(pos_);
+    pos_ += 4;
+    return val;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,510 @@
+#include <postgres/Arrow.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Columnar.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Receiver.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+namespace {
+
+// Days and microseconds from the Unix epoch to the PostgreSQL one, 2000-01-01.
+int32_t constexpr EPOCH_DAYS   = 10957;
+int64_t constexpr EPOCH_MICROS = int64_t{EPOCH_DAYS} * 86400 * 1000000;
+
+enum class Kind {
+    BOOL,
+    INT16,
+    INT32,
+    INT64,
+    FLOAT32,
+    FLOAT64,
+    DATE,
+    TIMESTAMP,
+    UUID,
+    STRING,
+    JSONB,
+    NUMERIC,
+    BINARY,
+};
+
+struct Type {
+    Kind        kind;
+    char const* format;
+};
+
+Type typeOf(PGresult const& res, int const col) {
+    if (PQfformat(&res, col) == 0) {
+        return {Kind::STRING, "u"};
+    }
+    switch (PQftype(&res, col)) {
+        case BOOLOID: {
+            return {Kind::BOOL, "b"};
+        }
+        case INT2OID: {
+            return {Kind::INT16, "s"};
+        }
+        case INT4OID: {
+            return {Kind::INT32, "i"};
+        }
+        case INT8OID: {
+            return {Kind::INT64, "l"};
+        }
+        case FLOAT4OID: {
+            return {Kind::FLOAT32, "f"};
+        }
+        case FLOAT8OID: {
+            return {Kind::FLOAT64, "g"};
+        }
+        case DATEOID: {
+            return {Kind::DATE, "tdD"};
+        }
+        case TIMESTAMPOID: {
+            return {Kind::TIMESTAMP, "tsu:"};
+        }
+        case TIMESTAMPTZOID: {
+            return {Kind::TIMESTAMP, "tsu:UTC"};
+        }
+        case UUIDOID: {
+            return {Kind::UUID, "w:16"};
+        }
+        case TEXTOID:
+        case VARCHAROID:
+        case BPCHAROID:
+        case NAMEOID:
+        case JSONOID: {
+            return {Kind::STRING, "u"};
+        }
+        case JSONBOID: {
+            return {Kind::JSONB, "u"};
+        }
+        case NUMERICOID: {
+            return {Kind::NUMERIC, "u"};
+        }
+        default: {
+            break;
+        }
+    }
+    return {Kind::BINARY, "z"};
+}
+
+// Formats a binary NUMERIC the way the server does: the count of base 10000 digits, the weight of the first one,
+// sign and display scale, followed by the digits themselves.
+void appendNumeric(char const* const data, std::vector<char>& out) {
+    auto const at = [data](int const idx) {
+        return internal::orderBytes<int16_t>(data + 2 * idx);
+    };
+    auto const count  = at(0);
+    auto const weight = at(1);
+    auto const sign   = static_cast<uint16_t>(at(2));
+    auto const scale  = at(3);
+    auto const digit  = [&at, count](int const idx) {
+        return ((0 <= idx) && (idx < count)) ? at(4 + idx) : 0;
+    };
+    auto const append = [&out](std::string const& str) {
+        out.insert(out.end(), str.begin(), str.end());
+    };
+    auto const pad = [&append](int const val) {
+        auto str = std::to_string(val);
+        append(std::string(4 - str.size(), '0') + str);
+    };
+
+    switch (sign) {
+        case 0xC000: {
+            return append("NaN");
+        }
+        case 0xD000: {
+            return append("Infinity");
+        }
+        case 0xF000: {
+            return append("-Infinity");
+        }
+        case 0x4000: {
+            out.push_back('-');
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    if (weight < 0) {
+        out.push_back('0');
+    } else {
+        append(std::to_string(digit(0)));
+        for (auto i = 1; i <= weight; ++i) {
+            pad(digit(i));
+        }
+    }
+    if (0 < scale) {
+        out.push_back('.');
+        auto const start = out.size();
+        for (auto i = weight + 1; out.size() - start < static_cast<size_t>(scale); ++i) {
+            pad(digit(i));
+        }
+        out.resize(start + static_cast<size_t>(scale));
+    }
+}
+
+// Owns the buffers of an exported column.
+struct Column {
+    std::vector<uint8_t>       validity;
+    std::vector<int32_t>       offsets;
+    std::vector<char>          data;
+    std::array<void const*, 3> buffers{};
+};
+
+// Owns the children of an exported batch, each child owning its own buffers.
+struct Batch {
+    std::vector<ArrowArray>    arrays;
+    std::vector<ArrowArray*>   children;
+    std::array<void const*, 1> buffers{};
+};
+
+struct Fields {
+    std::vector<ArrowSchema>  schemas;
+    std::vector<ArrowSchema*> children;
+};
+
+void releaseColumn(ArrowArray* const arr) {
+    delete static_cast<Column*>(arr->private_data);
+    arr->release = nullptr;
+}
+
+void releaseBatch(ArrowArray* const arr) {
+    auto const batch = static_cast<Batch*>(arr->private_data);
+    for (auto const child : batch->children) {
+        if (child->release) {
+            child->release(child);
+        }
+    }
+    delete batch;
+    arr->release = nullptr;
+}
+
+void releaseField(ArrowSchema* const schema) {
+    delete static_cast<std::string*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void releaseFields(ArrowSchema* const schema) {
+    auto const fields = static_cast<Fields*>(schema->private_data);
+    for (auto const child : fields->children) {
+        if (child->release) {
+            child->release(child);
+        }
+    }
+    delete fields;
+    schema->release = nullptr;
+}
+
+template <typename T>
+void copyFixed(PGresult const& res, int const col, Column& out) {
+    auto const rows = PQntuples(&res);
+    out.data.resize(static_cast<size_t>(rows) * sizeof(T));
+    internal::readDense(res, col, reinterpret_cast<T*>(out.data.data()), [](int) {
+    });
+}
+
+// Copies the values as they are, to be reordered in bulk and shifted to the Unix epoch.
+template <typename T>
+void copyTime(PGresult const& res, int const col, T const shift, Column& out) {
+    auto const rows = PQntuples(&res);
+    out.data.resize(static_cast<size_t>(rows) * sizeof(T));
+    auto const vals = reinterpret_cast<T*>(out.data.data());
+    for (auto row = 0; row < rows; ++row) {
+        if (PQgetisnull(&res, row, col) != 1) {
+            std::memcpy(vals + row, PQgetvalue(&res, row, col), sizeof(T));
+        }
+    }
+    internal::orderBytes(vals, static_cast<size_t>(rows), sizeof(T));
+    for (auto row = 0; row < rows; ++row) {
+        vals[row] += shift;
+    }
+}
+
+void copyVariable(PGresult const& res, int const col, Kind const kind, Column& out) {
+    auto const rows = PQntuples(&res);
+    out.offsets.resize(static_cast<size_t>(rows) + 1);
+    for (auto row = 0; row < rows; ++row) {
+        if (PQgetisnull(&res, row, col) != 1) {
+            auto const val = PQgetvalue(&res, row, col);
+            auto const len = PQgetlength(&res, row, col);
+            if (kind == Kind::NUMERIC) {
+                appendNumeric(val, out.data);
+            } else if (kind == Kind::JSONB) {
+                // Skips the version of the format.
+                out.data.insert(out.data.end(), val + 1, val + len);
+            } else {
+                out.data.insert(out.data.end(), val, val + len);
+            }
+        }
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             out.data.size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                             "column '" << PQfname(&res, col) << "' is too large for a batch, iterate by chunks");
+        out.offsets[static_cast<size_t>(row) + 1] = static_cast<int32_t>(out.data.size());
+    }
+}
+
+void exportColumn(PGresult const& res, int const col, ArrowArray* const out) {
+    auto const rows   = PQntuples(&res);
+    auto const kind   = typeOf(res, col).kind;
+    auto       column = std::make_unique<Column>();
+    auto       nulls  = int64_t{0};
+
+    column->validity.resize((static_cast<size_t>(rows) + 7) / 8);
+    for (auto row = 0; row < rows; ++row) {
+        if (PQgetisnull(&res, row, col) == 1) {
+            ++nulls;
+        } else {
+            column->validity[static_cast<size_t>(row) / 8] |= static_cast<uint8_t>(1u << (row % 8));
+        }
+    }
+
+    switch (kind) {
+        case Kind::BOOL: {
+            column->data.resize(column->validity.size());
+            for (auto row = 0; row < rows; ++row) {
+                if ((PQgetisnull(&res, row, col) != 1) && (*PQgetvalue(&res, row, col) != 0)) {
+                    column->data[static_cast<size_t>(row) / 8] |= static_cast<char>(1u << (row % 8));
+                }
+            }
+            break;
+        }
+        case Kind::INT16: {
+            copyFixed<int16_t>(res, col, *column);
+            break;
+        }
+        case Kind::INT32: {
+            copyFixed<int32_t>(res, col, *column);
+            break;
+        }
+        case Kind::INT64: {
+            copyFixed<int64_t>(res, col, *column);
+            break;
+        }
+        case Kind::FLOAT32: {
+            copyFixed<float>(res, col, *column);
+            break;
+        }
+        case Kind::FLOAT64: {
+            copyFixed<double>(res, col, *column);
+            break;
+        }
+        case Kind::DATE: {
+            copyTime<int32_t>(res, col, EPOCH_DAYS, *column);
+            break;
+        }
+        case Kind::TIMESTAMP: {
+            copyTime<int64_t>(res, col, EPOCH_MICROS, *column);
+            break;
+        }
+        case Kind::UUID: {
+            column->data.resize(static_cast<size_t>(rows) * 16);
+            for (auto row = 0; row < rows; ++row) {
+                if (PQgetisnull(&res, row, col) != 1) {
+                    std::memcpy(column->data.data() + static_cast<size_t>(row) * 16, PQgetvalue(&res, row, col), 16);
+                }
+            }
+            break;
+        }
+        case Kind::STRING:
+        case Kind::JSONB:
+        case Kind::NUMERIC:
+        case Kind::BINARY: {
+            copyVariable(res, col, kind, *column);
+            break;
+        }
+    }
+
+    // Buffers must not be null even when empty.
+    column->data.reserve(1);
+    column->buffers[0] = (0 < nulls) ? column->validity.data() : nullptr;
+    if (column->offsets.empty()) {
+        column->buffers[1] = column->data.data();
+        out->n_buffers     = 2;
+    } else {
+        column->buffers[1] = column->offsets.data();
+        column->buffers[2] = column->data.data();
+        out->n_buffers     = 3;
+    }
+
+    out->length       = rows;
+    out->null_count   = nulls;
+    out->offset       = 0;
+    out->n_children   = 0;
+    out->buffers      = column->buffers.data();
+    out->children     = nullptr;
+    out->dictionary   = nullptr;
+    out->release      = releaseColumn;
+    out->private_data = column.release();
+}
+
+void exportFields(PGresult const& res, ArrowSchema* const out) {
+    auto const cols   = PQnfields(&res);
+    auto       fields = std::make_unique<Fields>();
+    fields->schemas.resize(static_cast<size_t>(cols));
+    for (auto col = 0; col < cols; ++col) {
+        auto& field        = fields->schemas[static_cast<size_t>(col)];
+        auto  name         = std::make_unique<std::string>(PQfname(&res, col));
+        field.format       = typeOf(res, col).format;
+        field.name         = name->c_str();
+        field.metadata     = nullptr;
+        field.flags        = ARROW_FLAG_NULLABLE;
+        field.n_children   = 0;
+        field.children     = nullptr;
+        field.dictionary   = nullptr;
+        field.release      = releaseField;
+        field.private_data = name.release();
+        fields->children.push_back(&field);
+    }
+
+    out->format       = "+s";
+    out->name         = "";
+    out->metadata     = nullptr;
+    out->flags        = 0;
+    out->n_children   = cols;
+    out->children     = fields->children.data();
+    out->dictionary   = nullptr;
+    out->release      = releaseFields;
+    out->private_data = fields.release();
+}
+
+struct Stream {
+    explicit Stream(Receiver rcvr)
+        : rcvr{std::move(rcvr)} {
+    }
+
+    // Receives results until a non-empty one, remembering the columns of the first one for the schema.
+    std::optional<Result> next() {
+        while (!is_over) {
+            auto res = rcvr.receive();
+            if (res.isDone()) {
+                is_over = true;
+                break;
+            }
+            if (!shape) {
+                shape.reset(PQcopyResult(res.native(), PG_COPYRES_ATTRS));
+            }
+            if (!res.isEmpty()) {
+                return res;
+            }
+        }
+        return std::nullopt;
+    }
+
+    Receiver                                       rcvr;
+    std::optional<Result>                          head;
+    std::unique_ptr<PGresult, void (*)(PGresult*)> shape{nullptr, PQclear};
+    std::string                                    error;
+    bool                                           is_over = false;
+};
+
+Stream& streamOf(ArrowArrayStream* const stream) {
+    return *static_cast<Stream*>(stream->private_data);
+}
+
+int getSchema(ArrowArrayStream* const stream, ArrowSchema* const out) {
+    auto& self = streamOf(stream);
+    try {
+        if (!self.shape) {
+            self.head = self.next();
+        }
+        _POSTGRES_CXX_ASSERT(LogicError, self.shape, "no results to take the schema from");
+        exportFields(*self.shape, out);
+        return 0;
+    } catch (std::exception const& err) {
+        self.error = err.what();
+    }
+    return EIO;
+}
+
+int getNext(ArrowArrayStream* const stream, ArrowArray* const out) {
+    auto& self = streamOf(stream);
+    try {
+        auto res = self.head ? std::move(self.head) : self.next();
+        self.head.reset();
+        if (!res) {
+            out->release = nullptr;
+            return 0;
+        }
+        Arrow::exportBatch(*res, out);
+        return 0;
+    } catch (std::exception const& err) {
+        self.error = err.what();
+    }
+    return EIO;
+}
+
+char const* getLastError(ArrowArrayStream* const stream) {
+    auto const& self = streamOf(stream);
+    return self.error.empty() ? nullptr : self.error.c_str();
+}
+
+void releaseStream(ArrowArrayStream* const stream) {
+    delete static_cast<Stream*>(stream->private_data);
+    stream->release = nullptr;
+}
+
+}  // namespace
+
+void Arrow::exportSchema(Result const& res, ArrowSchema* const out) {
+    exportFields(*res.native(), out);
+}
+
+void Arrow::exportBatch(Result const& res, ArrowArray* const out) {
+    auto const& handle = *res.native();
+    auto const  cols   = PQnfields(&handle);
+    auto        batch  = std::make_unique<Batch>();
+    batch->arrays.resize(static_cast<size_t>(cols));
+    for (auto col = 0; col < cols; ++col) {
+        auto& child = batch->arrays[static_cast<size_t>(col)];
+        child.release = nullptr;
+        batch->children.push_back(&child);
+    }
+
+    // Children exported so far are released on a failure.
+    try {
+        for (auto col = 0; col < cols; ++col) {
+            exportColumn(handle, col, &batch->arrays[static_cast<size_t>(col)]);
+        }
+    } catch (...) {
+        ArrowArray tmp{};
+        tmp.private_data = batch.release();
+        releaseBatch(&tmp);
+        throw;
+    }
+
+    out->length       = PQntuples(&handle);
+    out->null_count   = 0;
+    out->offset       = 0;
+    out->n_buffers    = 1;
+    out->n_children   = cols;
+    out->buffers      = batch->buffers.data();
+    out->children     = batch->children.data();
+    out->dictionary   = nullptr;
+    out->release      = releaseBatch;
+    out->private_data = batch.release();
+}
+
+void Arrow::exportStream(Receiver rcvr, ArrowArrayStream* const out) {
+    out->get_schema     = getSchema;
+    out->get_next       = getNext;
+    out->get_last_error = getLastError;
+    out->release        = releaseStream;
+    out->private_data   = new Stream{std::move(rcvr)};
+}
+
+}  // namespace postgres
@@ -0,0 +1,80 @@
+#include <postgres/internal/Budget.h>
+
+#include <postgres/Error.h>
+#include <postgres/Result.h>
+
+namespace postgres::internal {
+
+namespace {
+
+thread_local Budget* current = nullptr;
+
+}  // namespace
+
+Budget::Budget(size_t const capacity, OverflowPolicy const pol, Duration const timeout)
+    : cap_{capacity}, pol_{pol}, timeout_{timeout} {
+}
+
+Budget::~Budget() noexcept = default;
+
+void Budget::charge(Result& res) {
+    auto const handle = res.native();
+    if ((current == nullptr) || (handle == nullptr)) {
+        return;
+    }
+
+    auto const bytes = PQresultMemorySize(handle);
+    current->acquire(bytes);
+    // The charge is released along with the last share of the result.
+    res.handle_ = std::shared_ptr<PGresult>{handle, [held = std::move(res.handle_),
+                                                     budget = current->shared_from_this(),
+                                                     bytes](PGresult*) mutable {
+        held.reset();
+        budget->release(bytes);
+    }};
+}
+
+size_t Budget::used() const {
+    std::lock_guard guard{mtx_};
+    return used_;
+}
+
+void Budget::acquire(size_t const bytes) {
+    std::unique_lock guard{mtx_};
+    auto const       has_room = [this, bytes] {
+        return (used_ == 0) || (used_ + bytes <= cap_);
+    };
+    if (pol_ == OverflowPolicy::THROW) {
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             used_ + bytes <= cap_,
+                             "result of " << bytes << " bytes exceeds the budget, " << used_ << " of "
+                                          << cap_ << " bytes being held");
+    } else if (timeout_.count() == 0) {
+        room_.wait(guard, has_room);
+    } else {
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             room_.wait_for(guard, timeout_, has_room),
+                             "result of " << bytes << " bytes exceeds the budget, " << used_ << " of "
+                                          << cap_ << " bytes being held");
+    }
+    used_ += bytes;
+}
+
+void Budget::release(size_t const bytes) {
+    {
+        std::lock_guard guard{mtx_};
+        used_ -= bytes;
+    }
+    room_.notify_all();
+}
+
+Budget::Scope::Scope(Budget& budget) noexcept
+    : prev_{current} {
+    current = &budget;
+}
+
+Budget::Scope::~Scope() noexcept {
+    current = prev_;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,140 @@
+#include <postgres/internal/Bytes.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _POSTGRES_CXX_BYTES_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#define _POSTGRES_CXX_BYTES_NEON
+#include <arm_neon.h>
+#endif
+
+namespace postgres::internal {
+
+template <typename T>
+static void swapScalar(uint8_t* const data, size_t const count) {
+    for (size_t i = 0; i < count; ++i) {
+        T val;
+        std::memcpy(&val, data + i * sizeof(T), sizeof(T));
+        val = swapBytes(val);
+        std::memcpy(data + i * sizeof(T), &val, sizeof(T));
+    }
+}
+
+static void swapScalar(uint8_t* const data, size_t const count, size_t const size) {
+    switch (size) {
+        case 2: {
+            swapScalar<uint16_t>(data, count);
+            break;
+        }
+        case 4: {
+            swapScalar<uint32_t>(data, count);
+            break;
+        }
+        case 8: {
+            swapScalar<uint64_t>(data, count);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+#if defined(_POSTGRES_CXX_BYTES_X86)
+
+// Byte indices reversing each value of the given size within 16 bytes.
+static __m128i reverseMask(size_t const size) {
+    alignas(16) uint8_t mask[16];
+    for (size_t i = 0; i < 16; ++i) {
+        mask[i] = static_cast<uint8_t>((i / size) * size + (size - 1 - i % size));
+    }
+    return _mm_load_si128(reinterpret_cast<__m128i const*>(mask));
+}
+
+__attribute__((target("avx2")))
+static void swapAvx2(uint8_t* const data, size_t const count, size_t const size) {
+    auto const len  = count * size;
+    auto const half = reverseMask(size);
+    auto const mask = _mm256_broadcastsi128_si256(half);
+
+    size_t pos = 0;
+    for (; pos + 32 <= len; pos += 32) {
+        auto const ptr = reinterpret_cast<__m256i*>(data + pos);
+        _mm256_storeu_si256(ptr, _mm256_shuffle_epi8(_mm256_loadu_si256(ptr), mask));
+    }
+    swapScalar(data + pos, (len - pos) / size, size);
+}
+
+__attribute__((target("ssse3")))
+static void swapSsse3(uint8_t* const data, size_t const count, size_t const size) {
+    auto const len  = count * size;
+    auto const mask = reverseMask(size);
+
+    size_t pos = 0;
+    for (; pos + 16 <= len; pos += 16) {
+        auto const ptr = reinterpret_cast<__m128i*>(data + pos);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask));
+    }
+    swapScalar(data + pos, (len - pos) / size, size);
+}
+
+using Kernel = void (*)(uint8_t*, size_t, size_t);
+
+static Kernel chooseKernel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return swapAvx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return swapSsse3;
+    }
+    return swapScalar;
+}
+
+static void swapVector(uint8_t* const data, size_t const count, size_t const size) {
+    static auto const kernel = chooseKernel();
+    kernel(data, count, size);
+}
+
+#elif defined(_POSTGRES_CXX_BYTES_NEON)
+
+static void swapVector(uint8_t* const data, size_t const count, size_t const size) {
+    auto const len = count * size;
+
+    size_t pos = 0;
+    for (; pos + 16 <= len; pos += 16) {
+        auto const val = vld1q_u8(data + pos);
+        switch (size) {
+            case 2: {
+                vst1q_u8(data + pos, vrev16q_u8(val));
+                break;
+            }
+            case 4: {
+                vst1q_u8(data + pos, vrev32q_u8(val));
+                break;
+            }
+            default: {
+                vst1q_u8(data + pos, vrev64q_u8(val));
+                break;
+            }
+        }
+    }
+    swapScalar(data + pos, (len - pos) / size, size);
+}
+
+#else
+
+static void swapVector(uint8_t* const data, size_t const count, size_t const size) {
+    swapScalar(data, count, size);
+}
+
+#endif
+
+void orderBytes(void* const data, size_t const count, size_t const size) {
+    if (IS_NET_ORDER || ((size != 2) && (size != 4) && (size != 8))) {
+        return;
+    }
+    swapVector(static_cast<uint8_t*>(data), count, size);
+}
+
+}  // namespace postgres::internal
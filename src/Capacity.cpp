@@ -0,0 +1,55 @@
+#include <postgres/internal/Capacity.h>
+
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+Capacity::Capacity(Context const& ctx)
+    : lim_{ctx.maxQueueSize()},
+      pol_{ctx.overflowPolicy()},
+      timeout_{ctx.overflowTimeout()},
+      waiters_{0} {
+}
+
+Capacity::~Capacity() noexcept = default;
+
+void Capacity::acquire(std::atomic<int> const& queued, bool const may_wait) {
+    if ((lim_ <= 0) || (queued < lim_)) {
+        return;
+    }
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         may_wait && (pol_ == OverflowPolicy::BLOCK),
+                         "queue overflow");
+
+    auto const has_room = [this, &queued] {
+        return queued < lim_;
+    };
+
+    std::unique_lock guard{mtx_};
+    ++waiters_;
+    auto is_ready = true;
+    if (timeout_.count() == 0) {
+        room_.wait(guard, has_room);
+    } else {
+        is_ready = room_.wait_for(guard, timeout_, has_room);
+    }
+    --waiters_;
+    _POSTGRES_CXX_ASSERT(RuntimeError, is_ready, "queue overflow");
+}
+
+void Capacity::release() {
+    // Senders register under the lock before checking the room, so none is missed.
+    if (0 < waiters_) {
+        std::lock_guard guard{mtx_};
+        room_.notify_one();
+    }
+}
+
+void Capacity::releaseAll() {
+    if (0 < waiters_) {
+        std::lock_guard guard{mtx_};
+        room_.notify_all();
+    }
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,215 @@
+#include <postgres/ChangeStream.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <poll.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+#include <postgres/Time.h>
+
+namespace postgres {
+
+namespace {
+
+// Kind of a message, followed by the start and the end of the log it carries, and the time it is sent.
+auto constexpr XLOG_HEADER = 1 + 3 * sizeof(uint64_t);
+// Kind of a message, followed by the end of the log, the time it is sent and whether it needs a reply.
+auto constexpr KEEPALIVE   = 1 + 2 * sizeof(uint64_t) + 1;
+
+void putBytes(char*& pos, uint64_t const val) {
+    auto const ordered = internal::orderBytes(val);
+    std::memcpy(pos, &ordered, sizeof(ordered));
+    pos += sizeof(ordered);
+}
+
+}  // namespace
+
+ChangeStream::ChangeStream(std::shared_ptr<PGconn> handle, std::string const& stmt, Duration const status_interval)
+    : handle_{std::move(handle)}, interval_{status_interval}, next_report_{Clock::now() + status_interval} {
+    auto const res = PQexec(native(), stmt.data());
+    auto const is_ok = PQresultStatus(res) == PGRES_COPY_BOTH;
+    std::string const msg = is_ok ? "" : PQresultErrorMessage(res);
+    PQclear(res);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_ok,
+                         "fail to start replication: " << (msg.empty() ? PQerrorMessage(native())
+                                                                         : msg.data()));
+}
+
+ChangeStream::ChangeStream(ChangeStream&& other) noexcept
+    : handle_{std::move(other.handle_)},
+      decoder_{std::move(other.decoder_)},
+      changes_{std::move(other.changes_)},
+      interval_{other.interval_},
+      next_report_{other.next_report_},
+      received_{other.received_},
+      acked_{other.acked_.load()},
+      is_over_{other.is_over_} {
+}
+
+ChangeStream::~ChangeStream() noexcept {
+    if (!handle_) {
+        return;
+    }
+    try {
+        if (!is_over_) {
+            report();
+            PQputCopyEnd(native(), nullptr);
+            PQflush(native());
+            char* buf = nullptr;
+            while (0 < PQgetCopyData(native(), &buf, 0)) {
+                PQfreemem(buf);
+            }
+        }
+        while (auto const res = PQgetResult(native())) {
+            PQclear(res);
+        }
+    } catch (...) {
+        // The connection is left broken, there is no one to report it to.
+    }
+}
+
+bool ChangeStream::read(Change& out) {
+    return read(out, Duration::max());
+}
+
+bool ChangeStream::read(Change& out, Duration const timeout) {
+    _POSTGRES_CXX_ASSERT(LogicError, handle_, "replication is moved");
+    auto const now      = Clock::now();
+    auto const deadline = (Clock::time_point::max() - now <= timeout) ? Clock::time_point::max() : now + timeout;
+    while (changes_.empty()) {
+        if (is_over_ || !receive(deadline)) {
+            return false;
+        }
+    }
+    out = std::move(changes_.front());
+    changes_.pop_front();
+    return true;
+}
+
+void ChangeStream::ack(uint64_t const lsn) {
+    auto cur = acked_.load(std::memory_order_relaxed);
+    while ((cur < lsn) && !acked_.compare_exchange_weak(cur, lsn, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t ChangeStream::acked() const {
+    return acked_.load(std::memory_order_relaxed);
+}
+
+uint64_t ChangeStream::received() const {
+    return received_;
+}
+
+bool ChangeStream::isOver() const {
+    return is_over_;
+}
+
+std::string ChangeStream::format(uint64_t const lsn) {
+    char buf[24];
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "%X/%X",
+                  static_cast<unsigned>(lsn >> 32u),
+                  static_cast<unsigned>(lsn & 0xFFFFFFFFu));
+    return buf;
+}
+
+bool ChangeStream::receive(Clock::time_point const deadline) {
+    while (true) {
+        if (next_report_ <= Clock::now()) {
+            report();
+        }
+
+        char*      buf = nullptr;
+        auto const len = PQgetCopyData(native(), &buf, 1);
+        if (0 < len) {
+            try {
+                handle(buf, static_cast<size_t>(len));
+            } catch (...) {
+                PQfreemem(buf);
+                throw;
+            }
+            PQfreemem(buf);
+            return true;
+        }
+        if (len == -1) {
+            while (auto const res = PQgetResult(native())) {
+                PQclear(res);
+            }
+            is_over_ = true;
+            return false;
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError, len == 0, "fail to receive replication: " << PQerrorMessage(native()));
+
+        // Waits for data, waking up for the next status update or the deadline, whichever comes first.
+        auto const now  = Clock::now();
+        auto const wake = std::min(next_report_, deadline);
+        if (wake <= now) {
+            if (deadline <= now) {
+                return false;
+            }
+            continue;
+        }
+        auto const ms = std::chrono::ceil<std::chrono::milliseconds>(wake - now).count();
+        pollfd     fd{PQsocket(native()), POLLIN, 0};
+        while ((::poll(&fd, 1, static_cast<int>(std::min<int64_t>(ms, INT_MAX))) < 0) && (errno == EINTR)) {
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             PQconsumeInput(native()) == 1,
+                             "fail to receive replication: " << PQerrorMessage(native()));
+    }
+}
+
+void ChangeStream::handle(char const* const data, size_t const len) {
+    switch (data[0]) {
+        case 'w': {
+            _POSTGRES_CXX_ASSERT(RuntimeError, XLOG_HEADER <= len, "replication message is truncated");
+            auto const start = internal::orderBytes<uint64_t>(data + 1);
+            auto const end   = internal::orderBytes<uint64_t>(data + 1 + sizeof(uint64_t));
+            received_ = std::max(received_, std::max(start, end));
+            decoder_.decode(data + XLOG_HEADER, len - XLOG_HEADER, start, changes_);
+            break;
+        }
+        case 'k': {
+            _POSTGRES_CXX_ASSERT(RuntimeError, KEEPALIVE <= len, "replication message is truncated");
+            received_ = std::max(received_, internal::orderBytes<uint64_t>(data + 1));
+            if (data[KEEPALIVE - 1] != 0) {
+                report();
+            }
+            break;
+        }
+        default: {
+            _POSTGRES_CXX_FAIL(RuntimeError, "unknown replication message '" << data[0] << "'");
+        }
+    }
+}
+
+void ChangeStream::report() {
+    // Positions written, flushed and applied, the time of the client, and whether a reply is wanted.
+    char       buf[1 + 4 * sizeof(uint64_t) + 1];
+    auto       pos   = buf;
+    auto const acked = acked_.load(std::memory_order_relaxed);
+    *pos++ = 'r';
+    putBytes(pos, std::max(received_, acked));
+    putBytes(pos, acked);
+    putBytes(pos, acked);
+    auto const now = std::chrono::system_clock::now() - Time::EPOCH;
+    putBytes(pos, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count()));
+    *pos = 0;
+
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (PQputCopyData(native(), buf, sizeof(buf)) == 1) && (PQflush(native()) == 0),
+                         "fail to report replication status: " << PQerrorMessage(native()));
+    next_report_ = Clock::now() + interval_;
+}
+
+PGconn* ChangeStream::native() const {
+    return handle_.get();
+}
+
+}  // namespace postgres
@@ -1,31 +1,74 @@
 #include <postgres/internal/Channel.h>
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
 #include <utility>
+#include <postgres/internal/Worker.h>
 #include <postgres/Context.h>
 #include <postgres/Error.h>
 
 namespace postgres::internal {
 
 Channel::Channel(std::shared_ptr<Context const> ctx)
-    : ctx_{std::move(ctx)} {
+    : ctx_{std::move(ctx)}, queue_{ctx_->strictPriority()}, quits_{0}, ids_{0} {
 }
 
 Channel::~Channel() noexcept = default;
 
 void Channel::quit(int count) {
-    while (0 < count--) {
-        send(nullptr, 0);
+    while (0 < count) {
+        std::unique_lock c_guard{mtx_};
+        if (slots_.empty()) {
+            // Lanes reorder jobs, so workers quit once there are none left.
+            quits_ += count;
+            return;
+        }
+
+        auto const slot = slots_.back();
+        slots_.pop_back();
+        c_guard.unlock();
+
+        std::lock_guard s_guard{slot->mtx};
+        slot->job = nullptr;
+        slot->signal.notify_one();
+        --count;
     }
 }
 
 std::tuple<bool, Worker*> Channel::send(Job job) {
-    return send(std::move(job), ctx_->maxQueueSize());
+    return send(std::move(job), Priority::NORMAL);
 }
 
-std::tuple<bool, Worker*> Channel::send(Job job, int const lim) {
+std::tuple<bool, Worker*> Channel::send(Job job, Priority const prio) {
+    return dispatch(std::move(job), prio, nullptr);
+}
+
+std::tuple<bool, Worker*> Channel::send(Job job, Priority const prio, Affinity const aff) {
+    return dispatch(std::move(job), prio, &aff);
+}
+
+std::tuple<bool, Worker*> Channel::dispatch(Job job, Priority const prio, Affinity const* const aff) {
     std::unique_lock c_guard{mtx_};
+    auto const       lim = ctx_->maxQueueSize();
+    if (0 < lim) {
+        reserve(c_guard, lim);
+    }
+
     if (!slots_.empty()) {
-        auto const it   = slots_.begin();
+        // The most recently idle worker is the most likely to be warm,
+        // while the least recent ones are left to time out.
+        auto it = std::prev(slots_.end());
+        if (aff) {
+            // Keys map onto the workers ever run, whose number settles at the max concurrency.
+            auto const id   = static_cast<int>(aff->key % static_cast<size_t>(ids_));
+            auto const home = std::find_if(slots_.begin(), slots_.end(), [id](Slot const* const slot) {
+                return slot->id == id;
+            });
+            if (home != slots_.end()) {
+                it = home;
+            }
+        }
         auto const slot = *it;
         slots_.erase(it);
         c_guard.unlock();
@@ -36,13 +79,8 @@ std::tuple<bool, Worker*> Channel::send(Job job, int const lim) {
         return {true, nullptr};
     }
 
-    if (0 < lim) {
-        _POSTGRES_CXX_ASSERT(RuntimeError,
-                             (static_cast<int>(queue_.size()) < lim),
-                             "queue overflow");
-    }
-
-    queue_.push(std::move(job));
+    job.stamp();
+    queue_.push(std::move(job), prio);
     if (recreation_.empty()) {
         return {false, nullptr};
     }
@@ -52,21 +90,106 @@ std::tuple<bool, Worker*> Channel::send(Job job, int const lim) {
     return {false, worker};
 }
 
+std::vector<std::tuple<bool, Worker*>> Channel::send(std::vector<Job>& jobs, Priority const prio) {
+    std::vector<std::tuple<bool, Worker*>> res{};
+    std::vector<std::pair<Slot*, Job*>>    idle{};
+    std::exception_ptr                     err{};
+    res.reserve(jobs.size());
+
+    std::unique_lock c_guard{mtx_};
+    auto const       lim = ctx_->maxQueueSize();
+    auto             it  = jobs.begin();
+    for (; it != jobs.end(); ++it) {
+        if (!slots_.empty()) {
+            idle.emplace_back(slots_.back(), &*it);
+            slots_.pop_back();
+            res.emplace_back(true, nullptr);
+            continue;
+        }
+        // Workers for the jobs queued so far are started by the caller, so the rest is left to it.
+        if ((it != jobs.begin())
+            && (0 < lim)
+            && (lim <= static_cast<int>(queue_.size()))
+            && (ctx_->overflowPolicy() == OverflowPolicy::BLOCK)) {
+            break;
+        }
+        if (0 < lim) {
+            try {
+                reserve(c_guard, lim);
+            } catch (...) {
+                err = std::current_exception();
+                break;
+            }
+        }
+        it->stamp();
+        queue_.push(std::move(*it), prio);
+        if (recreation_.empty()) {
+            res.emplace_back(false, nullptr);
+        } else {
+            res.emplace_back(false, recreation_.back());
+            recreation_.pop_back();
+        }
+    }
+    c_guard.unlock();
+
+    for (auto const& [slot, job] : idle) {
+        std::lock_guard s_guard{slot->mtx};
+        slot->job.swap(*job);
+        slot->signal.notify_one();
+    }
+    if (err) {
+        for (; it != jobs.end(); ++it) {
+            it->fail(err);
+        }
+    }
+    jobs.erase(jobs.begin(), it);
+    return res;
+}
+
+void Channel::reserve(std::unique_lock<std::mutex>& guard, int const lim) {
+    // Workers wait only for an empty queue, so none is idle while it is full.
+    auto const has_room = [this, lim] {
+        return static_cast<int>(queue_.size()) < lim;
+    };
+    if (has_room()) {
+        return;
+    }
+    // A worker waiting for room could wait for itself.
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (ctx_->overflowPolicy() == OverflowPolicy::BLOCK) && !Worker::serves(*this),
+                         "queue overflow");
+
+    auto const timeout = ctx_->overflowTimeout();
+    if (timeout.count() == 0) {
+        room_.wait(guard, has_room);
+        return;
+    }
+    _POSTGRES_CXX_ASSERT(RuntimeError, room_.wait_for(guard, timeout, has_room), "queue overflow");
+}
+
 void Channel::receive(Slot& slot) {
     std::unique_lock c_guard{mtx_};
+    if (slot.id < 0) {
+        slot.id = ids_++;
+    }
     if (!queue_.empty()) {
-        queue_.front().swap(slot.job);
-        queue_.pop();
+        queue_.pop(slot.job);
+        room_.notify_one();
+        return;
+    }
+    if (0 < quits_) {
+        --quits_;
+        slot.job = nullptr;
         return;
     }
 
-    // Keep slots sorted to detect idle workers.
-    slots_.insert(&slot);
+    slots_.push_back(&slot);
     // Prevent filling the slot until waiting.
     std::unique_lock s_guard{slot.mtx};
     c_guard.unlock();
 
-    auto const timeout = ctx_->idleTimeout();
+    // Persistent workers keep the minimal concurrency despite the idle timeout.
+    auto const timeout = slot.is_persistent ? Context::Duration{} : ctx_->idleTimeout();
     if (timeout.count() == 0) {
         slot.signal.wait(s_guard);
         return;
@@ -78,7 +201,9 @@ void Channel::receive(Slot& slot) {
 
     // Check if other thread is going to fill the slot.
     c_guard.lock();
-    if (0 < slots_.erase(&slot)) {
+    auto const it = std::find(slots_.begin(), slots_.end(), &slot);
+    if (it != slots_.end()) {
+        slots_.erase(it);
         return;
     }
 
@@ -86,14 +211,43 @@ void Channel::receive(Slot& slot) {
     slot.signal.wait(s_guard);
 }
 
+bool Channel::poll(Slot& slot) {
+    std::lock_guard guard{mtx_};
+    if (queue_.empty()) {
+        return false;
+    }
+
+    queue_.pop(slot.job);
+    room_.notify_one();
+    return true;
+}
+
 void Channel::recycle(Worker& worker) {
     std::lock_guard guard{mtx_};
     recreation_.push_back(&worker);
 }
 
+void Channel::requeue(Job job) {
+    std::unique_lock c_guard{mtx_};
+    if (slots_.empty()) {
+        job.stamp();
+        queue_.push(std::move(job), Priority::HIGH);
+        return;
+    }
+
+    auto const slot = slots_.back();
+    slots_.pop_back();
+    c_guard.unlock();
+
+    std::lock_guard s_guard{slot->mtx};
+    slot->job.swap(job);
+    slot->signal.notify_one();
+}
+
 void Channel::drop() {
     std::lock_guard guard{mtx_};
-    auto const      garbage = std::move(queue_);
+    queue_.clear();
+    room_.notify_all();
 }
 
 }  // namespace postgres::internal
@@ -1,36 +1,225 @@
 #include <postgres/Client.h>
 
+#include <exception>
 #include <utility>
 #include <postgres/internal/Channel.h>
 #include <postgres/internal/Dispatcher.h>
+#include <postgres/internal/Flights.h>
+#include <postgres/internal/Reactor.h>
+#include <postgres/internal/ResultCache.h>
+#include <postgres/internal/ShardedChannel.h>
+#include <postgres/internal/StealingChannel.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
 #include <postgres/Context.h>
-#include <postgres/Result.h>
-#include <postgres/Status.h>
+#include <postgres/Listener.h>
+#include <postgres/PreparedCommand.h>
 
 namespace postgres {
 
+namespace {
+
+struct Flight {
+    void operator()(Connection& conn) {
+        try {
+            auto res = conn.exec(cmd);
+            prom.set_value(std::move(res));
+            // Landing only once cached keeps the next query from sending the command again in between.
+            if (cache) {
+                cache->insert(key, std::move(shared), gen);
+            }
+            flights->land(key);
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    }
+
+    void fail(std::exception_ptr const& err) {
+        flights->land(key);
+        prom.set_exception(err);
+    }
+
+    Command                                cmd;
+    std::promise<Result>                   prom;
+    internal::Flights::Key                 key;
+    std::shared_ptr<internal::Flights>     flights;
+    // Results are cached unless the cache is cleared while they are obtained.
+    std::shared_ptr<internal::ResultCache> cache{};
+    std::shared_future<Result>             shared{};
+    uint64_t                               gen = 0;
+};
+
+}  // namespace
+
 Client::Client()
     : Client{Context{}} {
 }
 
 Client::Client(Context ctx) {
-    auto pctx = std::make_shared<Context>(std::move(ctx));
-    auto chan = std::make_shared<internal::Channel>(pctx);
-    impl_ = std::make_unique<Impl>(std::move(pctx), std::move(chan));
+    auto const pctx = std::make_shared<Context const>(std::move(ctx));
+    for (auto const& rep : pctx->replicas()) {
+        replicas_.push_back(std::make_unique<Replica>());
+        replicas_.back()->impl = makeImpl(rep);
+    }
+    if (0 < pctx->cacheTtl().count()) {
+        cache_ = std::make_shared<internal::ResultCache>(pctx->cacheTtl(), pctx->cacheCapacity());
+        if (!pctx->cacheChannel().empty()) {
+            // Whatever was cached while notifications could have been missed may be stale.
+            listener_ = std::make_unique<Listener>(pctx);
+            listener_->onGap([cache = cache_] {
+                cache->clear();
+            });
+            listener_->subscribe(pctx->cacheChannel(), [cache = cache_](Notification const&) {
+                cache->clear();
+            });
+        }
+    }
+    if (0 < pctx->hedgeQuantile()) {
+        hedger_ = std::make_unique<internal::Hedger>(pctx->hedgeQuantile());
+    }
+    if (0 < pctx->reactorThreads()) {
+        reactor_ = std::make_unique<internal::Reactor>(pctx);
+    }
+    impl_ = makeImpl(pctx);
 }
 
 Client::Client(Client&& other) noexcept = default;
 
-Client& Client::operator=(Client&& other) noexcept = default;
+Client& Client::operator=(Client&& other) noexcept {
+    if (hedger_) {
+        hedger_->stop();
+    }
+    replicas_ = std::move(other.replicas_);
+    hedger_   = std::move(other.hedger_);
+    impl_     = std::move(other.impl_);
+    reactor_  = std::move(other.reactor_);
+    next_     = other.next_;
+    flights_  = std::move(other.flights_);
+    listener_ = std::move(other.listener_);
+    cache_    = std::move(other.cache_);
+    return *this;
+}
+
+Client::~Client() noexcept {
+    if (hedger_) {
+        hedger_->stop();
+    }
+}
+
+std::future<Status> Client::exec(Command cmd, Priority const prio) {
+    return run<Status>(std::move(cmd), prio);
+}
+
+std::future<Status> Client::exec(PreparedCommand cmd, Priority const prio) {
+    return run<Status>(std::move(cmd), prio);
+}
+
+std::future<Result> Client::query(Command cmd, Priority const prio) {
+    return run<Result>(std::move(cmd), prio);
+}
+
+std::future<Result> Client::query(PreparedCommand cmd, Priority const prio) {
+    return run<Result>(std::move(cmd), prio);
+}
+
+template <typename T, typename C>
+std::future<T> Client::run(C cmd, Priority const prio) {
+    if (reactor_) {
+        return reactor_->send<T>(std::move(cmd), prio);
+    }
+    return impl_->send<T>([cmd = std::move(cmd)](Connection& conn) {
+        return conn.exec(cmd);
+    }, prio);
+}
+
+std::shared_future<Result> Client::queryShared(Command cmd, Priority const prio) {
+    if (!flights_) {
+        flights_ = std::make_shared<internal::Flights>();
+    }
+
+    auto                 key = internal::Flights::keyOf(cmd);
+    std::promise<Result> prom{std::allocator_arg, internal::PoolAllocator<char>{}};
+    auto const [flight, is_new] = flights_->join(key, prom.get_future().share());
+    if (is_new) {
+        // Otherwise the later queries would join a flight which never lands.
+        try {
+            impl_->post(Flight{std::move(cmd), std::move(prom), key, flights_}, prio);
+        } catch (...) {
+            flights_->land(key);
+            throw;
+        }
+    }
+    return flight;
+}
+
+std::shared_future<Result> Client::queryCached(Command cmd, Priority const prio) {
+    if (!cache_) {
+        return queryShared(std::move(cmd), prio);
+    }
+    if (!flights_) {
+        flights_ = std::make_shared<internal::Flights>();
+    }
+
+    auto key = internal::Flights::keyOf(cmd);
+    if (auto hit = cache_->find(key)) {
+        return std::move(*hit);
+    }
+
+    // Taking the generation before sending keeps a result obtained across a clear() out.
+    auto const           gen = cache_->generation();
+    std::promise<Result> prom{std::allocator_arg, internal::PoolAllocator<char>{}};
+    auto const [flight, is_new] = flights_->join(key, prom.get_future().share());
+    if (is_new) {
+        try {
+            impl_->post(Flight{std::move(cmd), std::move(prom), key, flights_, cache_, flight, gen}, prio);
+        } catch (...) {
+            flights_->land(key);
+            throw;
+        }
+    }
+    return flight;
+}
 
-Client::~Client() noexcept = default;
+void Client::invalidate() {
+    if (cache_) {
+        cache_->clear();
+    }
+}
+
+Metrics Client::metrics() const {
+    return impl_->metrics();
+}
 
-std::future<Status> Client::exec(std::function<Status(Connection&)> job) {
-    return impl_->send(std::move(job));
+std::unique_ptr<Client::Impl> Client::makeImpl(std::shared_ptr<Context const> ctx) {
+    auto chan = std::shared_ptr<internal::IChannel>{};
+    if (ctx->workStealing()) {
+        chan = std::make_shared<internal::StealingChannel>(ctx);
+    } else if (ctx->queueShards() == 1) {
+        chan = std::make_shared<internal::Channel>(ctx);
+    } else {
+        chan = std::make_shared<internal::ShardedChannel>(ctx);
+    }
+    return std::make_unique<Impl>(std::move(ctx), std::move(chan));
 }
 
-std::future<Result> Client::query(std::function<Result(Connection&)> job) {
-    return impl_->send(std::move(job));
+Client::Replica& Client::pick(Replica const* const skip) {
+    // Ties are broken in turn, so that an idle set of replicas is used round-robin.
+    auto const count = replicas_.size();
+    auto       first = next_++ % count;
+    if (replicas_[first].get() == skip) {
+        first = (first + 1) % count;
+    }
+    auto best  = first;
+    auto least = replicas_[first]->load.load(std::memory_order_relaxed);
+    for (auto i = size_t{1}; i < count; ++i) {
+        auto const idx  = (first + i) % count;
+        auto const load = replicas_[idx]->load.load(std::memory_order_relaxed);
+        if ((load < least) && (replicas_[idx].get() != skip)) {
+            best  = idx;
+            least = load;
+        }
+    }
+    return *replicas_[best];
 }
 
 }  // namespace postgres
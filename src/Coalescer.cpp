@@ -0,0 +1,125 @@
+#include <postgres/internal/Coalescer.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <postgres/Connection.h>
+
+namespace postgres::internal {
+namespace {
+
+// Keeps a steady stream of items from holding the worker forever.
+constexpr auto MAX_BATCHES = 16;
+
+}  // namespace
+
+Coalescer::Coalescer(Context::Duration const window, int const limit)
+    : window_{window}, limit_{static_cast<size_t>(limit)} {
+}
+
+Coalescer::~Coalescer() noexcept = default;
+
+bool Coalescer::add(Item item) {
+    std::lock_guard guard{mtx_};
+    items_.push_back(std::move(item));
+    if (limit_ <= items_.size()) {
+        full_.notify_one();
+    }
+    if (is_scheduled_) {
+        return false;
+    }
+    is_scheduled_ = true;
+    return true;
+}
+
+bool Coalescer::run(Connection& conn) {
+    for (auto count = 0; count < MAX_BATCHES; ++count) {
+        auto batch = take();
+        if (batch.empty()) {
+            return false;
+        }
+
+        if (batch.size() == 1) {
+            runAlone(batch.front(), conn);
+        } else {
+            runBatch(batch, conn);
+        }
+        if (!conn.isOk()) {
+            break;
+        }
+    }
+
+    std::lock_guard guard{mtx_};
+    is_scheduled_ = !items_.empty();
+    return is_scheduled_;
+}
+
+void Coalescer::fail(std::exception_ptr const& err) {
+    std::vector<Item> items{};
+    {
+        std::lock_guard guard{mtx_};
+        items.swap(items_);
+        is_scheduled_ = false;
+    }
+    for (auto& item : items) {
+        item.prom.set_exception(err);
+    }
+}
+
+std::vector<Coalescer::Item> Coalescer::take() {
+    std::unique_lock guard{mtx_};
+    if (window_.count() != 0) {
+        full_.wait_for(guard, window_, [this] {
+            return limit_ <= items_.size();
+        });
+    }
+
+    auto const end = items_.begin() + static_cast<std::ptrdiff_t>(std::min(limit_, items_.size()));
+    std::vector<Item> batch{std::make_move_iterator(items_.begin()), std::make_move_iterator(end)};
+    items_.erase(items_.begin(), end);
+    if (batch.empty()) {
+        is_scheduled_ = false;
+    }
+    return batch;
+}
+
+void Coalescer::runBatch(std::vector<Item>& batch, Connection& conn) {
+    std::vector<Status> results{};
+    results.reserve(batch.size());
+    try {
+        conn.execRaw("BEGIN");
+        for (auto& item : batch) {
+            results.push_back(item.job(conn));
+        }
+
+        // COMMIT of an aborted transaction quietly rolls it back, which happens if a job swallows a failure.
+        if (PQtransactionStatus(conn.native()) == PQTRANS_INTRANS) {
+            conn.execRaw("COMMIT");
+            for (size_t idx = 0; idx < batch.size(); ++idx) {
+                batch[idx].prom.set_value(std::move(results[idx]));
+            }
+            return;
+        }
+    } catch (...) {
+    }
+
+    try {
+        if (conn.isOk() && (PQtransactionStatus(conn.native()) != PQTRANS_IDLE)) {
+            conn.execRaw("ROLLBACK");
+        }
+    } catch (...) {
+    }
+    for (auto& item : batch) {
+        runAlone(item, conn);
+    }
+}
+
+void Coalescer::runAlone(Item& item, Connection& conn) {
+    try {
+        item.prom.set_value(item.job(conn));
+    } catch (...) {
+        item.prom.set_exception(std::current_exception());
+    }
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,44 @@
+#include <postgres/internal/Columns.h>
+
+#include <cstring>
+
+namespace postgres::internal {
+
+Columns::Columns(PGresult const& res)
+    : res_{&res} {
+}
+
+Columns::Columns(PGresult const& desc, int const format)
+    : own_{PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK)}, res_{own_.get()} {
+    std::vector<PGresAttDesc> attrs(static_cast<size_t>(PQnfields(&desc)));
+    for (auto i = 0; i < static_cast<int>(attrs.size()); ++i) {
+        auto& attr     = attrs[static_cast<size_t>(i)];
+        attr.name      = PQfname(&desc, i);
+        attr.tableid   = PQftable(&desc, i);
+        attr.columnid  = PQftablecol(&desc, i);
+        attr.format    = format;
+        attr.typid     = PQftype(&desc, i);
+        attr.typlen    = PQfsize(&desc, i);
+        attr.atttypmod = PQfmod(&desc, i);
+    }
+    PQsetResultAttrs(own_.get(), static_cast<int>(attrs.size()), attrs.data());
+}
+
+Columns::~Columns() noexcept = default;
+
+bool Columns::matches(PGresult const& res) const {
+    auto const count = PQnfields(res_);
+    if (PQnfields(&res) != count) {
+        return false;
+    }
+    for (auto i = 0; i < count; ++i) {
+        if ((PQftype(&res, i) != PQftype(res_, i))
+            || (PQfformat(&res, i) != PQfformat(res_, i))
+            || (std::strcmp(PQfname(&res, i), PQfname(res_, i)) != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace postgres::internal
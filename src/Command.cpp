@@ -1,5 +1,9 @@
 #include <postgres/Command.h>
+
+#include <algorithm>
 #include <cstring>
+#include <postgres/internal/Array.h>
+#include <postgres/internal/Numeric.h>
 
 namespace postgres {
 
@@ -9,6 +13,28 @@ Command& Command::operator=(Command&& other) noexcept = default;
 
 Command::~Command() noexcept = default;
 
+void Command::clear() {
+    types_.clear();
+    lengths_.clear();
+    formats_.clear();
+    buf_.clear();
+    values_.clear();
+    borrowed_.clear();
+    base_     = nullptr;
+    resolved_ = 0;
+    offset_   = 0;
+}
+
+size_t Command::memorySize() const {
+    return stmt_buf_.capacity()
+           + types_.capacity() * sizeof(Oid)
+           + lengths_.capacity() * sizeof(int)
+           + formats_.capacity() * sizeof(int)
+           + buf_.capacity()
+           + values_.capacity() * sizeof(char const*)
+           + borrowed_.capacity() * sizeof(size_t);
+}
+
 char const* Command::statement() const {
     return stmt_;
 }
@@ -22,6 +48,25 @@ Oid const* Command::types() const {
 }
 
 char const* const* Command::values() const {
+    if (base_ != buf_.data()) {
+        base_     = buf_.data();
+        resolved_ = 0;
+        offset_   = 0;
+    }
+
+    // Only the values stored in the buffer have non-zero lengths, except for borrowed ones.
+    auto next = std::lower_bound(borrowed_.begin(), borrowed_.end(), resolved_);
+    for (; resolved_ < values_.size(); ++resolved_) {
+        if (lengths_[resolved_] == 0) {
+            continue;
+        }
+        if ((next != borrowed_.end()) && (*next == resolved_)) {
+            ++next;
+            continue;
+        }
+        values_[resolved_] = base_ + offset_;
+        offset_ += static_cast<size_t>(lengths_[resolved_]);
+    }
     return values_.data();
 }
 
@@ -43,14 +88,35 @@ void Command::add(std::chrono::system_clock::time_point const t) {
 }
 
 void Command::add(Time const& t) {
-    if (t.hasZone()) {
-        add(t.toString());
-        types_.back() = TIMESTAMPTZOID;
-        return;
-    }
-
+    // Both timestamps with and without time zone are sent as UTC microseconds.
     add(t.toPostgres());
-    types_.back() = TIMESTAMPOID;
+    types_.back() = t.hasZone() ? TIMESTAMPTZOID : TIMESTAMPOID;
+}
+
+void Command::add(Time::Date const d) {
+    add((d - Time::EPOCH_DATE).count());
+    types_.back() = DATEOID;
+}
+
+void Command::addInterval(std::chrono::microseconds const dur) {
+    // Microseconds followed by days and months, which are left zero to keep the interval exact.
+    auto const micros = internal::orderBytes(static_cast<int64_t>(dur.count()));
+    char       data[16]{};
+    std::memcpy(data, &micros, sizeof(micros));
+    setMeta(INTERVALOID, sizeof(data), 1);
+    storeData(data, sizeof(data));
+}
+
+void Command::add(Decimal const val) {
+    char       data[internal::NUMERIC_MAX_LEN];
+    auto const len = internal::writeNumeric(val, data);
+    setMeta(NUMERICOID, static_cast<int>(len), 1);
+    storeData(data, len);
+}
+
+void Command::add(Uuid const& id) {
+    setMeta(UUIDOID, static_cast<int>(id.bytes.size()), 1);
+    storeData(id.bytes.data(), id.bytes.size());
 }
 
 void Command::add(std::string const& s) {
@@ -58,7 +124,43 @@ void Command::add(std::string const& s) {
 }
 
 void Command::add(std::string_view const s) {
-    add(s.data());
+    // Views are not necessarily terminated, so append the terminator.
+    setMeta(0, static_cast<int>(s.size() + 1), 0);
+    buf_.reserve(buf_.size() + s.size() + 1);
+    buf_.insert(buf_.end(), s.begin(), s.end());
+    storeData("", 1);
+}
+
+void Command::add(Borrowed const arg) {
+    // Null pointer would be sent as NULL. Empty values are skipped for their length anyway.
+    if (!arg.data.empty()) {
+        borrowed_.push_back(values_.size());
+    }
+    setMeta(arg.type, static_cast<int>(arg.data.size()), 1);
+    values_.push_back(arg.data.data() ? arg.data.data() : "");
+}
+
+void Command::add(std::vector<uint8_t> const& bytes) {
+    setMeta(BYTEAOID, static_cast<int>(bytes.size()), 1);
+    if (bytes.empty()) {
+        // Values of zero length are not stored, and null pointer would be sent as NULL.
+        values_.push_back("");
+        return;
+    }
+    storeData(bytes.data(), bytes.size());
+}
+
+void Command::add(std::vector<std::string> const& arr) {
+    auto len = size_t{0};
+    for (auto const& s : arr) {
+        len += s.size();
+    }
+
+    auto const start = beginArray(TEXTOID, arr.size(), len);
+    for (auto const& s : arr) {
+        putItem(s.data(), s.size());
+    }
+    endArray(start);
 }
 
 void Command::add(char const* const s) {
@@ -78,23 +180,79 @@ void Command::setMeta(Oid const id, int const len, int const fmt) {
 }
 
 void Command::storeData(void const* const arg, size_t const len) {
-    auto       storage = buf_.data();
-    auto const old_len = buf_.size();
-    auto const new_len = old_len + len;
-    buf_.resize(new_len);
-    if (buf_.data() != storage) {
-        storage = buf_.data();
-        for (auto i = 0u; i < values_.size(); ++i) {
-            if (values_[i] && lengths_[i]) {
-                values_[i] = storage;
-                storage += lengths_[i];
-            }
+    auto const data = static_cast<char const*>(arg);
+    buf_.insert(buf_.end(), data, data + len);
+    values_.push_back(nullptr);
+}
+
+void Command::reserve(size_t const count, size_t const len) {
+    // Keep the growth geometric when lots of small ranges are added one by one.
+    auto const grow = [](auto& vec, size_t const n) {
+        auto const size = vec.size() + n;
+        if (vec.capacity() < size) {
+            vec.reserve(std::max(size, 2 * vec.capacity()));
         }
-    } else {
-        storage += old_len;
+    };
+    grow(types_, count);
+    grow(values_, count);
+    grow(lengths_, count);
+    grow(formats_, count);
+    grow(buf_, len);
+}
+
+size_t Command::beginArray(Oid const elem, size_t const count, size_t const len) {
+    setMeta(internal::arrayOid(elem), 0, 1);
+    reserve(1, 20 + 4 * count + len);
+
+    auto const start = buf_.size();
+    auto const put   = [this](int32_t const val) {
+        auto const ordered = internal::orderBytes(val);
+        auto const data    = reinterpret_cast<char const*>(&ordered);
+        buf_.insert(buf_.end(), data, data + sizeof(ordered));
+    };
+
+    // Empty arrays have no dimensions.
+    put((count == 0) ? 0 : 1);
+    put(0);
+    put(static_cast<int32_t>(elem));
+    if (count != 0) {
+        put(static_cast<int32_t>(count));
+        put(1);
     }
-    memcpy(storage, arg, len);
-    values_.push_back(storage);
+    return start;
+}
+
+void Command::putItem(void const* const data, size_t const len) {
+    auto const size  = internal::orderBytes(static_cast<int32_t>(len));
+    auto const bytes = reinterpret_cast<char const*>(&size);
+    buf_.insert(buf_.end(), bytes, bytes + sizeof(size));
+
+    auto const item = static_cast<char const*>(data);
+    buf_.insert(buf_.end(), item, item + len);
+}
+
+void Command::putNull() {
+    auto const size  = internal::orderBytes(int32_t{-1});
+    auto const bytes = reinterpret_cast<char const*>(&size);
+    buf_.insert(buf_.end(), bytes, bytes + sizeof(size));
+}
+
+void Command::addItem(std::string const& s) {
+    putItem(s.data(), s.size());
+}
+
+void Command::addItem(std::chrono::system_clock::time_point const t) {
+    auto const item = internal::orderBytes(static_cast<int64_t>(Time{t}.toPostgres()));
+    putItem(&item, sizeof(item));
+}
+
+void Command::addItem(Uuid const& id) {
+    putItem(id.bytes.data(), id.bytes.size());
+}
+
+void Command::endArray(size_t const start) {
+    lengths_.back() = static_cast<int>(buf_.size() - start);
+    values_.push_back(nullptr);
 }
 
 void Command::setStatement(std::string stmt) {
@@ -22,6 +22,26 @@ char const* const* Config::values() const {
     return vals_.data();
 }
 
+void Config::addOptions(std::string const& val) {
+    auto& opts = params_["options"];
+    if (!opts.empty()) {
+        opts += ' ';
+    }
+    opts += val;
+    index();
+}
+
+void Config::index() {
+    keys_.clear();
+    vals_.clear();
+    for (auto const& param : params_) {
+        keys_.push_back(param.first.c_str());
+        vals_.push_back(param.second.c_str());
+    }
+    keys_.push_back(nullptr);
+    vals_.push_back(nullptr);
+}
+
 Config::Builder::Builder() = default;
 
 Config::Builder::Builder(Builder&& other) noexcept = default;
@@ -98,6 +118,10 @@ Config::Builder& Config::Builder::port(int const val) {
     return setNumber("port", val);
 }
 
+Config::Builder& Config::Builder::replication(bool const val) {
+    return set("replication", val ? "database" : "false");
+}
+
 Config::Builder& Config::Builder::requirepeer(std::string const& val) {
     return set("requirepeer", val);
 }
@@ -200,12 +224,7 @@ Config::Builder& Config::Builder::set(std::string const& key, std::string const&
 }
 
 Config Config::Builder::build() {
-    for (auto const& param : cfg_.params_) {
-        cfg_.keys_.push_back(param.first.c_str());
-        cfg_.vals_.push_back(param.second.c_str());
-    }
-    cfg_.keys_.push_back(nullptr);
-    cfg_.vals_.push_back(nullptr);
+    cfg_.index();
     return std::move(cfg_);
 }
 
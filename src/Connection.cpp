@@ -1,19 +1,41 @@
 #include <postgres/Connection.h>
 
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <poll.h>
+#include <postgres/internal/Columns.h>
+#include <postgres/internal/Span.h>
+#include <postgres/internal/StatementCache.h>
+#include <postgres/internal/Stats.h>
 #include <postgres/Config.h>
 #include <postgres/Consumer.h>
 #include <postgres/Error.h>
+#include <postgres/Pipeline.h>
 #include <postgres/PreparedCommand.h>
 #include <postgres/PrepareData.h>
 #include <postgres/Receiver.h>
+#include <postgres/Tracer.h>
 
 namespace postgres {
 
 enum {
     EXPAND_DBNAME = 0,
     RESULT_FORMAT = 1,
+    HOT_USES      = 2,
 };
 
+namespace {
+
+void account(Command const& cmd) {
+    if (auto const stats = internal::Stats::accounting()) {
+        stats->command(cmd.memorySize());
+    }
+}
+
+}  // namespace
+
 PGPing Connection::ping() {
     return ping(Config::build());
 }
@@ -26,6 +48,18 @@ PGPing Connection::ping(std::string const& uri) {
     return PQping(uri.data());
 }
 
+Connection Connection::start() {
+    return start(Config::build());
+}
+
+Connection Connection::start(Config const& cfg) {
+    return Connection{PQconnectStartParams(cfg.keys(), cfg.values(), EXPAND_DBNAME), true};
+}
+
+Connection Connection::start(std::string const& uri) {
+    return Connection{PQconnectStart(uri.data()), true};
+}
+
 Connection::Connection()
     : Connection{Config::build()} {
 }
@@ -39,8 +73,14 @@ Connection::Connection(std::string const& uri)
 }
 
 Connection::Connection(PGconn* const handle)
+    : Connection{handle, false} {
+}
+
+Connection::Connection(PGconn* const handle, bool const is_started)
     : handle_{handle, PQfinish} {
-    _POSTGRES_CXX_ASSERT(RuntimeError, isOk(), "fail to connect: " << message());
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_started ? (PQstatus(native()) != CONNECTION_BAD) : isOk(),
+                         "fail to connect: " << message());
 }
 
 Connection::Connection(Connection&& other) noexcept = default;
@@ -49,93 +89,395 @@ Connection& Connection::operator=(Connection&& other) noexcept = default;
 
 Connection::~Connection() noexcept = default;
 
-Result Connection::exec(PrepareData const& prep) {
-    return Result{PQprepare(native(),
-                            prep.name.data(),
-                            prep.statement.data(),
-                            static_cast<int>(prep.types.size()),
-                            prep.types.data())};
+void Connection::autoPrepare(int const size) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= size, "bad auto prepare size: " << size);
+    if (stmts_) {
+        for (auto const& name : stmts_->clear()) {
+            deallocate(name);
+        }
+        stmts_.reset();
+    }
+    if (0 < size) {
+        stmts_ = std::make_unique<internal::StatementCache>(static_cast<size_t>(size));
+    }
 }
 
-Result Connection::exec(Command const& cmd) {
-    return Result{PQexecParams(native(),
-                               cmd.statement(),
-                               cmd.count(),
-                               cmd.types(),
-                               cmd.values(),
-                               cmd.lengths(),
-                               cmd.formats(),
-                               RESULT_FORMAT)};
+void Connection::defer(PrepareData prep) {
+    defer(std::make_shared<PrepareData const>(std::move(prep)));
 }
 
-Result Connection::exec(PreparedCommand const& cmd) {
-    return Result{PQexecPrepared(native(),
-                                 cmd.statement(),
-                                 cmd.count(),
-                                 cmd.values(),
-                                 cmd.lengths(),
-                                 cmd.formats(),
-                                 RESULT_FORMAT)};
+void Connection::defer(std::shared_ptr<PrepareData const> prep) {
+    if (reprepares_) {
+        known_.insert_or_assign(prep->name, prep);
+    }
+    auto name = prep->name;
+    deferred_.insert_or_assign(std::move(name), std::move(prep));
 }
 
-Status Connection::execRaw(std::string_view const stmt) {
-    return Status{PQexec(native(), stmt.data())};
+void Connection::prepareDeferred() {
+    prepareDeferred({});
 }
 
-Receiver Connection::send(PrepareData const& prep) {
-    return Receiver{handle_,
-                    PQsendPrepare(native(),
-                                  prep.name.data(),
-                                  prep.statement.data(),
-                                  static_cast<int>(prep.types.size()),
-                                  prep.types.data())};
+void Connection::prepareDeferred(std::vector<std::string> const& inits) {
+    if (inits.empty() && deferred_.empty()) {
+        return;
+    }
+
+    auto pipe = Pipeline{handle_};
+    for (auto const& stmt : inits) {
+        pipe.send(Command{stmt});
+    }
+    // Statements described by another connection of the registry need no description.
+    std::vector<bool> describing{};
+    describing.reserve(deferred_.size());
+    for (auto const& [name, prep] : deferred_) {
+        pipe.send(*prep);
+        describing.push_back(describes_ && !reuse(*prep));
+        if (describing.back()) {
+            pipe.describe(name);
+        }
+    }
+    pipe.sync();
+
+    // In case of a failure the statements left are still deferred.
+    auto skip        = inits.size();
+    auto it          = deferred_.begin();
+    auto idx         = size_t{0};
+    auto is_prepared = false;
+    for (auto const& res : pipe) {
+        if (0 < skip) {
+            --skip;
+            continue;
+        }
+        // Each statement is followed by its description, if any.
+        if (describing[idx] && !is_prepared) {
+            is_prepared = true;
+            continue;
+        }
+        if (describing[idx]) {
+            remember(*it->second, res.native());
+        }
+        is_prepared = false;
+        it          = deferred_.erase(it);
+        ++idx;
+    }
 }
 
-Receiver Connection::send(Command const& cmd) {
-    return Receiver{handle_,
-                    PQsendQueryParams(native(),
+void Connection::reprepare(bool const val) {
+    reprepares_ = val;
+    if (!val) {
+        known_.clear();
+    }
+}
+
+void Connection::describe(bool const val) {
+    describes_ = val;
+    if (!val) {
+        described_.clear();
+    }
+}
+
+void Connection::share(std::shared_ptr<StatementRegistry> reg) {
+    registry_ = std::move(reg);
+}
+
+void Connection::trace(std::shared_ptr<Tracer> tracer) {
+    tracer_ = std::move(tracer);
+}
+
+Result Connection::exec(PrepareData const& prep) {
+    auto span = tracer_ ? std::make_unique<internal::Span>(tracer_, prep.statement) : nullptr;
+    auto res  = Result{finish(std::move(span),
+                              PQprepare(native(),
+                                        prep.name.data(),
+                                        prep.statement.data(),
+                                        static_cast<int>(prep.types.size()),
+                                        prep.types.data()))};
+    // Deferred statements are shared rather than copied.
+    auto shared = std::shared_ptr<PrepareData const>{};
+    if (auto const it = deferred_.find(prep.name); it != deferred_.end()) {
+        if (it->second.get() == &prep) {
+            shared = std::move(it->second);
+        }
+        deferred_.erase(it);
+    }
+    if (reprepares_ && res.isOk()) {
+        known_.insert_or_assign(prep.name, shared ? std::move(shared) : std::make_shared<PrepareData const>(prep));
+    }
+    if (describes_ && res.isOk() && !reuse(prep)) {
+        auto const desc = PQdescribePrepared(native(), prep.name.data());
+        remember(prep, desc);
+        PQclear(desc);
+    }
+    return res;
+}
+
+Result Connection::exec(Command const& cmd) {
+    account(cmd);
+    // Statements prepared automatically are still traced by their text.
+    auto span = tracer_ ? std::make_unique<internal::Span>(tracer_, cmd, false) : nullptr;
+    if (auto const name = stmts_ ? prepare(cmd) : nullptr) {
+        auto const run = [this, name, &cmd] {
+            return PQexecPrepared(native(),
+                                  name,
+                                  cmd.count(),
+                                  cmd.values(),
+                                  cmd.lengths(),
+                                  cmd.formats(),
+                                  RESULT_FORMAT);
+        };
+        auto res = run();
+        if (isLost(res)) {
+            PQclear(res);
+            PQclear(PQprepare(native(), name, cmd.statement(), cmd.count(), cmd.types()));
+            res = run();
+        }
+        return Result{finish(std::move(span), res)};
+    }
+
+    return Result{finish(std::move(span),
+                         PQexecParams(native(),
                                       cmd.statement(),
                                       cmd.count(),
                                       cmd.types(),
                                       cmd.values(),
                                       cmd.lengths(),
                                       cmd.formats(),
-                                      RESULT_FORMAT)};
+                                      RESULT_FORMAT))};
+}
+
+Result Connection::exec(PreparedCommand const& cmd) {
+    account(cmd);
+    prepare(cmd);
+    auto       span = tracer_ ? std::make_unique<internal::Span>(tracer_, cmd, true) : nullptr;
+    auto const run  = [this, &cmd] {
+        return PQexecPrepared(native(),
+                              cmd.statement(),
+                              cmd.count(),
+                              cmd.values(),
+                              cmd.lengths(),
+                              cmd.formats(),
+                              RESULT_FORMAT);
+    };
+    auto res = run();
+    if (isLost(res)) {
+        if (auto const it = known_.find(std::string_view{cmd.statement()}); it != known_.end()) {
+            auto const& prep = *it->second;
+            PQclear(res);
+            PQclear(PQprepare(native(),
+                              prep.name.data(),
+                              prep.statement.data(),
+                              static_cast<int>(prep.types.size()),
+                              prep.types.data()));
+            res = run();
+        }
+    }
+    if (!described_.empty()) {
+        if (auto const it = described_.find(std::string_view{cmd.statement()}); it != described_.end()) {
+            return Result::prepared(finish(std::move(span), res), it->second);
+        }
+    }
+    return Result{finish(std::move(span), res)};
+}
+
+Status Connection::execRaw(std::string_view const stmt) {
+    auto span = tracer_ ? std::make_unique<internal::Span>(tracer_, std::string{stmt}) : nullptr;
+    return Status{finish(std::move(span), PQexec(native(), stmt.data()))};
+}
+
+Receiver Connection::send(PrepareData const& prep) {
+    // The statement may replace one described before.
+    if (auto const it = described_.find(prep.name); it != described_.end()) {
+        described_.erase(it);
+    }
+    auto rcvr = Receiver{handle_,
+                         PQsendPrepare(native(),
+                                       prep.name.data(),
+                                       prep.statement.data(),
+                                       static_cast<int>(prep.types.size()),
+                                       prep.types.data())};
+    if (tracer_) {
+        rcvr.span_ = std::make_unique<internal::Span>(tracer_, prep.statement);
+    }
+    return rcvr;
+}
+
+Receiver Connection::send(Command const& cmd) {
+    account(cmd);
+    auto span = tracer_ ? std::make_unique<internal::Span>(tracer_, cmd, false) : nullptr;
+    auto rcvr = Receiver{handle_,
+                         PQsendQueryParams(native(),
+                                           cmd.statement(),
+                                           cmd.count(),
+                                           cmd.types(),
+                                           cmd.values(),
+                                           cmd.lengths(),
+                                           cmd.formats(),
+                                           RESULT_FORMAT)};
+    rcvr.span_ = std::move(span);
+    return rcvr;
 }
 
 Receiver Connection::send(PreparedCommand const& cmd) {
-    return Receiver{handle_,
-                    PQsendQueryPrepared(native(),
-                                        cmd.statement(),
-                                        cmd.count(),
-                                        cmd.values(),
-                                        cmd.lengths(),
-                                        cmd.formats(),
-                                        RESULT_FORMAT)};
+    account(cmd);
+    prepare(cmd);
+    auto span = tracer_ ? std::make_unique<internal::Span>(tracer_, cmd, true) : nullptr;
+    auto rcvr = Receiver{handle_,
+                         PQsendQueryPrepared(native(),
+                                             cmd.statement(),
+                                             cmd.count(),
+                                             cmd.values(),
+                                             cmd.lengths(),
+                                             cmd.formats(),
+                                             RESULT_FORMAT)};
+    rcvr.span_ = std::move(span);
+    return rcvr;
 }
 
 Consumer Connection::sendRaw(std::string_view const stmt) {
     return Consumer{handle_, PQsendQuery(native(), stmt.data())};
 }
 
+CopyWriter Connection::copyIn(std::string_view const stmt) {
+    return CopyWriter{handle_, stmt};
+}
+
+CopyReader Connection::copyOut(std::string_view const stmt) {
+    return CopyReader{handle_, stmt};
+}
+
+ChangeStream Connection::replicate(std::string const&              slot,
+                                   std::vector<std::string> const& publications,
+                                   uint64_t const                  start_lsn,
+                                   ChangeStream::Duration const    status_interval) {
+    _POSTGRES_CXX_ASSERT(LogicError, !publications.empty(), "no publications to replicate");
+    std::string names{};
+    for (auto const& pub : publications) {
+        names += names.empty() ? "" : ",";
+        names += escId(pub);
+    }
+    auto const stmt = "START_REPLICATION SLOT " + escId(slot) + " LOGICAL " + ChangeStream::format(start_lsn)
+                      + " (proto_version '1', publication_names " + esc(names) + ", binary 'true')";
+    return ChangeStream{handle_, stmt, status_interval};
+}
+
 Receiver Connection::iter(Command const& cmd) {
-    auto rcvr = send(cmd);
-    rcvr.iter();
-    return rcvr;
+    return iter(cmd, 1);
 }
 
 Receiver Connection::iter(PreparedCommand const& cmd) {
-    auto rcvr = send(cmd);
-    rcvr.iter();
+    return iter(cmd, 1);
+}
+
+Receiver Connection::iter(Command const& cmd, int const chunk) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < chunk, "bad chunk size: " << chunk);
+    auto const is_idle = PQtransactionStatus(native()) == PQTRANS_IDLE;
+    auto       rcvr    = send(cmd);
+    rcvr.iter(chunk);
+    rcvr.cancels_ = is_idle;
     return rcvr;
 }
 
+Receiver Connection::iter(PreparedCommand const& cmd, int const chunk) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < chunk, "bad chunk size: " << chunk);
+    auto const is_idle = PQtransactionStatus(native()) == PQTRANS_IDLE;
+    auto       rcvr    = send(cmd);
+    rcvr.iter(chunk);
+    rcvr.cancels_ = is_idle;
+    return rcvr;
+}
+
+Cursor Connection::cursor(Command const& cmd, int const size) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < size, "bad fetch size: " << size);
+
+    static std::atomic<uint64_t> next{0};
+    auto name = "_pgcc_cursor_" + std::to_string(next++);
+
+    // Cursors live as long as a transaction.
+    auto const is_owner = (PQtransactionStatus(native()) == PQTRANS_IDLE);
+    if (is_owner) {
+        exec("BEGIN");
+    }
+
+    auto cur  = Cursor{*this, std::move(name), size, is_owner};
+    auto decl = "DECLARE " + cur.name_ + " NO SCROLL CURSOR FOR " + cmd.statement();
+    Result{PQexecParams(native(),
+                        decl.data(),
+                        cmd.count(),
+                        cmd.types(),
+                        cmd.values(),
+                        cmd.lengths(),
+                        cmd.formats(),
+                        RESULT_FORMAT)};
+    return cur;
+}
+
+Oid Connection::createLargeObject() {
+    auto const id = lo_create(native(), InvalidOid);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         id != InvalidOid,
+                         "fail to create large object: " << PQerrorMessage(native()));
+    return id;
+}
+
+LargeObject Connection::openLargeObject(Oid const id, LargeObject::Mode const mode) {
+    // Descriptors live as long as a transaction.
+    auto const is_owner = (PQtransactionStatus(native()) == PQTRANS_IDLE);
+    if (is_owner) {
+        exec("BEGIN");
+    }
+    return LargeObject{*native(), id, mode, is_owner};
+}
+
+void Connection::removeLargeObject(Oid const id) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         lo_unlink(native(), id) == 1,
+                         "fail to remove large object " << id << ": " << PQerrorMessage(native()));
+}
+
+Pipeline Connection::pipeline() {
+    // Statements can't be prepared on demand within a pipeline.
+    prepareDeferred();
+    return Pipeline{handle_};
+}
+
+Result Connection::commit(Pipeline pipe) {
+    pipe.sync();
+
+    std::optional<Result> res{};
+    std::exception_ptr    err{};
+    try {
+        // Results of BEGIN and COMMIT are not interesting.
+        pipe.receive();
+        while (1 < pipe.size()) {
+            res.emplace(pipe.receive());
+        }
+        pipe.receive();
+    } catch (...) {
+        err = std::current_exception();
+    }
+
+    // A failure leaves the transaction aborted, to be rolled back once the pipeline is closed.
+    static_cast<void>(Pipeline{std::move(pipe)});
+    if (err) {
+        if (PQtransactionStatus(native()) != PQTRANS_IDLE) {
+            execRaw("ROLLBACK");
+        }
+        std::rethrow_exception(err);
+    }
+    return std::move(res.value());
+}
+
 Transaction Connection::begin() {
     exec("BEGIN");
     return Transaction{*this};
 }
 
 bool Connection::reset() {
+    // Prepared statements don't survive reconnection.
+    if (stmts_) {
+        stmts_->clear();
+    }
     PQreset(native());
     return isOk();
 }
@@ -144,10 +486,47 @@ bool Connection::isOk() {
     return PQstatus(native()) == CONNECTION_OK;
 }
 
+bool Connection::isAlive() {
+    if (!isOk()) {
+        return false;
+    }
+
+    // Nothing is expected on the socket of an idle connection but notifications, an error or the end of it.
+    pollfd fd{PQsocket(native()), POLLIN, 0};
+    if (::poll(&fd, 1, 0) == 1) {
+        PQconsumeInput(native());
+    }
+    return isOk();
+}
+
 std::string Connection::message() {
     return PQerrorMessage(native());
 }
 
+PostgresPollingStatusType Connection::poll() {
+    return PQconnectPoll(native());
+}
+
+void Connection::setNonBlocking(bool const is_on) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQsetnonblocking(native(), is_on ? 1 : 0) == 0,
+                         "fail to set non-blocking mode: " << message());
+}
+
+bool Connection::isNonBlocking() {
+    return PQisnonblocking(native()) == 1;
+}
+
+bool Connection::flush() {
+    auto const res = PQflush(native());
+    _POSTGRES_CXX_ASSERT(RuntimeError, res != -1, "fail to flush: " << message());
+    return res == 0;
+}
+
+int Connection::socket() {
+    return PQsocket(native());
+}
+
 std::string Connection::esc(std::string const& in) {
     return doEsc(in, PQescapeLiteral);
 }
@@ -165,6 +544,96 @@ std::string Connection::doEsc(std::string const& in, F const f) {
     return res;
 }
 
+char const* Connection::prepare(Command const& cmd) {
+    // Parameter types take part in the key, since they are fixed by preparation.
+    auto const types = reinterpret_cast<char const*>(cmd.types());
+    std::string key = cmd.statement();
+    key.push_back('\0');
+    key.append(types, cmd.count() * sizeof(Oid));
+
+    std::string stale{};
+    auto&       entry = stmts_->use(key, stale);
+    if (!stale.empty()) {
+        deallocate(stale);
+    }
+    if (entry.is_prepared) {
+        return entry.name.data();
+    }
+    if (entry.uses < HOT_USES) {
+        return nullptr;
+    }
+
+    // Executing the statement reports the error if any.
+    auto const res = PQprepare(native(), entry.name.data(), cmd.statement(), cmd.count(), cmd.types());
+    entry.is_prepared = (PQresultStatus(res) == PGRES_COMMAND_OK);
+    PQclear(res);
+    if (!entry.is_prepared) {
+        entry.uses = 0;
+        return nullptr;
+    }
+    return entry.name.data();
+}
+
+void Connection::prepare(PreparedCommand const& cmd) {
+    if (deferred_.empty()) {
+        return;
+    }
+    if (auto const it = deferred_.find(std::string_view{cmd.statement()}); it != deferred_.end()) {
+        // Held on, since preparing drops it from the deferred ones.
+        auto const prep = it->second;
+        exec(*prep);
+    }
+}
+
+void Connection::deallocate(std::string const& name) {
+    // Failures are ignored, since the statement goes away with the session anyway.
+    // Closing by the protocol rather than by SQL is also understood by transaction poolers.
+#ifdef LIBPQ_HAS_CLOSE_PREPARED
+    PQclear(PQclosePrepared(native(), name.data()));
+#else
+    PQclear(PQexec(native(), ("DEALLOCATE " + name).data()));
+#endif
+}
+
+void Connection::remember(PrepareData const& prep, PGresult const* const desc) {
+    if (desc && (PQresultStatus(desc) == PGRES_COMMAND_OK)) {
+        auto cols = std::make_shared<internal::Columns>(*desc, RESULT_FORMAT);
+        if (registry_) {
+            cols = registry_->describe(prep, std::move(cols));
+        }
+        described_.insert_or_assign(prep.name, std::move(cols));
+    } else if (auto const it = described_.find(prep.name); it != described_.end()) {
+        described_.erase(it);
+    }
+}
+
+bool Connection::reuse(PrepareData const& prep) {
+    auto cols = registry_ ? registry_->described(prep) : nullptr;
+    if (!cols) {
+        return false;
+    }
+    described_.insert_or_assign(prep.name, std::move(cols));
+    return true;
+}
+
+bool Connection::isLost(PGresult* const res) const {
+    if (!reprepares_ || (PQresultStatus(res) != PGRES_FATAL_ERROR)
+        || (PQtransactionStatus(native()) != PQTRANS_IDLE)) {
+        return false;
+    }
+    // SQLSTATE of invalid_sql_statement_name, reported for the statements which do not exist.
+    auto const code = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+    return code && (std::string_view{code} == "26000");
+}
+
+PGresult* Connection::finish(std::unique_ptr<internal::Span> const span, PGresult* const res) {
+    if (span) {
+        span->add(res);
+        span->finish();
+    }
+    return res;
+}
+
 PGconn* Connection::native() const {
     return handle_.get();
 }
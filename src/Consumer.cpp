@@ -17,14 +17,20 @@ Consumer::Consumer(Consumer&& other) noexcept = default;
 Consumer& Consumer::operator=(Consumer&& other) noexcept = default;
 
 Consumer::~Consumer() noexcept {
-    while (!consume().isDone()) {
-    }
+    drain();
 }
 
 Status Consumer::consume() {
     return Status{PQgetResult(handle_.get()), this};
 }
 
+std::optional<Status> Consumer::tryConsume() {
+    if (isBusy()) {
+        return std::nullopt;
+    }
+    return consume();
+}
+
 bool Consumer::isOk() const {
     return is_ok_;
 }
@@ -34,4 +40,37 @@ bool Consumer::isBusy() {
     return PQisBusy(handle_.get()) == 1;
 }
 
+void Consumer::cancel() {
+    auto const cancel = PQgetCancel(handle_.get());
+    if (cancel == nullptr) {
+        return;
+    }
+
+    char err[256]{};
+    PQcancel(cancel, err, sizeof(err));
+    PQfreeCancel(cancel);
+}
+
+void Consumer::drain() {
+    // Results are dropped as they are, since those following a cancel end with an error.
+    auto const conn = handle_.get();
+    if (!conn) {
+        return;
+    }
+    if (cancels_) {
+        while (!isBusy()) {
+            auto const res = PQgetResult(conn);
+            if (!res) {
+                return;
+            }
+            PQclear(res);
+        }
+        cancel();
+    }
+
+    while (auto const res = PQgetResult(conn)) {
+        PQclear(res);
+    }
+}
+
 }  // namespace postgres
@@ -1,17 +1,132 @@
 #include <postgres/Context.h>
 
+#include <cctype>
+#include <climits>
+#include <pthread.h>
+#include <sched.h>
+#include <string_view>
 #include <thread>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
 
 namespace postgres {
 
+namespace {
+
+std::string_view trim(std::string_view val) {
+    while (!val.empty() && std::isspace(static_cast<unsigned char>(val.front()))) {
+        val.remove_prefix(1);
+    }
+    while (!val.empty() && (std::isspace(static_cast<unsigned char>(val.back())) || (val.back() == ';'))) {
+        val.remove_suffix(1);
+    }
+    return val;
+}
+
+bool takeWord(std::string_view& val, std::string_view const word) {
+    if ((val.size() <= word.size()) || !std::isspace(static_cast<unsigned char>(val[word.size()]))) {
+        return false;
+    }
+    for (auto i = size_t{0}; i < word.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(val[i])) != word[i]) {
+            return false;
+        }
+    }
+    val = trim(val.substr(word.size()));
+    return true;
+}
+
+// Turns "SET [SESSION] name {=|TO} value" into "-c name=value", giving nothing for anything else,
+// including values the server would parse differently as a startup option.
+std::string toOption(std::string_view stmt) {
+    stmt = trim(stmt);
+    if (!takeWord(stmt, "SET")) {
+        return {};
+    }
+    takeWord(stmt, "SESSION");
+
+    auto len = size_t{0};
+    while ((len < stmt.size())
+           && (std::isalnum(static_cast<unsigned char>(stmt[len])) || (stmt[len] == '_') || (stmt[len] == '.'))) {
+        ++len;
+    }
+    auto const name = stmt.substr(0, len);
+    auto       val  = trim(stmt.substr(len));
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) {
+        return {};
+    }
+    if (!val.empty() && (val.front() == '=')) {
+        val = trim(val.substr(1));
+    } else if (!takeWord(val, "TO")) {
+        return {};
+    }
+
+    if ((2 <= val.size()) && (val.front() == '\'') && (val.back() == '\'')) {
+        val = val.substr(1, val.size() - 2);
+        if (val.find_first_of("'\\") != std::string_view::npos) {
+            return {};
+        }
+    } else {
+        // Unquoted identifiers are folded to lower case by the parser, but not in the options.
+        for (auto const c : val) {
+            if (!std::islower(static_cast<unsigned char>(c)) && !std::isdigit(static_cast<unsigned char>(c))
+                && (std::string_view{"_.,- "}.find(c) == std::string_view::npos)) {
+                return {};
+            }
+        }
+        if (val.empty() || (val == "default")) {
+            return {};
+        }
+    }
+
+    auto res = std::string{"-c "};
+    res.append(name.data(), name.size()).push_back('=');
+    for (auto const c : val) {
+        if (c == ' ') {
+            res.push_back('\\');
+        }
+        res.push_back(c);
+    }
+    return res;
+}
+
+}  // namespace
+
 Context::Context()
     : cfg_{Config::build()},
       max_idle_{0},
+      min_concur_{0},
+      wait_warm_{false},
       max_concur_{static_cast<int>(std::thread::hardware_concurrency())},
+      adapt_concur_{false},
       max_queue_{0},
-      shut_pol_{ShutdownPolicy::GRACEFUL} {
+      over_pol_{OverflowPolicy::THROW},
+      over_timeout_{0},
+      queue_shards_{1},
+      strict_prio_{false},
+      work_steal_{false},
+      reactor_threads_{0},
+      auto_prep_{0},
+      lazy_prep_{false},
+      tx_pooler_{false},
+      describe_prep_{false},
+      coal_window_{0},
+      coal_limit_{64},
+      shut_pol_{ShutdownPolicy::GRACEFUL},
+      hedge_quant_{0},
+      cache_ttl_{0},
+      cache_cap_{size_t{64} << 20},
+      metrics_period_{0},
+      account_mem_{false},
+      budget_{0},
+      budget_pol_{OverflowPolicy::THROW},
+      health_check_{0},
+      reconn_attempts_{0},
+      reconn_backoff_{0},
+      max_connecting_{0},
+      conn_interval_{0},
+      pin_each_{false},
+      stack_size_{0} {
 }
 
 Context::Context(Context&& other) noexcept = default;
@@ -22,28 +137,210 @@ Context::~Context() noexcept = default;
 
 Connection Context::connect() const {
     auto conn = uri_.empty() ? Connection{cfg_} : Connection{uri_};
+    conn.reprepare(tx_pooler_);
+    conn.describe(describe_prep_);
+    conn.share(registry_);
+    if (lazy_prep_) {
+        conn.prepareDeferred(inits_);
+    }
+    if (registry_) {
+        for (auto& prep : registry_->statements()) {
+            conn.defer(std::move(prep));
+        }
+    }
     for (auto const& prep : preparings_) {
-        conn.exec(prep);
+        conn.defer(prep);
     }
+    if (!lazy_prep_) {
+        conn.prepareDeferred(inits_);
+    }
+    conn.autoPrepare(auto_prep_);
+    conn.trace(tracer_);
     return conn;
 }
 
+std::vector<std::string> const& Context::onConnect() const {
+    return inits_;
+}
+
 Context::Duration Context::idleTimeout() const {
     return max_idle_;
 }
 
+int Context::minConcurrency() const {
+    return min_concur_;
+}
+
+bool Context::waitWarmUp() const {
+    return wait_warm_;
+}
+
 int Context::maxConcurrency() const {
     return max_concur_;
 }
 
+bool Context::adaptiveConcurrency() const {
+    return adapt_concur_;
+}
+
 int Context::maxQueueSize() const {
     return max_queue_;
 }
 
+OverflowPolicy Context::overflowPolicy() const {
+    return over_pol_;
+}
+
+Context::Duration Context::overflowTimeout() const {
+    return over_timeout_;
+}
+
+int Context::queueShards() const {
+    return queue_shards_;
+}
+
+bool Context::strictPriority() const {
+    return strict_prio_;
+}
+
+bool Context::workStealing() const {
+    return work_steal_;
+}
+
+int Context::reactorThreads() const {
+    return reactor_threads_;
+}
+
+int Context::autoPrepare() const {
+    return auto_prep_;
+}
+
+bool Context::lazyPrepare() const {
+    return lazy_prep_;
+}
+
+bool Context::transactionPooler() const {
+    return tx_pooler_;
+}
+
+bool Context::describePrepared() const {
+    return describe_prep_;
+}
+
+std::shared_ptr<StatementRegistry> const& Context::statements() const {
+    return registry_;
+}
+
+Context::Duration Context::coalesceWindow() const {
+    return coal_window_;
+}
+
+int Context::coalesceLimit() const {
+    return coal_limit_;
+}
+
 ShutdownPolicy Context::shutdownPolicy() const {
     return shut_pol_;
 }
 
+double Context::hedgeQuantile() const {
+    return hedge_quant_;
+}
+
+Context::Duration Context::cacheTtl() const {
+    return cache_ttl_;
+}
+
+size_t Context::cacheCapacity() const {
+    return cache_cap_;
+}
+
+std::string const& Context::cacheChannel() const {
+    return cache_chan_;
+}
+
+Context::Duration Context::metricsPeriod() const {
+    return metrics_period_;
+}
+
+Context::MetricsSink const& Context::metricsSink() const {
+    return metrics_sink_;
+}
+
+bool Context::accountMemory() const {
+    return account_mem_;
+}
+
+size_t Context::resultBudget() const {
+    return budget_;
+}
+
+OverflowPolicy Context::budgetPolicy() const {
+    return budget_pol_;
+}
+
+Context::Duration Context::healthCheck() const {
+    return health_check_;
+}
+
+int Context::reconnectAttempts() const {
+    return reconn_attempts_;
+}
+
+Context::Duration Context::reconnectBackoff() const {
+    return reconn_backoff_;
+}
+
+int Context::maxConnecting() const {
+    return max_connecting_;
+}
+
+Context::Duration Context::connectInterval() const {
+    return conn_interval_;
+}
+
+std::vector<int> const& Context::cpuAffinity() const {
+    return cpus_;
+}
+
+bool Context::pinEach() const {
+    return pin_each_;
+}
+
+std::string const& Context::threadName() const {
+    return thread_name_;
+}
+
+size_t Context::stackSize() const {
+    return stack_size_;
+}
+
+std::shared_ptr<Tracer> const& Context::tracer() const {
+    return tracer_;
+}
+
+std::vector<std::shared_ptr<Context const>> const& Context::replicas() const {
+    return replicas_;
+}
+
+void Context::foldOptions() {
+    // Settings of the leading statements alone, so that the rest run in the given order.
+    auto opts = std::string{};
+    auto it   = inits_.begin();
+    for (; it != inits_.end(); ++it) {
+        auto const opt = toOption(*it);
+        if (opt.empty()) {
+            break;
+        }
+        opts += opts.empty() ? "" : " ";
+        opts += opt;
+    }
+    if (!opts.empty()) {
+        cfg_.addOptions(opts);
+        inits_.erase(inits_.begin(), it);
+    }
+}
+
 Context::Builder::Builder() = default;
 
 Context::Builder::Builder(Context::Builder&& other) noexcept = default;
@@ -63,7 +360,15 @@ Context::Builder& Context::Builder::uri(std::string uri) {
 }
 
 Context::Builder& Context::Builder::prepare(PrepareData prep) {
-    ctx_.preparings_.push_back(std::move(prep));
+    ctx_.preparings_.push_back(std::make_shared<PrepareData const>(std::move(prep)));
+    return *this;
+}
+
+Context::Builder& Context::Builder::onConnect(std::vector<std::string> stmts) {
+    for (auto& stmt : stmts) {
+        _POSTGRES_CXX_ASSERT(LogicError, !trim(stmt).empty(), "empty statement on connect");
+        ctx_.inits_.push_back(std::move(stmt));
+    }
     return *this;
 }
 
@@ -73,24 +378,218 @@ Context::Builder& Context::Builder::idleTimeout(Context::Duration const val) {
     return *this;
 }
 
+Context::Builder& Context::Builder::minConcurrency(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad min concurrency: " << val);
+    ctx_.min_concur_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::waitWarmUp(bool const val) {
+    ctx_.wait_warm_ = val;
+    return *this;
+}
+
 Context::Builder& Context::Builder::maxConcurrency(int const val) {
     _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad concurrency: " << val);
     ctx_.max_concur_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::adaptiveConcurrency(bool const val) {
+    ctx_.adapt_concur_ = val;
+    return *this;
+}
+
 Context::Builder& Context::Builder::maxQueueSize(int const val) {
     _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad queue size: " << val);
     ctx_.max_queue_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::overflowPolicy(OverflowPolicy const val) {
+    ctx_.over_pol_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::overflowTimeout(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad overflow timeout: " << val.count());
+    ctx_.over_timeout_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::queueShards(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad queue shards: " << val);
+    ctx_.queue_shards_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::strictPriority(bool const val) {
+    ctx_.strict_prio_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::workStealing(bool const val) {
+    ctx_.work_steal_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::reactorThreads(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad reactor threads: " << val);
+    ctx_.reactor_threads_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::autoPrepare(int const size) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= size, "bad auto prepare size: " << size);
+    ctx_.auto_prep_ = size;
+    return *this;
+}
+
+Context::Builder& Context::Builder::lazyPrepare(bool const val) {
+    ctx_.lazy_prep_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::transactionPooler(bool const val) {
+    ctx_.tx_pooler_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::describePrepared(bool const val) {
+    ctx_.describe_prep_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::statements(std::shared_ptr<StatementRegistry> reg) {
+    _POSTGRES_CXX_ASSERT(LogicError, reg, "statement registry is null");
+    ctx_.registry_ = std::move(reg);
+    return *this;
+}
+
+Context::Builder& Context::Builder::coalesceWindow(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad coalesce window: " << val.count());
+    ctx_.coal_window_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::coalesceLimit(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad coalesce limit: " << val);
+    ctx_.coal_limit_ = val;
+    return *this;
+}
+
 Context::Builder& Context::Builder::shutdownPolicy(ShutdownPolicy const val) {
     ctx_.shut_pol_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::replica(Context ctx) {
+    _POSTGRES_CXX_ASSERT(LogicError, ctx.replicas_.empty(), "replica cannot have replicas of its own");
+    ctx_.replicas_.push_back(std::make_shared<Context const>(std::move(ctx)));
+    return *this;
+}
+
+Context::Builder& Context::Builder::hedgeQuantile(double const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, (0 <= val) && (val < 1), "bad hedge quantile: " << val);
+    ctx_.hedge_quant_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::cacheTtl(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad cache ttl: " << val.count());
+    ctx_.cache_ttl_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::cacheCapacity(size_t const val) {
+    ctx_.cache_cap_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::cacheChannel(std::string val) {
+    ctx_.cache_chan_ = std::move(val);
+    return *this;
+}
+
+Context::Builder& Context::Builder::metricsSink(Context::Duration const period, Context::MetricsSink sink) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < period.count(), "bad metrics period: " << period.count());
+    ctx_.metrics_period_ = period;
+    ctx_.metrics_sink_   = std::move(sink);
+    return *this;
+}
+
+Context::Builder& Context::Builder::accountMemory(bool const val) {
+    ctx_.account_mem_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::resultBudget(size_t const bytes, OverflowPolicy const pol) {
+    ctx_.budget_     = bytes;
+    ctx_.budget_pol_ = pol;
+    return *this;
+}
+
+Context::Builder& Context::Builder::healthCheck(Context::Duration const idle) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= idle.count(), "bad health check idle time: " << idle.count());
+    ctx_.health_check_ = idle;
+    return *this;
+}
+
+Context::Builder& Context::Builder::reconnect(int const attempts, Context::Duration const backoff) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= attempts, "bad reconnect attempts: " << attempts);
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= backoff.count(), "bad reconnect backoff: " << backoff.count());
+    ctx_.reconn_attempts_ = attempts;
+    ctx_.reconn_backoff_  = backoff;
+    return *this;
+}
+
+Context::Builder& Context::Builder::connectThrottle(int const max_connecting, Context::Duration const interval) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= max_connecting, "bad max connecting: " << max_connecting);
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= interval.count(), "bad connect interval: " << interval.count());
+    ctx_.max_connecting_ = max_connecting;
+    ctx_.conn_interval_  = interval;
+    return *this;
+}
+
+Context::Builder& Context::Builder::cpuAffinity(std::vector<int> cpus, bool const pin_each) {
+    for (auto const cpu : cpus) {
+        _POSTGRES_CXX_ASSERT(LogicError, (0 <= cpu) && (cpu < CPU_SETSIZE), "bad cpu: " << cpu);
+    }
+    ctx_.cpus_     = std::move(cpus);
+    ctx_.pin_each_ = pin_each;
+    return *this;
+}
+
+Context::Builder& Context::Builder::threadName(std::string val) {
+    ctx_.thread_name_ = std::move(val);
+    return *this;
+}
+
+Context::Builder& Context::Builder::stackSize(size_t const bytes) {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (bytes == 0) || (static_cast<size_t>(PTHREAD_STACK_MIN) <= bytes),
+                         "bad stack size: " << bytes);
+    ctx_.stack_size_ = bytes;
+    return *this;
+}
+
+Context::Builder& Context::Builder::tracer(std::shared_ptr<Tracer> val) {
+    ctx_.tracer_ = std::move(val);
+    return *this;
+}
+
 Context Context::Builder::build() {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         ctx_.min_concur_ <= ctx_.max_concur_,
+                         "min concurrency " << ctx_.min_concur_
+                                            << " exceeds max concurrency " << ctx_.max_concur_);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         ctx_.reactor_threads_ <= ctx_.max_concur_,
+                         "reactor threads " << ctx_.reactor_threads_
+                                            << " exceed max concurrency " << ctx_.max_concur_);
+    if (ctx_.uri_.empty()) {
+        ctx_.foldOptions();
+    }
     return std::move(ctx_);
 }
 
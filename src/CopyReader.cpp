@@ -0,0 +1,208 @@
+#include <postgres/CopyReader.h>
+
+#include <cstring>
+#include <utility>
+#include <postgres/internal/Numeric.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+// Signature, followed by flags and header extension length.
+static char constexpr SIGNATURE[] = "PGCOPY\n\377\r\n\0";
+
+CopyReader::CopyReader(std::shared_ptr<PGconn> handle, std::string_view const stmt)
+    : handle_{std::move(handle)} {
+    auto const res = PQexec(native(), stmt.data());
+    auto const is_ok = PQresultStatus(res) == PGRES_COPY_OUT;
+    std::string const msg = is_ok ? "" : PQresultErrorMessage(res);
+    PQclear(res);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_ok,
+                         "fail to start copying: " << (msg.empty() ? PQerrorMessage(native())
+                                                                     : msg.data()));
+
+    auto constexpr len = sizeof(SIGNATURE) - 1;
+    auto const is_binary = need(len + 2 * sizeof(int32_t))
+                           && (memcmp(buf_.data(), SIGNATURE, len) == 0);
+    if (!is_binary) {
+        abort();
+        _POSTGRES_CXX_FAIL(RuntimeError, "copied data is not in binary format");
+    }
+
+    // Flags are only reserved for future use, the header extension is skipped as a whole.
+    pos_ += len + sizeof(int32_t);
+    auto const ext = static_cast<size_t>(internal::orderBytes<int32_t>(&buf_[pos_]));
+    pos_ += sizeof(int32_t);
+    if (!need(ext)) {
+        abort();
+        _POSTGRES_CXX_FAIL(RuntimeError, "copied data header is truncated");
+    }
+    pos_ += ext;
+}
+
+CopyReader::CopyReader(CopyReader&& other) noexcept = default;
+
+CopyReader::~CopyReader() noexcept {
+    if (handle_) {
+        abort();
+    }
+}
+
+Status CopyReader::finish() {
+    _POSTGRES_CXX_ASSERT(LogicError, handle_, "copying is finished");
+    drain();
+
+    auto const handle = std::move(handle_);
+    auto const res    = PQgetResult(handle.get());
+    while (auto const tail = PQgetResult(handle.get())) {
+        PQclear(tail);
+    }
+    return Status{res};
+}
+
+int CopyReader::size() const {
+    return rows_;
+}
+
+void CopyReader::read(char const* const name, int const len, Time& out) {
+    Time::Point pnt{};
+    read(name, len, pnt);
+    out = Time{pnt};
+}
+
+void CopyReader::read(char const* const name, int const len, Time::Point& out) {
+    check(name, len);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         len == sizeof(int64_t),
+                         "cannot cast copied field '"
+                             << name
+                             << "' of length "
+                             << len
+                             << " to timestamp");
+
+    out = Time::EPOCH;
+    out += std::chrono::microseconds{internal::orderBytes<int64_t>(&buf_[pos_])};
+}
+
+void CopyReader::read(char const* const name, int const len, std::string& out) {
+    check(name, len);
+    out.assign(&buf_[pos_], static_cast<size_t>(len));
+}
+
+void CopyReader::read(char const* const name, int const len, std::vector<uint8_t>& out) {
+    check(name, len);
+    auto const data = reinterpret_cast<uint8_t const*>(&buf_[pos_]);
+    out.assign(data, data + len);
+}
+
+void CopyReader::read(char const* const name, int const len, Decimal& out) {
+    check(name, len);
+    out = internal::readNumeric(&buf_[pos_], len);
+}
+
+void CopyReader::read(char const* const name, int const len, Uuid& out) {
+    check(name, len);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         len == static_cast<int>(out.bytes.size()),
+                         "cannot cast copied field '"
+                             << name
+                             << "' of length "
+                             << len
+                             << " to uuid");
+
+    std::memcpy(out.bytes.data(), &buf_[pos_], out.bytes.size());
+}
+
+void CopyReader::check(char const* const name, int const len) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         0 <= len,
+                         "cannot store NULL of copied field '" << name << "' to non-optional");
+}
+
+bool CopyReader::next() {
+    _POSTGRES_CXX_ASSERT(LogicError, handle_, "copying is finished");
+    if (is_over_ || !need(sizeof(int16_t))) {
+        is_over_ = true;
+        return false;
+    }
+
+    cols_ = internal::orderBytes<int16_t>(&buf_[pos_]);
+    col_  = 0;
+    pos_ += sizeof(int16_t);
+    if (cols_ < 0) {
+        is_over_ = true;
+        return false;
+    }
+    return true;
+}
+
+int CopyReader::field() {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         need(sizeof(int32_t)),
+                         "copied row is truncated");
+    auto const len = internal::orderBytes<int32_t>(&buf_[pos_]);
+    pos_ += sizeof(int32_t);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (len < 0) || need(static_cast<size_t>(len)),
+                         "copied row is truncated");
+    return len;
+}
+
+bool CopyReader::need(size_t const len) {
+    // The server sends a message per row, so the buffer only keeps it
+    // and the tail of the previous one when a value crosses their boundary.
+    while (buf_.size() - pos_ < len) {
+        if (is_end_) {
+            return false;
+        }
+
+        char* data = nullptr;
+        auto const size = PQgetCopyData(native(), &data, 0);
+        if (size == -1) {
+            is_end_ = true;
+            return false;
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             0 <= size,
+                             "fail to receive copy data: " << PQerrorMessage(native()));
+
+        buf_.erase(buf_.begin(), buf_.begin() + static_cast<std::ptrdiff_t>(pos_));
+        pos_ = 0;
+        buf_.insert(buf_.end(), data, data + size);
+        PQfreemem(data);
+    }
+    return true;
+}
+
+void CopyReader::drain() {
+    char* data = nullptr;
+    while (!is_end_ && (0 <= PQgetCopyData(native(), &data, 0))) {
+        PQfreemem(data);
+        data = nullptr;
+    }
+    is_end_  = true;
+    is_over_ = true;
+    buf_.clear();
+    pos_ = 0;
+}
+
+void CopyReader::abort() {
+    // The server would otherwise send the rest of the data only to have it dropped.
+    if (!is_end_) {
+        if (auto const cancel = PQgetCancel(native())) {
+            char err[256]{};
+            PQcancel(cancel, err, sizeof(err));
+            PQfreeCancel(cancel);
+        }
+    }
+    drain();
+    while (auto const res = PQgetResult(native())) {
+        PQclear(res);
+    }
+}
+
+PGconn* CopyReader::native() const {
+    return handle_.get();
+}
+
+}  // namespace postgres
@@ -0,0 +1,133 @@
+#include <postgres/CopyWriter.h>
+
+#include <cstring>
+#include <utility>
+#include <postgres/internal/Numeric.h>
+#include <postgres/Error.h>
+#include <postgres/Status.h>
+
+namespace postgres {
+
+// Signature, flags and header extension length.
+static char constexpr HEADER[] = "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0";
+
+CopyWriter::CopyWriter(std::shared_ptr<PGconn> handle, std::string_view const stmt)
+    : handle_{std::move(handle)} {
+    auto const res = PQexec(native(), stmt.data());
+    auto const is_ok = PQresultStatus(res) == PGRES_COPY_IN;
+    std::string const msg = is_ok ? "" : PQresultErrorMessage(res);
+    PQclear(res);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_ok,
+                         "fail to start copying: " << (msg.empty() ? PQerrorMessage(native())
+                                                                     : msg.data()));
+    buf_.reserve(CHUNK_SIZE * 2);
+    append(HEADER, sizeof(HEADER) - 1);
+}
+
+CopyWriter::CopyWriter(CopyWriter&& other) noexcept = default;
+
+CopyWriter::~CopyWriter() noexcept {
+    if (!handle_) {
+        return;
+    }
+
+    PQputCopyEnd(native(), "copying is aborted");
+    while (auto const res = PQgetResult(native())) {
+        PQclear(res);
+    }
+}
+
+Status CopyWriter::finish() {
+    _POSTGRES_CXX_ASSERT(LogicError, handle_, "copying is finished");
+    put(int16_t{-1});
+    flush();
+
+    auto const handle = std::move(handle_);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQputCopyEnd(handle.get(), nullptr) == 1,
+                         "fail to finish copying: " << PQerrorMessage(handle.get()));
+
+    auto const res = PQgetResult(handle.get());
+    while (auto const tail = PQgetResult(handle.get())) {
+        PQclear(tail);
+    }
+    return Status{res};
+}
+
+int CopyWriter::size() const {
+    return rows_;
+}
+
+void CopyWriter::add(std::nullptr_t) {
+    put(int32_t{-1});
+    ++cols_;
+}
+
+void CopyWriter::add(std::chrono::system_clock::time_point const t) {
+    add(Time{t});
+}
+
+void CopyWriter::add(Time const& t) {
+    // Both timestamps with and without time zone are stored as UTC microseconds.
+    putLength(sizeof(int64_t));
+    put(int64_t{t.toPostgres()});
+}
+
+void CopyWriter::add(std::string const& s) {
+    add(std::string_view{s});
+}
+
+void CopyWriter::add(std::string_view const s) {
+    putLength(s.size());
+    append(s.data(), s.size());
+}
+
+void CopyWriter::add(std::vector<uint8_t> const& bytes) {
+    putLength(bytes.size());
+    append(bytes.data(), bytes.size());
+}
+
+void CopyWriter::add(Decimal const val) {
+    char       data[internal::NUMERIC_MAX_LEN];
+    auto const len = internal::writeNumeric(val, data);
+    putLength(len);
+    append(data, len);
+}
+
+void CopyWriter::add(Uuid const& id) {
+    putLength(id.bytes.size());
+    append(id.bytes.data(), id.bytes.size());
+}
+
+void CopyWriter::add(char const* const s) {
+    s ? add(std::string_view{s}) : add(nullptr);
+}
+
+void CopyWriter::putLength(size_t const len) {
+    put(static_cast<int32_t>(len));
+    ++cols_;
+}
+
+void CopyWriter::append(void const* const data, size_t const len) {
+    auto const pos = buf_.size();
+    buf_.resize(pos + len);
+    memcpy(&buf_[pos], data, len);
+}
+
+void CopyWriter::flush() {
+    if (buf_.empty()) {
+        return;
+    }
+
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQputCopyData(native(), buf_.data(), static_cast<int>(buf_.size())) == 1,
+                         "fail to send copy data: " << PQerrorMessage(native()));
+    buf_.clear();
+}
+
+PGconn* CopyWriter::native() const {
+    return handle_.get();
+}
+
+}  // namespace postgres
@@ -0,0 +1,83 @@
+#include <postgres/Cursor.h>
+
+#include <utility>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+Cursor::Cursor(Connection& conn, std::string name, int const size, bool const is_owner)
+    : conn_{&conn},
+      name_{std::move(name)},
+      fetch_{"FETCH " + std::to_string(size) + " FROM " + name_},
+      is_owner_{is_owner} {
+}
+
+Cursor::Cursor(Cursor&& other) noexcept
+    : conn_{other.conn_},
+      name_{std::move(other.name_)},
+      fetch_{std::move(other.fetch_)},
+      is_owner_{other.is_owner_} {
+    other.conn_ = nullptr;
+}
+
+Cursor::~Cursor() noexcept {
+    close();
+}
+
+Result Cursor::fetch() {
+    _POSTGRES_CXX_ASSERT(LogicError, conn_, "cursor is closed");
+    return Result{PQexec(conn_->native(), fetch_.data())};
+}
+
+void Cursor::close() {
+    if (!conn_) {
+        return;
+    }
+
+    // Failures are ignored, since the cursor goes away with the transaction anyway.
+    auto const conn = conn_;
+    conn_ = nullptr;
+    auto const stmt = is_owner_ ? std::string{"COMMIT"} : ("CLOSE " + name_);
+    PQclear(PQexec(conn->native(), stmt.data()));
+}
+
+Cursor::iterator Cursor::begin() {
+    return iterator{*this, false};
+}
+
+Cursor::iterator Cursor::end() {
+    return iterator{*this, true};
+}
+
+Cursor::iterator::iterator(Cursor& cur, bool const is_done)
+    : cur_{&cur}, res_{nullptr, nullptr}, is_done_{is_done} {
+    if (!is_done_) {
+        ++*this;
+    }
+}
+
+Cursor::iterator::iterator(iterator&& other) noexcept = default;
+
+Cursor::iterator& Cursor::iterator::operator=(iterator&& other) noexcept = default;
+
+Cursor::iterator::~iterator() noexcept = default;
+
+bool Cursor::iterator::operator==(iterator const& other) const {
+    return (cur_ == other.cur_) && (is_done_ == other.is_done_);
+}
+
+bool Cursor::iterator::operator!=(iterator const& other) const {
+    return !(*this == other);
+}
+
+void Cursor::iterator::operator++() {
+    res_     = cur_->fetch();
+    is_done_ = res_.isEmpty();
+}
+
+Result Cursor::iterator::operator*() {
+    return std::move(res_);
+}
+
+}  // namespace postgres
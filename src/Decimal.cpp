@@ -0,0 +1,32 @@
+#include <postgres/Decimal.h>
+
+namespace postgres {
+
+std::string Decimal::toString() const {
+    auto const is_neg = value < 0;
+    auto       mag    = is_neg ? (uint64_t{0} - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+
+    // Digits are written backwards, padding the fraction with zeros.
+    std::string res{};
+    for (auto idx = 0; (idx <= scale) || (mag != 0); ++idx) {
+        if ((idx == scale) && (0 < scale)) {
+            res += '.';
+        }
+        res += static_cast<char>('0' + mag % 10);
+        mag /= 10;
+    }
+    if (is_neg) {
+        res += '-';
+    }
+    return std::string{res.rbegin(), res.rend()};
+}
+
+double Decimal::toDouble() const {
+    auto div = 1.;
+    for (auto idx = 0; idx < scale; ++idx) {
+        div *= 10.;
+    }
+    return static_cast<double>(value) / div;
+}
+
+}  // namespace postgres
@@ -1,15 +1,35 @@
 #include <postgres/internal/Dispatcher.h>
 
+#include <postgres/internal/Limiter.h>
+#include <postgres/internal/Stats.h>
+#include <postgres/internal/Throttle.h>
 #include <postgres/internal/Worker.h>
 #include <postgres/Context.h>
 
 namespace postgres::internal {
 
 Dispatcher::Dispatcher(std::shared_ptr<Context const> ctx, std::shared_ptr<IChannel> chan)
-    : ctx_{std::move(ctx)}, chan_{std::move(chan)} {
+    : ctx_{std::move(ctx)},
+      chan_{std::move(chan)},
+      stats_{std::make_shared<Stats>()},
+      coal_{std::make_unique<Coalescer>(ctx_->coalesceWindow(), ctx_->coalesceLimit())} {
+    if (ctx_->adaptiveConcurrency()) {
+        lim_ = std::make_shared<Limiter>(ctx_->minConcurrency(), ctx_->maxConcurrency());
+    }
+    if (0 < ctx_->resultBudget()) {
+        budget_ = std::make_shared<Budget>(ctx_->resultBudget(), ctx_->budgetPolicy(), ctx_->overflowTimeout());
+    }
+    if ((0 < ctx_->maxConnecting()) || (0 < ctx_->connectInterval().count())) {
+        throttle_ = std::make_shared<Throttle>(ctx_->maxConnecting(), ctx_->connectInterval());
+    }
+    warmUp();
+    if (ctx_->metricsSink()) {
+        reporter_ = std::make_unique<Reporter>(stats_, ctx_->metricsPeriod(), ctx_->metricsSink());
+    }
 }
 
 Dispatcher::~Dispatcher() noexcept {
+    reporter_.reset();
     switch (ctx_->shutdownPolicy()) {
         case ShutdownPolicy::DROP: {
             chan_->drop();
@@ -25,26 +45,77 @@ Dispatcher::~Dispatcher() noexcept {
     }
 }
 
+void Dispatcher::warmUp() {
+    std::vector<std::future<void>> conns{};
+    for (auto i = 0; i < ctx_->minConcurrency(); ++i) {
+        auto worker = std::make_unique<internal::Worker>(ctx_, chan_);
+        worker->keepAlive();
+        worker->limitBy(lim_);
+        worker->reportTo(stats_);
+        worker->chargeTo(budget_);
+        // The initial connections are paced but not capped, since none of them would be made up later.
+        worker->throttleBy(throttle_);
+        if (throttle_) {
+            throttle_->enter();
+        }
+        conns.push_back(worker->run());
+        workers_.push_back(std::move(worker));
+    }
+
+    if (!ctx_->waitWarmUp()) {
+        return;
+    }
+    // Failed workers are recreated on demand like the recycled ones.
+    for (auto const& conn : conns) {
+        conn.wait();
+    }
+}
+
 void Dispatcher::scale(std::tuple<bool, Worker*> const params) {
     auto const[is_sent, recycled] = params;
+    stats_->send();
     if (is_sent) {
         return;
     }
 
-    if (recycled != nullptr) {
-        recycled->run();
+    // Running workers are going to take the job anyway.
+    if (lim_ && !lim_->allows()) {
+        if (recycled != nullptr) {
+            chan_->recycle(*recycled);
+        }
         return;
     }
 
-    if (size() == ctx_->maxConcurrency()) {
+    if ((recycled == nullptr) && (size() == ctx_->maxConcurrency())) {
+        return;
+    }
+
+    // The job waits in the queue for the connections in progress, and fails with the last of them.
+    if (throttle_ && !throttle_->admit()) {
+        if (recycled != nullptr) {
+            chan_->recycle(*recycled);
+        }
+        return;
+    }
+
+    if (recycled != nullptr) {
+        recycled->run();
         return;
     }
 
     auto worker = std::make_unique<internal::Worker>(ctx_, chan_);
+    worker->limitBy(lim_);
+    worker->reportTo(stats_);
+    worker->chargeTo(budget_);
+    worker->throttleBy(throttle_);
     worker->run();
     workers_.push_back(std::move(worker));
 }
 
+Metrics Dispatcher::metrics() const {
+    return stats_->snapshot();
+}
+
 inline int Dispatcher::size() const {
     return static_cast<int>(workers_.size());
 }
@@ -38,6 +38,10 @@ RuntimeError::RuntimeError(std::string msg)
     : Error{std::move(msg)} {
 }
 
+RuntimeError::RuntimeError(std::string msg, std::string code)
+    : Error{std::move(msg)}, code_{std::move(code)} {
+}
+
 RuntimeError::RuntimeError(RuntimeError const& other) = default;
 
 RuntimeError& RuntimeError::operator=(RuntimeError const& other) = default;
@@ -48,4 +52,8 @@ RuntimeError& RuntimeError::operator=(RuntimeError&& other) noexcept = default;
 
 RuntimeError::~RuntimeError() noexcept = default;
 
+char const* RuntimeError::code() const noexcept {
+    return code_.data();
+}
+
 }  // namespace postgres
@@ -1,5 +1,11 @@
 #include <postgres/Field.h>
 
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <postgres/internal/Numeric.h>
+
 namespace postgres {
 
 Field::Field(PGresult& res, int const row_idx, int const col_idx)
@@ -19,52 +25,185 @@ Field::~Field() noexcept = default;
 void Field::read(Time& out) const {
     Time::Point pnt{};
     read(pnt);
-    out = Time{pnt};
+    out = Time{pnt, type() == TIMESTAMPTZOID};
 }
 
 void Field::read(Time::Point& out) const {
+    // Both timestamps with and without time zone are received as UTC microseconds.
     _POSTGRES_CXX_ASSERT(LogicError,
-                         type() == TIMESTAMPOID,
+                         (type() == TIMESTAMPOID) || (type() == TIMESTAMPTZOID),
                          "cannot cast field '"
                              << name()
                              << "' of type "
                              << type()
-                             << " to timestamp without time zone");
+                             << " to timestamp");
 
     out = Time::EPOCH;
     out += std::chrono::microseconds{internal::orderBytes<int64_t>(value())};
 }
 
+void Field::read(Time::Date& out) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         type() == DATEOID,
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to date");
+
+    out = Time::EPOCH_DATE + Time::Days{internal::orderBytes<int32_t>(value())};
+}
+
+std::chrono::microseconds Field::readInterval() const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         type() == INTERVALOID,
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to duration");
+
+    // Microseconds followed by days and months.
+    auto const months = internal::orderBytes<int32_t>(value() + 12);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         months == 0,
+                         "cannot cast field '" << name() << "' with months to duration");
+
+    auto const days = internal::orderBytes<int32_t>(value() + 8);
+    return std::chrono::microseconds{internal::orderBytes<int64_t>(value())} + std::chrono::hours{24 * days};
+}
+
 void Field::read(std::string& out) const {
-    out = std::string{value(), static_cast<size_t>(length())};
+    auto const txt = text();
+    out.assign(txt.data(), txt.size());
+}
+
+void Field::read(std::pmr::string& out) const {
+    auto const txt = text();
+    out.assign(txt.data(), txt.size());
+}
+
+void Field::readIn(std::pmr::string& out, std::pmr::memory_resource& mem) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         !isNull(),
+                         "cannot store NULL value of field '"
+                             << name()
+                             << "' into variable of non-optional type");
+    if (*out.get_allocator().resource() == mem) {
+        read(out);
+        return;
+    }
+
+    // Strings never take over an allocator on assignment, so construct it anew.
+    // The copy is made first, since moving it in cannot throw.
+    auto const       txt = text();
+    std::pmr::string tmp{txt.data(), txt.size(), &mem};
+    std::destroy_at(&out);
+    new (&out) std::pmr::string{std::move(tmp)};
+}
+
+void Field::readIn(std::optional<std::pmr::string>& out, std::pmr::memory_resource& mem) const {
+    if (isNull()) {
+        out.reset();
+        return;
+    }
+    auto const txt = text();
+    out.emplace(txt.data(), txt.size(), &mem);
 }
 
 void Field::read(std::string_view& out) const {
-    out = std::string_view{value(), static_cast<size_t>(length())};
+    out = text();
 }
 
-bool Field::isNull() const {
-    return PQgetisnull(res_, row_idx_, col_idx_) == 1;
+void Field::read(std::vector<uint8_t>& out) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         type() == BYTEAOID,
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to bytes");
+
+    auto const data = reinterpret_cast<uint8_t const*>(value());
+    out.assign(data, data + length());
 }
 
-char const* Field::name() const {
-    return PQfname(res_, col_idx_);
+void Field::read(Decimal& out) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         type() == NUMERICOID,
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to decimal");
+
+    out = internal::readNumeric(value(), length());
 }
 
-char const* Field::value() const {
-    return PQgetvalue(res_, row_idx_, col_idx_);
+void Field::read(Uuid& out) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (type() == UUIDOID) && (length() == static_cast<int>(out.bytes.size())),
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to uuid");
+
+    std::memcpy(out.bytes.data(), value(), out.bytes.size());
 }
 
-Oid Field::type() const {
-    return PQftype(res_, col_idx_);
+void Field::read(std::vector<std::string>& out) const {
+    checkArray();
+    internal::ArrayReader arr{value(), length()};
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (arr.type() == TEXTOID) || (arr.type() == VARCHAROID),
+                         "cannot cast elements of field '"
+                             << name()
+                             << "' of type "
+                             << arr.type()
+                             << " to string");
+
+    out.clear();
+    out.reserve(static_cast<size_t>(arr.size()));
+    for (auto i = 0; i < arr.size(); ++i) {
+        auto       len = 0;
+        auto const val = item(arr, len);
+        out.emplace_back(val, static_cast<size_t>(len));
+    }
+}
+
+std::string_view Field::text() const {
+    std::string_view res{value(), static_cast<size_t>(length())};
+    if ((type() == JSONBOID) && (format() == 1) && !res.empty()) {
+        _POSTGRES_CXX_ASSERT(RuntimeError, res[0] == 1, "unsupported jsonb version of field '" << name() << "'");
+        res.remove_prefix(1);
+    }
+    return res;
+}
+
+void Field::checkArray() const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         internal::elementOid(type()) != 0,
+                         "cannot cast field '"
+                             << name()
+                             << "' of type "
+                             << type()
+                             << " to vector");
 }
 
-int Field::length() const {
-    return PQgetlength(res_, row_idx_, col_idx_);
+char const* Field::item(internal::ArrayReader& arr, int& len) const {
+    auto const val = arr.next(len);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         val != nullptr,
+                         "cannot store NULL element of field '"
+                             << name()
+                             << "' into vector of non-optional type");
+    return val;
 }
 
-int Field::format() const {
-    return PQfformat(res_, col_idx_);
+char const* Field::item(internal::ArrayReader& arr) const {
+    auto len = 0;
+    return item(arr, len);
 }
 
 }  // namespace postgres
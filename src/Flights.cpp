@@ -0,0 +1,51 @@
+#include <postgres/internal/Flights.h>
+
+#include <cstring>
+#include <postgres/Command.h>
+
+namespace postgres::internal {
+
+Flights::Flights() = default;
+
+Flights::~Flights() noexcept = default;
+
+Flights::Key Flights::keyOf(Command const& cmd) {
+    auto const count = cmd.count();
+    auto const put   = [](Key& key, auto const val) {
+        char bytes[sizeof(val)];
+        std::memcpy(bytes, &val, sizeof(val));
+        key.append(bytes, sizeof(val));
+    };
+
+    Key key{cmd.statement()};
+    key.push_back('\0');
+    put(key, count);
+    for (auto i = 0; i < count; ++i) {
+        put(key, cmd.types()[i]);
+        put(key, cmd.formats()[i]);
+
+        // The server reads text values up to the terminator, whatever their lengths.
+        auto const val = cmd.values()[i];
+        auto const len = (val == nullptr)
+                         ? -1
+                         : (cmd.formats()[i] == 0) ? static_cast<int>(std::strlen(val)) : cmd.lengths()[i];
+        put(key, len);
+        if (0 < len) {
+            key.append(val, static_cast<size_t>(len));
+        }
+    }
+    return key;
+}
+
+std::pair<std::shared_future<Result>, bool> Flights::join(Key const& key, std::shared_future<Result> const& flight) {
+    std::lock_guard guard{mtx_};
+    auto const [it, is_new] = flights_.try_emplace(key, flight);
+    return {it->second, is_new};
+}
+
+void Flights::land(Key const& key) {
+    std::lock_guard guard{mtx_};
+    flights_.erase(key);
+}
+
+}  // namespace postgres::internal
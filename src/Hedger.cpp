@@ -0,0 +1,89 @@
+#include <postgres/internal/Hedger.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace postgres::internal {
+
+Hedger::Hedger(double const quantile)
+    : quantile_{quantile} {
+    thread_ = std::thread([this] {
+        run();
+    });
+}
+
+Hedger::~Hedger() noexcept {
+    stop();
+}
+
+std::optional<std::chrono::microseconds> Hedger::delay() const {
+    auto const val = delay_.load(std::memory_order_relaxed);
+    if (val < 0) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds{val};
+}
+
+void Hedger::record(Clock::duration const took) {
+    std::vector<int64_t> samples{};
+    {
+        std::lock_guard guard{mtx_};
+        samples_[count_ % SAMPLES] = std::chrono::duration_cast<std::chrono::microseconds>(took).count();
+        ++count_;
+        if (count_ % REFRESH != 0) {
+            return;
+        }
+        samples.assign(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(std::min(count_, SAMPLES)));
+    }
+
+    // Sorting outside the lock keeps the workers recording their durations from waiting.
+    auto const idx = static_cast<size_t>(quantile_ * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx), samples.end());
+    delay_.store(samples[idx], std::memory_order_relaxed);
+}
+
+void Hedger::schedule(Deadline const deadline, std::function<void()> call) {
+    std::lock_guard guard{mtx_};
+    auto const      key = Key{deadline, next_++};
+    calls_.emplace(key, std::move(call));
+    if (calls_.begin()->first == key) {
+        signal_.notify_one();
+    }
+}
+
+void Hedger::stop() {
+    {
+        std::lock_guard guard{mtx_};
+        is_done_ = true;
+        calls_.clear();
+        signal_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Hedger::run() {
+    std::unique_lock guard{mtx_};
+    while (!is_done_) {
+        if (calls_.empty()) {
+            signal_.wait(guard);
+            continue;
+        }
+
+        auto const it       = calls_.begin();
+        auto const deadline = it->first.first;
+        if (Clock::now() < deadline) {
+            signal_.wait_until(guard, deadline);
+            continue;
+        }
+
+        auto call = std::move(it->second);
+        calls_.erase(it);
+        guard.unlock();
+        call();
+        guard.lock();
+    }
+}
+
+}  // namespace postgres::internal
@@ -1,7 +1,31 @@
 #include <postgres/internal/IChannel.h>
 
+#include <utility>
+
 namespace postgres::internal {
 
 IChannel::~IChannel() noexcept = default;
 
+std::tuple<bool, Worker*> IChannel::send(Job job, Priority) {
+    return send(std::move(job));
+}
+
+std::tuple<bool, Worker*> IChannel::send(Job job, Priority const prio, Affinity) {
+    return send(std::move(job), prio);
+}
+
+std::vector<std::tuple<bool, Worker*>> IChannel::send(std::vector<Job>& jobs, Priority const prio) {
+    std::vector<std::tuple<bool, Worker*>> res{};
+    res.reserve(jobs.size());
+    for (auto& job : jobs) {
+        res.push_back(send(std::move(job), prio));
+    }
+    jobs.clear();
+    return res;
+}
+
+void IChannel::requeue(Job job) {
+    send(std::move(job), Priority::HIGH);
+}
+
 }  // namespace postgres::internal
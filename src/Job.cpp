@@ -1 +1,72 @@
 #include <postgres/internal/Job.h>
+
+namespace postgres::internal {
+
+Job::Job() noexcept = default;
+
+Job::Job(std::nullptr_t) noexcept {
+}
+
+Job::Job(Job&& other) noexcept
+    : ops_{other.ops_}, queued_{other.queued_} {
+    if (ops_) {
+        ops_->move(&other.buf_, &buf_);
+        other.ops_ = nullptr;
+    }
+}
+
+Job& Job::operator=(Job&& other) noexcept {
+    if (this != &other) {
+        *this = nullptr;
+        if (other.ops_) {
+            other.ops_->move(&other.buf_, &buf_);
+            std::swap(ops_, other.ops_);
+        }
+        queued_ = other.queued_;
+    }
+    return *this;
+}
+
+Job& Job::operator=(std::nullptr_t) noexcept {
+    if (ops_) {
+        ops_->destroy(&buf_);
+        ops_ = nullptr;
+    }
+    return *this;
+}
+
+Job::~Job() noexcept {
+    *this = nullptr;
+}
+
+Job::operator bool() const noexcept {
+    return ops_ != nullptr;
+}
+
+void Job::operator()(Connection& conn) const {
+    ops_->call(const_cast<Storage*>(&buf_), conn);
+}
+
+void Job::fail(std::exception_ptr const& err) const {
+    ops_->fail(const_cast<Storage*>(&buf_), err);
+}
+
+void Job::swap(Job& other) noexcept {
+    Job tmp{std::move(other)};
+    other = std::move(*this);
+    *this = std::move(tmp);
+}
+
+void Job::stamp() noexcept {
+    queued_ = Clock::now();
+}
+
+Job::Clock::duration Job::waited(Clock::time_point const now) const noexcept {
+    return (queued_ == Clock::time_point{}) ? Clock::duration{} : now - queued_;
+}
+
+size_t Job::pooledSize() const noexcept {
+    return ops_ ? ops_->pooled : 0;
+}
+
+}  // namespace postgres::internal
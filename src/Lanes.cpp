@@ -0,0 +1,54 @@
+#include <postgres/internal/Lanes.h>
+
+#include <utility>
+
+namespace postgres::internal {
+
+Lanes::Lanes(bool const is_strict)
+    : is_strict_{is_strict}, credits_{WEIGHTS}, size_{0} {
+}
+
+Lanes::~Lanes() noexcept = default;
+
+bool Lanes::empty() const {
+    return size_ == 0;
+}
+
+size_t Lanes::size() const {
+    return size_;
+}
+
+void Lanes::push(Job job, Priority const prio) {
+    queues_[static_cast<size_t>(prio)].push(std::move(job));
+    ++size_;
+}
+
+void Lanes::pop(Job& job) {
+    while (true) {
+        for (size_t i = 0; i < COUNT; ++i) {
+            auto& queue = queues_[i];
+            if (queue.empty() || (!is_strict_ && (credits_[i] == 0))) {
+                continue;
+            }
+
+            if (!is_strict_) {
+                --credits_[i];
+            }
+            queue.front().swap(job);
+            queue.pop();
+            --size_;
+            return;
+        }
+        // Every lane having jobs has run out of credits.
+        credits_ = WEIGHTS;
+    }
+}
+
+void Lanes::clear() {
+    for (auto& queue : queues_) {
+        queue = std::queue<Job>{};
+    }
+    size_ = 0;
+}
+
+}  // namespace postgres::internal
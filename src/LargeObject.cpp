@@ -0,0 +1,135 @@
+#include <postgres/LargeObject.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <libpq/libpq-fs.h>
+
+namespace postgres {
+
+LargeObject::LargeObject(PGconn& conn, Oid const id, Mode const mode, bool const is_owner)
+    : conn_{&conn}, oid_{id}, is_owner_{is_owner} {
+    auto const flags = (mode == Mode::READ) ? INV_READ
+                                            : (mode == Mode::WRITE) ? INV_WRITE : (INV_READ | INV_WRITE);
+    fd_ = lo_open(conn_, oid_, flags);
+    if (fd_ < 0) {
+        std::string const msg = PQerrorMessage(&conn);
+        release();
+        _POSTGRES_CXX_FAIL(RuntimeError, "fail to open large object " << id << ": " << msg);
+    }
+}
+
+LargeObject::LargeObject(LargeObject&& other) noexcept
+    : conn_{other.conn_}, oid_{other.oid_}, fd_{other.fd_}, is_owner_{other.is_owner_} {
+    other.conn_ = nullptr;
+}
+
+LargeObject::~LargeObject() noexcept {
+    release();
+}
+
+Oid LargeObject::oid() const {
+    return oid_;
+}
+
+size_t LargeObject::read(char* const buf, size_t const len) {
+    check(true, "read");
+    auto total = size_t{0};
+    while (total < len) {
+        auto const part = std::min(len - total, MAX_CALL);
+        auto const res  = lo_read(conn_, fd_, buf + total, part);
+        check(0 <= res, "read");
+        total += static_cast<size_t>(res);
+        if (static_cast<size_t>(res) < part) {
+            break;
+        }
+    }
+    return total;
+}
+
+void LargeObject::write(char const* const data, size_t const len) {
+    check(true, "write");
+    for (auto total = size_t{0}; total < len;) {
+        auto const part = std::min(len - total, MAX_CALL);
+        auto const res  = lo_write(conn_, fd_, data + total, part);
+        check(0 <= res, "write");
+        total += static_cast<size_t>(res);
+    }
+}
+
+size_t LargeObject::read(int64_t const offset, char* const buf, size_t const len) {
+    seek(offset);
+    return read(buf, len);
+}
+
+void LargeObject::write(int64_t const offset, char const* const data, size_t const len) {
+    seek(offset);
+    write(data, len);
+}
+
+int64_t LargeObject::seek(int64_t const offset, int const whence) {
+    check(true, "seek");
+    auto const res = lo_lseek64(conn_, fd_, offset, whence);
+    check(0 <= res, "seek");
+    return res;
+}
+
+int64_t LargeObject::tell() {
+    check(true, "tell");
+    auto const res = lo_tell64(conn_, fd_);
+    check(0 <= res, "tell");
+    return res;
+}
+
+int64_t LargeObject::size() {
+    auto const pos  = tell();
+    auto const size = seek(0, SEEK_END);
+    seek(pos);
+    return size;
+}
+
+void LargeObject::truncate(int64_t const len) {
+    check(true, "truncate");
+    check(lo_truncate64(conn_, fd_, len) == 0, "truncate");
+}
+
+void LargeObject::close() {
+    if (!conn_) {
+        return;
+    }
+
+    // The transaction is ended even if the descriptor fails to close.
+    auto const  conn = conn_;
+    std::string msg{};
+    conn_ = nullptr;
+    if ((0 <= fd_) && (lo_close(conn, fd_) < 0)) {
+        msg = PQerrorMessage(conn);
+    }
+    if (is_owner_) {
+        auto const res = PQexec(conn, "COMMIT");
+        // Committing a failed transaction rolls it back without an error.
+        auto const is_ok = (PQresultStatus(res) == PGRES_COMMAND_OK) && (std::strcmp(PQcmdStatus(res), "COMMIT") == 0);
+        if (!is_ok && msg.empty()) {
+            msg = (PQresultStatus(res) == PGRES_COMMAND_OK) ? "transaction is rolled back" : PQerrorMessage(conn);
+        }
+        PQclear(res);
+    }
+    _POSTGRES_CXX_ASSERT(RuntimeError, msg.empty(), "fail to close large object " << oid_ << ": " << msg);
+}
+
+void LargeObject::release() noexcept {
+    try {
+        close();
+    } catch (...) {
+        // Nothing is left to clean up, and there is no one to report the failure to.
+    }
+}
+
+void LargeObject::check(bool const is_ok, char const* const action) const {
+    _POSTGRES_CXX_ASSERT(LogicError, conn_, "large object is closed");
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_ok,
+                         "fail to " << action << " large object " << oid_ << ": " << PQerrorMessage(conn_));
+}
+
+}  // namespace postgres
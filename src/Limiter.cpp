@@ -0,0 +1,81 @@
+#include <postgres/internal/Limiter.h>
+
+#include <algorithm>
+
+namespace postgres::internal {
+
+Limiter::Limiter(int const min, int const max)
+    : min_{std::max(min, 1)},
+      max_{std::max(max, min_)},
+      limit_{min_},
+      running_{0},
+      base_{Duration::max()},
+      sum_{0},
+      count_{0} {
+}
+
+Limiter::~Limiter() noexcept = default;
+
+int Limiter::limit() const {
+    return limit_.load(std::memory_order_relaxed);
+}
+
+int Limiter::running() const {
+    return running_.load(std::memory_order_relaxed);
+}
+
+bool Limiter::allows() const {
+    return running() < limit();
+}
+
+void Limiter::enter() {
+    running_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Limiter::leave() {
+    running_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool Limiter::keep() {
+    auto cur = running();
+    while (limit() < cur) {
+        if (running_.compare_exchange_weak(cur, cur - 1, std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Limiter::record(Duration const latency) {
+    // Samples are not worth waiting for.
+    std::unique_lock guard{mtx_, std::try_to_lock};
+    if (!guard) {
+        return;
+    }
+
+    // Judge by the average over a window of as many jobs as may run at once.
+    sum_ += latency;
+    auto const lim = limit();
+    if (++count_ < lim) {
+        return;
+    }
+
+    auto const avg = sum_ / count_;
+    sum_   = Duration{0};
+    count_ = 0;
+
+    if (avg < base_) {
+        base_ = avg;
+    } else {
+        // Let the baseline follow a database getting slower for good.
+        base_ += (avg - base_) / 16;
+    }
+
+    if (avg <= base_ * TOLERANCE) {
+        limit_.store(std::min(lim + 1, max_), std::memory_order_relaxed);
+    } else {
+        limit_.store(std::max(lim * 3 / 4, min_), std::memory_order_relaxed);
+    }
+}
+
+}  // namespace postgres::internal
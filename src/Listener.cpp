@@ -0,0 +1,237 @@
+#include <postgres/Listener.h>
+
+#include <cerrno>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+namespace {
+
+auto constexpr RECONNECT_MS = 1000;
+
+}  // namespace
+
+Listener::Listener()
+    : Listener{Context{}} {
+}
+
+Listener::Listener(Context ctx, int const threads)
+    : Listener{std::make_shared<Context const>(std::move(ctx)), threads} {
+}
+
+Listener::Listener(std::shared_ptr<Context const> ctx, int const threads)
+    : ctx_{std::move(ctx)} {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= threads, "bad threads: " << threads);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         ::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) == 0,
+                         "fail to create pipe");
+    for (auto i = 0; i < threads; ++i) {
+        pool_.emplace_back([this] {
+            serve();
+        });
+    }
+    thread_ = std::thread([this] {
+        run();
+    });
+}
+
+Listener::~Listener() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+    }
+    wake();
+    thread_.join();
+
+    // The callbacks already received are run before stopping.
+    cond_.notify_all();
+    for (auto& thread : pool_) {
+        thread.join();
+    }
+    ::close(wake_[0]);
+    ::close(wake_[1]);
+}
+
+void Listener::subscribe(std::string channel, Callback cb) {
+    {
+        std::lock_guard guard{mtx_};
+        subs_[std::move(channel)] = std::make_shared<Callback const>(std::move(cb));
+    }
+    wake();
+}
+
+void Listener::unsubscribe(std::string const& channel) {
+    {
+        std::lock_guard guard{mtx_};
+        subs_.erase(channel);
+    }
+    wake();
+}
+
+void Listener::onGap(std::function<void()> cb) {
+    std::lock_guard guard{mtx_};
+    gap_ = std::make_shared<std::function<void()> const>(std::move(cb));
+}
+
+void Listener::run() {
+    while (true) {
+        try {
+            auto conn = ctx_->connect();
+            if (conn.isOk()) {
+                listen(conn);
+                return;
+            }
+        } catch (...) {
+        }
+
+        gap();
+        if (wait(-1, RECONNECT_MS)) {
+            std::lock_guard guard{mtx_};
+            if (is_stopped_) {
+                return;
+            }
+        }
+    }
+}
+
+void Listener::listen(Connection& conn) {
+    std::unordered_set<std::string> listened{};
+    sync(conn, listened);
+    gap();
+
+    while (true) {
+        if (wait(conn.socket(), -1)) {
+            {
+                std::lock_guard guard{mtx_};
+                if (is_stopped_) {
+                    return;
+                }
+            }
+            sync(conn, listened);
+        } else {
+            receive(conn);
+        }
+    }
+}
+
+void Listener::sync(Connection& conn, std::unordered_set<std::string>& listened) {
+    std::unordered_set<std::string> subscribed{};
+    {
+        std::lock_guard guard{mtx_};
+        for (auto const& [channel, _] : subs_) {
+            subscribed.insert(channel);
+        }
+    }
+
+    for (auto it = listened.begin(); it != listened.end();) {
+        if (subscribed.count(*it) == 0) {
+            conn.exec("UNLISTEN " + conn.escId(*it));
+            it = listened.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto const& channel : subscribed) {
+        if (listened.count(channel) == 0) {
+            conn.exec("LISTEN " + conn.escId(channel));
+            listened.insert(channel);
+        }
+    }
+    // Notifications may have arrived along with the results.
+    receive(conn);
+}
+
+void Listener::receive(Connection& conn) {
+    _POSTGRES_CXX_ASSERT(RuntimeError, PQconsumeInput(conn.native()) == 1, conn.message());
+
+    while (auto const note = PQnotifies(conn.native())) {
+        auto msg = Notification{note->relname, note->extra, note->be_pid};
+        PQfreemem(note);
+
+        auto cb = std::shared_ptr<Callback const>{};
+        {
+            std::lock_guard guard{mtx_};
+            auto const      it = subs_.find(msg.channel);
+            if (it != subs_.end()) {
+                cb = it->second;
+            }
+        }
+        if (cb) {
+            post([cb = std::move(cb), msg = std::move(msg)] {
+                (*cb)(msg);
+            });
+        }
+    }
+}
+
+void Listener::gap() {
+    auto cb = std::shared_ptr<std::function<void()> const>{};
+    {
+        std::lock_guard guard{mtx_};
+        cb = gap_;
+    }
+    if (cb) {
+        post([cb = std::move(cb)] {
+            (*cb)();
+        });
+    }
+}
+
+void Listener::post(Task task) {
+    {
+        std::lock_guard guard{mtx_};
+        tasks_.push_back(std::move(task));
+    }
+    cond_.notify_one();
+}
+
+void Listener::serve() {
+    while (true) {
+        auto task = Task{};
+        {
+            std::unique_lock lock{mtx_};
+            cond_.wait(lock, [this] {
+                return is_stopped_ || !tasks_.empty();
+            });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // Callbacks are to handle their own errors, there is no one to report them to.
+        }
+    }
+}
+
+bool Listener::wait(int const socket, int const timeout_ms) {
+    pollfd fds[2]{{wake_[0], POLLIN, 0}, {socket, POLLIN, 0}};
+    auto const count = (socket < 0) ? 1 : 2;
+    while ((::poll(fds, static_cast<nfds_t>(count), timeout_ms) < 0) && (errno == EINTR)) {
+    }
+    if ((fds[0].revents & POLLIN) == 0) {
+        return false;
+    }
+
+    char buf[64];
+    while (0 < ::read(wake_[0], buf, sizeof(buf))) {
+    }
+    return true;
+}
+
+void Listener::wake() {
+    char const sig = 0;
+    static_cast<void>(::write(wake_[1], &sig, 1));
+}
+
+}  // namespace postgres
@@ -0,0 +1,151 @@
+#include <postgres/internal/Numeric.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+namespace {
+
+uint16_t constexpr SIGN_NEG = 0x4000;
+uint16_t constexpr SIGN_NAN = 0xC000;
+uint16_t constexpr BASE     = 10000;
+int constexpr      MAX_SCALE = 18;
+
+uint64_t constexpr POW10[] = {1,
+                              10,
+                              100,
+                              1000,
+                              10000,
+                              100000,
+                              1000000,
+                              10000000,
+                              100000000,
+                              1000000000,
+                              10000000000,
+                              100000000000,
+                              1000000000000,
+                              10000000000000,
+                              100000000000000,
+                              1000000000000000,
+                              10000000000000000,
+                              100000000000000000,
+                              1000000000000000000};
+
+// Multiplies and adds unless the result exceeds the limit.
+bool fuse(uint64_t& acc, uint64_t const mul, uint64_t const add, uint64_t const lim) {
+    if ((lim - add) / mul < acc) {
+        return false;
+    }
+    acc = acc * mul + add;
+    return true;
+}
+
+template <typename T>
+void write(T const val, char*& out) {
+    auto const ordered = orderBytes(val);
+    std::memcpy(out, &ordered, sizeof(ordered));
+    out += sizeof(ordered);
+}
+
+}  // namespace
+
+Decimal readNumeric(char const* const data, int const len) {
+    _POSTGRES_CXX_ASSERT(RuntimeError, 8 <= len, "numeric of length " << len << " is truncated");
+
+    auto const count  = orderBytes<int16_t>(data);
+    auto const weight = orderBytes<int16_t>(data + 2);
+    auto const sign   = orderBytes<uint16_t>(data + 4);
+    auto const scale  = orderBytes<int16_t>(data + 6);
+    _POSTGRES_CXX_ASSERT(RuntimeError, 8 + 2 * count <= len, "numeric of length " << len << " is truncated");
+    _POSTGRES_CXX_ASSERT(LogicError, (sign & SIGN_NAN) != SIGN_NAN, "cannot cast NaN or infinite numeric to decimal");
+
+    auto const is_neg = (sign == SIGN_NEG);
+    auto const lim    = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + is_neg;
+
+    // Decimal exponents of the lowest digit accumulated so far and of the one the display scale requires.
+    auto const cut = -static_cast<int>(scale);
+    auto       low = cut;
+    auto       acc = uint64_t{0};
+    auto       is_ok = true;
+    for (auto idx = 0; is_ok && (idx < count); ++idx) {
+        auto const exp   = 4 * (weight - idx);
+        auto const digit = orderBytes<uint16_t>(data + 8 + 2 * idx);
+        if (cut <= exp) {
+            is_ok = fuse(acc, BASE, digit, lim);
+            low   = exp;
+        } else if (cut < exp + 4) {
+            auto const keep = exp + 4 - cut;
+            is_ok = fuse(acc, POW10[keep], digit / POW10[4 - keep], lim);
+            low   = cut;
+        } else {
+            break;
+        }
+    }
+    for (; is_ok && (cut < low); --low) {
+        is_ok = fuse(acc, 10, 0, lim);
+    }
+    _POSTGRES_CXX_ASSERT(LogicError, is_ok && (scale <= MAX_SCALE), "numeric is out of decimal range");
+
+    auto const val = is_neg ? static_cast<int64_t>(uint64_t{0} - acc) : static_cast<int64_t>(acc);
+    return Decimal{val, scale};
+}
+
+size_t writeNumeric(Decimal const val, char* const out) {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 <= val.scale) && (val.scale <= MAX_SCALE),
+                         "bad decimal scale: " << val.scale);
+
+    auto const is_neg = val.value < 0;
+    auto const mag    = is_neg ? (uint64_t{0} - static_cast<uint64_t>(val.value)) : static_cast<uint64_t>(val.value);
+    auto       whole  = mag / POW10[val.scale];
+    auto       frac   = mag % POW10[val.scale];
+
+    // Digits are collected from the lowest one, the partial last group of the fraction padded with zeros.
+    uint16_t digits[10]{};
+    auto     size  = 0;
+    auto     rest  = val.scale;
+    if (auto const part = rest % 4) {
+        digits[size++] = static_cast<uint16_t>(frac % POW10[part] * POW10[4 - part]);
+        frac /= POW10[part];
+        rest -= part;
+    }
+    for (; 0 < rest; rest -= 4) {
+        digits[size++] = static_cast<uint16_t>(frac % BASE);
+        frac /= BASE;
+    }
+    auto const frac_size = size;
+    for (; whole != 0; whole /= BASE) {
+        digits[size++] = static_cast<uint16_t>(whole % BASE);
+    }
+
+    // Zero groups around are not sent.
+    auto weight = size - frac_size - 1;
+    auto first  = size;
+    while ((0 < first) && (digits[first - 1] == 0)) {
+        --first;
+        --weight;
+    }
+    auto last = 0;
+    while ((last < first) && (digits[last] == 0)) {
+        ++last;
+    }
+    if (first == last) {
+        weight = 0;
+    }
+
+    auto it = out;
+    write(static_cast<int16_t>(first - last), it);
+    write(static_cast<int16_t>(weight), it);
+    write(static_cast<uint16_t>(is_neg ? SIGN_NEG : 0), it);
+    write(static_cast<int16_t>(val.scale), it);
+    for (auto idx = first; last < idx; --idx) {
+        write(digits[idx - 1], it);
+    }
+    return static_cast<size_t>(it - out);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,44 @@
+#include <postgres/internal/Parallel.h>
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace postgres::internal {
+
+void parallelFor(int const size, int const threads, int const grain, std::function<void(int, int)> const& f) {
+    auto const parts = std::max(1, std::min(threads, size / std::max(1, grain)));
+    if (parts == 1) {
+        f(0, size);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(static_cast<size_t>(parts));
+    auto const                      run = [&f, &errors, size, parts](int const part) {
+        try {
+            f(static_cast<int>(static_cast<long long>(size) * part / parts),
+              static_cast<int>(static_cast<long long>(size) * (part + 1) / parts));
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool{};
+    pool.reserve(static_cast<size_t>(parts - 1));
+    for (auto part = 1; part < parts; ++part) {
+        pool.emplace_back(run, part);
+    }
+    run(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (auto const& err : errors) {
+        if (err) {
+            std::rethrow_exception(err);
+        }
+    }
+}
+
+}  // namespace postgres::internal
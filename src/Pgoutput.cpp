@@ -0,0 +1,205 @@
+#include <postgres/internal/Pgoutput.h>
+
+#include <cstring>
+#include <utility>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+class Pgoutput::Reader {
+public:
+    explicit Reader(char const* const data, size_t const len)
+        : pos_{data}, end_{data + len} {
+    }
+
+    template <typename T>
+    T num() {
+        return orderBytes<T>(bytes(sizeof(T)));
+    }
+
+    char byte() {
+        return *bytes(1);
+    }
+
+    std::string str() {
+        auto const end = static_cast<char const*>(std::memchr(pos_, '\0', static_cast<size_t>(end_ - pos_)));
+        _POSTGRES_CXX_ASSERT(RuntimeError, end, "replication message is truncated");
+        std::string res{pos_, static_cast<size_t>(end - pos_)};
+        pos_ = end + 1;
+        return res;
+    }
+
+    char const* bytes(size_t const len) {
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             len <= static_cast<size_t>(end_ - pos_),
+                             "replication message is truncated");
+        auto const res = pos_;
+        pos_ += len;
+        return res;
+    }
+
+private:
+    char const* pos_;
+    char const* end_;
+};
+
+Pgoutput::Pgoutput() = default;
+
+Pgoutput::Pgoutput(Pgoutput&& other) noexcept = default;
+
+Pgoutput& Pgoutput::operator=(Pgoutput&& other) noexcept = default;
+
+Pgoutput::~Pgoutput() noexcept = default;
+
+void Pgoutput::decode(char const* const data, size_t const len, uint64_t const lsn, std::deque<Change>& out) {
+    Reader     rd{data, len};
+    auto const type = rd.byte();
+    switch (type) {
+        case 'B': {
+            auto& chg = out.emplace_back();
+            chg.kind  = Change::Kind::BEGIN;
+            chg.lsn   = rd.num<uint64_t>();
+            rd.num<int64_t>();
+            chg.xid   = rd.num<uint32_t>();
+            break;
+        }
+        case 'C': {
+            // Flags and the position of the commit record are followed by the end of the transaction.
+            rd.byte();
+            rd.num<uint64_t>();
+            auto& chg = out.emplace_back();
+            chg.kind  = Change::Kind::COMMIT;
+            chg.lsn   = rd.num<uint64_t>();
+            break;
+        }
+        case 'R': {
+            describe(rd);
+            break;
+        }
+        case 'I': {
+            auto const& rel = relation(rd.num<uint32_t>());
+            rd.byte();
+            auto        row = tuple(rd, rel);
+            auto&       chg = out.emplace_back();
+            chg.kind   = Change::Kind::INSERT;
+            chg.lsn    = lsn;
+            chg.schema = rel.schema;
+            chg.table  = rel.table;
+            chg.row.emplace(std::move(row));
+            break;
+        }
+        case 'U':
+        case 'D': {
+            auto const& rel = relation(rd.num<uint32_t>());
+            Change      chg{};
+            chg.kind   = (type == 'U') ? Change::Kind::UPDATE : Change::Kind::DELETE;
+            chg.lsn    = lsn;
+            chg.schema = rel.schema;
+            chg.table  = rel.table;
+
+            // The old row of an update is only sent when its key has changed or the replica identity is full.
+            auto tag = rd.byte();
+            if ((tag == 'K') || (tag == 'O')) {
+                chg.old.emplace(tuple(rd, rel));
+                if (type == 'U') {
+                    tag = rd.byte();
+                }
+            }
+            if (tag == 'N') {
+                chg.row.emplace(tuple(rd, rel));
+            }
+            out.push_back(std::move(chg));
+            break;
+        }
+        case 'T': {
+            auto const count = rd.num<int32_t>();
+            rd.byte();
+            std::vector<Relation const*> rels{};
+            for (auto i = 0; i < count; ++i) {
+                rels.push_back(&relation(rd.num<uint32_t>()));
+            }
+            for (auto const rel : rels) {
+                auto& chg = out.emplace_back();
+                chg.kind   = Change::Kind::TRUNCATE;
+                chg.lsn    = lsn;
+                chg.schema = rel->schema;
+                chg.table  = rel->table;
+            }
+            break;
+        }
+        default: {
+            // Origins, types and logical messages carry no changes of rows.
+            break;
+        }
+    }
+}
+
+void Pgoutput::describe(Reader& rd) {
+    auto const id  = rd.num<uint32_t>();
+    auto       rel = Relation{};
+    rel.schema = rd.str();
+    rel.table  = rd.str();
+    rd.byte();
+
+    auto const count = rd.num<int16_t>();
+    for (auto i = 0; i < count; ++i) {
+        rd.byte();
+        rel.names.push_back(rd.str());
+        rel.types.push_back(rd.num<uint32_t>());
+        rd.num<int32_t>();
+    }
+    rels_.insert_or_assign(id, std::move(rel));
+}
+
+Pgoutput::Relation const& Pgoutput::relation(Oid const id) const {
+    auto const it = rels_.find(id);
+    _POSTGRES_CXX_ASSERT(RuntimeError, it != rels_.end(), "replicated relation " << id << " is not described");
+    return it->second;
+}
+
+Result Pgoutput::tuple(Reader& rd, Relation const& rel) {
+    auto const count = static_cast<size_t>(rd.num<int16_t>());
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         count == rel.names.size(),
+                         "replicated row of " << rel.table << " has " << count << " columns, "
+                                              << rel.names.size() << " expected");
+
+    struct Value {
+        char const* data = nullptr;
+        int         len  = -1;
+        int         fmt  = 1;
+    };
+    std::vector<Value>        vals(count);
+    std::vector<PGresAttDesc> attrs(count);
+    for (auto i = size_t{0}; i < count; ++i) {
+        auto&      val = vals[i];
+        auto const tag = rd.byte();
+        switch (tag) {
+            case 't':
+            case 'b': {
+                val.fmt  = (tag == 'b') ? 1 : 0;
+                val.len  = rd.num<int32_t>();
+                val.data = rd.bytes(static_cast<size_t>(val.len));
+                break;
+            }
+            default: {
+                // NULLs and unchanged values, which are left out.
+                break;
+            }
+        }
+        attrs[i].name   = const_cast<char*>(rel.names[i].data());
+        attrs[i].typid  = rel.types[i];
+        attrs[i].format = val.fmt;
+        attrs[i].typlen = -1;
+    }
+
+    auto const res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PQsetResultAttrs(res, static_cast<int>(count), attrs.data());
+    for (auto i = size_t{0}; i < count; ++i) {
+        PQsetvalue(res, 0, static_cast<int>(i), const_cast<char*>(vals[i].data), vals[i].len);
+    }
+    return Result::adopt(res);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,210 @@
+#include <postgres/Pipeline.h>
+
+#include <utility>
+#include <postgres/Command.h>
+#include <postgres/Error.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+
+namespace postgres {
+
+enum {
+    RESULT_FORMAT = 1,
+};
+
+Pipeline::Pipeline(std::shared_ptr<PGconn> handle)
+    : handle_{std::move(handle)} {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         PQpipelineStatus(native()) == PQ_PIPELINE_OFF,
+                         "pipeline is already in progress");
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQenterPipelineMode(native()) == 1,
+                         "fail to enter pipeline mode: " << PQerrorMessage(native()));
+}
+
+Pipeline::Pipeline(Pipeline&& other) noexcept
+    : handle_{std::move(other.handle_)},
+      queued_{other.queued_},
+      unsynced_{other.unsynced_},
+      syncs_{other.syncs_} {
+    other.queued_   = 0;
+    other.unsynced_ = 0;
+    other.syncs_    = 0;
+}
+
+Pipeline::~Pipeline() noexcept {
+    if (!handle_) {
+        return;
+    }
+
+    // Close the last batch so the server completes it.
+    if ((0 < unsynced_) && (PQpipelineSync(native()) == 1)) {
+        ++syncs_;
+    }
+    while (auto const res = next()) {
+        PQclear(res);
+    }
+    while (0 < syncs_) {
+        auto const res = PQgetResult(native());
+        if (!res) {
+            break;
+        }
+        if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+            --syncs_;
+        }
+        PQclear(res);
+    }
+    PQexitPipelineMode(native());
+}
+
+Pipeline& Pipeline::send(PrepareData const& prep) {
+    enqueue(PQsendPrepare(native(),
+                          prep.name.data(),
+                          prep.statement.data(),
+                          static_cast<int>(prep.types.size()),
+                          prep.types.data()));
+    return *this;
+}
+
+Pipeline& Pipeline::send(Command const& cmd) {
+    enqueue(PQsendQueryParams(native(),
+                              cmd.statement(),
+                              cmd.count(),
+                              cmd.types(),
+                              cmd.values(),
+                              cmd.lengths(),
+                              cmd.formats(),
+                              RESULT_FORMAT));
+    return *this;
+}
+
+Pipeline& Pipeline::send(PreparedCommand const& cmd) {
+    enqueue(PQsendQueryPrepared(native(),
+                                cmd.statement(),
+                                cmd.count(),
+                                cmd.values(),
+                                cmd.lengths(),
+                                cmd.formats(),
+                                RESULT_FORMAT));
+    return *this;
+}
+
+Pipeline& Pipeline::describe(std::string const& name) {
+    enqueue(PQsendDescribePrepared(native(), name.data()));
+    return *this;
+}
+
+Pipeline& Pipeline::sync() {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQpipelineSync(native()) == 1,
+                         "fail to sync pipeline: " << PQerrorMessage(native()));
+    unsynced_ = 0;
+    ++syncs_;
+    return *this;
+}
+
+Result Pipeline::receive() {
+    flush();
+    auto const is_expected = 0 < queued_;
+    auto const res         = next();
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         res || !is_expected,
+                         "fail to receive pipeline result: " << PQerrorMessage(native()));
+    return Result{res, nullptr};
+}
+
+Pipeline::iterator Pipeline::begin() {
+    return iterator{*this, receive()};
+}
+
+Pipeline::iterator Pipeline::end() {
+    return iterator{*this, Result{nullptr, nullptr}};
+}
+
+int Pipeline::size() const {
+    return queued_;
+}
+
+void Pipeline::enqueue(int const is_ok) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         is_ok == 1,
+                         "fail to send statement: " << PQerrorMessage(native()));
+    ++queued_;
+    ++unsynced_;
+}
+
+void Pipeline::flush() {
+    if (unsynced_ == 0) {
+        return;
+    }
+
+    // Ask the server to deliver the results without closing the batch,
+    // so that an error keeps aborting statements up to the next sync point.
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (PQsendFlushRequest(native()) == 1) && (PQflush(native()) == 0),
+                         "fail to flush pipeline: " << PQerrorMessage(native()));
+    unsynced_ = 0;
+}
+
+PGresult* Pipeline::next() {
+    while (0 < queued_) {
+        auto const res = PQgetResult(native());
+        if (!res) {
+            return nullptr;
+        }
+
+        if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+            PQclear(res);
+            --syncs_;
+            continue;
+        }
+
+        // Every statement's result is followed by null.
+        --queued_;
+        while (auto const tail = PQgetResult(native())) {
+            PQclear(tail);
+        }
+        return res;
+    }
+    return nullptr;
+}
+
+PGconn* Pipeline::native() const {
+    return handle_.get();
+}
+
+Pipeline::iterator::iterator(Pipeline& pipe, Result res)
+    : pipe_{&pipe}, res_{std::move(res)}, is_{!res_.isDone()} {
+}
+
+Pipeline::iterator::iterator(iterator&& other) noexcept = default;
+
+Pipeline::iterator& Pipeline::iterator::operator=(iterator&& other) noexcept = default;
+
+Pipeline::iterator::~iterator() noexcept = default;
+
+bool Pipeline::iterator::operator==(iterator const& other) const {
+    return (pipe_ == other.pipe_) && (is_ == other.is_);
+}
+
+bool Pipeline::iterator::operator!=(iterator const& other) const {
+    return !(*this == other);
+}
+
+void Pipeline::iterator::operator++() {
+    *this = pipe_->begin();
+}
+
+Pipeline::iterator const Pipeline::iterator::operator++(int) {
+    return pipe_->begin();
+}
+
+Result Pipeline::iterator::operator->() {
+    return this->operator*();
+}
+
+Result Pipeline::iterator::operator*() {
+    return std::move(res_);
+}
+
+}  // namespace postgres
@@ -0,0 +1,76 @@
+#include <postgres/internal/Pool.h>
+
+#include <new>
+
+namespace postgres::internal {
+
+namespace {
+
+auto constexpr STEP    = alignof(std::max_align_t);
+auto constexpr CLASSES = size_t{16};
+auto constexpr LIMIT   = 256;
+
+struct Node {
+    Node* next;
+};
+
+thread_local bool is_over = false;
+
+// Blocks are kept per size class up to a limit,
+// since they can be released by other threads than allocated them.
+struct Cache {
+    ~Cache() noexcept {
+        // Memory still can be released by destructors of other thread storage.
+        is_over = true;
+        for (auto head : heads) {
+            while (head) {
+                auto const next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    Node* heads[CLASSES]{};
+    int   counts[CLASSES]{};
+};
+
+thread_local Cache cache{};
+
+size_t classify(size_t const size) {
+    return (size + STEP - 1) / STEP - 1;
+}
+
+}  // namespace
+
+void* Pool::allocate(size_t const size) {
+    auto const idx = classify(size);
+    if ((CLASSES <= idx) || is_over) {
+        return ::operator new(size);
+    }
+
+    auto& head = cache.heads[idx];
+    if (!head) {
+        return ::operator new((idx + 1) * STEP);
+    }
+
+    auto const res = head;
+    head = res->next;
+    --cache.counts[idx];
+    return res;
+}
+
+void Pool::deallocate(void* const ptr, size_t const size) noexcept {
+    auto const idx = classify(size);
+    if ((CLASSES <= idx) || is_over || (LIMIT <= cache.counts[idx])) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto const node = static_cast<Node*>(ptr);
+    node->next = cache.heads[idx];
+    cache.heads[idx] = node;
+    ++cache.counts[idx];
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,108 @@
+#include <postgres/internal/Race.h>
+
+#include <utility>
+
+namespace postgres::internal {
+
+Race::Race() = default;
+
+Race::~Race() noexcept {
+    for (auto const cancel : cancels_) {
+        if (cancel != nullptr) {
+            PQfreeCancel(cancel);
+        }
+    }
+    for (auto const cancel : cancelling_) {
+        if (cancel != nullptr) {
+            PQfreeCancel(cancel);
+        }
+    }
+}
+
+std::future<Result> Race::future() {
+    return prom_.get_future();
+}
+
+bool Race::isOver() {
+    std::lock_guard guard{mtx_};
+    return is_over_;
+}
+
+bool Race::enter(int const attempt, PGconn& conn) {
+    std::lock_guard guard{mtx_};
+    if (is_over_) {
+        return false;
+    }
+    cancels_[attempt] = PQgetCancel(&conn);
+    return true;
+}
+
+void Race::leave(int const attempt) {
+    // Waiting keeps the connection from moving on to the next job while it is being cancelled.
+    std::unique_lock guard{mtx_};
+    cancelled_.wait(guard, [this, attempt] {
+        return cancelling_[attempt] == nullptr;
+    });
+    if (cancels_[attempt] != nullptr) {
+        PQfreeCancel(cancels_[attempt]);
+        cancels_[attempt] = nullptr;
+    }
+}
+
+bool Race::finish(Result res) {
+    std::unique_lock guard{mtx_};
+    if (!win()) {
+        return false;
+    }
+    prom_.set_value(std::move(res));
+    guard.unlock();
+    cancel();
+    return true;
+}
+
+bool Race::finish(std::exception_ptr const& err) {
+    std::unique_lock guard{mtx_};
+    if (!win()) {
+        return false;
+    }
+    prom_.set_exception(err);
+    guard.unlock();
+    cancel();
+    return true;
+}
+
+bool Race::win() {
+    if (is_over_) {
+        return false;
+    }
+    is_over_ = true;
+
+    // The winner has already left, so only the loser is still registered.
+    for (auto idx = 0; idx < ATTEMPTS; ++idx) {
+        std::swap(cancels_[idx], cancelling_[idx]);
+    }
+    return true;
+}
+
+void Race::cancel() {
+    // No attempt enters once the race is over, so the handles taken over stay as they are meanwhile.
+    char err[256];
+    for (auto const cancel : cancelling_) {
+        if (cancel != nullptr) {
+            PQcancel(cancel, err, sizeof(err));
+        }
+    }
+
+    {
+        std::lock_guard guard{mtx_};
+        for (auto& cancel : cancelling_) {
+            if (cancel != nullptr) {
+                PQfreeCancel(cancel);
+                cancel = nullptr;
+            }
+        }
+    }
+    cancelled_.notify_all();
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,338 @@
+#include <postgres/internal/Reactor.h>
+
+#include <array>
+#include <cerrno>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <postgres/internal/Thread.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Receiver.h>
+
+namespace postgres::internal {
+
+class Reactor::Loop {
+public:
+    explicit Loop(std::shared_ptr<Context const> ctx, int size);
+    Loop(Loop const& other) = delete;
+    Loop& operator=(Loop const& other) = delete;
+    Loop(Loop&& other) noexcept = delete;
+    Loop& operator=(Loop&& other) noexcept = delete;
+    ~Loop() noexcept;
+
+    void post(Request req, Priority prio);
+    // Finishes the requests sent, dropping the queued ones unless told otherwise, and quits.
+    void stop(bool is_graceful);
+    int load() const;
+
+private:
+    struct Slot {
+        std::optional<Connection> conn;
+        std::optional<Request>    req;
+        std::optional<Receiver>   rcvr;
+        std::optional<Result>     last;
+        std::exception_ptr        err;
+        bool                      is_flushed = true;
+    };
+
+    void run();
+    // Sends the queued requests to the idle connections, connecting them if needed.
+    void dispatch();
+    std::optional<Request> take();
+    void start(Slot& slot);
+    void receive(Slot& slot);
+    void finish(Slot& slot);
+    void fail(Request& req, std::exception_ptr const& err);
+    bool isOver();
+    void wait(std::vector<pollfd>& fds);
+    void wake();
+
+    std::shared_ptr<Context const> ctx_;
+    std::vector<Slot>              slots_;
+
+    std::mutex                         mtx_;
+    std::array<std::deque<Request>, 3> queues_;
+    bool                               is_stopped_ = false;
+    std::atomic<int>                   load_{0};
+
+    int         wake_[2]{-1, -1};
+    Thread      thread_;
+};
+
+Reactor::Loop::Loop(std::shared_ptr<Context const> ctx, int const size)
+    : ctx_{std::move(ctx)}, slots_(static_cast<size_t>(size)) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         ::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) == 0,
+                         "fail to create pipe");
+    thread_ = Thread{*ctx_, [this] {
+        run();
+    }};
+}
+
+Reactor::Loop::~Loop() noexcept {
+    if (thread_.joinable()) {
+        stop(true);
+    }
+    ::close(wake_[0]);
+    ::close(wake_[1]);
+}
+
+void Reactor::Loop::post(Request req, Priority const prio) {
+    load_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard guard{mtx_};
+        queues_[static_cast<size_t>(prio)].push_back(std::move(req));
+    }
+    wake();
+}
+
+void Reactor::Loop::stop(bool const is_graceful) {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+        if (!is_graceful) {
+            for (auto& queue : queues_) {
+                load_.fetch_sub(static_cast<int>(queue.size()), std::memory_order_relaxed);
+                queue.clear();
+            }
+        }
+    }
+    wake();
+    thread_.join();
+}
+
+int Reactor::Loop::load() const {
+    return load_.load(std::memory_order_relaxed);
+}
+
+void Reactor::Loop::run() {
+    std::vector<pollfd> fds{};
+    while (true) {
+        dispatch();
+        if (isOver()) {
+            return;
+        }
+        wait(fds);
+
+        // The first descriptor is the wake up pipe, followed by the busy connections in order.
+        auto it = fds.begin() + 1;
+        for (auto& slot : slots_) {
+            if (!slot.req) {
+                continue;
+            }
+            auto const events = (it++)->revents;
+            if (events == 0) {
+                continue;
+            }
+
+            try {
+                if (!slot.is_flushed) {
+                    slot.is_flushed = slot.conn->flush();
+                }
+            } catch (...) {
+                slot.err = std::current_exception();
+            }
+            receive(slot);
+        }
+    }
+}
+
+void Reactor::Loop::dispatch() {
+    for (auto& slot : slots_) {
+        if (slot.req) {
+            continue;
+        }
+
+        while (!slot.req) {
+            auto req = take();
+            if (!req) {
+                return;
+            }
+
+            // Connecting blocks the loop, but happens once per connection unless it breaks.
+            if (!slot.conn) {
+                try {
+                    slot.conn.emplace(ctx_->connect());
+                    slot.conn->setNonBlocking(true);
+                } catch (...) {
+                    slot.conn.reset();
+                    fail(*req, std::current_exception());
+                    continue;
+                }
+            }
+            slot.req = std::move(req);
+            start(slot);
+        }
+    }
+}
+
+std::optional<Reactor::Request> Reactor::Loop::take() {
+    std::lock_guard guard{mtx_};
+    for (auto& queue : queues_) {
+        if (!queue.empty()) {
+            auto req = std::move(queue.front());
+            queue.pop_front();
+            return req;
+        }
+    }
+    return std::nullopt;
+}
+
+void Reactor::Loop::start(Slot& slot) {
+    try {
+        slot.rcvr.emplace(std::visit([&slot](auto const& cmd) {
+            return slot.conn->send(cmd);
+        }, slot.req->cmd));
+        slot.is_flushed = slot.conn->flush();
+    } catch (...) {
+        slot.err = std::current_exception();
+        finish(slot);
+    }
+}
+
+void Reactor::Loop::receive(Slot& slot) {
+    if (!slot.rcvr) {
+        return;
+    }
+
+    // Results following a failed one are drained all the same, keeping the first error.
+    while (true) {
+        try {
+            auto res = slot.rcvr->tryReceive();
+            if (!res) {
+                return;
+            }
+            if (res->isDone()) {
+                break;
+            }
+            slot.last.emplace(std::move(*res));
+        } catch (...) {
+            if (!slot.err) {
+                slot.err = std::current_exception();
+            }
+        }
+    }
+    finish(slot);
+}
+
+void Reactor::Loop::finish(Slot& slot) {
+    auto err = std::move(slot.err);
+    if (!err && !slot.last) {
+        err = std::make_exception_ptr(LogicError{_POSTGRES_CXX_PREFIX "no result received"});
+    }
+
+    if (err) {
+        fail(*slot.req, err);
+    } else {
+        std::visit([&slot](auto& prom) {
+            prom.set_value(std::move(*slot.last));
+        }, slot.req->prom);
+        load_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    slot.rcvr.reset();
+    slot.last.reset();
+    slot.req.reset();
+    slot.err = nullptr;
+    slot.is_flushed = true;
+    // A broken connection is replaced on the next request.
+    if (!slot.conn->isOk()) {
+        slot.conn.reset();
+    }
+}
+
+void Reactor::Loop::fail(Request& req, std::exception_ptr const& err) {
+    std::visit([&err](auto& prom) {
+        prom.set_exception(err);
+    }, req.prom);
+    load_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool Reactor::Loop::isOver() {
+    for (auto const& slot : slots_) {
+        if (slot.req) {
+            return false;
+        }
+    }
+
+    std::lock_guard guard{mtx_};
+    if (!is_stopped_) {
+        return false;
+    }
+    for (auto const& queue : queues_) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Reactor::Loop::wait(std::vector<pollfd>& fds) {
+    fds.clear();
+    fds.push_back({wake_[0], POLLIN, 0});
+    for (auto& slot : slots_) {
+        if (slot.req) {
+            auto const events = slot.is_flushed ? POLLIN : (POLLIN | POLLOUT);
+            fds.push_back({slot.conn->socket(), static_cast<short>(events), 0});
+        }
+    }
+
+    while ((::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) && (errno == EINTR)) {
+    }
+    if ((fds[0].revents & POLLIN) == 0) {
+        return;
+    }
+
+    char buf[64];
+    while (0 < ::read(wake_[0], buf, sizeof(buf))) {
+    }
+}
+
+void Reactor::Loop::wake() {
+    char const sig = 0;
+    static_cast<void>(::write(wake_[1], &sig, 1));
+}
+
+Reactor::Reactor(std::shared_ptr<Context const> ctx)
+    : ctx_{std::move(ctx)} {
+    // Connections are split between the loops as evenly as possible.
+    auto const threads = ctx_->reactorThreads();
+    auto const conns   = ctx_->maxConcurrency();
+    for (auto i = 0; i < threads; ++i) {
+        auto const size = conns / threads + ((i < conns % threads) ? 1 : 0);
+        loops_.push_back(std::make_unique<Loop>(ctx_, size));
+    }
+}
+
+Reactor::~Reactor() noexcept {
+    // Requests already sent to the server are always waited for, since the loops own their connections.
+    auto const is_graceful = (ctx_->shutdownPolicy() == ShutdownPolicy::GRACEFUL);
+    for (auto& loop : loops_) {
+        loop->stop(is_graceful);
+    }
+}
+
+void Reactor::submit(Request req, Priority const prio) {
+    // Ties are broken in turn, so that idle loops are used round-robin.
+    auto const count = loops_.size();
+    auto const first = next_.fetch_add(1, std::memory_order_relaxed) % count;
+    auto       best  = first;
+    auto       least = loops_[first]->load();
+    for (auto i = size_t{1}; i < count; ++i) {
+        auto const idx  = (first + i) % count;
+        auto const load = loops_[idx]->load();
+        if (load < least) {
+            best  = idx;
+            least = load;
+        }
+    }
+    loops_[best]->post(std::move(req), prio);
+}
+
+}  // namespace postgres::internal
@@ -1,5 +1,7 @@
 #include <postgres/Receiver.h>
 
+#include <postgres/internal/Span.h>
+
 namespace postgres {
 
 Receiver::Receiver(std::shared_ptr<PGconn> handle, int const is_ok)
@@ -10,13 +12,40 @@ Receiver::Receiver(Receiver&& other) noexcept = default;
 
 Receiver& Receiver::operator=(Receiver&& other) noexcept = default;
 
-Receiver::~Receiver() noexcept = default;
+Receiver::~Receiver() noexcept {
+    // Results left unreceived are drained untraced.
+    if (span_) {
+        span_->finish();
+    }
+}
 
 Result Receiver::receive() {
-    return Result{PQgetResult(handle_.get()), this};
+    auto const res = PQgetResult(handle_.get());
+    if (span_) {
+        span_->add(res);
+        if (res == nullptr) {
+            span_->finish();
+            span_.reset();
+        }
+    }
+    return Result{res, this};
+}
+
+std::optional<Result> Receiver::tryReceive() {
+    if (isBusy()) {
+        return std::nullopt;
+    }
+    return receive();
 }
 
-void Receiver::iter() {
+void Receiver::iter([[maybe_unused]] int const chunk) {
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    if (1 < chunk) {
+        is_ok_ = is_ok_ && (PQsetChunkedRowsMode(handle_.get(), chunk) == 1);
+        return;
+    }
+#endif
+    // Older libpq supports just a row per result.
     is_ok_ = is_ok_ && (PQsetSingleRowMode(handle_.get()) == 1);
 }
 
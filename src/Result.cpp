@@ -1,16 +1,40 @@
 #include <postgres/Result.h>
 
+#include <postgres/internal/Columns.h>
 #include <postgres/Error.h>
 #include <postgres/Row.h>
 
 namespace postgres {
 
+// Rows received one by one are not worth caching their columns.
+static std::shared_ptr<internal::Columns> makeColumns(PGresult* const handle) {
+    if (PQntuples(handle) < 2) {
+        return nullptr;
+    }
+    return std::make_shared<internal::Columns>(*handle);
+}
+
 Result::Result(PGresult* const handle)
-    : Status{handle} {
+    : Status{handle}, cols_{makeColumns(handle)} {
 }
 
 Result::Result(PGresult* const handle, postgres::Consumer* const consumer)
-    : Status{handle, consumer} {
+    : Status{handle, consumer}, cols_{makeColumns(handle)} {
+}
+
+Result::Result(PGresult* const handle, postgres::Consumer* const consumer, std::shared_ptr<internal::Columns> cols)
+    : Status{handle, consumer}, cols_{std::move(cols)} {
+}
+
+Result Result::prepared(PGresult* const handle, std::shared_ptr<internal::Columns> const& cols) {
+    if (handle && cols && cols->matches(*handle)) {
+        return Result{handle, nullptr, cols};
+    }
+    return Result{handle};
+}
+
+Result Result::adopt(PGresult* const handle) {
+    return Result{handle};
 }
 
 Result::Result(Result&& other) noexcept = default;
@@ -21,21 +45,32 @@ Result::~Result() noexcept = default;
 
 Result::iterator Result::begin() const {
     check();
-    return iterator{*native(), 0};
+    return iterator{*native(), 0, cols_.get()};
 }
 
 Result::iterator Result::end() const {
     check();
-    return iterator{*native(), size()};
+    return iterator{*native(), size(), cols_.get()};
 }
 
 Row Result::operator[](int const idx) const {
     check();
-    return *iterator{*native(), idx};
+    return *iterator{*native(), idx, cols_.get()};
+}
+
+Grid Result::grid() const {
+    check();
+    return Grid{*native()};
+}
+
+int Result::columnIndex(char const* const col_name) const {
+    auto const col_idx = PQfnumber(native(), col_name);
+    _POSTGRES_CXX_ASSERT(LogicError, (0 <= col_idx), "column '" << col_name << "' does not exist");
+    return col_idx;
 }
 
-Result::iterator::iterator(PGresult& handle, int const idx)
-    : handle_{&handle}, idx_{idx} {
+Result::iterator::iterator(PGresult& handle, int const idx, internal::Columns* const cols)
+    : handle_{&handle}, idx_{idx}, cols_{cols} {
 }
 
 Result::iterator::iterator(iterator const& other) = default;
@@ -61,7 +96,7 @@ void Result::iterator::operator++() {
 }
 
 Result::iterator const Result::iterator::operator++(int) {
-    return Result::iterator{*handle_, idx_++};
+    return Result::iterator{*handle_, idx_++, cols_};
 }
 
 Row Result::iterator::operator->() const {
@@ -72,7 +107,7 @@ Row Result::iterator::operator*() const {
     _POSTGRES_CXX_ASSERT(LogicError,
                          (0 <= idx_) && (idx_ < PQntuples(handle_)),
                          "row index " << idx_ << " is out of range");
-    return Row{*handle_, idx_};
+    return Row{*handle_, idx_, cols_};
 }
 
 }  // namespace postgres
@@ -0,0 +1,84 @@
+#include <postgres/internal/ResultCache.h>
+
+#include <utility>
+
+namespace postgres::internal {
+
+ResultCache::ResultCache(Clock::duration const ttl, size_t const capacity)
+    : ttl_{ttl}, capacity_{capacity} {
+}
+
+ResultCache::~ResultCache() noexcept = default;
+
+size_t ResultCache::sizeOf(Result const& res) {
+    // Each field takes a length and a pointer besides its value.
+    auto const handle = res.native();
+    auto const rows   = PQntuples(handle);
+    auto const cols   = PQnfields(handle);
+    auto       size   = sizeof(Result) + static_cast<size_t>(rows) * static_cast<size_t>(cols) * 16;
+    for (auto row = 0; row < rows; ++row) {
+        for (auto col = 0; col < cols; ++col) {
+            size += static_cast<size_t>(PQgetlength(handle, row, col)) + 1;
+        }
+    }
+    return size;
+}
+
+std::optional<std::shared_future<Result>> ResultCache::find(Key const& key) {
+    std::lock_guard guard{mtx_};
+    auto const      it = entries_.find(key);
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    if (it->second.expiry <= Clock::now()) {
+        erase(it);
+        return std::nullopt;
+    }
+
+    uses_.splice(uses_.begin(), uses_, it->second.use);
+    return it->second.res;
+}
+
+void ResultCache::insert(Key const& key, std::shared_future<Result> res, uint64_t const gen) {
+    auto const size = sizeOf(res.get());
+    if (capacity_ < size) {
+        return;
+    }
+
+    std::lock_guard guard{mtx_};
+    if (gen != gen_) {
+        return;
+    }
+    auto const it = entries_.find(key);
+    if (it != entries_.end()) {
+        erase(it);
+    }
+
+    while (capacity_ < used_ + size) {
+        erase(entries_.find(uses_.back()));
+    }
+    uses_.push_front(key);
+    entries_.emplace(key, Entry{std::move(res), Clock::now() + ttl_, size, uses_.begin()});
+    used_ += size;
+}
+
+void ResultCache::clear() {
+    std::lock_guard guard{mtx_};
+    entries_.clear();
+    uses_.clear();
+    used_ = 0;
+    ++gen_;
+}
+
+uint64_t ResultCache::generation() {
+    std::lock_guard guard{mtx_};
+    return gen_;
+}
+
+void ResultCache::erase(std::unordered_map<Key, Entry>::iterator const it) {
+    used_ -= it->second.size;
+    uses_.erase(it->second.use);
+    entries_.erase(it);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,30 @@
+#include <postgres/RetryPolicy.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+bool RetryPolicy::isTransient(RuntimeError const& err) {
+    // serialization_failure and deadlock_detected.
+    return (std::strcmp(err.code(), "40001") == 0) || (std::strcmp(err.code(), "40P01") == 0);
+}
+
+std::chrono::microseconds RetryPolicy::backoff(int const retry) const {
+    thread_local std::minstd_rand gen{std::random_device{}()};
+
+    auto limit = delay;
+    for (auto i = 1; (i < retry) && (limit < max_delay); ++i) {
+        limit *= 2;
+    }
+    limit = std::min(limit, max_delay);
+    if (limit.count() <= 0) {
+        return std::chrono::microseconds{0};
+    }
+    std::uniform_int_distribution<std::chrono::microseconds::rep> dist{0, limit.count()};
+    return std::chrono::microseconds{dist(gen)};
+}
+
+}  // namespace postgres
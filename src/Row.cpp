@@ -3,8 +3,8 @@
 
 namespace postgres {
 
-Row::Row(PGresult& res, int const row_idx)
-    : res_{&res}, row_idx_{row_idx}, col_idx_{0} {
+Row::Row(PGresult& res, int const row_idx, internal::Columns* const cols)
+    : res_{&res}, row_idx_{row_idx}, col_idx_{0}, cols_{cols} {
 }
 
 Row::Row(Row const& other) = default;
@@ -27,15 +27,15 @@ Field Row::operator[](char const* const col_name) const {
     return Field{*res_, row_idx_, col_idx};
 }
 
-Field Row::operator[](int const col_idx) const {
+void Row::checkTuple(PGresult const& res, int const col_idx, size_t const size) {
     _POSTGRES_CXX_ASSERT(LogicError,
-                         (0 <= col_idx) && (col_idx < size()),
-                         "column index " << col_idx << " is out of range");
-    return Field{*res_, row_idx_, col_idx};
-}
-
-int Row::size() const {
-    return PQnfields(res_);
+                         col_idx + size <= static_cast<size_t>(PQnfields(&res)),
+                         "cannot decode "
+                             << size
+                             << " columns starting from "
+                             << col_idx
+                             << " out of "
+                             << PQnfields(&res));
 }
 
 }  // namespace postgres
@@ -0,0 +1,210 @@
+#include <postgres/internal/ShardedChannel.h>
+
+#include <algorithm>
+#include <utility>
+#include <postgres/internal/Worker.h>
+#include <postgres/Context.h>
+
+namespace postgres::internal {
+
+// Numbers threads in order of their first use,
+// so that both senders and workers are evenly spread over the shards.
+static size_t threadIndex() {
+    static std::atomic<size_t>     next{0};
+    static thread_local auto const idx = next++;
+    return idx;
+}
+
+ShardedChannel::ShardedChannel(std::shared_ptr<Context const> ctx)
+    : ctx_{std::move(ctx)},
+      shards_(static_cast<size_t>(ctx_->queueShards())),
+      queued_{0},
+      room_{*ctx_},
+      idle_{0},
+      quits_{0} {
+}
+
+ShardedChannel::~ShardedChannel() noexcept = default;
+
+void ShardedChannel::quit(int const count) {
+    // Workers quit only when there are no more jobs in any shard.
+    quits_ += count;
+    for (auto i = 0; i < count; ++i) {
+        wake(threadIndex());
+    }
+}
+
+std::tuple<bool, Worker*> ShardedChannel::send(Job job) {
+    // A worker waiting for room could wait for itself.
+    room_.acquire(queued_, !Worker::serves(*this));
+    job.stamp();
+
+    auto const idx   = threadIndex();
+    auto&      shard = shards_[idx % shards_.size()];
+    {
+        std::lock_guard guard{shard.mtx};
+        shard.queue.push_back(std::move(job));
+        ++queued_;
+    }
+
+    if (wake(idx)) {
+        return {true, nullptr};
+    }
+
+    std::lock_guard guard{mtx_};
+    if (recreation_.empty()) {
+        return {false, nullptr};
+    }
+
+    auto const worker = recreation_.back();
+    recreation_.pop_back();
+    return {false, worker};
+}
+
+void ShardedChannel::requeue(Job job) {
+    auto const idx   = threadIndex();
+    auto&      shard = shards_[idx % shards_.size()];
+    job.stamp();
+    {
+        std::lock_guard guard{shard.mtx};
+        shard.queue.push_front(std::move(job));
+        ++queued_;
+    }
+    wake(idx);
+}
+
+void ShardedChannel::receive(Slot& slot) {
+    auto const idx = threadIndex();
+    while (!take(slot, idx)) {
+        auto& shard = shards_[idx % shards_.size()];
+        {
+            std::lock_guard guard{shard.mtx};
+            shard.slots.push_back(&slot);
+            ++idle_;
+        }
+
+        // A job sent meanwhile could miss the slot, so check it once again.
+        if (isPending() && forget(slot, idx)) {
+            continue;
+        }
+
+        if (!wait(slot, idx)) {
+            slot.job = nullptr;
+            return;
+        }
+    }
+}
+
+bool ShardedChannel::poll(Slot& slot) {
+    return take(slot, threadIndex());
+}
+
+void ShardedChannel::recycle(Worker& worker) {
+    std::lock_guard guard{mtx_};
+    recreation_.push_back(&worker);
+}
+
+void ShardedChannel::drop() {
+    for (auto& shard : shards_) {
+        std::lock_guard guard{shard.mtx};
+        queued_ -= static_cast<int>(shard.queue.size());
+        auto const garbage = std::move(shard.queue);
+    }
+    room_.releaseAll();
+}
+
+bool ShardedChannel::take(Slot& slot, size_t const idx) {
+    auto const count = shards_.size();
+    for (size_t i = 0; (0 < queued_) && (i < count); ++i) {
+        auto&           shard = shards_[(idx + i) % count];
+        std::lock_guard guard{shard.mtx};
+        if (!shard.queue.empty()) {
+            shard.queue.front().swap(slot.job);
+            shard.queue.pop_front();
+            --queued_;
+            room_.release();
+            return true;
+        }
+    }
+
+    auto quits = quits_.load();
+    while (0 < quits) {
+        if (quits_.compare_exchange_weak(quits, quits - 1)) {
+            slot.job = nullptr;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShardedChannel::wake(size_t const idx) {
+    auto const count = shards_.size();
+    for (size_t i = 0; (0 < idle_) && (i < count); ++i) {
+        auto&            shard = shards_[(idx + i) % count];
+        std::unique_lock c_guard{shard.mtx};
+        if (shard.slots.empty()) {
+            continue;
+        }
+
+        // The most recently idle worker is the most likely to be warm.
+        auto const slot = shard.slots.back();
+        shard.slots.pop_back();
+        --idle_;
+        c_guard.unlock();
+
+        std::lock_guard s_guard{slot->mtx};
+        slot->is_woken = true;
+        slot->signal.notify_one();
+        return true;
+    }
+    return false;
+}
+
+bool ShardedChannel::wait(Slot& slot, size_t const idx) {
+    std::unique_lock s_guard{slot.mtx};
+    auto const       is_woken = [&slot] {
+        return slot.is_woken;
+    };
+
+    auto const timeout = slot.is_persistent ? Context::Duration{} : ctx_->idleTimeout();
+    if (timeout.count() == 0) {
+        slot.signal.wait(s_guard, is_woken);
+        slot.is_woken = false;
+        return true;
+    }
+
+    if (slot.signal.wait_for(s_guard, timeout, is_woken)) {
+        slot.is_woken = false;
+        return true;
+    }
+
+    // Check if other thread is going to wake the slot.
+    s_guard.unlock();
+    if (forget(slot, idx)) {
+        return isPending();
+    }
+
+    s_guard.lock();
+    slot.signal.wait(s_guard, is_woken);
+    slot.is_woken = false;
+    return true;
+}
+
+bool ShardedChannel::forget(Slot& slot, size_t const idx) {
+    auto&           shard = shards_[idx % shards_.size()];
+    std::lock_guard guard{shard.mtx};
+    auto const      it    = std::find(shard.slots.begin(), shard.slots.end(), &slot);
+    if (it == shard.slots.end()) {
+        return false;
+    }
+
+    shard.slots.erase(it);
+    --idle_;
+    return true;
+}
+
+bool ShardedChannel::isPending() const {
+    return (0 < queued_) || (0 < quits_);
+}
+
+}  // namespace postgres::internal
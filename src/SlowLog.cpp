@@ -0,0 +1,208 @@
+#include <postgres/SlowLog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+
+namespace postgres {
+
+namespace {
+
+bool isWord(char const c) {
+    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_');
+}
+
+bool endsWith(std::string const& s, std::string_view const tail) {
+    return (tail.size() <= s.size()) && (s.compare(s.size() - tail.size(), tail.size(), tail) == 0);
+}
+
+// Appends a placeholder, merging it into the list of them it continues.
+void putValue(std::string& out) {
+    if (endsWith(out, "?, ")) {
+        out.resize(out.size() - 2);
+    } else if (endsWith(out, "?,")) {
+        out.pop_back();
+    } else {
+        out.push_back('?');
+    }
+}
+
+// Appends a closing parenthesis, merging a row of placeholders into the list of them it continues.
+void putClose(std::string& out) {
+    out.push_back(')');
+    if (endsWith(out, "(?), (?)")) {
+        out.resize(out.size() - 5);
+    } else if (endsWith(out, "(?),(?)")) {
+        out.resize(out.size() - 4);
+    }
+}
+
+double toMicros(SlowLog::Duration const dur) {
+    return std::chrono::duration<double, std::micro>{dur}.count();
+}
+
+}  // namespace
+
+SlowLog::SlowLog(Duration const threshold, size_t const capacity)
+    : threshold_{threshold}, shard_cap_{std::max(capacity / SHARDS, size_t{1})} {
+}
+
+SlowLog::~SlowLog() noexcept = default;
+
+void SlowLog::trace(Trace const& trace) {
+    auto const latency = trace.wait + trace.total;
+    if (latency < threshold_) {
+        return;
+    }
+
+    auto  key   = trace.is_prepared ? std::string{trace.statement} : fingerprint(trace.statement);
+    auto& shard = shards_[std::hash<std::string>{}(key) % SHARDS];
+
+    std::lock_guard guard{shard.mtx};
+    auto            it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
+        if (shard_cap_ <= shard.entries.size()) {
+            evict(shard);
+        }
+        it = shard.entries.emplace(key, Entry{}).first;
+        it->second.fingerprint = std::move(key);
+    }
+
+    auto& entry = it->second;
+    ++entry.calls;
+    entry.errors += trace.code.empty() ? 0 : 1;
+    entry.rows += trace.rows;
+    entry.max = std::max(entry.max, latency);
+    entry.latency.add(latency);
+    entry.wait.add(trace.wait);
+}
+
+std::vector<SlowLog::Entry> SlowLog::top(size_t const count) const {
+    std::vector<Entry> res{};
+    for (auto const& shard : shards_) {
+        std::lock_guard guard{shard.mtx};
+        for (auto const& [key, entry] : shard.entries) {
+            res.push_back(entry);
+        }
+    }
+
+    auto const by_total = [](Entry const& lhs, Entry const& rhs) {
+        return lhs.latency.total > rhs.latency.total;
+    };
+    auto const mid = res.begin() + static_cast<std::ptrdiff_t>(std::min(count, res.size()));
+    std::partial_sort(res.begin(), mid, res.end(), by_total);
+    res.erase(mid, res.end());
+    return res;
+}
+
+void SlowLog::dump(std::ostream& out, size_t const count) const {
+    out << std::setw(10) << "calls"
+        << std::setw(14) << "total_ms"
+        << std::setw(12) << "mean_us"
+        << std::setw(12) << "p99_us"
+        << std::setw(12) << "max_us"
+        << std::setw(12) << "wait_us"
+        << std::setw(8) << "errors"
+        << std::setw(10) << "rows"
+        << "  fingerprint\n";
+    for (auto const& entry : top(count)) {
+        out << std::fixed << std::setprecision(1)
+            << std::setw(10) << entry.calls
+            << std::setw(14) << toMicros(entry.latency.total) / 1000
+            << std::setw(12) << toMicros(entry.latency.mean())
+            << std::setw(12) << toMicros(entry.latency.quantile(0.99))
+            << std::setw(12) << toMicros(entry.max)
+            << std::setw(12) << toMicros(entry.wait.mean())
+            << std::setw(8) << entry.errors
+            << std::setw(10) << entry.rows
+            << "  " << entry.fingerprint << '\n';
+    }
+}
+
+void SlowLog::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard guard{shard.mtx};
+        shard.entries.clear();
+    }
+}
+
+std::string SlowLog::fingerprint(std::string_view const stmt) {
+    std::string out{};
+    out.reserve(stmt.size());
+
+    auto i = size_t{0};
+    while (i < stmt.size()) {
+        auto const c = stmt[i];
+        if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+            while ((i < stmt.size()) && (std::isspace(static_cast<unsigned char>(stmt[i])) != 0)) {
+                ++i;
+            }
+            if (!out.empty() && (i < stmt.size())) {
+                out.push_back(' ');
+            }
+            continue;
+        }
+
+        // Quoted identifiers are kept as they are.
+        if (c == '"') {
+            auto const end = stmt.find('"', i + 1);
+            auto const len = (end == std::string_view::npos) ? stmt.size() - i : end + 1 - i;
+            out.append(stmt.substr(i, len));
+            i += len;
+            continue;
+        }
+
+        // String literals with the quotes doubled inside.
+        if (c == '\'') {
+            ++i;
+            while (i < stmt.size()) {
+                if (stmt[i++] != '\'') {
+                    continue;
+                }
+                if ((i < stmt.size()) && (stmt[i] == '\'')) {
+                    ++i;
+                    continue;
+                }
+                break;
+            }
+            putValue(out);
+            continue;
+        }
+
+        // Numbers and parameters, unless being a part of a name.
+        auto const is_number = (std::isdigit(static_cast<unsigned char>(c)) != 0);
+        auto const is_param  = (c == '$') && (i + 1 < stmt.size())
+                               && (std::isdigit(static_cast<unsigned char>(stmt[i + 1])) != 0);
+        if ((is_number || is_param) && (out.empty() || !isWord(out.back()))) {
+            ++i;
+            while ((i < stmt.size()) && (isWord(stmt[i]) || (stmt[i] == '.'))) {
+                auto const is_exp = (stmt[i] == 'e') || (stmt[i] == 'E');
+                ++i;
+                if (is_number && is_exp && (i < stmt.size()) && ((stmt[i] == '-') || (stmt[i] == '+'))) {
+                    ++i;
+                }
+            }
+            putValue(out);
+            continue;
+        }
+
+        if (c == ')') {
+            putClose(out);
+        } else {
+            out.push_back(c);
+        }
+        ++i;
+    }
+    return out;
+}
+
+void SlowLog::evict(Shard& shard) {
+    auto const it = std::min_element(shard.entries.begin(), shard.entries.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.second.latency.total < rhs.second.latency.total;
+    });
+    shard.entries.erase(it);
+}
+
+}  // namespace postgres
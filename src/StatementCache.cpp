@@ -0,0 +1,52 @@
+#include <postgres/internal/StatementCache.h>
+
+namespace postgres::internal {
+
+StatementCache::StatementCache(size_t const capacity)
+    : capacity_{capacity} {
+}
+
+StatementCache::~StatementCache() noexcept = default;
+
+StatementCache::Entry& StatementCache::use(std::string_view const key, std::string& stale) {
+    if (auto const it = index_.find(key); it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        auto& entry = entries_.front();
+        ++entry.uses;
+        return entry;
+    }
+
+    if (entries_.size() == capacity_) {
+        auto& last = entries_.back();
+        if (last.is_prepared) {
+            stale = std::move(last.name);
+        }
+        index_.erase(last.key);
+        entries_.pop_back();
+    }
+
+    auto& entry = entries_.emplace_front();
+    entry.key  = key;
+    entry.name = "_pgcc_" + std::to_string(++count_);
+    entry.uses = 1;
+    index_.emplace(entry.key, entries_.begin());
+    return entry;
+}
+
+std::vector<std::string> StatementCache::clear() {
+    std::vector<std::string> res{};
+    for (auto& entry : entries_) {
+        if (entry.is_prepared) {
+            res.push_back(std::move(entry.name));
+        }
+    }
+    index_.clear();
+    entries_.clear();
+    return res;
+}
+
+size_t StatementCache::size() const {
+    return entries_.size();
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,65 @@
+#include <postgres/StatementRegistry.h>
+
+#include <mutex>
+#include <utility>
+#include <postgres/internal/Columns.h>
+
+namespace postgres {
+
+StatementRegistry::StatementRegistry() = default;
+
+StatementRegistry::~StatementRegistry() noexcept = default;
+
+StatementRegistry& StatementRegistry::add(PrepareData prep) {
+    auto ptr  = std::make_shared<PrepareData const>(std::move(prep));
+    auto name = ptr->name;
+    std::unique_lock lock{mtx_};
+    entries_.insert_or_assign(std::move(name), Entry{std::move(ptr), nullptr});
+    return *this;
+}
+
+std::vector<std::shared_ptr<PrepareData const>> StatementRegistry::statements() const {
+    std::shared_lock lock{mtx_};
+    std::vector<std::shared_ptr<PrepareData const>> res{};
+    res.reserve(entries_.size());
+    for (auto const& [_, entry] : entries_) {
+        res.push_back(entry.prep);
+    }
+    return res;
+}
+
+std::shared_ptr<PrepareData const> StatementRegistry::find(std::string_view const name) const {
+    std::shared_lock lock{mtx_};
+    auto const it = entries_.find(name);
+    return (it == entries_.end()) ? nullptr : it->second.prep;
+}
+
+size_t StatementRegistry::size() const {
+    std::shared_lock lock{mtx_};
+    return entries_.size();
+}
+
+std::shared_ptr<internal::Columns> StatementRegistry::described(PrepareData const& prep) const {
+    std::shared_lock lock{mtx_};
+    auto const it = entries_.find(prep.name);
+    // Statements of the same name prepared aside may differ.
+    if ((it == entries_.end()) || (it->second.prep.get() != &prep)) {
+        return nullptr;
+    }
+    return it->second.cols;
+}
+
+std::shared_ptr<internal::Columns> StatementRegistry::describe(PrepareData const&                 prep,
+                                                               std::shared_ptr<internal::Columns> cols) {
+    std::unique_lock lock{mtx_};
+    auto const it = entries_.find(prep.name);
+    if ((it == entries_.end()) || (it->second.prep.get() != &prep)) {
+        return cols;
+    }
+    if (!it->second.cols) {
+        it->second.cols = std::move(cols);
+    }
+    return it->second.cols;
+}
+
+}  // namespace postgres
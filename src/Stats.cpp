@@ -0,0 +1,197 @@
+#include <postgres/internal/Stats.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace postgres {
+
+int Histogram::bucket(Duration const dur) {
+    auto us  = std::chrono::duration_cast<std::chrono::microseconds>(dur).count();
+    auto idx = 0;
+    while ((0 < us) && (idx < SIZE - 1)) {
+        us >>= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+void Histogram::add(Duration const dur) {
+    ++counts[static_cast<size_t>(bucket(dur))];
+    ++count;
+    total += dur;
+}
+
+Histogram::Duration Histogram::mean() const {
+    return (count == 0) ? Duration{0} : total / count;
+}
+
+Histogram::Duration Histogram::quantile(double const q) const {
+    auto const target = std::max(int64_t{1}, static_cast<int64_t>(std::ceil(q * static_cast<double>(count))));
+    auto       sum    = int64_t{0};
+    for (auto i = 0; i < SIZE; ++i) {
+        sum += counts[static_cast<size_t>(i)];
+        if (target <= sum) {
+            return std::chrono::microseconds{int64_t{1} << i};
+        }
+    }
+    return Duration{0};
+}
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+namespace {
+
+thread_local Stats* accounted = nullptr;
+
+}  // namespace
+
+Stats::Stats() = default;
+
+Stats::~Stats() noexcept = default;
+
+void Stats::send() {
+    local().sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Stats::start(Clock::duration const wait) {
+    auto& shard = local();
+    shard.started.fetch_add(1, std::memory_order_relaxed);
+    add(shard.wait, wait);
+}
+
+void Stats::finish(Clock::duration const exec) {
+    auto& shard = local();
+    shard.finished.fetch_add(1, std::memory_order_relaxed);
+    add(shard.exec, exec);
+}
+
+void Stats::drop() {
+    local().dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Stats::connect(Clock::duration const dur) {
+    auto& shard = local();
+    shard.connects.fetch_add(1, std::memory_order_relaxed);
+    add(shard.connect, dur);
+}
+
+void Stats::fail(Clock::duration const dur) {
+    auto& shard = local();
+    shard.failures.fetch_add(1, std::memory_order_relaxed);
+    add(shard.connect, dur);
+}
+
+void Stats::recycle() {
+    local().recycled.fetch_add(1, std::memory_order_relaxed);
+}
+
+Stats* Stats::accounting() noexcept {
+    return accounted;
+}
+
+void Stats::command(size_t const bytes) {
+    auto& shard = local();
+    shard.commands.fetch_add(1, std::memory_order_relaxed);
+    shard.command_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void Stats::result(size_t const bytes) {
+    auto& shard = local();
+    shard.results.fetch_add(1, std::memory_order_relaxed);
+    shard.result_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void Stats::job(size_t const bytes) {
+    auto& shard = local();
+    shard.jobs.fetch_add(1, std::memory_order_relaxed);
+    shard.job_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+Metrics Stats::snapshot() const {
+    Metrics res{};
+    auto    conns = int64_t{0};
+    for (auto const& shard : shards_) {
+        res.sent += shard.sent.load(std::memory_order_relaxed);
+        res.started += shard.started.load(std::memory_order_relaxed);
+        res.finished += shard.finished.load(std::memory_order_relaxed);
+        res.dropped += shard.dropped.load(std::memory_order_relaxed);
+        conns += shard.connects.load(std::memory_order_relaxed);
+        res.failures += shard.failures.load(std::memory_order_relaxed);
+        res.recycled += shard.recycled.load(std::memory_order_relaxed);
+        res.commands += shard.commands.load(std::memory_order_relaxed);
+        res.command_bytes += shard.command_bytes.load(std::memory_order_relaxed);
+        res.results += shard.results.load(std::memory_order_relaxed);
+        res.result_bytes += shard.result_bytes.load(std::memory_order_relaxed);
+        res.jobs += shard.jobs.load(std::memory_order_relaxed);
+        res.job_bytes += shard.job_bytes.load(std::memory_order_relaxed);
+        read(shard.wait, res.wait);
+        read(shard.exec, res.exec);
+        read(shard.connect, res.connect);
+    }
+
+    // Shards are read one by one while being updated, so the derived values are clamped.
+    res.connects = conns + res.failures;
+    res.queued   = std::max(int64_t{0}, res.sent - res.started - res.dropped);
+    res.workers  = static_cast<int>(std::max(int64_t{0}, conns - res.recycled));
+    res.active   = static_cast<int>(std::clamp(res.started - res.finished, int64_t{0}, int64_t{res.workers}));
+    res.idle     = res.workers - res.active;
+    return res;
+}
+
+void Stats::add(Buckets& to, Clock::duration const dur) {
+    to.counts[static_cast<size_t>(Histogram::bucket(dur))].fetch_add(1, std::memory_order_relaxed);
+    to.total.fetch_add(std::chrono::duration_cast<Histogram::Duration>(dur).count(), std::memory_order_relaxed);
+}
+
+void Stats::read(Buckets const& from, Histogram& to) {
+    for (auto i = size_t{0}; i < to.counts.size(); ++i) {
+        auto const count = from.counts[i].load(std::memory_order_relaxed);
+        to.counts[i] += count;
+        to.count += count;
+    }
+    to.total += Histogram::Duration{from.total.load(std::memory_order_relaxed)};
+}
+
+Stats::Account::Account(Stats& stats) noexcept
+    : prev_{accounted} {
+    accounted = &stats;
+}
+
+Stats::Account::~Account() noexcept {
+    accounted = prev_;
+}
+
+Stats::Shard& Stats::local() {
+    static std::atomic<size_t> next{0};
+    thread_local auto const    idx = next.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    return shards_[idx];
+}
+
+Reporter::Reporter(std::shared_ptr<Stats const> stats, Stats::Clock::duration const period, Sink sink)
+    : stats_{std::move(stats)} {
+    thread_ = std::thread([this, period, sink = std::move(sink)] {
+        std::unique_lock guard{mtx_};
+        while (!signal_.wait_for(guard, period, [this] { return is_stopped_; })) {
+            guard.unlock();
+            // A failing sink misses the report, but gets the following ones.
+            try {
+                sink(stats_->snapshot());
+            } catch (...) {
+            }
+            guard.lock();
+        }
+    });
+}
+
+Reporter::~Reporter() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+    }
+    signal_.notify_one();
+    thread_.join();
+}
+
+}  // namespace postgres::internal
@@ -1,15 +1,28 @@
 #include <postgres/Status.h>
+#include <postgres/internal/Stats.h>
 #include <postgres/Error.h>
 
 namespace postgres {
 
+namespace {
+
+void account(PGresult const* const handle) {
+    if (auto const stats = internal::Stats::accounting(); stats && handle) {
+        stats->result(PQresultMemorySize(handle));
+    }
+}
+
+}  // namespace
+
 Status::Status(PGresult* const handle)
     : handle_{handle, PQclear} {
+    account(handle);
     check();
 }
 
 Status::Status(PGresult* const handle, postgres::Consumer*)
     : handle_{handle, PQclear} {
+    account(handle);
     // Null result is valid in asynchronous mode.
     // It indicates an end of rows stream.
     if (handle) {
@@ -28,9 +41,16 @@ void Status::check() const {
         _POSTGRES_CXX_FAIL(LogicError, "rows stream is over");
     }
 
-    _POSTGRES_CXX_ASSERT(RuntimeError,
-                         isOk(),
-                         "fail to execute operation: " << describe() << ": " << message());
+    if (!isOk()) {
+        auto const code = PQresultErrorField(handle_.get(), PG_DIAG_SQLSTATE);
+        _POSTGRES_CXX_FAIL_CODE(RuntimeError,
+                                code ? code : "",
+                                "fail to execute operation: " << describe() << ": " << message());
+    }
+}
+
+std::shared_ptr<PGresult const> Status::share() const {
+    return handle_;
 }
 
 bool Status::isOk() const {
@@ -38,6 +58,9 @@ bool Status::isOk() const {
         case PGRES_COMMAND_OK:
         case PGRES_TUPLES_OK:
         case PGRES_SINGLE_TUPLE:
+#ifdef LIBPQ_HAS_CHUNK_MODE
+        case PGRES_TUPLES_CHUNK:
+#endif
         case PGRES_NONFATAL_ERROR: {
             return true;
         }
@@ -0,0 +1,272 @@
+#include <postgres/internal/StealingChannel.h>
+
+#include <algorithm>
+#include <postgres/internal/Worker.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+thread_local std::pair<StealingChannel const*, StealingChannel::Local*> StealingChannel::current_{};
+
+StealingChannel::StealingChannel(std::shared_ptr<Context const> ctx)
+    : ctx_{std::move(ctx)},
+      locals_(static_cast<size_t>(ctx_->maxConcurrency())),
+      owners_{0},
+      queued_{0},
+      room_{*ctx_},
+      idle_{0},
+      quits_{0} {
+}
+
+StealingChannel::~StealingChannel() noexcept = default;
+
+void StealingChannel::quit(int const count) {
+    // Workers quit only when there are no more jobs in any queue.
+    quits_ += count;
+    for (auto i = 0; i < count; ++i) {
+        wake();
+    }
+}
+
+std::tuple<bool, Worker*> StealingChannel::send(Job job) {
+    // A worker waiting for room would keep other ones waiting too.
+    room_.acquire(queued_, current_.first != this);
+    job.stamp();
+
+    if (current_.first == this) {
+        std::lock_guard guard{current_.second->mtx};
+        current_.second->queue.push_back(std::move(job));
+        ++queued_;
+    } else {
+        std::lock_guard guard{mtx_};
+        queue_.push_back(std::move(job));
+        ++queued_;
+    }
+
+    if (wake()) {
+        return {true, nullptr};
+    }
+
+    std::lock_guard guard{mtx_};
+    if (recreation_.empty()) {
+        return {false, nullptr};
+    }
+
+    auto const worker = recreation_.back();
+    recreation_.pop_back();
+    return {false, worker};
+}
+
+void StealingChannel::requeue(Job job) {
+    job.stamp();
+    {
+        std::lock_guard guard{mtx_};
+        queue_.push_front(std::move(job));
+        ++queued_;
+    }
+    wake();
+}
+
+void StealingChannel::receive(Slot& slot) {
+    auto& own = local(slot);
+    while (!take(slot, own)) {
+        {
+            std::lock_guard guard{mtx_};
+            slots_.push_back(&slot);
+            ++idle_;
+        }
+
+        // A job sent meanwhile could miss the slot, so check it once again.
+        if (isPending() && forget(slot)) {
+            continue;
+        }
+
+        // Jobs sent by the thread while the worker is idle are not its follow-ups.
+        current_ = {};
+        if (!wait(slot)) {
+            slot.job = nullptr;
+            break;
+        }
+    }
+
+    // Follow-ups of the job taken, stolen or not, go to the local queue unless the worker is going to quit.
+    if (slot.job) {
+        current_ = {this, &own};
+    } else {
+        current_ = {};
+    }
+}
+
+bool StealingChannel::poll(Slot& slot) {
+    auto const res = take(slot, local(slot));
+    current_ = {};
+    return res;
+}
+
+void StealingChannel::recycle(Worker& worker) {
+    // Workers recycle themselves, while the dispatcher may recycle a parked one from the thread of another.
+    if (worker.isCurrent()) {
+        current_ = {};
+    }
+    std::lock_guard guard{mtx_};
+    recreation_.push_back(&worker);
+}
+
+void StealingChannel::drop() {
+    {
+        std::lock_guard guard{mtx_};
+        queued_ -= static_cast<int>(queue_.size());
+        auto const garbage = std::move(queue_);
+    }
+
+    auto const count = owners_.load();
+    for (auto i = 0; i < count; ++i) {
+        auto&           peer = locals_[i];
+        std::lock_guard guard{peer.mtx};
+        queued_ -= static_cast<int>(peer.queue.size());
+        auto const garbage = std::move(peer.queue);
+    }
+    room_.releaseAll();
+}
+
+StealingChannel::Local& StealingChannel::local(Slot& slot) {
+    if ((current_.first == this) && (current_.second->owner == &slot)) {
+        return *current_.second;
+    }
+
+    // A worker keeps its queue when being run again.
+    std::lock_guard guard{mtx_};
+    auto const      count = owners_.load();
+    auto const      end   = locals_.begin() + count;
+    auto            it    = std::find_if(locals_.begin(), end, [&slot](Local const& loc) {
+        return loc.owner == &slot;
+    });
+    if (it == end) {
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             count < static_cast<int>(locals_.size()),
+                             "too many workers: " << count);
+        it->owner = &slot;
+        ++owners_;
+    }
+
+    current_ = {this, &*it};
+    return *it;
+}
+
+bool StealingChannel::take(Slot& slot, Local& own) {
+    if (0 < queued_) {
+        {
+            std::lock_guard guard{own.mtx};
+            if (!own.queue.empty()) {
+                own.queue.back().swap(slot.job);
+                own.queue.pop_back();
+                --queued_;
+                room_.release();
+                return true;
+            }
+        }
+        {
+            std::lock_guard guard{mtx_};
+            if (!queue_.empty()) {
+                queue_.front().swap(slot.job);
+                queue_.pop_front();
+                --queued_;
+                room_.release();
+                return true;
+            }
+        }
+
+        auto const count = owners_.load();
+        auto const idx   = static_cast<int>(&own - locals_.data());
+        for (auto i = 1; (0 < queued_) && (i < count); ++i) {
+            auto&           peer = locals_[(idx + i) % count];
+            std::lock_guard guard{peer.mtx};
+            if (!peer.queue.empty()) {
+                peer.queue.front().swap(slot.job);
+                peer.queue.pop_front();
+                --queued_;
+                room_.release();
+                return true;
+            }
+        }
+    }
+
+    auto quits = quits_.load();
+    while (0 < quits) {
+        if (quits_.compare_exchange_weak(quits, quits - 1)) {
+            slot.job = nullptr;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StealingChannel::wake() {
+    if (idle_ == 0) {
+        return false;
+    }
+
+    std::unique_lock c_guard{mtx_};
+    if (slots_.empty()) {
+        return false;
+    }
+
+    auto const slot = slots_.back();
+    slots_.pop_back();
+    --idle_;
+    c_guard.unlock();
+
+    std::lock_guard s_guard{slot->mtx};
+    slot->is_woken = true;
+    slot->signal.notify_one();
+    return true;
+}
+
+bool StealingChannel::wait(Slot& slot) {
+    std::unique_lock s_guard{slot.mtx};
+    auto const       is_woken = [&slot] {
+        return slot.is_woken;
+    };
+
+    auto const timeout = slot.is_persistent ? Context::Duration{} : ctx_->idleTimeout();
+    if (timeout.count() == 0) {
+        slot.signal.wait(s_guard, is_woken);
+        slot.is_woken = false;
+        return true;
+    }
+
+    if (slot.signal.wait_for(s_guard, timeout, is_woken)) {
+        slot.is_woken = false;
+        return true;
+    }
+
+    // Check if other thread is going to wake the slot.
+    s_guard.unlock();
+    if (forget(slot)) {
+        return isPending();
+    }
+
+    s_guard.lock();
+    slot.signal.wait(s_guard, is_woken);
+    slot.is_woken = false;
+    return true;
+}
+
+bool StealingChannel::forget(Slot& slot) {
+    std::lock_guard guard{mtx_};
+    auto const      it = std::find(slots_.begin(), slots_.end(), &slot);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    slots_.erase(it);
+    --idle_;
+    return true;
+}
+
+bool StealingChannel::isPending() const {
+    return (0 < queued_) || (0 < quits_);
+}
+
+}  // namespace postgres::internal
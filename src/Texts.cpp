@@ -0,0 +1,31 @@
+#include <postgres/internal/Texts.h>
+
+#include <mutex>
+#include <utility>
+
+namespace postgres::internal {
+
+Texts::Texts(size_t const limit)
+    : limit_{limit} {
+}
+
+Texts::~Texts() noexcept = default;
+
+std::string_view Texts::find(size_t const key) const {
+    std::shared_lock lock{mtx_};
+    auto const       it = cache_.find(key);
+    return (it == cache_.end()) ? std::string_view{} : std::string_view{it->second};
+}
+
+std::string_view Texts::add(size_t const key, std::string&& text) {
+    std::unique_lock lock{mtx_};
+    if (auto const it = cache_.find(key); it != cache_.end()) {
+        return it->second;
+    }
+    if (cache_.size() == limit_) {
+        return {};
+    }
+    return cache_.emplace(key, std::move(text)).first->second;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,115 @@
+#include <postgres/internal/Thread.h>
+
+#include <atomic>
+#include <exception>
+#include <string>
+#include <sched.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+namespace {
+
+// Threads pinned to a CPU each take the CPUs of the set in turn.
+std::atomic<size_t> next_cpu{0};
+
+class Attributes {
+public:
+    explicit Attributes() {
+        pthread_attr_init(&attr_);
+    }
+
+    Attributes(Attributes const& other) = delete;
+    Attributes& operator=(Attributes const& other) = delete;
+
+    ~Attributes() noexcept {
+        pthread_attr_destroy(&attr_);
+    }
+
+    pthread_attr_t* get() {
+        return &attr_;
+    }
+
+private:
+    pthread_attr_t attr_{};
+};
+
+}  // namespace
+
+Thread::Thread(Context const& ctx, std::unique_ptr<IBody> body) {
+    Attributes attr{};
+    if (auto const size = ctx.stackSize(); size != 0) {
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             pthread_attr_setstacksize(attr.get(), size) == 0,
+                             "fail to set thread stack size " << size);
+    }
+    if (auto const& cpus = ctx.cpuAffinity(); !cpus.empty()) {
+        cpu_set_t set{};
+        CPU_ZERO(&set);
+        if (ctx.pinEach()) {
+            CPU_SET(cpus[next_cpu.fetch_add(1, std::memory_order_relaxed) % cpus.size()], &set);
+        } else {
+            for (auto const cpu : cpus) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             pthread_attr_setaffinity_np(attr.get(), sizeof(set), &set) == 0,
+                             "fail to set thread affinity");
+    }
+
+    auto const res = pthread_create(&handle_, attr.get(), &Thread::run, body.get());
+    _POSTGRES_CXX_ASSERT(RuntimeError, res == 0, "fail to create thread: " << res);
+    static_cast<void>(body.release());
+    is_joinable_ = true;
+
+    // Names over the limit of 15 characters are rejected, so they are cut.
+    if (auto const& name = ctx.threadName(); !name.empty()) {
+        pthread_setname_np(handle_, name.substr(0, 15).c_str());
+    }
+}
+
+Thread::Thread(Thread&& other) noexcept
+    : handle_{other.handle_}, is_joinable_{other.is_joinable_} {
+    other.is_joinable_ = false;
+}
+
+Thread& Thread::operator=(Thread&& other) noexcept {
+    if (is_joinable_) {
+        std::terminate();
+    }
+    handle_            = other.handle_;
+    is_joinable_       = other.is_joinable_;
+    other.is_joinable_ = false;
+    return *this;
+}
+
+Thread::~Thread() noexcept {
+    if (is_joinable_) {
+        std::terminate();
+    }
+}
+
+bool Thread::joinable() const {
+    return is_joinable_;
+}
+
+void Thread::join() {
+    _POSTGRES_CXX_ASSERT(LogicError, is_joinable_, "thread is not joinable");
+    pthread_join(handle_, nullptr);
+    is_joinable_ = false;
+}
+
+void Thread::detach() {
+    _POSTGRES_CXX_ASSERT(LogicError, is_joinable_, "thread is not joinable");
+    pthread_detach(handle_);
+    is_joinable_ = false;
+}
+
+void* Thread::run(void* const body) noexcept {
+    std::unique_ptr<IBody>{static_cast<IBody*>(body)}->run();
+    return nullptr;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,67 @@
+#include <postgres/internal/Throttle.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace postgres::internal {
+
+Throttle::Throttle(int const max, Duration const interval)
+    : max_{max}, interval_{interval}, pending_{0}, open_{0}, rand_{std::random_device{}()} {
+}
+
+Throttle::~Throttle() noexcept = default;
+
+int Throttle::pending() const {
+    return pending_.load(std::memory_order_relaxed);
+}
+
+bool Throttle::isIdle() const {
+    return (pending_.load() == 0) && (open_.load() == 0);
+}
+
+bool Throttle::admit() {
+    if (max_ == 0) {
+        enter();
+        return true;
+    }
+
+    auto cur = pending();
+    do {
+        if (max_ <= cur) {
+            return false;
+        }
+    } while (!pending_.compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void Throttle::enter() {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Throttle::leave() {
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Throttle::open() {
+    open_.fetch_add(1);
+}
+
+void Throttle::close() {
+    open_.fetch_sub(1);
+}
+
+void Throttle::pace() {
+    if (interval_.count() == 0) {
+        return;
+    }
+
+    std::unique_lock guard{mtx_};
+    auto const at     = std::max(Clock::now(), next_);
+    auto const jitter = Duration{std::uniform_int_distribution<Duration::rep>{0, interval_.count() / 2}(rand_)};
+    next_ = at + interval_;
+    guard.unlock();
+
+    std::this_thread::sleep_until(at + jitter);
+}
+
+}  // namespace postgres::internal
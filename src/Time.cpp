@@ -1,5 +1,5 @@
 #include <postgres/Time.h>
-#include <regex>
+#include <ctime>
 #include <utility>
 #include <postgres/Error.h>
 
@@ -9,12 +9,126 @@ using std::chrono::seconds;
 using std::chrono::microseconds;
 using std::chrono::nanoseconds;
 
-inline bool isLeap(long const year) {
-    // There is a leap year every year divisible by four
-    // except for years which are both divisible by 100 and not divisible by 400.
-    return !(year % 4) && ((year % 100) || !(year % 400));
+namespace {
+
+// Days since 1970-01-01 of the proleptic Gregorian calendar date, in constant time.
+// Years are shifted to start in March, so that the leap day comes last.
+int64_t daysFromCivil(int64_t year, int64_t const month, int64_t const day) {
+    year -= (month <= 2);
+    auto const era = ((0 <= year) ? year : (year - 399)) / 400;
+    auto const yoe = year - era * 400;
+    auto const doy = (153 * (month + ((2 < month) ? -3 : 9)) + 2) / 5 + day - 1;
+    auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
 }
 
+// The inverse of the above.
+void civilFromDays(int64_t days, int64_t& year, int& month, int& day) {
+    days += 719468;
+    auto const era = ((0 <= days) ? days : (days - 146096)) / 146097;
+    auto const doe = days - era * 146097;
+    auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp  = (5 * doy + 2) / 153;
+    day   = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>((mp < 10) ? (mp + 3) : (mp - 9));
+    year  = yoe + era * 400 + (month <= 2);
+}
+
+bool isDigit(char const c) {
+    return ('0' <= c) && (c <= '9');
+}
+
+bool readNumber(std::string_view const s, size_t const pos, size_t const len, int64_t& out) {
+    if (s.size() < pos + len) {
+        return false;
+    }
+    out = 0;
+    for (auto idx = pos; idx < pos + len; ++idx) {
+        if (!isDigit(s[idx])) {
+            return false;
+        }
+        out = out * 10 + (s[idx] - '0');
+    }
+    return true;
+}
+
+char* writeNumber(char* out, int64_t val, int const width) {
+    char* const end = out + width;
+    for (auto it = end; it != out;) {
+        *--it = static_cast<char>('0' + val % 10);
+        val /= 10;
+    }
+    return end;
+}
+
+// Returns the name of the malformed part, or nullptr on success.
+//  00000000001111111111222222222
+//  01234567890123456789012345678
+//  YYYY-mm-ddTHH:MM:SS.fffffffff
+char const* parseTime(std::string_view const s, Time::Point& out) {
+    int64_t years   = 0;
+    int64_t months  = 0;
+    int64_t days    = 0;
+    int64_t hours   = 0;
+    int64_t minutes = 0;
+    int64_t secs    = 0;
+
+    auto const is_valid = (19 <= s.size())
+                          && readNumber(s, 0, 4, years)
+                          && (s[4] == '-')
+                          && readNumber(s, 5, 2, months)
+                          && (s[7] == '-')
+                          && readNumber(s, 8, 2, days)
+                          && ((s[10] == 'T') || (s[10] == ' ') || (s[10] == '\t'))
+                          && readNumber(s, 11, 2, hours)
+                          && (s[13] == ':')
+                          && readNumber(s, 14, 2, minutes)
+                          && (s[16] == ':')
+                          && readNumber(s, 17, 2, secs);
+    if (!is_valid) {
+        return "time format";
+    }
+    if ((months < 1) || (12 < months)) {
+        return "month";
+    }
+    if ((days < 1) || (31 < days)) {
+        return "month day";
+    }
+    if (23 < hours) {
+        return "hours";
+    }
+    if (59 < minutes) {
+        return "minutes";
+    }
+    if (59 < secs) {
+        return "seconds";
+    }
+
+    // Up to nine digits of fraction, optionally preceded by a dot.
+    auto pos   = size_t{19};
+    auto nanos = int64_t{0};
+    if ((pos < s.size()) && (s[pos] == '.')) {
+        ++pos;
+    }
+    auto const frac = pos;
+    for (; (pos < s.size()) && (pos - frac < 9) && isDigit(s[pos]); ++pos) {
+        nanos = nanos * 10 + (s[pos] - '0');
+    }
+    if (pos != s.size()) {
+        return "time format";
+    }
+    for (auto digits = pos - frac; digits < 9; ++digits) {
+        nanos *= 10;
+    }
+
+    auto const total = ((daysFromCivil(years, months, days) * 24 + hours) * 60 + minutes) * 60 + secs;
+    out = Time::Point{std::chrono::duration_cast<Time::Point::duration>(seconds{total} + nanoseconds{nanos})};
+    return nullptr;
+}
+
+}  // namespace
+
 Time::Time() = default;
 
 Time::Time(time_t const uni, bool const has_zone)
@@ -25,63 +139,13 @@ Time::Time(Point const pnt, bool const has_zone)
     : pnt_{pnt}, has_zone_{has_zone} {
 }
 
-Time::Time(std::string const& s) {
+Time::Time(std::string_view const s) {
     // 2017-08-25T13:03:35
     // 2017-08-25T13:03:35.123456789
     // 2017-08-25 13:03:35
     // 2017-08-25 13:03:35.123457
-    static std::regex const expr{"([[:digit:]]{4})-"    // years
-                                 "([[:digit:]]{2})-"    // months
-                                 "([[:digit:]]{2})"     // days
-                                 "[[:space:]T]"         // delimiter
-                                 "([[:digit:]]{2}):"    // hours
-                                 "([[:digit:]]{2}):"    // minutes
-                                 "([[:digit:]]{2})"     // seconds
-                                 "\\.?"                 // dot
-                                 "([[:digit:]]{1,9})?"  // fraction
-    };
-
-    std::smatch match{};
-    _POSTGRES_CXX_ASSERT(LogicError,
-                         std::regex_match(s, match, expr),
-                         "bad time format: '" << s << "'");
-
-    auto const years    = std::stol(match[1].str());
-    auto const months   = std::stol(match[2].str());
-    auto       days     = std::stol(match[3].str());
-    auto       hours    = std::stol(match[4].str());
-    auto       minutes  = std::stol(match[5].str());
-    auto       seconds  = std::stol(match[6].str());
-    auto       fraction = match[7].str();
-
-    _POSTGRES_CXX_ASSERT(LogicError, 1 <= months && months <= 12, "bad month in '" << s << "'");
-    _POSTGRES_CXX_ASSERT(LogicError, 1 <= days && days <= 31, "bad month day in '" << s << "'");
-    _POSTGRES_CXX_ASSERT(LogicError, 0 <= hours && hours <= 23, "bad hours in '" << s << "'");
-    _POSTGRES_CXX_ASSERT(LogicError, 0 <= minutes && minutes <= 59, "bad minutes in '" << s << "'");
-    _POSTGRES_CXX_ASSERT(LogicError, 0 <= seconds && seconds <= 59, "bad seconds in '" << s << "'");
-
-    for (auto y = years; y < 1970; ++y) {
-        days -= isLeap(y) ? 366 : 365;
-    }
-    for (auto y = 1970; y < years; ++y) {
-        days += isLeap(y) ? 366 : 365;
-    }
-    for (auto m = 1; m < months; ++m) {
-        days += ((int[]) {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31})[m - 1];
-    }
-    if (2 < months && isLeap(years)) {
-        ++days;
-    }
-    hours += (days - 1) * 24;
-    minutes += hours * 60;
-    seconds += minutes * 60;
-
-    pnt_ = Clock::from_time_t(seconds);
-    if (!fraction.empty()) {
-        fraction.resize(9, '0');
-        auto const nanos = nanoseconds{std::stol(fraction)};
-        pnt_ += std::chrono::duration_cast<Point::duration>(nanos);
-    }
+    auto const err = parseTime(s, pnt_);
+    _POSTGRES_CXX_ASSERT(LogicError, !err, "bad " << err << " in '" << s << "'");
 }
 
 Time::Time(Time const& other) noexcept = default;
@@ -94,6 +158,10 @@ Time& Time::operator=(Time&& other) noexcept = default;
 
 Time::~Time() noexcept = default;
 
+bool Time::parse(std::string_view const s, Point& out) {
+    return !parseTime(s, out);
+}
+
 time_t Time::toUnix() const {
     return Clock::to_time_t(pnt_);
 }
@@ -103,32 +171,75 @@ time_t Time::toPostgres() const {
 }
 
 std::string Time::toString() const {
-    std::string res(64, 0);
-    auto const  dur   = pnt_.time_since_epoch();
-    auto const  secs  = std::chrono::duration_cast<seconds>(dur);
-    auto const  nanos = std::chrono::duration_cast<nanoseconds>(dur - secs);
-    auto        uni   = toUnix();
-    tm          parts{};
+    char res[MAX_STRING_LEN];
+    return std::string(res, format(res));
+}
+
+size_t Time::format(char* const out) const {
+    // Rounding towards negative infinity keeps the fraction positive before 1970.
+    auto const dur   = std::chrono::duration_cast<nanoseconds>(pnt_.time_since_epoch());
+    auto       secs  = std::chrono::duration_cast<seconds>(dur);
+    if (dur < secs) {
+        secs -= seconds{1};
+    }
+    auto const nanos  = (dur - secs).count();
+    auto       offset = int64_t{0};
 
     if (has_zone_) {
-        res.resize(strftime(&res[0],
-                            res.size(),
-                            nanos.count() ? "%FT%T.000000000 %z" : "%FT%T %z",
-                            localtime_r(&uni, &parts)));
-    } else {
-        res.resize(strftime(&res[0],
-                            res.size(),
-                            nanos.count() ? "%FT%T.000000000" : "%FT%T",
-                            gmtime_r(&uni, &parts)));
-    }
-
-    //  00000000001111111111222222222233333
-    //  01234567890123456789012345678901234
+        auto uni   = static_cast<time_t>(secs.count());
+        tm   parts{};
+        localtime_r(&uni, &parts);
+        offset = parts.tm_gmtoff;
+    }
+
+    auto const local = secs.count() + offset;
+    auto       days  = local / 86400;
+    auto       rest  = local % 86400;
+    if (rest < 0) {
+        rest += 86400;
+        --days;
+    }
+
+    int64_t year  = 0;
+    int     month = 0;
+    int     day   = 0;
+    civilFromDays(days, year, month, day);
+
+    //  0000000000111111111122222222223333
+    //  0123456789012345678901234567890123
     //  YYYY-mm-ddTHH:MM:SS.000000000 +0300
-    if (nanos.count()) {
-        res.replace(20, 9, std::to_string(nanos.count()));
+    auto it = out;
+    if (year < 0) {
+        *it++ = '-';
+        year  = -year;
+    }
+    auto width = 4;
+    for (auto y = year / 10000; y; y /= 10) {
+        ++width;
+    }
+    it    = writeNumber(it, year, width);
+    *it++ = '-';
+    it    = writeNumber(it, month, 2);
+    *it++ = '-';
+    it    = writeNumber(it, day, 2);
+    *it++ = 'T';
+    it    = writeNumber(it, rest / 3600, 2);
+    *it++ = ':';
+    it    = writeNumber(it, rest / 60 % 60, 2);
+    *it++ = ':';
+    it    = writeNumber(it, rest % 60, 2);
+    if (nanos) {
+        *it++ = '.';
+        it    = writeNumber(it, nanos, 9);
+    }
+    if (has_zone_) {
+        *it++ = ' ';
+        *it++ = (offset < 0) ? '-' : '+';
+        offset = (offset < 0) ? -offset : offset;
+        it     = writeNumber(it, offset / 3600, 2);
+        it     = writeNumber(it, offset / 60 % 60, 2);
     }
-    return res;
+    return static_cast<size_t>(it - out);
 }
 
 Time::Point Time::point() const {
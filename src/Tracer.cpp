@@ -0,0 +1,80 @@
+#include <postgres/Tracer.h>
+
+#include <cstring>
+#include <postgres/internal/Span.h>
+#include <postgres/Command.h>
+
+namespace postgres {
+
+Tracer::~Tracer() noexcept = default;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+namespace {
+
+thread_local Trace::Clock::duration job_wait{0};
+
+}  // namespace
+
+void Span::queued(Trace::Clock::duration const wait) {
+    job_wait = wait;
+}
+
+Span::Span(std::shared_ptr<Tracer> tracer, std::string stmt)
+    : tracer_{std::move(tracer)}, stmt_{std::move(stmt)} {
+    trace_.start = Trace::Clock::now();
+    trace_.wait  = job_wait;
+    job_wait     = Trace::Clock::duration{0};
+}
+
+Span::Span(std::shared_ptr<Tracer> tracer, Command const& cmd, bool const is_prepared)
+    : Span{std::move(tracer), cmd.statement()} {
+    trace_.is_prepared = is_prepared;
+    trace_.params      = cmd.count();
+
+    // Lengths of text values are not set.
+    auto const vals    = cmd.values();
+    auto const lens    = cmd.lengths();
+    auto const formats = cmd.formats();
+    for (auto i = 0; i < cmd.count(); ++i) {
+        if (formats[i] == 1) {
+            trace_.bytes += static_cast<size_t>(lens[i]);
+        } else if (vals[i] != nullptr) {
+            trace_.bytes += std::strlen(vals[i]);
+        }
+    }
+}
+
+Span::~Span() noexcept = default;
+
+void Span::add(PGresult const* const res) {
+    if (is_first_) {
+        trace_.first = Trace::Clock::now() - trace_.start;
+        is_first_    = false;
+    }
+    if (res == nullptr) {
+        return;
+    }
+
+    trace_.rows += PQntuples(res);
+    if (code_.empty()) {
+        if (auto const code = PQresultErrorField(res, PG_DIAG_SQLSTATE)) {
+            code_ = code;
+        }
+    }
+}
+
+void Span::finish() {
+    trace_.total     = Trace::Clock::now() - trace_.start;
+    trace_.statement = stmt_;
+    trace_.code      = code_;
+    // A failing tracer must not fail the statement, nor the destructor of a receiver.
+    try {
+        tracer_->trace(trace_);
+    } catch (...) {
+    }
+}
+
+}  // namespace postgres::internal
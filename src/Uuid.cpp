@@ -0,0 +1,65 @@
+#include <postgres/Uuid.h>
+
+#include <postgres/Error.h>
+
+namespace postgres {
+
+namespace {
+
+//  000000000011111111112222222222333333
+//  012345678901234567890123456789012345
+//  xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+bool isDash(size_t const pos) {
+    return (pos == 8) || (pos == 13) || (pos == 18) || (pos == 23);
+}
+
+int fromHex(char const c) {
+    if (('0' <= c) && (c <= '9')) {
+        return c - '0';
+    }
+    if (('a' <= c) && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    if (('A' <= c) && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+}  // namespace
+
+Uuid Uuid::parse(std::string_view const s) {
+    _POSTGRES_CXX_ASSERT(LogicError, s.size() == 36, "bad uuid format: '" << s << "'");
+
+    Uuid res{};
+    auto idx = size_t{0};
+    for (auto pos = size_t{0}; pos < s.size(); ++pos) {
+        if (isDash(pos)) {
+            _POSTGRES_CXX_ASSERT(LogicError, s[pos] == '-', "bad uuid format: '" << s << "'");
+            continue;
+        }
+
+        auto const hi = fromHex(s[pos]);
+        auto const lo = fromHex(s[++pos]);
+        _POSTGRES_CXX_ASSERT(LogicError, (0 <= hi) && (0 <= lo), "bad uuid format: '" << s << "'");
+        res.bytes[idx++] = static_cast<uint8_t>(hi * 16 + lo);
+    }
+    return res;
+}
+
+std::string Uuid::toString() const {
+    static char constexpr DIGITS[] = "0123456789abcdef";
+
+    std::string res(36, '-');
+    auto        idx = size_t{0};
+    for (auto pos = size_t{0}; pos < res.size(); ++pos) {
+        if (isDash(pos)) {
+            continue;
+        }
+        res[pos]   = DIGITS[bytes[idx] >> 4];
+        res[++pos] = DIGITS[bytes[idx++] & 0xF];
+    }
+    return res;
+}
+
+}  // namespace postgres
@@ -0,0 +1,112 @@
+#include <postgres/internal/Watchdog.h>
+
+#include <algorithm>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+Watchdog::Watchdog()
+    : next_{0}, is_done_{false} {
+    thread_ = std::thread([this] {
+        run();
+    });
+}
+
+Watchdog::~Watchdog() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_done_ = true;
+        signal_.notify_one();
+    }
+    thread_.join();
+
+    for (auto const& [key, cancel] : watches_) {
+        PQfreeCancel(cancel);
+    }
+}
+
+Watchdog::Watch Watchdog::watch(Connection& conn, Deadline const deadline) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         std::chrono::steady_clock::now() < deadline,
+                         "deadline exceeded");
+
+    auto const cancel = PQgetCancel(conn.native());
+    _POSTGRES_CXX_ASSERT(RuntimeError, cancel != nullptr, "fail to get cancel handle");
+
+    std::lock_guard guard{mtx_};
+    auto const      key = Key{deadline, next_++};
+    watches_.emplace(key, cancel);
+    if (watches_.begin()->first == key) {
+        signal_.notify_one();
+    }
+    return Watch{*this, key};
+}
+
+void Watchdog::run() {
+    std::unique_lock guard{mtx_};
+    while (!is_done_) {
+        if (watches_.empty()) {
+            signal_.wait(guard);
+            continue;
+        }
+
+        auto const now      = std::chrono::steady_clock::now();
+        auto const deadline = watches_.begin()->first.first;
+        if (now < deadline) {
+            signal_.wait_until(guard, deadline);
+            continue;
+        }
+
+        std::vector<std::pair<Key, PGcancel*>> expired{};
+        for (auto it = watches_.begin(); (it != watches_.end()) && (it->first.first <= now);) {
+            expired.emplace_back(*it);
+            cancelling_.push_back(it->first);
+            it = watches_.erase(it);
+        }
+
+        // Watching other queries doesn't wait for the server meanwhile.
+        guard.unlock();
+        for (auto const& [key, cancel] : expired) {
+            char err[256];
+            PQcancel(cancel, err, sizeof(err));
+            PQfreeCancel(cancel);
+        }
+        guard.lock();
+        cancelling_.clear();
+        cancelled_.notify_all();
+    }
+}
+
+void Watchdog::forget(Key const& key) {
+    std::unique_lock guard{mtx_};
+    // The connection doesn't move on to the next query while the cancel is being sent.
+    cancelled_.wait(guard, [this, &key] {
+        return std::find(cancelling_.begin(), cancelling_.end(), key) == cancelling_.end();
+    });
+
+    auto const it = watches_.find(key);
+    if (it == watches_.end()) {
+        return;
+    }
+
+    PQfreeCancel(it->second);
+    watches_.erase(it);
+}
+
+Watchdog::Watch::Watch(Watchdog& dog, Key key)
+    : dog_{&dog}, key_{std::move(key)} {
+}
+
+Watchdog::Watch::Watch(Watch&& other) noexcept
+    : dog_{other.dog_}, key_{other.key_} {
+    other.dog_ = nullptr;
+}
+
+Watchdog::Watch::~Watch() noexcept {
+    if (dog_ != nullptr) {
+        dog_->forget(key_);
+    }
+}
+
+}  // namespace postgres::internal
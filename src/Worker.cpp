@@ -1,16 +1,44 @@
 #include <postgres/internal/Worker.h>
 
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <thread>
 #include <utility>
+#include <postgres/internal/Budget.h>
 #include <postgres/internal/IChannel.h>
+#include <postgres/internal/Limiter.h>
+#include <postgres/internal/Span.h>
+#include <postgres/internal/Stats.h>
+#include <postgres/internal/Throttle.h>
 #include <postgres/Connection.h>
 #include <postgres/Context.h>
+#include <postgres/Error.h>
 
 namespace postgres::internal {
 
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Only compared, as a worker aborted on shutdown may be gone before its thread.
+thread_local Worker const*   running = nullptr;
+thread_local IChannel const* serving = nullptr;
+
+}  // namespace
+
 Worker::Worker(std::shared_ptr<Context const> ctx, std::shared_ptr<IChannel> chan)
     : ctx_{std::move(ctx)}, chan_{std::move(chan)} {
 }
 
+bool Worker::serves(IChannel const& chan) {
+    return serving == &chan;
+}
+
+bool Worker::isCurrent() const {
+    return running == this;
+}
+
 Worker::~Worker() noexcept {
     if (thread_.joinable()) {
         switch (ctx_->shutdownPolicy()) {
@@ -27,11 +55,49 @@ Worker::~Worker() noexcept {
     }
 }
 
-void Worker::run() {
+std::future<void> Worker::run() {
     if (thread_.joinable()) {
         thread_.join();
     }
-    thread_ = std::thread([this, conn = ctx_->connect()]() mutable {
+
+    std::promise<void> prom{};
+    auto               res = prom.get_future();
+    if (lim_) {
+        lim_->enter();
+    }
+    thread_ = Thread{*ctx_, [this, prom = std::move(prom)]() mutable {
+        running = this;
+        serving = chan_.get();
+        // Connecting in the background keeps senders from waiting.
+        std::optional<Connection> conn{};
+        if (throttle_) {
+            throttle_->pace();
+        }
+        auto const conn_beg = Clock::now();
+        try {
+            conn.emplace(ctx_->connect());
+            if (throttle_) {
+                throttle_->open();
+                throttle_->leave();
+            }
+        } catch (...) {
+            if (throttle_) {
+                throttle_->leave();
+            }
+            if (stats_) {
+                stats_->fail(Clock::now() - conn_beg);
+            }
+            prom.set_exception(std::current_exception());
+            fail(std::current_exception());
+            quit(true);
+            return;
+        }
+        if (stats_) {
+            stats_->connect(Clock::now() - conn_beg);
+        }
+        prom.set_value();
+
+        auto idle_since = Clock::now();
         while (true) {
             chan_->receive(slot_);
             auto const job = std::move(slot_.job);
@@ -39,13 +105,173 @@ void Worker::run() {
                 break;
             }
 
-            job(conn);
-            if (!conn.isOk()) {
-                break;
+            auto const check = ctx_->healthCheck();
+            if ((check.count() != 0) && (check <= Clock::now() - idle_since) && !conn->isAlive()) {
+                if (auto const err = reconnect(conn)) {
+                    if (stats_) {
+                        stats_->drop();
+                    }
+                    job.fail(err);
+                    drain(err);
+                    break;
+                }
+            }
+
+            std::optional<Budget::Scope> charged{};
+            if (budget_) {
+                charged.emplace(*budget_);
+            }
+            if (!lim_ && !stats_) {
+                job(*conn);
+            } else {
+                auto const beg = Clock::now();
+                if (stats_) {
+                    auto const wait = job.waited(beg);
+                    stats_->start(wait);
+                    Span::queued(wait);
+                }
+                std::optional<Stats::Account> acc{};
+                if (stats_ && ctx_->accountMemory()) {
+                    stats_->job(job.pooledSize());
+                    acc.emplace(*stats_);
+                }
+                job(*conn);
+                acc.reset();
+                auto const dur = Clock::now() - beg;
+                if (stats_) {
+                    // A job without statements would leave its wait to a later span of the thread.
+                    Span::queued({});
+                    stats_->finish(dur);
+                }
+                if (lim_) {
+                    lim_->record(dur);
+                }
+            }
+
+            if (!conn->isOk()) {
+                if (auto const err = reconnect(conn)) {
+                    drain(err);
+                    break;
+                }
+            }
+            idle_since = Clock::now();
+            if (lim_ && !slot_.is_persistent && !lim_->keep()) {
+                if (stats_) {
+                    stats_->recycle();
+                }
+                disconnect(conn);
+                quit(false);
+                return;
             }
         }
-        chan_->recycle(*this);
-    });
+        if (stats_) {
+            stats_->recycle();
+        }
+        disconnect(conn);
+        quit(true);
+    }};
+    return res;
+}
+
+void Worker::keepAlive() {
+    slot_.is_persistent = true;
+}
+
+void Worker::limitBy(std::shared_ptr<Limiter> lim) {
+    lim_ = std::move(lim);
+}
+
+void Worker::reportTo(std::shared_ptr<Stats> stats) {
+    stats_ = std::move(stats);
+}
+
+void Worker::chargeTo(std::shared_ptr<Budget> budget) {
+    budget_ = std::move(budget);
+}
+
+void Worker::throttleBy(std::shared_ptr<Throttle> throttle) {
+    throttle_ = std::move(throttle);
+}
+
+std::exception_ptr Worker::reconnect(std::optional<Connection>& conn) {
+    disconnect(conn);
+    auto backoff = ctx_->reconnectBackoff();
+    auto err     = std::make_exception_ptr(RuntimeError{"connection is broken"});
+    for (auto attempt = 0; attempt < ctx_->reconnectAttempts(); ++attempt) {
+        if (attempt != 0) {
+            std::this_thread::sleep_for(backoff);
+            backoff *= 2;
+        }
+
+        if (throttle_) {
+            throttle_->enter();
+            throttle_->pace();
+        }
+        auto const beg = Clock::now();
+        try {
+            conn.emplace(ctx_->connect());
+            if (throttle_) {
+                throttle_->open();
+                throttle_->leave();
+            }
+            if (stats_) {
+                stats_->connect(Clock::now() - beg);
+            }
+            return nullptr;
+        } catch (...) {
+            if (throttle_) {
+                throttle_->leave();
+            }
+            if (stats_) {
+                stats_->fail(Clock::now() - beg);
+            }
+            err = std::current_exception();
+        }
+    }
+    return err;
+}
+
+void Worker::disconnect(std::optional<Connection>& conn) {
+    if (throttle_ && conn) {
+        throttle_->close();
+    }
+    conn.reset();
+}
+
+void Worker::quit(bool const is_counted) {
+    if (lim_ && is_counted) {
+        lim_->leave();
+    }
+    chan_->recycle(*this);
+}
+
+void Worker::fail(std::exception_ptr const& err) {
+    // The job which has caused the worker to start likely waits in the queue.
+    if (!chan_->poll(slot_)) {
+        return;
+    }
+
+    auto const job = std::move(slot_.job);
+    if (job) {
+        if (stats_) {
+            stats_->drop();
+        }
+        job.fail(err);
+    }
+    drain(err);
+}
+
+void Worker::drain(std::exception_ptr const& err) {
+    // No worker is started for the jobs left queued while the connections have been throttled.
+    while (throttle_ && throttle_->isIdle() && chan_->poll(slot_)) {
+        auto const job = std::move(slot_.job);
+        if (job) {
+            if (stats_) {
+                stats_->drop();
+            }
+            job.fail(err);
+        }
+    }
 }
 
 }  // namespace postgres::internal
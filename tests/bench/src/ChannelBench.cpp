@@ -0,0 +1,77 @@
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <postgres/internal/Channel.h>
+#include <postgres/internal/ShardedChannel.h>
+#include <postgres/internal/StealingChannel.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+
+namespace postgres::internal {
+
+// Jobs are passed around without being run, since there are no connections.
+template <typename C>
+static void ChannelSendPoll(benchmark::State& state) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<C>(ctx);
+    auto const jobs = state.range(0);
+    Slot       slot{};
+    for (auto _ : state) {
+        for (auto i = 0; i < jobs; ++i) {
+            chan->send([](Connection&) {
+            });
+        }
+        while (chan->poll(slot)) {
+            slot.job = nullptr;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * jobs);
+}
+
+BENCHMARK_TEMPLATE(ChannelSendPoll, Channel)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(ChannelSendPoll, ShardedChannel)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(ChannelSendPoll, StealingChannel)->Arg(1)->Arg(64);
+
+// Receivers stand in for the workers, taking the jobs sent by the benchmark threads.
+template <typename C>
+static void ChannelHandoff(benchmark::State& state) {
+    static std::shared_ptr<C>       chan{};
+    static std::vector<std::thread> receivers{};
+    auto const                      count = static_cast<int>(state.range(0));
+    if (state.thread_index() == 0) {
+        chan = std::make_shared<C>(Context::Builder{}.maxConcurrency(count).queueShards(4).share());
+        for (auto i = 0; i < count; ++i) {
+            receivers.emplace_back([] {
+                Slot slot{};
+                while (true) {
+                    chan->receive(slot);
+                    if (!std::exchange(slot.job, nullptr)) {
+                        break;
+                    }
+                }
+            });
+        }
+    }
+
+    for (auto _ : state) {
+        chan->send([](Connection&) {
+        });
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        chan->quit(count);
+        for (auto& receiver : receivers) {
+            receiver.join();
+        }
+        receivers.clear();
+        chan.reset();
+    }
+}
+
+BENCHMARK_TEMPLATE(ChannelHandoff, Channel)->Arg(1)->Arg(4)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(ChannelHandoff, ShardedChannel)->Arg(1)->Arg(4)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(ChannelHandoff, StealingChannel)->Arg(1)->Arg(4)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace postgres::internal
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <postgres/Command.h>
+#include <postgres/Statement.h>
+#include <postgres/Time.h>
+#include <postgres/Visitable.h>
+
+namespace postgres {
+
+struct CommandBenchTable {
+    int64_t                               id = 0;
+    double                                price = 0;
+    std::string                           name;
+    int32_t                               count = 0;
+    std::chrono::system_clock::time_point created;
+
+    POSTGRES_CXX_TABLE("command_bench", id, price, name, count, created);
+};
+
+static void CommandScalars(benchmark::State& state) {
+    auto const name = std::string{"spam"};
+    auto const now  = std::chrono::system_clock::now();
+    for (auto _ : state) {
+        Command cmd{"SELECT $1, $2, $3, $4, $5", int64_t{42}, 4.2, name, static_cast<int32_t const*>(nullptr), now};
+        benchmark::DoNotOptimize(cmd.values());
+    }
+}
+
+BENCHMARK(CommandScalars);
+
+static void CommandTime(benchmark::State& state) {
+    auto const now = Time{std::chrono::system_clock::now(), true};
+    for (auto _ : state) {
+        Command cmd{"SELECT $1", now};
+        benchmark::DoNotOptimize(cmd.values());
+    }
+}
+
+BENCHMARK(CommandTime);
+
+static void CommandVisitable(benchmark::State& state) {
+    auto const val = CommandBenchTable{42, 4.2, "spam", 7, std::chrono::system_clock::now()};
+    for (auto _ : state) {
+        Command cmd{Statement<CommandBenchTable>::insert(), val};
+        benchmark::DoNotOptimize(cmd.values());
+    }
+}
+
+BENCHMARK(CommandVisitable);
+
+static void CommandRange(benchmark::State& state) {
+    std::vector<CommandBenchTable> rows(static_cast<size_t>(state.range(0)));
+    for (auto i = size_t{0}; i < rows.size(); ++i) {
+        rows[i] = CommandBenchTable{static_cast<int64_t>(i), 4.2, "spam", 7, std::chrono::system_clock::now()};
+    }
+
+    auto const stmt = RangeStatement::insert(rows.begin(), rows.end());
+    for (auto _ : state) {
+        Command cmd{stmt, std::make_pair(rows.begin(), rows.end())};
+        benchmark::DoNotOptimize(cmd.values());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(CommandRange)->Arg(10)->Arg(1000);
+
+}  // namespace postgres
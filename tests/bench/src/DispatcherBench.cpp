@@ -0,0 +1,116 @@
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <benchmark/benchmark.h>
+#include <postgres/internal/Channel.h>
+#include <postgres/internal/Dispatcher.h>
+#include <postgres/internal/ShardedChannel.h>
+#include <postgres/internal/StealingChannel.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include "ServerFake.h"
+
+namespace postgres::internal {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Jobs sent by each submitter per iteration, waited for before the next one.
+auto constexpr BATCH = 64;
+
+// Shared by the submitting threads of a run, set up and torn down by the first one.
+struct Harness {
+    ServerFake                  server;
+    std::unique_ptr<Dispatcher> disp;
+    std::atomic<int64_t>        handoff{0};
+    std::atomic<int64_t>        jobs{0};
+};
+
+struct Probe {
+    void operator()(Connection&) {
+        harness->handoff.fetch_add((Clock::now() - sent).count(), std::memory_order_relaxed);
+        harness->jobs.fetch_add(1, std::memory_order_relaxed);
+        left->fetch_sub(1, std::memory_order_release);
+    }
+
+    void fail(std::exception_ptr const&) {
+        left->fetch_sub(1, std::memory_order_release);
+    }
+
+    Harness*          harness;
+    std::atomic<int>* left;
+    Clock::time_point sent;
+};
+
+template <typename C>
+Context makeContext(std::string uri, int const workers, int const limit) {
+    auto bld = Context::Builder{};
+    bld.uri(std::move(uri))
+       .minConcurrency(workers)
+       .maxConcurrency(workers)
+       .waitWarmUp(true)
+       .maxQueueSize(limit)
+       .overflowPolicy(OverflowPolicy::BLOCK)
+       .queueShards(std::is_same_v<C, ShardedChannel> ? 4 : 1)
+       .workStealing(std::is_same_v<C, StealingChannel>);
+    return bld.build();
+}
+
+}  // namespace
+
+// Measures jobs per second through Dispatcher, the channel and the workers,
+// which connect to a fake server, across submitter threads, worker counts and queue limits.
+// The handoff counter is the mean time from sending a job to a worker starting it.
+template <typename C>
+static void DispatcherThroughput(benchmark::State& state) {
+    static std::unique_ptr<Harness> harness{};
+    if (state.thread_index() == 0) {
+        harness = std::make_unique<Harness>();
+        auto const ctx = std::make_shared<Context const>(makeContext<C>(harness->server.uri(),
+                                                                        static_cast<int>(state.range(0)),
+                                                                        static_cast<int>(state.range(1))));
+        harness->disp = std::make_unique<Dispatcher>(ctx, std::make_shared<C>(ctx));
+    }
+
+    std::atomic<int> left{0};
+    for (auto _ : state) {
+        left.store(BATCH, std::memory_order_relaxed);
+        for (auto i = 0; i < BATCH; ++i) {
+            harness->disp->post(Probe{harness.get(), &left, Clock::now()});
+        }
+        while (0 < left.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+
+    if (state.thread_index() == 0) {
+        harness->disp.reset();
+        auto const jobs = harness->jobs.load();
+        state.counters["handoff_ns"] = (jobs == 0) ? 0.0 : static_cast<double>(harness->handoff.load()) / jobs;
+        harness.reset();
+    }
+}
+
+// Arguments are the number of workers and the queue limit, zero meaning none.
+static void dispatcherArgs(benchmark::internal::Benchmark* const bench) {
+    bench->ArgNames({"workers", "limit"});
+    for (auto const workers : {1, 4, 16}) {
+        for (auto const limit : {0, 64}) {
+            bench->Args({workers, limit});
+        }
+    }
+    bench->ThreadRange(1, 8)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(DispatcherThroughput, Channel)->Apply(dispatcherArgs);
+BENCHMARK_TEMPLATE(DispatcherThroughput, ShardedChannel)->Apply(dispatcherArgs);
+BENCHMARK_TEMPLATE(DispatcherThroughput, StealingChannel)->Apply(dispatcherArgs);
+
+}  // namespace postgres::internal
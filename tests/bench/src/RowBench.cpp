@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Oid.h>
+#include <postgres/Result.h>
+#include <postgres/Row.h>
+#include <postgres/Visitable.h>
+
+namespace postgres {
+
+struct RowBenchTable {
+    int64_t                               id = 0;
+    double                                price = 0;
+    std::string                           name;
+    std::chrono::system_clock::time_point created;
+
+    POSTGRES_CXX_TABLE("row_bench", id, price, name, created);
+};
+
+// Binary result of the given number of rows like the ones of RowBenchTable, made without a server.
+static Result makeResult(int const rows) {
+    auto const   handle = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PGresAttDesc attrs[4]{};
+    char const*  names[4]{"id", "price", "name", "created"};
+    Oid const    types[4]{INT8OID, FLOAT8OID, TEXTOID, TIMESTAMPOID};
+    for (auto i = 0; i < 4; ++i) {
+        attrs[i].name   = const_cast<char*>(names[i]);
+        attrs[i].typid  = types[i];
+        attrs[i].format = 1;
+    }
+    PQsetResultAttrs(handle, 4, attrs);
+
+    for (auto row = 0; row < rows; ++row) {
+        auto const id      = internal::orderBytes(int64_t{row});
+        auto const price   = internal::orderBytes(4.2);
+        auto const created = internal::orderBytes(int64_t{row} * 1000000);
+        auto       name    = std::string{"spam"};
+        PQsetvalue(handle, row, 0, const_cast<char*>(reinterpret_cast<char const*>(&id)), sizeof(id));
+        PQsetvalue(handle, row, 1, const_cast<char*>(reinterpret_cast<char const*>(&price)), sizeof(price));
+        PQsetvalue(handle, row, 2, name.data(), static_cast<int>(name.size()));
+        PQsetvalue(handle, row, 3, const_cast<char*>(reinterpret_cast<char const*>(&created)), sizeof(created));
+    }
+    return Result::adopt(handle);
+}
+
+static void RowField(benchmark::State& state) {
+    auto const res = makeResult(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto sum = int64_t{0};
+        for (auto const row : res) {
+            sum += row[0].as<int64_t>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(RowField)->Arg(1)->Arg(1000);
+
+static void RowFieldByName(benchmark::State& state) {
+    auto const res = makeResult(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto sum = int64_t{0};
+        for (auto const row : res) {
+            sum += row["id"].as<int64_t>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(RowFieldByName)->Arg(1)->Arg(1000);
+
+static void RowVisitable(benchmark::State& state) {
+    auto const res = makeResult(static_cast<int>(state.range(0)));
+    auto       val = RowBenchTable{};
+    for (auto _ : state) {
+        for (auto row : res) {
+            row >> val;
+        }
+        benchmark::DoNotOptimize(val);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(RowVisitable)->Arg(1)->Arg(1000);
+
+static void RowTuple(benchmark::State& state) {
+    using Tuple = std::tuple<int64_t, double, std::string, std::chrono::system_clock::time_point>;
+
+    auto const res = makeResult(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const& val : res.as<Tuple>()) {
+            benchmark::DoNotOptimize(val);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(RowTuple)->Arg(1)->Arg(1000);
+
+static void RowView(benchmark::State& state) {
+    auto const res = makeResult(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const cells : res.view<int64_t, double, std::string_view>()) {
+            benchmark::DoNotOptimize(cells.get<2>());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(RowView)->Arg(1)->Arg(1000);
+
+}  // namespace postgres
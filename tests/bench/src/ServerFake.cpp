@@ -0,0 +1,131 @@
+#include "ServerFake.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace postgres::internal {
+
+namespace {
+
+// Request codes sent by libpq in place of the protocol version before the startup message.
+auto constexpr SSL_REQUEST    = uint32_t{80877103};
+auto constexpr GSSENC_REQUEST = uint32_t{80877104};
+
+bool readAll(int const sock, char* buf, size_t len) {
+    while (0 < len) {
+        auto const n = ::read(sock, buf, len);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void writeAll(int const sock, char const* buf, size_t len) {
+    while (0 < len) {
+        auto const n = ::write(sock, buf, len);
+        if (n <= 0) {
+            return;
+        }
+        buf += n;
+        len -= static_cast<size_t>(n);
+    }
+}
+
+}  // namespace
+
+ServerFake::ServerFake() {
+    listener_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto len = socklen_t{sizeof(addr)};
+    if ((listener_ < 0)
+        || (::bind(listener_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        || (::listen(listener_, SOMAXCONN) != 0)
+        || (::getsockname(listener_, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+        || (::pipe2(wake_, O_CLOEXEC) != 0)) {
+        throw std::runtime_error{std::string{"fail to start fake server: "} + std::strerror(errno)};
+    }
+    port_   = ntohs(addr.sin_port);
+    thread_ = std::thread([this] {
+        serve();
+    });
+}
+
+ServerFake::~ServerFake() noexcept {
+    char const sig = 0;
+    static_cast<void>(::write(wake_[1], &sig, 1));
+    thread_.join();
+    for (auto const sock : clients_) {
+        ::close(sock);
+    }
+    ::close(listener_);
+    ::close(wake_[0]);
+    ::close(wake_[1]);
+}
+
+std::string ServerFake::uri() const {
+    return "postgresql://fake@127.0.0.1:" + std::to_string(port_) + "/fake?sslmode=disable&gssencmode=disable";
+}
+
+void ServerFake::serve() {
+    while (true) {
+        pollfd fds[2]{{wake_[0], POLLIN, 0}, {listener_, POLLIN, 0}};
+        while ((::poll(fds, 2, -1) < 0) && (errno == EINTR)) {
+        }
+        if (fds[0].revents != 0) {
+            return;
+        }
+
+        auto const sock = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (0 <= sock) {
+            // Connections are kept open until the end, being closed by their clients anyway.
+            clients_.push_back(sock);
+            greet(sock);
+        }
+    }
+}
+
+void ServerFake::greet(int const sock) {
+    while (true) {
+        char head[8];
+        if (!readAll(sock, head, sizeof(head))) {
+            return;
+        }
+
+        uint32_t len  = 0;
+        uint32_t code = 0;
+        std::memcpy(&len, head, 4);
+        std::memcpy(&code, head + 4, 4);
+        len  = ntohl(len);
+        code = ntohl(code);
+        if ((code == SSL_REQUEST) || (code == GSSENC_REQUEST)) {
+            writeAll(sock, "N", 1);
+            continue;
+        }
+
+        // The parameters of the startup message are of no interest.
+        std::string rest(len - sizeof(head), '\0');
+        if (!readAll(sock, rest.data(), rest.size())) {
+            return;
+        }
+        break;
+    }
+
+    // AuthenticationOk followed by ReadyForQuery while idle.
+    char const reply[]{'R', 0, 0, 0, 8, 0, 0, 0, 0, 'Z', 0, 0, 0, 5, 'I'};
+    writeAll(sock, reply, sizeof(reply));
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace postgres::internal {
+
+// Accepts connections on a local port and completes their startup without authentication,
+// so that workers can connect without a database and run jobs which don't touch the server.
+class ServerFake {
+public:
+    explicit ServerFake();
+    ServerFake(ServerFake const& other) = delete;
+    ServerFake& operator=(ServerFake const& other) = delete;
+    ServerFake(ServerFake&& other) noexcept = delete;
+    ServerFake& operator=(ServerFake&& other) noexcept = delete;
+    ~ServerFake() noexcept;
+
+    std::string uri() const;
+
+private:
+    void serve();
+    void greet(int sock);
+
+    int              listener_ = -1;
+    int              port_     = 0;
+    int              wake_[2]{-1, -1};
+    std::vector<int> clients_;
+    std::thread      thread_;
+};
+
+}  // namespace postgres::internal
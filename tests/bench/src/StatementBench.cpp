@@ -0,0 +1,45 @@
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <postgres/Statement.h>
+#include <postgres/Visitable.h>
+
+namespace postgres {
+
+struct StatementBenchTable {
+    int64_t     id = 0;
+    double      price = 0;
+    std::string name;
+
+    POSTGRES_CXX_TABLE("statement_bench", id, price, name);
+};
+
+static void StatementCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Statement<StatementBenchTable>::create());
+    }
+}
+
+BENCHMARK(StatementCreate);
+
+static void StatementRangeInsert(benchmark::State& state) {
+    std::vector<StatementBenchTable> rows(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RangeStatement::insert(rows.begin(), rows.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(StatementRangeInsert)->Arg(10)->Arg(1000);
+
+static void StatementRangeInsertCached(benchmark::State& state) {
+    std::vector<StatementBenchTable> rows(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RangeStatement::insertCached(rows.begin(), rows.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(StatementRangeInsertCached)->Arg(10)->Arg(1000);
+
+}  // namespace postgres
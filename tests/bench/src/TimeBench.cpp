@@ -0,0 +1,37 @@
+#include <chrono>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <postgres/Time.h>
+
+namespace postgres {
+
+static void TimeParse(benchmark::State& state) {
+    auto const str = std::string{"2017-08-25T13:03:35.987654+02:00"};
+    auto       pnt = Time::Point{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Time::parse(str, pnt));
+    }
+}
+
+BENCHMARK(TimeParse);
+
+static void TimeToString(benchmark::State& state) {
+    auto const t = Time{std::chrono::system_clock::now(), true};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(t.toString());
+    }
+}
+
+BENCHMARK(TimeToString);
+
+static void TimeFormat(benchmark::State& state) {
+    auto const t = Time{std::chrono::system_clock::now(), true};
+    char       buf[Time::MAX_STRING_LEN];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(t.format(buf));
+    }
+}
+
+BENCHMARK(TimeFormat);
+
+}  // namespace postgres
@@ -0,0 +1,219 @@
+// Runs fixed workloads against the database and checks them against the thresholds,
+// so that throughput and allocation regressions fail the build.
+//
+// Usage: PostgresCxxClientPerf <thresholds> [report]
+// Each line of the thresholds file is `<workload> <metric> <min|max> <value>`, '#' starting a comment.
+// The report is written as JSON, to stdout unless a path is given.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <postgres/Postgres.h>
+
+using postgres::Client;
+using postgres::Command;
+using postgres::Connection;
+using postgres::Context;
+using postgres::RangeStatement;
+
+namespace {
+
+std::atomic<int64_t> allocs{0};
+
+}  // namespace
+
+// Every allocation of the process is counted, including the ones of the library.
+void* operator new(size_t const size) {
+    allocs.fetch_add(1, std::memory_order_relaxed);
+    if (auto const ptr = std::malloc((size == 0) ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+auto constexpr ROWS    = 100'000;
+auto constexpr BATCH   = 1'000;
+auto constexpr QUERIES = 20'000;
+auto constexpr WORKERS = 8;
+
+struct PerfRow {
+    int32_t     id    = 0;
+    int64_t     value = 0;
+    std::string info;
+
+    POSTGRES_CXX_TABLE("perf_row", id, value, info);
+};
+
+struct Metric {
+    std::string workload;
+    std::string name;
+    double      value;
+};
+
+struct Threshold {
+    std::string workload;
+    std::string metric;
+    bool        is_min;
+    double      limit;
+};
+
+// Runs the workload once and reports its items per second and allocations per item.
+void measure(std::vector<Metric>& out, std::string const& name, int const items, std::function<void()> const& f) {
+    auto const alloc_beg = allocs.load();
+    auto const beg       = Clock::now();
+    f();
+    auto const secs   = std::chrono::duration<double>{Clock::now() - beg}.count();
+    auto const counts = static_cast<double>(allocs.load() - alloc_beg);
+    out.push_back({name, "items_per_sec", items / secs});
+    out.push_back({name, "allocs_per_item", counts / items});
+}
+
+void bulkInsert(Connection& conn) {
+    std::vector<PerfRow> rows{};
+    rows.reserve(BATCH);
+    for (auto i = 0; i < ROWS; i += BATCH) {
+        rows.clear();
+        for (auto j = 0; j < BATCH; ++j) {
+            rows.push_back({i + j, int64_t{i} * j, "row info"});
+        }
+        conn.exec(Command{RangeStatement::insert(rows.begin(), rows.end()), std::make_pair(rows.begin(), rows.end())});
+    }
+}
+
+void largeSelect(Connection& conn) {
+    auto const res = conn.exec("SELECT id, value, info FROM perf_row");
+    int64_t    sum = 0;
+    PerfRow    row{};
+    for (auto tuple : res) {
+        tuple >> row;
+        sum += row.value;
+    }
+    static_cast<void>(sum);
+}
+
+void streamRows(Connection& conn) {
+    int64_t sum = 0;
+    for (auto const& row : conn.stream<PerfRow>(Command{"SELECT id, value, info FROM perf_row"}, 1'000)) {
+        sum += row.value;
+    }
+    static_cast<void>(sum);
+}
+
+void smallQueries(Client& cl) {
+    std::vector<std::future<postgres::Result>> results{};
+    results.reserve(QUERIES);
+    for (auto i = 0; i < QUERIES; ++i) {
+        results.push_back(cl.query([i](Connection& conn) {
+            return conn.exec(Command{"SELECT $1::INT", i});
+        }));
+    }
+    for (auto& res : results) {
+        res.get();
+    }
+}
+
+std::vector<Threshold> readThresholds(char const* const path) {
+    std::ifstream file{path};
+    if (!file) {
+        std::cerr << "fail to open thresholds: " << path << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<Threshold> res{};
+    std::string            line{};
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream in{line};
+        Threshold          thr{};
+        std::string        kind{};
+        if (in >> thr.workload >> thr.metric >> kind >> thr.limit) {
+            thr.is_min = (kind == "min");
+            res.push_back(std::move(thr));
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+int main(int const argc, char const* const* const argv) {
+    if (argc < 2) {
+        std::cerr << "usage: PostgresCxxClientPerf <thresholds> [report]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto const thresholds = readThresholds(argv[1]);
+
+    std::vector<Metric> metrics{};
+    {
+        Connection conn{};
+        conn.execRaw("DROP TABLE IF EXISTS perf_row");
+        conn.create<PerfRow>();
+        measure(metrics, "bulk_insert", ROWS, [&conn] { bulkInsert(conn); });
+        measure(metrics, "large_select", ROWS, [&conn] { largeSelect(conn); });
+        measure(metrics, "stream", ROWS, [&conn] { streamRows(conn); });
+        conn.drop<PerfRow>();
+    }
+    {
+        Client cl{Context::Builder{}.minConcurrency(WORKERS).maxConcurrency(WORKERS).waitWarmUp(true).build()};
+        measure(metrics, "small_queries", QUERIES, [&cl] { smallQueries(cl); });
+    }
+
+    // Every threshold must match a metric, so that a renamed one doesn't pass silently.
+    std::ostringstream report{};
+    auto               is_ok = true;
+    report << "[\n";
+    for (auto i = size_t{0}; i < metrics.size(); ++i) {
+        auto const& met = metrics[i];
+        report << "  {\"workload\": \"" << met.workload << "\", \"metric\": \"" << met.name
+               << "\", \"value\": " << met.value;
+        for (auto const& thr : thresholds) {
+            if ((thr.workload != met.workload) || (thr.metric != met.name)) {
+                continue;
+            }
+            auto const is_met = thr.is_min ? (thr.limit <= met.value) : (met.value <= thr.limit);
+            is_ok = is_ok && is_met;
+            report << ", \"" << (thr.is_min ? "min" : "max") << "\": " << thr.limit
+                   << ", \"ok\": " << (is_met ? "true" : "false");
+        }
+        report << "}" << (i + 1 < metrics.size() ? "," : "") << "\n";
+    }
+    report << "]\n";
+    for (auto const& thr : thresholds) {
+        auto is_known = false;
+        for (auto const& met : metrics) {
+            is_known = is_known || ((thr.workload == met.workload) && (thr.metric == met.name));
+        }
+        if (!is_known) {
+            std::cerr << "unknown metric: " << thr.workload << " " << thr.metric << std::endl;
+            is_ok = false;
+        }
+    }
+
+    if (argc < 3) {
+        std::cout << report.str();
+    } else {
+        std::ofstream{argv[2]} << report.str();
+    }
+    return is_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
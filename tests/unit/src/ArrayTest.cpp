@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Array.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Command.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Visitable.h>
+
+namespace postgres::internal {
+
+namespace {
+
+struct ArrayTestTable {
+    int32_t                n = 0;
+    std::optional<int16_t> m;
+    std::string            s;
+
+    POSTGRES_CXX_TABLE("array_test", n, m, s);
+};
+
+}  // namespace
+
+TEST(ArrayTest, Oids) {
+    ASSERT_EQ(Oid{INT8ARRAYOID}, arrayOid(INT8OID));
+    ASSERT_EQ(Oid{INT8OID}, elementOid(INT8ARRAYOID));
+    ASSERT_EQ(Oid{TEXTOID}, elementOid(arrayOid(TEXTOID)));
+    ASSERT_EQ(Oid{UUIDOID}, elementOid(arrayOid(UUIDOID)));
+    ASSERT_EQ(Oid{0}, arrayOid(DATEOID));
+    ASSERT_EQ(Oid{0}, elementOid(INT4OID));
+}
+
+TEST(ArrayTest, Roundtrip) {
+    Command const cmd{"STMT", std::vector<int32_t>{1, -2, 3}};
+    ASSERT_EQ(Oid{INT4ARRAYOID}, cmd.types()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+    ASSERT_EQ(20 + 3 * 8, cmd.lengths()[0]);
+
+    ArrayReader arr{cmd.values()[0], cmd.lengths()[0]};
+    ASSERT_EQ(Oid{INT4OID}, arr.type());
+    ASSERT_EQ(3, arr.size());
+
+    auto len = 0;
+    ASSERT_EQ(1, orderBytes<int32_t>(arr.next(len)));
+    ASSERT_EQ(4, len);
+    ASSERT_EQ(-2, orderBytes<int32_t>(arr.next(len)));
+    ASSERT_EQ(3, orderBytes<int32_t>(arr.next(len)));
+    ASSERT_THROW(arr.next(len), RuntimeError);
+}
+
+TEST(ArrayTest, Strings) {
+    Command const cmd{"STMT", std::vector<std::string>{"foo", ""}, std::vector<double>{}};
+    ASSERT_EQ(Oid{TEXTARRAYOID}, cmd.types()[0]);
+
+    ArrayReader strs{cmd.values()[0], cmd.lengths()[0]};
+    ASSERT_EQ(Oid{TEXTOID}, strs.type());
+    ASSERT_EQ(2, strs.size());
+    auto len = 0;
+    ASSERT_EQ("foo", std::string(strs.next(len), 3));
+    ASSERT_NE(nullptr, strs.next(len));
+    ASSERT_EQ(0, len);
+
+    ASSERT_EQ(Oid{FLOAT8ARRAYOID}, cmd.types()[1]);
+    ASSERT_EQ(12, cmd.lengths()[1]);
+    ArrayReader empty{cmd.values()[1], cmd.lengths()[1]};
+    ASSERT_EQ(Oid{FLOAT8OID}, empty.type());
+    ASSERT_EQ(0, empty.size());
+}
+
+TEST(ArrayTest, Transposed) {
+    std::vector<ArrayTestTable> const rows{{1, 2, "foo"}, {3, std::nullopt, "bar"}};
+    Command const                     cmd{"STMT", transpose(rows.begin(), rows.end())};
+    ASSERT_EQ(3, cmd.count());
+    ASSERT_EQ(Oid{INT4ARRAYOID}, cmd.types()[0]);
+    ASSERT_EQ(Oid{INT2ARRAYOID}, cmd.types()[1]);
+    ASSERT_EQ(Oid{TEXTARRAYOID}, cmd.types()[2]);
+
+    auto        len = 0;
+    ArrayReader n{cmd.values()[0], cmd.lengths()[0]};
+    ASSERT_EQ(2, n.size());
+    ASSERT_EQ(1, orderBytes<int32_t>(n.next(len)));
+    ASSERT_EQ(3, orderBytes<int32_t>(n.next(len)));
+
+    ArrayReader m{cmd.values()[1], cmd.lengths()[1]};
+    ASSERT_EQ(2, orderBytes<int16_t>(m.next(len)));
+    ASSERT_EQ(nullptr, m.next(len));
+
+    ArrayReader s{cmd.values()[2], cmd.lengths()[2]};
+    ASSERT_EQ(Oid{TEXTOID}, s.type());
+    ASSERT_EQ("foo", std::string(s.next(len), 3));
+    ASSERT_EQ("bar", std::string(s.next(len), 3));
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,162 @@
+#include <cstring>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Arrow.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Oid.h>
+#include <postgres/Receiver.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+namespace {
+
+template <typename T>
+void set(PGresult* const res, int const row, int const col, T const val) {
+    auto const net = internal::orderBytes(val);
+    PQsetvalue(res, row, col, const_cast<char*>(reinterpret_cast<char const*>(&net)), sizeof(net));
+}
+
+void set(PGresult* const res, int const row, int const col, std::string const& val) {
+    PQsetvalue(res, row, col, const_cast<char*>(val.data()), static_cast<int>(val.size()));
+}
+
+// 12.50 as a binary NUMERIC: two digits of weight 0, positive, scale 2.
+std::string numeric() {
+    std::string res{};
+    for (auto const val : {int16_t{2}, int16_t{0}, int16_t{0}, int16_t{2}, int16_t{12}, int16_t{5000}}) {
+        auto const net = internal::orderBytes(val);
+        res.append(reinterpret_cast<char const*>(&net), sizeof(net));
+    }
+    return res;
+}
+
+Result make() {
+    auto const res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PGresAttDesc attrs[6]{};
+    char const* names[] = {"flag", "num", "text", "day", "money", "raw"};
+    Oid const   types[] = {BOOLOID, INT4OID, TEXTOID, DATEOID, NUMERICOID, OIDOID};
+    for (auto i = 0; i < 6; ++i) {
+        attrs[i].name   = const_cast<char*>(names[i]);
+        attrs[i].format = 1;
+        attrs[i].typid  = types[i];
+    }
+    PQsetResultAttrs(res, 6, attrs);
+
+    set(res, 0, 0, int8_t{1});
+    set(res, 0, 1, int32_t{7});
+    set(res, 0, 2, std::string{"abc"});
+    set(res, 0, 3, int32_t{1});
+    set(res, 0, 4, numeric());
+    set(res, 0, 5, uint32_t{9});
+
+    set(res, 1, 0, int8_t{0});
+    PQsetvalue(res, 1, 1, nullptr, -1);
+    set(res, 1, 2, std::string{"de"});
+    PQsetvalue(res, 1, 3, nullptr, -1);
+    PQsetvalue(res, 1, 4, nullptr, -1);
+    set(res, 1, 5, uint32_t{10});
+    return Result::adopt(res);
+}
+
+template <typename T>
+T const* values(ArrowArray const& arr, int const buf = 1) {
+    return static_cast<T const*>(arr.buffers[buf]);
+}
+
+}  // namespace
+
+TEST(ArrowTest, Schema) {
+    auto const  res = make();
+    ArrowSchema schema{};
+    Arrow::exportSchema(res, &schema);
+    ASSERT_STREQ("+s", schema.format);
+    ASSERT_EQ(6, schema.n_children);
+
+    char const* formats[] = {"b", "i", "u", "tdD", "u", "z"};
+    for (auto i = 0; i < 6; ++i) {
+        ASSERT_STREQ(formats[i], schema.children[i]->format);
+        ASSERT_EQ(ARROW_FLAG_NULLABLE, schema.children[i]->flags);
+    }
+    ASSERT_STREQ("num", schema.children[1]->name);
+
+    schema.release(&schema);
+    ASSERT_EQ(nullptr, schema.release);
+}
+
+TEST(ArrowTest, Batch) {
+    auto const res = make();
+    ArrowArray batch{};
+    Arrow::exportBatch(res, &batch);
+    ASSERT_EQ(2, batch.length);
+    ASSERT_EQ(6, batch.n_children);
+
+    auto const& flag = *batch.children[0];
+    ASSERT_EQ(0, flag.null_count);
+    ASSERT_EQ(nullptr, flag.buffers[0]);
+    ASSERT_EQ(1, *values<uint8_t>(flag));
+
+    auto const& num = *batch.children[1];
+    ASSERT_EQ(1, num.null_count);
+    ASSERT_EQ(1, *values<uint8_t>(num, 0));
+    ASSERT_EQ(7, values<int32_t>(num)[0]);
+
+    auto const& text = *batch.children[2];
+    ASSERT_EQ(3, text.n_buffers);
+    ASSERT_EQ(3, values<int32_t>(text)[1]);
+    ASSERT_EQ(5, values<int32_t>(text)[2]);
+    ASSERT_EQ(0, std::memcmp("abcde", values<char>(text, 2), 5));
+
+    auto const& day = *batch.children[3];
+    ASSERT_EQ(10958, values<int32_t>(day)[0]);
+
+    auto const& money = *batch.children[4];
+    ASSERT_EQ(5, values<int32_t>(money)[1]);
+    ASSERT_EQ(0, std::memcmp("12.50", values<char>(money, 2), 5));
+
+    auto const& raw = *batch.children[5];
+    ASSERT_EQ(4, values<int32_t>(raw)[1]);
+    ASSERT_EQ(8, values<int32_t>(raw)[2]);
+
+    // Moved out children outlive the batch.
+    auto moved = *batch.children[2];
+    batch.children[2]->release = nullptr;
+    batch.release(&batch);
+    ASSERT_EQ(nullptr, batch.release);
+    ASSERT_EQ('a', values<char>(moved, 2)[0]);
+    moved.release(&moved);
+}
+
+TEST(ArrowTest, Stream) {
+    auto             conn = Connection{};
+    ArrowArrayStream stream{};
+    Arrow::exportStream(conn.iter(Command{"SELECT generate_series(1, $1) AS n", int32_t{10}}, 4), &stream);
+
+    ArrowSchema schema{};
+    ASSERT_EQ(0, stream.get_schema(&stream, &schema));
+    ASSERT_STREQ("i", schema.children[0]->format);
+    schema.release(&schema);
+
+    auto count = int64_t{0};
+    auto sum   = int64_t{0};
+    while (true) {
+        ArrowArray batch{};
+        ASSERT_EQ(0, stream.get_next(&stream, &batch));
+        if (!batch.release) {
+            break;
+        }
+        for (auto i = 0; i < batch.length; ++i) {
+            sum += values<int32_t>(*batch.children[0])[i];
+        }
+        count += batch.length;
+        batch.release(&batch);
+    }
+    ASSERT_EQ(10, count);
+    ASSERT_EQ(55, sum);
+    ASSERT_EQ(nullptr, stream.get_last_error(&stream));
+    stream.release(&stream);
+}
+
+}  // namespace postgres
@@ -0,0 +1,73 @@
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <future>
+#include <gtest/gtest.h>
+#include <postgres/Awaitable.h>
+#include <postgres/Client.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+// Eagerly started coroutine reporting its result to a future.
+template <typename T>
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return Task{prom.get_future()};
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_value(T val) {
+            prom.set_value(std::move(val));
+        }
+
+        void unhandled_exception() {
+            prom.set_exception(std::current_exception());
+        }
+
+        std::promise<T> prom;
+    };
+
+    std::future<T> res;
+};
+
+static Task<int32_t> sum(Client& cl) {
+    auto const a = co_await cl.asyncQuery([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    });
+    auto const b = co_await cl.asyncQuery([](Connection& conn) {
+        return conn.exec("SELECT 2::INT");
+    });
+    co_return a[0][0].as<int32_t>() + b[0][0].as<int32_t>();
+}
+
+static Task<bool> bad(Client& cl) {
+    auto const st = co_await cl.asyncExec([](Connection& conn) {
+        return conn.exec("BAD");
+    });
+    co_return st.isOk();
+}
+
+TEST(AwaitableTest, Query) {
+    Client cl{};
+    ASSERT_EQ(3, sum(cl).res.get());
+}
+
+TEST(AwaitableTest, Error) {
+    Client cl{};
+    ASSERT_THROW(bad(cl).res.get(), RuntimeError);
+}
+
+}  // namespace postgres
+
+#endif
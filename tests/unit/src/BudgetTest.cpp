@@ -0,0 +1,86 @@
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/internal/Budget.h>
+#include <postgres/Error.h>
+#include <postgres/Result.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+namespace {
+
+Result make() {
+    return Result::adopt(PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK));
+}
+
+}  // namespace
+
+TEST(BudgetTest, Unscoped) {
+    auto res = make();
+    Budget::charge(res);
+    ASSERT_NE(nullptr, res.native());
+}
+
+TEST(BudgetTest, Release) {
+    auto const budget = std::make_shared<Budget>(size_t{1} << 20, OverflowPolicy::THROW, 0s);
+    auto       res    = make();
+    auto const size   = PQresultMemorySize(res.native());
+    auto const handle = res.native();
+    {
+        Budget::Scope const scope{*budget};
+        Budget::charge(res);
+    }
+    ASSERT_EQ(handle, res.native());
+    ASSERT_EQ(size, budget->used());
+
+    auto moved = std::move(res);
+    ASSERT_EQ(size, budget->used());
+    {
+        auto const other = std::move(moved);
+    }
+    ASSERT_EQ(0, budget->used());
+}
+
+TEST(BudgetTest, Throw) {
+    auto const          budget = std::make_shared<Budget>(size_t{1}, OverflowPolicy::THROW, 0s);
+    Budget::Scope const scope{*budget};
+    auto                res = make();
+    ASSERT_THROW(Budget::charge(res), RuntimeError);
+    ASSERT_EQ(0, budget->used());
+}
+
+TEST(BudgetTest, Block) {
+    auto const budget = std::make_shared<Budget>(size_t{1}, OverflowPolicy::BLOCK, 0s);
+    auto       first  = std::make_unique<Result>(make());
+    {
+        // Passes being alone.
+        Budget::Scope const scope{*budget};
+        Budget::charge(*first);
+    }
+
+    auto const later = std::async(std::launch::async, [&budget] {
+        Budget::Scope const scope{*budget};
+        auto                res = make();
+        Budget::charge(res);
+        return res;
+    });
+    ASSERT_EQ(std::future_status::timeout, later.wait_for(10ms));
+    first.reset();
+    ASSERT_EQ(std::future_status::ready, later.wait_for(1s));
+}
+
+TEST(BudgetTest, Timeout) {
+    auto const budget = std::make_shared<Budget>(size_t{1}, OverflowPolicy::BLOCK, 1ms);
+    auto       first  = make();
+    auto       second = make();
+
+    Budget::Scope const scope{*budget};
+    Budget::charge(first);
+    ASSERT_THROW(Budget::charge(second), RuntimeError);
+}
+
+}  // namespace postgres::internal
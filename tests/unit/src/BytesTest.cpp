@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+
+namespace postgres::internal {
+
+TEST(BytesTest, Scalar) {
+    char const buf[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    ASSERT_EQ(0x0102, orderBytes<int16_t>(buf + 1));
+    ASSERT_EQ(0x01020304, orderBytes<int32_t>(buf + 1));
+    ASSERT_EQ(0x0102030405060708, orderBytes<int64_t>(buf + 1));
+    ASSERT_EQ(orderBytes(orderBytes(1.5)), 1.5);
+}
+
+template <typename T>
+static void checkBulk() {
+    // Odd sizes cover both vector and scalar tails.
+    for (auto const count : {0, 1, 3, 4, 15, 16, 33, 257}) {
+        std::vector<T> vals(static_cast<size_t>(count));
+        for (auto i = 0; i < count; ++i) {
+            vals[i] = static_cast<T>(0x0102030405060708ull * static_cast<unsigned>(i + 1));
+        }
+
+        auto res = vals;
+        orderBytes(res.data(), res.size(), sizeof(T));
+        for (auto i = 0; i < count; ++i) {
+            ASSERT_EQ(orderBytes(vals[i]), res[i]);
+        }
+    }
+}
+
+TEST(BytesTest, Bulk) {
+    checkBulk<uint16_t>();
+    checkBulk<uint32_t>();
+    checkBulk<uint64_t>();
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,51 @@
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/internal/Capacity.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+TEST(CapacityTest, Unlimited) {
+    Capacity         room{Context{}};
+    std::atomic<int> queued{100};
+    room.acquire(queued, true);
+}
+
+TEST(CapacityTest, Throw) {
+    Capacity         room{Context::Builder{}.maxQueueSize(1).build()};
+    std::atomic<int> queued{0};
+    room.acquire(queued, true);
+    queued = 1;
+    ASSERT_THROW(room.acquire(queued, true), RuntimeError);
+}
+
+TEST(CapacityTest, Timeout) {
+    Capacity         room{Context::Builder{}.maxQueueSize(1)
+                                            .overflowPolicy(OverflowPolicy::BLOCK)
+                                            .overflowTimeout(1ms)
+                                            .build()};
+    std::atomic<int> queued{1};
+    ASSERT_THROW(room.acquire(queued, true), RuntimeError);
+    ASSERT_THROW(room.acquire(queued, false), RuntimeError);
+}
+
+TEST(CapacityTest, Block) {
+    Capacity         room{Context::Builder{}.maxQueueSize(1)
+                                            .overflowPolicy(OverflowPolicy::BLOCK)
+                                            .build()};
+    std::atomic<int> queued{1};
+    std::thread      thread{[&room, &queued] {
+        std::this_thread::sleep_for(10ms);
+        --queued;
+        room.release();
+    }};
+    room.acquire(queued, true);
+    thread.join();
+    ASSERT_EQ(0, queued);
+}
+
+}  // namespace postgres::internal
@@ -10,6 +10,7 @@ public:
     MOCK_METHOD1(quit, void(int));
     MOCK_METHOD1(send, std::tuple<bool, Worker*>(Job));
     MOCK_METHOD1(receive, void(Slot&));
+    MOCK_METHOD1(poll, bool(Slot&));
     MOCK_METHOD1(recycle, void(Worker&));
     MOCK_METHOD0(drop, void());
 };
@@ -1,4 +1,8 @@
+#include <atomic>
+#include <exception>
 #include <future>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/internal/Channel.h>
@@ -92,6 +96,103 @@ TEST(ChannelTest, Timeout) {
     ASSERT_EQ(worker, recycled);
 }
 
+TEST(ChannelTest, Persistent) {
+    auto const ctx  = Context::Builder{}.idleTimeout(1ns).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot slot{};
+    slot.is_persistent = true;
+    std::thread thread{[&chan, &slot] {
+        chan->receive(slot);
+    }};
+
+    std::this_thread::sleep_for(10ms);
+    auto const[is_sent, recycled] = chan->send(nullptr);
+    thread.join();
+    ASSERT_TRUE(is_sent);
+    ASSERT_EQ(nullptr, recycled);
+}
+
+TEST(ChannelTest, Lifo) {
+    auto const ctx  = Context::Builder{}.share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot             first{};
+    Slot             second{};
+    std::atomic<int> order{0};
+    std::atomic<int> first_order{0};
+    std::atomic<int> second_order{0};
+    std::thread      first_thread{[&] {
+        chan->receive(first);
+        first_order = ++order;
+    }};
+    std::this_thread::sleep_for(10ms);
+    std::thread second_thread{[&] {
+        chan->receive(second);
+        second_order = ++order;
+    }};
+    std::this_thread::sleep_for(10ms);
+
+    chan->send(nullptr);
+    second_thread.join();
+    chan->send(nullptr);
+    first_thread.join();
+    ASSERT_EQ(1, second_order);
+    ASSERT_EQ(2, first_order);
+}
+
+TEST(ChannelTest, Affinity) {
+    auto const ctx  = Context::Builder{}.share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot             first{};
+    Slot             second{};
+    std::atomic<int> order{0};
+    std::atomic<int> first_order{0};
+    std::atomic<int> second_order{0};
+    std::thread      first_thread{[&] {
+        chan->receive(first);
+        first_order = ++order;
+    }};
+    std::this_thread::sleep_for(10ms);
+    std::thread second_thread{[&] {
+        chan->receive(second);
+        second_order = ++order;
+    }};
+    std::this_thread::sleep_for(10ms);
+
+    // Unlike the most recently idle worker, the first one is chosen by the key.
+    chan->send(nullptr, Priority::NORMAL, Affinity{2});
+    first_thread.join();
+    chan->send(nullptr, Priority::NORMAL, Affinity{2});
+    second_thread.join();
+    ASSERT_EQ(1, first_order);
+    ASSERT_EQ(2, second_order);
+    ASSERT_EQ(0, first.id);
+    ASSERT_EQ(1, second.id);
+}
+
+TEST(ChannelTest, Priority) {
+    auto const ctx  = Context::Builder{}.strictPriority(true).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    auto       low  = [](Connection&) {
+    };
+    auto       high = [](Connection&) {
+    };
+    chan->quit(1);
+    chan->send(low, Priority::LOW);
+    chan->send(high, Priority::HIGH);
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_NE(nullptr, slot.job.target<decltype(high)>());
+    chan->receive(slot);
+    ASSERT_NE(nullptr, slot.job.target<decltype(low)>());
+    // Quits come after all the jobs.
+    chan->receive(slot);
+    ASSERT_FALSE(slot.job);
+}
+
 TEST(ChannelTest, Overflow) {
     auto const ctx  = Context::Builder{}.maxQueueSize(1).share();
     auto const chan = std::make_shared<Channel>(ctx);
@@ -99,4 +200,113 @@ TEST(ChannelTest, Overflow) {
     ASSERT_THROW(chan->send(nullptr), RuntimeError);
 }
 
+TEST(ChannelTest, OverflowTimeout) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1)
+                                        .overflowPolicy(OverflowPolicy::BLOCK)
+                                        .overflowTimeout(1ms)
+                                        .share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(nullptr);
+    ASSERT_THROW(chan->send(nullptr), RuntimeError);
+}
+
+TEST(ChannelTest, OverflowBlock) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1)
+                                        .overflowPolicy(OverflowPolicy::BLOCK)
+                                        .share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(nullptr);
+
+    std::atomic<bool> is_polled{false};
+    std::thread       thread{[&chan, &is_polled] {
+        std::this_thread::sleep_for(10ms);
+        Slot slot{};
+        is_polled = chan->poll(slot);
+    }};
+    chan->send(nullptr);
+    thread.join();
+    ASSERT_TRUE(is_polled);
+}
+
+TEST(ChannelTest, Batch) {
+    struct Probe {
+        void operator()(Connection&) {
+        }
+
+        void fail(std::exception_ptr const&) {
+            ++*fails;
+        }
+
+        std::atomic<int>* fails;
+    };
+
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot        slot{};
+    std::thread thread{[&chan, &slot] {
+        chan->receive(slot);
+    }};
+    std::this_thread::sleep_for(10ms);
+
+    std::atomic<int> fails{0};
+    std::vector<Job> jobs{};
+    for (auto i = 0; i < 3; ++i) {
+        jobs.emplace_back(Probe{&fails});
+    }
+    auto const res = chan->send(jobs, Priority::NORMAL);
+    thread.join();
+
+    // The idle worker takes the first job, the queue the second one, and the third overflows.
+    ASSERT_EQ(2, res.size());
+    ASSERT_TRUE(jobs.empty());
+    ASSERT_TRUE(std::get<0>(res[0]));
+    ASSERT_FALSE(std::get<0>(res[1]));
+    ASSERT_TRUE(slot.job);
+    ASSERT_EQ(1, fails);
+}
+
+TEST(ChannelTest, BatchBlock) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1)
+                                        .overflowPolicy(OverflowPolicy::BLOCK)
+                                        .share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    std::vector<Job> jobs{};
+    for (auto i = 0; i < 3; ++i) {
+        jobs.emplace_back([](Connection&) {
+        });
+    }
+    auto const res = chan->send(jobs, Priority::NORMAL);
+
+    // The queue takes the first job, and the rest waits for the caller to start a worker.
+    ASSERT_EQ(1, res.size());
+    ASSERT_FALSE(std::get<0>(res[0]));
+    ASSERT_EQ(2, jobs.size());
+
+    Slot slot{};
+    ASSERT_TRUE(chan->poll(slot));
+    ASSERT_EQ(1, chan->send(jobs, Priority::NORMAL).size());
+    ASSERT_EQ(1, jobs.size());
+}
+
+TEST(ChannelTest, Requeue) {
+    auto const ctx   = Context::Builder{}.maxQueueSize(1).share();
+    auto const chan  = std::make_shared<Channel>(ctx);
+    auto       sent  = [](Connection&) {
+    };
+    auto       taken = [](Connection&) {
+    };
+    chan->send(sent);
+    chan->requeue(taken);
+
+    // The job given back goes past the limit and ahead of the queue.
+    Slot slot{};
+    ASSERT_TRUE(chan->poll(slot));
+    ASSERT_NE(nullptr, slot.job.target<decltype(taken)>());
+    ASSERT_TRUE(chan->poll(slot));
+    ASSERT_NE(nullptr, slot.job.target<decltype(sent)>());
+    ASSERT_FALSE(chan->poll(slot));
+}
+
 }  // namespace postgres::internal
@@ -1,11 +1,31 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Client.h>
 #include <postgres/Command.h>
 #include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Ingester.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/RetryPolicy.h>
+#include <postgres/Visitable.h>
+
+using namespace std::chrono_literals;
 
 namespace postgres {
 
+struct ClientTestTable {
+    int32_t n = 0;
+
+    POSTGRES_CXX_TABLE("client_test", n);
+};
+
 TEST(ClientTest, Result) {
     Client cl{};
     ASSERT_TRUE(cl.exec([](Connection& conn) {
@@ -19,6 +39,18 @@ TEST(ClientTest, Result) {
     }).get(), RuntimeError);
 }
 
+TEST(ClientTest, Command) {
+    for (auto const threads : {0, 2}) {
+        Client cl{Context::Builder{}.prepare({"my_select", "SELECT $1::INT"})
+                                    .maxConcurrency(4)
+                                    .reactorThreads(threads)
+                                    .build()};
+        ASSERT_TRUE(cl.exec(Command{"SELECT $1::INT", 1}).get().isOk());
+        ASSERT_EQ(2, cl.query(PreparedCommand{"my_select", 2}).get()[0][0].as<int32_t>());
+        ASSERT_THROW(cl.query(Command{"BAD"}).get(), RuntimeError);
+    }
+}
+
 TEST(ClientTest, Load) {
     auto constexpr                   N = 64;
     Client                           cl{};
@@ -37,4 +69,266 @@ TEST(ClientTest, Load) {
     ASSERT_EQ(2080, sum);
 }
 
+TEST(ClientTest, Batch) {
+    Client                                          cl{};
+    std::vector<std::function<Result(Connection&)>> jobs{};
+    for (auto i = 1; i <= 64; ++i) {
+        jobs.emplace_back([i](Connection& conn) {
+            return conn.exec(Command{"SELECT $1", i});
+        });
+    }
+
+    auto sum = 0;
+    for (auto& res : cl.queryBatch(jobs.begin(), jobs.end())) {
+        sum += res.get()[0][0].as<int32_t>();
+    }
+    ASSERT_EQ(2080, sum);
+
+    auto statuses = cl.execBatch(std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
+    ASSERT_EQ(64, statuses.size());
+    for (auto& status : statuses) {
+        ASSERT_TRUE(status.get().isOk());
+    }
+}
+
+TEST(ClientTest, Deadline) {
+    Client     cl{};
+    auto const now = std::chrono::steady_clock::now();
+    ASSERT_THROW(cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, now).get(), RuntimeError);
+    ASSERT_THROW(cl.exec([](Connection& conn) {
+        return conn.exec("SELECT pg_sleep(10)");
+    }, now + 100ms).get(), RuntimeError);
+    ASSERT_TRUE(cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, now + 10s, Priority::HIGH).get().isOk());
+}
+
+TEST(ClientTest, OverflowFromPool) {
+    Client cl{Context::Builder{}.maxConcurrency(1)
+                                .maxQueueSize(1)
+                                .overflowPolicy(OverflowPolicy::BLOCK)
+                                .build()};
+    std::promise<void> sent{};
+    auto               outer = cl.exec([&cl, is_sent = sent.get_future()](Connection& conn) {
+        // The only worker would wait for itself to take the queued job.
+        is_sent.wait();
+        EXPECT_THROW(cl.exec([](Connection& inner) {
+            return inner.exec("SELECT 1");
+        }), RuntimeError);
+        return conn.exec("SELECT 1");
+    });
+    auto queued = cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    });
+    sent.set_value();
+    ASSERT_TRUE(outer.get().isOk());
+    ASSERT_TRUE(queued.get().isOk());
+}
+
+TEST(ClientTest, Coalesce) {
+    auto constexpr                   N = 16;
+    Client                           cl{Context::Builder{}.coalesceWindow(10ms).coalesceLimit(4).build()};
+    std::vector<std::future<Status>> results{};
+    results.reserve(N);
+
+    for (auto i = 0; i < N; ++i) {
+        results.push_back(cl.coalesce([i](Connection& conn) {
+            return conn.exec((i == 5) ? Command{"BAD"} : Command{"SELECT $1", i});
+        }));
+    }
+    for (auto i = 0; i < N; ++i) {
+        if (i == 5) {
+            ASSERT_THROW(results[i].get(), RuntimeError);
+        } else {
+            ASSERT_TRUE(results[i].get().isOk());
+        }
+    }
+}
+
+TEST(ClientTest, ConnectThrottle) {
+    Client cl{Context::Builder{}.uri("postgresql://localhost:1/none").connectThrottle(1, 0ms).build()};
+    std::vector<std::future<Result>> res{};
+    for (auto i = 0; i < 8; ++i) {
+        res.push_back(cl.query([](Connection& conn) {
+            return conn.exec("SELECT 1");
+        }));
+    }
+    for (auto& r : res) {
+        ASSERT_EQ(std::future_status::ready, r.wait_for(10s));
+        ASSERT_THROW(r.get(), Error);
+    }
+}
+
+TEST(ClientTest, Retry) {
+    Client cl{};
+    auto   count = 0;
+    ASSERT_EQ(1, cl.retry(RetryPolicy{}, [&count](Connection& conn) {
+        if (++count < 3) {
+            throw RuntimeError{"conflict", "40001"};
+        }
+        return conn.exec("SELECT 1::INT");
+    }).get()[0][0].as<int32_t>());
+    ASSERT_EQ(3, count);
+}
+
+TEST(ClientTest, Read) {
+    Client cl{Context::Builder{}.replica(Context::Builder{}.maxConcurrency(1).build())
+                                .replica(Context::Builder{}.maxConcurrency(1).build())
+                                .build()};
+    std::vector<std::future<Result>> results{};
+    for (auto i = 0; i < 8; ++i) {
+        results.push_back(cl.read([i](Connection& conn) {
+            return conn.exec(Command{"SELECT $1", i});
+        }));
+    }
+    auto sum = 0;
+    for (auto& res : results) {
+        sum += res.get()[0][0].as<int32_t>();
+    }
+    ASSERT_EQ(28, sum);
+    ASSERT_EQ(1, Client{}.read([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    }).get()[0][0].as<int32_t>());
+}
+
+TEST(ClientTest, Hedge) {
+    Client cl{Context::Builder{}.replica(Context{})
+                                .replica(Context{})
+                                .hedgeQuantile(0.5)
+                                .build()};
+    for (auto i = 0; i < 32; ++i) {
+        ASSERT_EQ(i, cl.read([i](Connection& conn) {
+            return conn.exec(Command{"SELECT $1", i});
+        }).get()[0][0].as<int32_t>());
+    }
+    ASSERT_EQ(1, cl.read([](Connection& conn) {
+        return conn.exec("SELECT 1::INT FROM pg_sleep(0.1)");
+    }).get()[0][0].as<int32_t>());
+}
+
+TEST(ClientTest, Affinity) {
+    Client cl{Context::Builder{}.maxConcurrency(2).build()};
+    auto   pid = [&cl](size_t const key) {
+        return cl.query([](Connection& conn) {
+            return conn.exec("SELECT pg_backend_pid()");
+        }, Affinity{key}).get()[0][0].as<int32_t>();
+    };
+    ASSERT_TRUE(cl.exec([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, Affinity{1}).get().isOk());
+    auto const first = pid(1);
+    for (auto i = 0; i < 8; ++i) {
+        ASSERT_EQ(first, pid(1));
+    }
+}
+
+TEST(ClientTest, QueryShared) {
+    Client     cl{};
+    auto const first  = cl.queryShared(Command{"SELECT $1::INT FROM pg_sleep(0.1)", 1});
+    auto const second = cl.queryShared(Command{"SELECT $1::INT FROM pg_sleep(0.1)", 1});
+    auto const other  = cl.queryShared(Command{"SELECT $1::INT FROM pg_sleep(0.1)", 2});
+    ASSERT_EQ(1, first.get()[0][0].as<int32_t>());
+    ASSERT_EQ(first.get().native(), second.get().native());
+    ASSERT_EQ(2, other.get()[0][0].as<int32_t>());
+    ASSERT_NE(first.get().native(), cl.queryShared(Command{"SELECT $1::INT FROM pg_sleep(0.1)", 1}).get().native());
+}
+
+TEST(ClientTest, QueryCached) {
+    Client     cl{Context::Builder{}.cacheTtl(200ms).build()};
+    auto const first = cl.queryCached(Command{"SELECT $1::INT", 1}).get().native();
+    ASSERT_EQ(first, cl.queryCached(Command{"SELECT $1::INT", 1}).get().native());
+    ASSERT_NE(first, cl.queryCached(Command{"SELECT $1::INT", 2}).get().native());
+
+    cl.invalidate();
+    auto const second = cl.queryCached(Command{"SELECT $1::INT", 1}).get().native();
+    ASSERT_NE(first, second);
+
+    std::this_thread::sleep_for(300ms);
+    ASSERT_NE(second, cl.queryCached(Command{"SELECT $1::INT", 1}).get().native());
+}
+
+TEST(ClientTest, QueryCachedCapacity) {
+    Client     cl{Context::Builder{}.cacheTtl(1min).cacheCapacity(1).build()};
+    auto const first = cl.queryCached(Command{"SELECT $1::INT", 1}).get().native();
+    ASSERT_NE(first, cl.queryCached(Command{"SELECT $1::INT", 1}).get().native());
+}
+
+TEST(ClientTest, QueryCachedNotify) {
+    Client cl{Context::Builder{}.cacheTtl(1min).cacheChannel("client_test").build()};
+    std::this_thread::sleep_for(100ms);
+    auto const first = cl.queryCached(Command{"SELECT $1::INT", 1}).get().native();
+    ASSERT_EQ(first, cl.queryCached(Command{"SELECT $1::INT", 1}).get().native());
+
+    Connection{}.exec("NOTIFY client_test");
+    std::this_thread::sleep_for(100ms);
+    ASSERT_NE(first, cl.queryCached(Command{"SELECT $1::INT", 1}).get().native());
+}
+
+TEST(ClientTest, ParallelSelect) {
+    Connection conn{};
+    conn.create<ClientTestTable>();
+    conn.exec("INSERT INTO client_test SELECT generate_series(1, 10000)");
+
+    Client     cl{Context::Builder{}.maxConcurrency(4).build()};
+    auto const rows = cl.parallelSelect<ClientTestTable>(4).get();
+
+    std::atomic<int> parts{0};
+    std::atomic<int> count{0};
+    cl.parallelSelect<ClientTestTable>(3, [&parts, &count](int, std::vector<ClientTestTable>& part) {
+        ++parts;
+        count += static_cast<int>(part.size());
+    }).get();
+    conn.drop<ClientTestTable>();
+
+    ASSERT_EQ(10000u, rows.size());
+    auto sum = int64_t{0};
+    for (auto const& row : rows) {
+        sum += row.n;
+    }
+    ASSERT_EQ(50005000, sum);
+    ASSERT_EQ(3, parts);
+    ASSERT_EQ(10000, count);
+    ASSERT_THROW(cl.parallelSelect<ClientTestTable>(0), LogicError);
+}
+
+TEST(ClientTest, Ingest) {
+    Connection conn{};
+    conn.create<ClientTestTable>();
+
+    auto const write = [](Ingester<ClientTestTable>& ing) {
+        for (auto i = 1; i <= 10000; ++i) {
+            ClientTestTable row{};
+            row.n = i;
+            ing << row;
+        }
+    };
+    auto const sum = [&conn] {
+        return conn.exec("SELECT COALESCE(SUM(n), 0)::BIGINT FROM client_test")[0][0].as<int64_t>();
+    };
+
+    Client cl{Context::Builder{}.maxConcurrency(4).build()};
+    auto   ing = cl.ingest<ClientTestTable>(4, 3000);
+    write(ing);
+    ASSERT_EQ(4u, ing.progress().size());
+    ASSERT_EQ(10000, ing.finish());
+    ASSERT_EQ(50005000, sum());
+    ASSERT_THROW(ing.finish(), LogicError);
+
+    // A failure of a stream aborts the others.
+    conn.exec("TRUNCATE client_test");
+    conn.exec("ALTER TABLE client_test ADD CHECK (n < 0)");
+    auto bad = cl.ingest<ClientTestTable>(2);
+    ASSERT_THROW({
+        write(bad);
+        bad.finish();
+    }, RuntimeError);
+    ASSERT_EQ(0, sum());
+    conn.drop<ClientTestTable>();
+
+    ASSERT_THROW(cl.ingest<ClientTestTable>(0), LogicError);
+    ASSERT_THROW(cl.ingest<ClientTestTable>(1, -1), LogicError);
+}
+
 }  // namespace postgres
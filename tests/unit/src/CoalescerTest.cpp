@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/Coalescer.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(CoalescerTest, Schedule) {
+    Coalescer            coal{Context::Duration{0}, 2};
+    std::promise<Status> first{};
+    std::promise<Status> second{};
+    auto                 res = first.get_future();
+    ASSERT_TRUE(coal.add(Coalescer::Item{[](Connection& conn) {
+        return conn.execRaw("SELECT 1");
+    }, std::move(first)}));
+    ASSERT_FALSE(coal.add(Coalescer::Item{[](Connection& conn) {
+        return conn.execRaw("SELECT 2");
+    }, std::move(second)}));
+
+    coal.fail(std::make_exception_ptr(LogicError{"fail"}));
+    ASSERT_THROW(res.get(), LogicError);
+
+    std::promise<Status> third{};
+    ASSERT_TRUE(coal.add(Coalescer::Item{[](Connection& conn) {
+        return conn.execRaw("SELECT 3");
+    }, std::move(third)}));
+}
+
+}  // namespace postgres::internal
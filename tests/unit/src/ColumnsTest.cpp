@@ -0,0 +1,122 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Columns.h>
+#include <postgres/Visitable.h>
+
+namespace postgres::internal {
+
+struct ColumnsTestTable {
+    int32_t x = 0;
+    int32_t y = 0;
+
+    POSTGRES_CXX_TABLE("columns_test", x, y);
+};
+
+struct ColumnsTestOther {
+    int32_t z = 0;
+    int32_t y = 0;
+
+    POSTGRES_CXX_TABLE("columns_test", z, y);
+};
+
+struct ColumnsTestTyped {
+    int64_t                a = 0;
+    std::optional<int64_t> b;
+    int32_t                c = 0;
+    std::string            d;
+
+    POSTGRES_CXX_TABLE("columns_test", a, b, c, d);
+};
+
+struct ColumnsTest : testing::Test {
+    ColumnsTest() {
+        PGresAttDesc attrs[2]{};
+        attrs[0].name = const_cast<char*>("y");
+        attrs[1].name = const_cast<char*>("x");
+        PQsetResultAttrs(res_.get(), 2, attrs);
+    }
+
+    std::unique_ptr<PGresult, void (*)(PGresult*)> res_{PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK),
+                                                        PQclear};
+};
+
+TEST_F(ColumnsTest, Get) {
+    Columns    cols{*res_};
+    auto const& idx = cols.get<ColumnsTestTable>();
+    ASSERT_EQ(2u, idx.size());
+    ASSERT_EQ(1, idx[0].idx);
+    ASSERT_EQ(0, idx[1].idx);
+    ASSERT_EQ(&idx, &cols.get<ColumnsTestTable>());
+}
+
+TEST_F(ColumnsTest, Missing) {
+    Columns    cols{*res_};
+    auto const& idx = cols.get<ColumnsTestOther>();
+    ASSERT_EQ(2u, idx.size());
+    ASSERT_EQ(-1, idx[0].idx);
+    ASSERT_EQ(0, idx[1].idx);
+    ASSERT_NE(&idx, &cols.get<ColumnsTestTable>());
+}
+
+TEST_F(ColumnsTest, Described) {
+    // Descriptions of prepared statements report text format for every column.
+    PGresAttDesc attrs[2]{};
+    attrs[0].name  = const_cast<char*>("x");
+    attrs[0].typid = INT4OID;
+    attrs[1].name  = const_cast<char*>("y");
+    attrs[1].typid = INT4OID;
+    std::unique_ptr<PGresult, void (*)(PGresult*)> desc{PQmakeEmptyPGresult(nullptr, PGRES_COMMAND_OK), PQclear};
+    PQsetResultAttrs(desc.get(), 2, attrs);
+
+    Columns    cols{*desc, 1};
+    auto const& idx = cols.get<ColumnsTestTable>();
+    ASSERT_EQ(0, idx[0].idx);
+    ASSERT_TRUE(idx[0].is_exact);
+    ASSERT_EQ(1, idx[1].idx);
+
+    std::unique_ptr<PGresult, void (*)(PGresult*)> res{PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK), PQclear};
+    attrs[0].format = 1;
+    attrs[1].format = 1;
+    PQsetResultAttrs(res.get(), 2, attrs);
+    ASSERT_TRUE(cols.matches(*res));
+    ASSERT_FALSE(cols.matches(*desc));
+    ASSERT_FALSE(cols.matches(*res_));
+}
+
+TEST(ColumnsTypedTest, Exact) {
+    std::unique_ptr<PGresult, void (*)(PGresult*)> res{PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK), PQclear};
+
+    PGresAttDesc attrs[4]{};
+    attrs[0].name   = const_cast<char*>("a");
+    attrs[0].typid  = INT8OID;
+    attrs[0].format = 1;
+    attrs[1].name   = const_cast<char*>("b");
+    attrs[1].typid  = INT8OID;
+    attrs[1].format = 1;
+    attrs[2].name   = const_cast<char*>("c");
+    attrs[2].typid  = INT2OID;
+    attrs[2].format = 1;
+    attrs[3].name   = const_cast<char*>("d");
+    attrs[3].typid  = TEXTOID;
+    attrs[3].format = 1;
+    PQsetResultAttrs(res.get(), 4, attrs);
+
+    Columns    cols{*res};
+    auto const& idx = cols.get<ColumnsTestTyped>();
+    ASSERT_EQ(4u, idx.size());
+    ASSERT_TRUE(idx[0].is_exact);
+    ASSERT_TRUE(idx[1].is_exact);
+    ASSERT_FALSE(idx[2].is_exact);
+    ASSERT_FALSE(idx[3].is_exact);
+
+    auto const tpl = makeColumns<int64_t, std::optional<int32_t>, int16_t>(res.get(), 0);
+    ASSERT_EQ(2, tpl[2].idx);
+    ASSERT_TRUE(tpl[0].is_exact);
+    ASSERT_FALSE(tpl[1].is_exact);
+    ASSERT_TRUE(tpl[2].is_exact);
+    ASSERT_EQ(-1, (makeColumns<int64_t>(res.get(), 4)[0].idx));
+}
+
+}  // namespace postgres::internal
@@ -1,3 +1,5 @@
+#include <cstring>
+#include <string>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/internal/Bytes.h>
@@ -184,13 +186,56 @@ TEST(CommandTest, CStr) {
 TEST(CommandTest, StrView) {
     std::string const      str  = "STR";
     std::string_view const view = str;
-    Command const          cmd{"STMT", view};
+    Command const          cmd{"STMT", view, view.substr(1, 1)};
     ASSERT_STREQ("STMT", cmd.statement());
-    ASSERT_EQ(1, cmd.count());
+    ASSERT_EQ(2, cmd.count());
     ASSERT_EQ(0u, cmd.types()[0]);
-    ASSERT_EQ(str.data(), cmd.values()[0]);
-    ASSERT_EQ(0, cmd.lengths()[0]);
+    ASSERT_STREQ("STR", cmd.values()[0]);
+    ASSERT_EQ(4, cmd.lengths()[0]);
     ASSERT_EQ(0, cmd.formats()[0]);
+    ASSERT_STREQ("T", cmd.values()[1]);
+    ASSERT_EQ(2, cmd.lengths()[1]);
+}
+
+TEST(CommandTest, Borrowed) {
+    std::string const str = "STRING";
+    Command const     cmd{"STMT",
+                          int32_t{1},
+                          borrow(std::string_view{str}.substr(0, 3)),
+                          int32_t{2},
+                          borrow(std::string_view{}, BYTEAOID)};
+    ASSERT_EQ(4, cmd.count());
+
+    ASSERT_EQ(Oid{TEXTOID}, cmd.types()[1]);
+    ASSERT_EQ(str.data(), cmd.values()[1]);
+    ASSERT_EQ(3, cmd.lengths()[1]);
+    ASSERT_EQ(1, cmd.formats()[1]);
+
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(cmd.values()[0]));
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(cmd.values()[2]));
+
+    ASSERT_EQ(Oid{BYTEAOID}, cmd.types()[3]);
+    ASSERT_NE(nullptr, cmd.values()[3]);
+    ASSERT_EQ(0, cmd.lengths()[3]);
+    ASSERT_EQ(1, cmd.formats()[3]);
+}
+
+TEST(CommandTest, BorrowedMixed) {
+    std::string const str = "STRING";
+    Command const     cmd{"STMT",
+                          borrow(std::string_view{}),
+                          borrow(std::string_view{str}),
+                          std::string{"xyz"},
+                          borrow(std::string_view{}),
+                          std::string{"uv"},
+                          borrow(std::string_view{str}.substr(1, 2))};
+    ASSERT_EQ(6, cmd.count());
+    ASSERT_EQ(0, cmd.lengths()[0]);
+    ASSERT_EQ(str.data(), cmd.values()[1]);
+    ASSERT_EQ("xyz", std::string(cmd.values()[2], 3));
+    ASSERT_EQ(0, cmd.lengths()[3]);
+    ASSERT_EQ("uv", std::string(cmd.values()[4], 2));
+    ASSERT_EQ(str.data() + 1, cmd.values()[5]);
 }
 
 TEST(CommandTest, Str) {
@@ -205,6 +250,28 @@ TEST(CommandTest, Str) {
     ASSERT_EQ(0, cmd.formats()[0]);
 }
 
+TEST(CommandTest, Bytes) {
+    std::vector<uint8_t> const bytes{0x00, 0xff, 0x00};
+    Command const              cmd{"STMT", bytes, std::vector<uint8_t>{}, borrow(bytes.data(), 2)};
+    ASSERT_EQ(3, cmd.count());
+
+    ASSERT_EQ(Oid{BYTEAOID}, cmd.types()[0]);
+    ASSERT_NE(reinterpret_cast<char const*>(bytes.data()), cmd.values()[0]);
+    ASSERT_EQ(0, std::memcmp(bytes.data(), cmd.values()[0], bytes.size()));
+    ASSERT_EQ(3, cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+
+    ASSERT_EQ(Oid{BYTEAOID}, cmd.types()[1]);
+    ASSERT_NE(nullptr, cmd.values()[1]);
+    ASSERT_EQ(0, cmd.lengths()[1]);
+    ASSERT_EQ(1, cmd.formats()[1]);
+
+    ASSERT_EQ(Oid{BYTEAOID}, cmd.types()[2]);
+    ASSERT_EQ(reinterpret_cast<char const*>(bytes.data()), cmd.values()[2]);
+    ASSERT_EQ(2, cmd.lengths()[2]);
+    ASSERT_EQ(1, cmd.formats()[2]);
+}
+
 TEST(CommandTest, Oid) {
     std::string   str  = "STR";
     auto const    data = str.data();
@@ -232,9 +299,26 @@ TEST(CommandTest, TimeZone) {
     Command const cmd{"STMT", Time{TIME_POINT_SAMPLE_MICRO, true}};
     ASSERT_EQ(1, cmd.count());
     ASSERT_EQ(Oid{TIMESTAMPTZOID}, cmd.types()[0]);
-    ASSERT_EQ(TIME_STR_SAMPLE_NANO_TZ, cmd.values()[0]);
-    ASSERT_EQ(static_cast<int>(TIME_STR_SAMPLE_NANO_TZ.size() + 1), cmd.lengths()[0]);
-    ASSERT_EQ(0, cmd.formats()[0]);
+    ASSERT_EQ(TIME_SAMPLE_PG_MICRO, internal::orderBytes<time_t>(cmd.values()[0]));
+    ASSERT_EQ(static_cast<int>(sizeof(time_t)), cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+}
+
+TEST(CommandTest, Date) {
+    Command const cmd{"STMT", Time::Date{Time::Days{10958}}};
+    ASSERT_EQ(Oid{DATEOID}, cmd.types()[0]);
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(cmd.values()[0]));
+    ASSERT_EQ(4, cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+}
+
+TEST(CommandTest, Interval) {
+    Command const cmd{"STMT", std::chrono::seconds{90}};
+    ASSERT_EQ(Oid{INTERVALOID}, cmd.types()[0]);
+    ASSERT_EQ(90000000, internal::orderBytes<int64_t>(cmd.values()[0]));
+    ASSERT_EQ(0, internal::orderBytes<int64_t>(cmd.values()[0] + 8));
+    ASSERT_EQ(16, cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
 }
 
 TEST(CommandTest, Range) {
@@ -321,4 +405,67 @@ TEST(CommandTest, Dynamic) {
     ASSERT_EQ(0, cmd.formats()[1]);
 }
 
+TEST(CommandTest, DynamicGrow) {
+    Command cmd{"STMT"};
+    cmd << int32_t{1};
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(cmd.values()[0]));
+
+    // Values taken earlier must survive the buffer growth.
+    for (auto i = 2; i <= 100; ++i) {
+        cmd << std::to_string(i) << i;
+    }
+    ASSERT_EQ(199, cmd.count());
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(cmd.values()[0]));
+    ASSERT_STREQ("2", cmd.values()[1]);
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(cmd.values()[2]));
+    ASSERT_STREQ("100", cmd.values()[197]);
+    ASSERT_EQ(100, internal::orderBytes<int32_t>(cmd.values()[198]));
+}
+
+TEST(CommandTest, Rebind) {
+    Command cmd{"STMT", std::string{"TEXT"}, int32_t{3}};
+    auto const values = cmd.values();
+    auto const buf    = cmd.values()[0];
+
+    cmd.rebind(std::string{"NEW!"}, int32_t{4});
+    ASSERT_STREQ("STMT", cmd.statement());
+    ASSERT_EQ(2, cmd.count());
+    ASSERT_EQ(values, cmd.values());
+    ASSERT_EQ(buf, cmd.values()[0]);
+    ASSERT_STREQ("NEW!", cmd.values()[0]);
+    ASSERT_EQ(4, internal::orderBytes<int32_t>(cmd.values()[1]));
+
+    cmd.clear();
+    ASSERT_EQ(0, cmd.count());
+    cmd << int32_t{5};
+    ASSERT_EQ(1, cmd.count());
+    ASSERT_EQ(Oid{INT4OID}, cmd.types()[0]);
+    ASSERT_EQ(5, internal::orderBytes<int32_t>(cmd.values()[0]));
+}
+
+TEST(CommandTest, MemorySize) {
+    Command    cmd{"STMT", std::string(1000, 'a'), int32_t{3}};
+    auto const size = cmd.memorySize();
+    ASSERT_LE(1004, size);
+
+    // Rebinding reuses the buffers.
+    cmd.rebind(std::string(10, 'b'), int32_t{4});
+    ASSERT_EQ(size, cmd.memorySize());
+}
+
+TEST(CommandTest, Wide) {
+    std::vector<CommandTestTable> rows(10000);
+    for (auto i = 0u; i < rows.size(); ++i) {
+        rows[i].s = std::to_string(i);
+        rows[i].n = static_cast<int32_t>(i);
+    }
+
+    Command const cmd{"STMT", std::make_pair(rows.begin(), rows.end())};
+    ASSERT_EQ(30000, cmd.count());
+    for (auto i = 0u; i < rows.size(); ++i) {
+        ASSERT_EQ(rows[i].s, cmd.values()[3 * i]);
+        ASSERT_EQ(rows[i].n, internal::orderBytes<int32_t>(cmd.values()[3 * i + 1]));
+    }
+}
+
 }  // namespace postgres
@@ -25,6 +25,7 @@ TEST(ConfigTest, Values) {
                                     .passfile("PASSF")
                                     .password("PASSW")
                                     .port(5)
+                                    .replication(true)
                                     .requirepeer("PEER")
                                     .requiressl(true)
                                     .service("SVC")
@@ -89,6 +90,9 @@ TEST(ConfigTest, Values) {
     ASSERT_STREQ(k[i], "port");
     ASSERT_STREQ(v[i], "5");
     ++i;
+    ASSERT_STREQ(k[i], "replication");
+    ASSERT_STREQ(v[i], "database");
+    ++i;
     ASSERT_STREQ(k[i], "requirepeer");
     ASSERT_STREQ(v[i], "PEER");
     ++i;
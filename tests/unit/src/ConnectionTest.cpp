@@ -1,6 +1,11 @@
+#include <poll.h>
+#include <string>
+#include <string_view>
 #include <gtest/gtest.h>
 #include <postgres/Config.h>
 #include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Pipeline.h>
 #include <postgres/PreparedCommand.h>
 #include <postgres/PrepareData.h>
 #include <postgres/Receiver.h>
@@ -50,6 +55,37 @@ TEST(ConnectionTest, ConnectBad) {
     ASSERT_THROW(Connection{"postgresql://:2345"}, RuntimeError);
 }
 
+TEST(ConnectionTest, Start) {
+    auto conn = Connection::start();
+    ASSERT_LE(0, conn.socket());
+
+    auto st = PGRES_POLLING_WRITING;
+    while ((st != PGRES_POLLING_OK) && (st != PGRES_POLLING_FAILED)) {
+        pollfd fd{conn.socket(), static_cast<short>((st == PGRES_POLLING_READING) ? POLLIN : POLLOUT), 0};
+        ASSERT_EQ(1, ::poll(&fd, 1, -1));
+        st = conn.poll();
+    }
+    ASSERT_EQ(PGRES_POLLING_OK, st);
+    ASSERT_TRUE(conn.isOk());
+    ASSERT_TRUE(conn.exec("SELECT 1").isOk());
+}
+
+TEST(ConnectionTest, StartBad) {
+    ASSERT_THROW(Connection::start(Config::Builder{}.set("k", "v").build()), RuntimeError);
+    ASSERT_THROW(Connection::start("k=v"), RuntimeError);
+    ASSERT_THROW(Connection::start("port=2345"), RuntimeError);
+}
+
+TEST(ConnectionTest, NonBlocking) {
+    Connection conn{};
+    ASSERT_FALSE(conn.isNonBlocking());
+    conn.setNonBlocking(true);
+    ASSERT_TRUE(conn.isNonBlocking());
+    ASSERT_TRUE(conn.flush());
+    conn.setNonBlocking(false);
+    ASSERT_FALSE(conn.isNonBlocking());
+}
+
 TEST(ConnectionTest, Exec) {
     Connection conn{};
     ASSERT_TRUE(conn.exec("SELECT 1").isOk());
@@ -57,6 +93,28 @@ TEST(ConnectionTest, Exec) {
     ASSERT_THROW(conn.exec("BAD"), RuntimeError);
 }
 
+TEST(ConnectionTest, ErrorCode) {
+    Connection conn{};
+    try {
+        conn.exec("BAD");
+        FAIL();
+    } catch (RuntimeError const& err) {
+        ASSERT_STREQ("42601", err.code());
+    }
+}
+
+TEST(ConnectionTest, ExecBorrowed) {
+    std::string const text = "foobar";
+    auto const        view = std::string_view{text};
+    auto const        res  = Connection{}.exec(Command{"SELECT $1::TEXT, $2, length($3)",
+                                                      view.substr(0, 3),
+                                                      borrow(view.substr(3)),
+                                                      borrow(view, BYTEAOID)});
+    ASSERT_EQ("foo", res[0][0].as<std::string>());
+    ASSERT_EQ("bar", res[0][1].as<std::string>());
+    ASSERT_EQ(6, res[0][2].as<int32_t>());
+}
+
 TEST(ConnectionTest, ExecRaw) {
     Connection conn{};
     ASSERT_TRUE(conn.execRaw("SELECT 1").isOk());
@@ -117,6 +175,102 @@ TEST(ConnectionTest, PrepareRowByRow) {
     ASSERT_THROW(conn.iter(PreparedCommand{"bad"}).receive(), RuntimeError);
 }
 
+TEST(ConnectionTest, AutoPrepare) {
+    Connection conn{};
+    ASSERT_THROW(conn.autoPrepare(-1), LogicError);
+    conn.autoPrepare(2);
+
+    auto const count = [&conn] {
+        return conn.exec("SELECT COUNT(*)::INT FROM pg_prepared_statements")[0][0].as<int32_t>();
+    };
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, conn.exec(Command{"SELECT $1::INT", i})[0][0].as<int32_t>());
+    }
+    ASSERT_EQ(1, count());
+    ASSERT_EQ(2, count());
+
+    // Failures are reported as usual, and the least recent statement is deallocated.
+    ASSERT_THROW(conn.exec(Command{"SELECT $1::INT + BAD", 1}), RuntimeError);
+    ASSERT_THROW(conn.exec(Command{"SELECT $1::INT + BAD", 1}), RuntimeError);
+    ASSERT_EQ(1, count());
+
+    conn.autoPrepare(0);
+    ASSERT_EQ(0, count());
+}
+
+TEST(ConnectionTest, Defer) {
+    Connection conn{};
+    conn.defer(PrepareData{"select1", "SELECT 1"});
+    conn.defer(PrepareData{"select2", "SELECT 2"});
+    conn.defer(PrepareData{"select3", "SELECT 3"});
+    ASSERT_TRUE(conn.send(PreparedCommand{"select1"}).receive().isOk());
+    ASSERT_TRUE(conn.exec(PrepareData{"select2", "SELECT 2"}).isOk());
+
+    // The rest is prepared in a single round trip.
+    conn.prepareDeferred();
+    ASSERT_TRUE(conn.exec(PreparedCommand{"select3"}).isOk());
+    ASSERT_TRUE(conn.pipeline().send(PreparedCommand{"select2"}).sync().receive().isOk());
+}
+
+TEST(ConnectionTest, DeferBad) {
+    Connection conn{};
+    conn.defer(PrepareData{"select1", "SELECT 1"});
+    conn.defer(PrepareData{"select2", "BAD"});
+    ASSERT_THROW(conn.prepareDeferred(), RuntimeError);
+    ASSERT_TRUE(conn.exec(PreparedCommand{"select1"}).isOk());
+    ASSERT_THROW(conn.exec(PreparedCommand{"select2"}), RuntimeError);
+}
+
+TEST(ConnectionTest, Reprepare) {
+    Connection conn{};
+    conn.reprepare(true);
+    conn.autoPrepare(1);
+    conn.defer(PrepareData{"select1", "SELECT 1"});
+    ASSERT_TRUE(conn.exec(PrepareData{"select2", "SELECT 2"}).isOk());
+    ASSERT_TRUE(conn.exec(PreparedCommand{"select1"}).isOk());
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, conn.exec(Command{"SELECT $1::INT", i})[0][0].as<int32_t>());
+    }
+
+    // Same as a transaction pooler switching to another server session.
+    ASSERT_TRUE(conn.execRaw("DEALLOCATE ALL").isOk());
+    ASSERT_EQ(1, conn.exec(PreparedCommand{"select1"})[0][0].as<int32_t>());
+    ASSERT_EQ(2, conn.exec(PreparedCommand{"select2"})[0][0].as<int32_t>());
+    ASSERT_EQ(3, conn.exec(Command{"SELECT $1::INT", 3})[0][0].as<int32_t>());
+
+    // Transactions fail as usual.
+    ASSERT_TRUE(conn.execRaw("DEALLOCATE ALL").isOk());
+    ASSERT_TRUE(conn.execRaw("BEGIN").isOk());
+    ASSERT_THROW(conn.exec(PreparedCommand{"select1"}), RuntimeError);
+    ASSERT_TRUE(conn.execRaw("ROLLBACK").isOk());
+
+    conn.reprepare(false);
+    ASSERT_THROW(conn.exec(PreparedCommand{"select1"}), RuntimeError);
+}
+
+TEST(ConnectionTest, Describe) {
+    Connection conn{};
+    conn.describe(true);
+    conn.defer(PrepareData{"select1", "SELECT 1 AS x, 'a'::TEXT AS y"});
+    conn.prepareDeferred();
+    ASSERT_TRUE(conn.exec(PrepareData{"select2", "SELECT generate_series(1, $1) AS x", {INT4OID}}).isOk());
+
+    auto const res = conn.exec(PreparedCommand{"select1"});
+    ASSERT_EQ(1, res[0]["x"].as<int32_t>());
+    ASSERT_EQ("a", res[0]["y"].as<std::string>());
+
+    auto sum = 0;
+    for (auto const& row : conn.exec(PreparedCommand{"select2", 3})) {
+        sum += row["x"].as<int32_t>();
+    }
+    ASSERT_EQ(6, sum);
+
+    // Results of a statement prepared again with other columns are mapped on their own.
+    ASSERT_TRUE(conn.execRaw("DEALLOCATE select1").isOk());
+    ASSERT_TRUE(conn.execRaw("PREPARE select1 AS SELECT 2 AS y").isOk());
+    ASSERT_EQ(2, conn.exec(PreparedCommand{"select1"})[0]["y"].as<int32_t>());
+}
+
 TEST(ConnectionTest, Esc) {
     Connection conn{};
     ASSERT_EQ("'E''SCAPE_ME'", conn.esc("E'SCAPE_ME"));
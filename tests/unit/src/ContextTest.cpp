@@ -1,9 +1,15 @@
+#include <memory>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
 #include <postgres/Context.h>
 #include <postgres/Error.h>
+#include <postgres/Metrics.h>
 #include <postgres/PreparedCommand.h>
 #include <postgres/PrepareData.h>
+#include <postgres/StatementRegistry.h>
+#include <postgres/Visitable.h>
 #include "Samples.h"
 
 using namespace std::chrono_literals;
@@ -12,29 +18,168 @@ namespace postgres {
 
 TEST(ContextTest, Default) {
     Context const ctx{};
+    ASSERT_TRUE(ctx.onConnect().empty());
     ASSERT_EQ(0, ctx.idleTimeout().count());
+    ASSERT_EQ(0, ctx.minConcurrency());
+    ASSERT_FALSE(ctx.waitWarmUp());
     ASSERT_LT(0, ctx.maxConcurrency());
+    ASSERT_FALSE(ctx.adaptiveConcurrency());
     ASSERT_EQ(0, ctx.maxQueueSize());
+    ASSERT_EQ(OverflowPolicy::THROW, ctx.overflowPolicy());
+    ASSERT_EQ(0, ctx.overflowTimeout().count());
+    ASSERT_EQ(1, ctx.queueShards());
+    ASSERT_FALSE(ctx.strictPriority());
+    ASSERT_FALSE(ctx.workStealing());
+    ASSERT_EQ(0, ctx.reactorThreads());
+    ASSERT_EQ(0, ctx.autoPrepare());
+    ASSERT_FALSE(ctx.lazyPrepare());
+    ASSERT_FALSE(ctx.transactionPooler());
+    ASSERT_FALSE(ctx.describePrepared());
+    ASSERT_FALSE(ctx.statements());
+    ASSERT_EQ(0, ctx.coalesceWindow().count());
+    ASSERT_EQ(64, ctx.coalesceLimit());
     ASSERT_EQ(ShutdownPolicy::GRACEFUL, ctx.shutdownPolicy());
+    ASSERT_EQ(0, ctx.hedgeQuantile());
+    ASSERT_EQ(0, ctx.cacheTtl().count());
+    ASSERT_EQ(size_t{64} << 20, ctx.cacheCapacity());
+    ASSERT_TRUE(ctx.cacheChannel().empty());
+    ASSERT_EQ(0, ctx.metricsPeriod().count());
+    ASSERT_FALSE(ctx.metricsSink());
+    ASSERT_FALSE(ctx.accountMemory());
+    ASSERT_EQ(0, ctx.resultBudget());
+    ASSERT_EQ(OverflowPolicy::THROW, ctx.budgetPolicy());
+    ASSERT_EQ(0, ctx.healthCheck().count());
+    ASSERT_EQ(0, ctx.reconnectAttempts());
+    ASSERT_EQ(0, ctx.reconnectBackoff().count());
+    ASSERT_EQ(0, ctx.maxConnecting());
+    ASSERT_EQ(0, ctx.connectInterval().count());
+    ASSERT_TRUE(ctx.cpuAffinity().empty());
+    ASSERT_FALSE(ctx.pinEach());
+    ASSERT_TRUE(ctx.threadName().empty());
+    ASSERT_EQ(0, ctx.stackSize());
+    ASSERT_TRUE(ctx.replicas().empty());
 }
 
 TEST(ContextTest, Values) {
+    auto const reg = std::make_shared<StatementRegistry>();
     auto const ctx = Context::Builder{}.idleTimeout(1s)
+                                       .minConcurrency(1)
+                                       .waitWarmUp(true)
                                        .maxConcurrency(2)
+                                       .adaptiveConcurrency(true)
                                        .maxQueueSize(3)
+                                       .overflowPolicy(OverflowPolicy::BLOCK)
+                                       .overflowTimeout(2s)
+                                       .queueShards(4)
+                                       .strictPriority(true)
+                                       .workStealing(true)
+                                       .reactorThreads(2)
+                                       .autoPrepare(5)
+                                       .lazyPrepare(true)
+                                       .transactionPooler(true)
+                                       .describePrepared(true)
+                                       .statements(reg)
+                                       .coalesceWindow(3ms)
+                                       .coalesceLimit(6)
                                        .shutdownPolicy(ShutdownPolicy::DROP)
+                                       .replica(Context::Builder{}.maxConcurrency(7).build())
+                                       .hedgeQuantile(0.9)
+                                       .cacheTtl(8s)
+                                       .cacheCapacity(9)
+                                       .cacheChannel("chan")
+                                       .metricsSink(10s, [](Metrics const&) {})
+                                       .accountMemory(true)
+                                       .resultBudget(11, OverflowPolicy::BLOCK)
+                                       .healthCheck(12s)
+                                       .reconnect(13, 14ms)
+                                       .connectThrottle(15, 16ms)
+                                       .cpuAffinity({0, 15}, true)
+                                       .threadName("name")
+                                       .stackSize(size_t{16} << 20)
                                        .build();
     ASSERT_EQ(1s, ctx.idleTimeout());
+    ASSERT_EQ(1, ctx.minConcurrency());
+    ASSERT_TRUE(ctx.waitWarmUp());
     ASSERT_EQ(2, ctx.maxConcurrency());
+    ASSERT_TRUE(ctx.adaptiveConcurrency());
     ASSERT_EQ(3, ctx.maxQueueSize());
+    ASSERT_EQ(OverflowPolicy::BLOCK, ctx.overflowPolicy());
+    ASSERT_EQ(2s, ctx.overflowTimeout());
+    ASSERT_EQ(4, ctx.queueShards());
+    ASSERT_TRUE(ctx.strictPriority());
+    ASSERT_TRUE(ctx.workStealing());
+    ASSERT_EQ(2, ctx.reactorThreads());
+    ASSERT_EQ(5, ctx.autoPrepare());
+    ASSERT_TRUE(ctx.lazyPrepare());
+    ASSERT_TRUE(ctx.transactionPooler());
+    ASSERT_TRUE(ctx.describePrepared());
+    ASSERT_EQ(reg, ctx.statements());
+    ASSERT_EQ(3ms, ctx.coalesceWindow());
+    ASSERT_EQ(6, ctx.coalesceLimit());
     ASSERT_EQ(ShutdownPolicy::DROP, ctx.shutdownPolicy());
+    ASSERT_EQ(0.9, ctx.hedgeQuantile());
+    ASSERT_EQ(8s, ctx.cacheTtl());
+    ASSERT_EQ(9, ctx.cacheCapacity());
+    ASSERT_EQ("chan", ctx.cacheChannel());
+    ASSERT_EQ(10s, ctx.metricsPeriod());
+    ASSERT_TRUE(ctx.metricsSink());
+    ASSERT_TRUE(ctx.accountMemory());
+    ASSERT_EQ(11, ctx.resultBudget());
+    ASSERT_EQ(OverflowPolicy::BLOCK, ctx.budgetPolicy());
+    ASSERT_EQ(12s, ctx.healthCheck());
+    ASSERT_EQ(13, ctx.reconnectAttempts());
+    ASSERT_EQ(14ms, ctx.reconnectBackoff());
+    ASSERT_EQ(15, ctx.maxConnecting());
+    ASSERT_EQ(16ms, ctx.connectInterval());
+    ASSERT_EQ((std::vector<int>{0, 15}), ctx.cpuAffinity());
+    ASSERT_TRUE(ctx.pinEach());
+    ASSERT_EQ("name", ctx.threadName());
+    ASSERT_EQ(size_t{16} << 20, ctx.stackSize());
+    ASSERT_EQ(1, ctx.replicas().size());
+    ASSERT_EQ(7, ctx.replicas()[0]->maxConcurrency());
 }
 
 TEST(ContextTest, Bad) {
+    ASSERT_THROW(Context::Builder{}.onConnect({" ;"}).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.idleTimeout(-1s).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxConcurrency(-1).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxConcurrency(0).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.minConcurrency(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.minConcurrency(2).maxConcurrency(1).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxQueueSize(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.overflowTimeout(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.queueShards(0).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.reactorThreads(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.reactorThreads(2).maxConcurrency(1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.autoPrepare(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.statements(nullptr).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.coalesceWindow(-1ms).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.coalesceLimit(0).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.hedgeQuantile(-0.1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.cacheTtl(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.hedgeQuantile(1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.metricsSink(0s, [](Metrics const&) {}).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.healthCheck(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.reconnect(-1, 1ms).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.reconnect(1, -1ms).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.connectThrottle(-1, 1ms).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.connectThrottle(1, -1ms).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.cpuAffinity({-1}, false).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.stackSize(1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.replica(Context::Builder{}.replica(Context{}).build()).build(), LogicError);
+}
+
+TEST(ContextTest, OnConnectFold) {
+    auto const stmts = std::vector<std::string>{"SET application_name = 'my app';",
+                                                "set session search_path to public, pg_catalog",
+                                                "CREATE TEMP TABLE my_temp (n INT)",
+                                                "SET work_mem = '64MB'"};
+    auto const rest  = std::vector<std::string>{stmts.begin() + 2, stmts.end()};
+    ASSERT_EQ(rest, Context::Builder{}.onConnect(stmts).build().onConnect());
+    ASSERT_EQ(stmts, Context::Builder{}.uri(CONNECT_URI).onConnect(stmts).build().onConnect());
+    ASSERT_EQ(1, Context::Builder{}.onConnect({"SET search_path = MySchema"}).build().onConnect().size());
+    ASSERT_EQ(1, Context::Builder{}.onConnect({"SET TIME ZONE 'UTC'"}).build().onConnect().size());
+    ASSERT_EQ(1, Context::Builder{}.onConnect({"SET work_mem = DEFAULT"}).build().onConnect().size());
 }
 
 TEST(ContextTest, Connect) {
@@ -53,6 +198,22 @@ TEST(ContextTest, Prepare) {
                  RuntimeError);
 }
 
+TEST(ContextTest, PrepareLazy) {
+    auto conn = Context::Builder{}.prepare(PrepareData{"select1", "SELECT 1"})
+                                  .prepare(PrepareData{"bad", "BAD"})
+                                  .lazyPrepare(true)
+                                  .build()
+                                  .connect();
+    auto const count = [&conn] {
+        return conn.exec("SELECT COUNT(*)::INT FROM pg_prepared_statements")[0][0].as<int32_t>();
+    };
+    ASSERT_EQ(0, count());
+    ASSERT_TRUE(conn.exec(PreparedCommand{"select1"}).isOk());
+    ASSERT_TRUE(conn.exec(PreparedCommand{"select1"}).isOk());
+    ASSERT_EQ(1, count());
+    ASSERT_THROW(conn.exec(PreparedCommand{"bad"}), RuntimeError);
+}
+
 TEST(ContextTest, PrepareMulti) {
     auto conn = Context::Builder{}.prepare(PrepareData{"select1", "SELECT 1"})
                                   .prepare(PrepareData{"select2", "SELECT 2"})
@@ -62,4 +223,63 @@ TEST(ContextTest, PrepareMulti) {
     ASSERT_TRUE(conn.exec(PreparedCommand{"select2"}).isOk());
 }
 
+struct ContextTestTable {
+    int32_t     id = 0;
+    std::string s;
+
+    POSTGRES_CXX_TABLE("my_table", id, s);
+};
+
+TEST(ContextTest, PrepareTables) {
+    auto conn = Context::Builder{}.onConnect({"CREATE TEMP TABLE my_table (id INT, s TEXT)"})
+                                  .prepareTables<ContextTestTable>()
+                                  .build()
+                                  .connect();
+    ASSERT_TRUE(conn.exec(PreparedCommand{"my_table_insert", 1, "abc"}).isOk());
+    ASSERT_TRUE(conn.exec(PreparedCommand{"my_table_update", 2, "de"}).isOk());
+
+    auto const res = conn.exec(PreparedCommand{"my_table_select"});
+    ASSERT_EQ(1, res.size());
+    ASSERT_EQ(2, res[0]["id"].as<int32_t>());
+}
+
+TEST(ContextTest, Statements) {
+    auto const reg = std::make_shared<StatementRegistry>();
+    reg->add(PrepareData{"select1", "SELECT 1 AS x"}).add(PrepareData{"select2", "SELECT 2 AS x"});
+
+    // The context's own statements take over those of the registry.
+    auto const first  = Context::Builder{}.statements(reg)
+                                          .prepare(PrepareData{"select2", "SELECT 3 AS x"})
+                                          .describePrepared(true)
+                                          .build();
+    auto const second = Context::Builder{}.statements(reg).describePrepared(true).lazyPrepare(true).build();
+    for (auto i = 0; i < 2; ++i) {
+        auto conn = first.connect();
+        ASSERT_EQ(1, conn.exec(PreparedCommand{"select1"})[0]["x"].as<int32_t>());
+        ASSERT_EQ(3, conn.exec(PreparedCommand{"select2"})[0]["x"].as<int32_t>());
+    }
+
+    auto conn = second.connect();
+    ASSERT_EQ(1, conn.exec(PreparedCommand{"select1"})[0]["x"].as<int32_t>());
+    ASSERT_EQ(2, conn.exec(PreparedCommand{"select2"})[0]["x"].as<int32_t>());
+}
+
+TEST(ContextTest, OnConnect) {
+    for (auto const is_lazy : {false, true}) {
+        auto conn = Context::Builder{}.onConnect({"SET application_name = 'my app'",
+                                                  "SET search_path TO public, pg_catalog",
+                                                  "CREATE TEMP TABLE my_temp (n INT)",
+                                                  "SET work_mem = '64MB'"})
+                                      .prepare(PrepareData{"my_insert", "INSERT INTO my_temp VALUES (1)"})
+                                      .lazyPrepare(is_lazy)
+                                      .build()
+                                      .connect();
+        ASSERT_EQ("my app", conn.exec("SHOW application_name")[0][0].as<std::string>());
+        ASSERT_EQ("public, pg_catalog", conn.exec("SHOW search_path")[0][0].as<std::string>());
+        ASSERT_EQ("64MB", conn.exec("SHOW work_mem")[0][0].as<std::string>());
+        ASSERT_TRUE(conn.exec(PreparedCommand{"my_insert"}).isOk());
+    }
+    ASSERT_THROW(Context::Builder{}.onConnect({"BAD"}).build().connect(), RuntimeError);
+}
+
 }  // namespace postgres
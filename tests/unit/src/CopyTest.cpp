@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Connection.h>
+#include <postgres/CopyReader.h>
+#include <postgres/CopyWriter.h>
+#include <postgres/Error.h>
+#include <postgres/Visitable.h>
+#include "Samples.h"
+
+namespace postgres {
+
+struct CopyTable {
+    int32_t                               n = 0;
+    std::optional<int64_t>                m;
+    double                                f = 0.0;
+    std::string                           s;
+    std::chrono::system_clock::time_point t;
+
+    POSTGRES_CXX_TABLE("copy_test", n, m, f, s, t);
+};
+
+struct CopyTest : testing::Test {
+    CopyTest() {
+        conn_.exec("CREATE TABLE copy_test ("
+                   "n INT, m BIGINT, f DOUBLE PRECISION, s TEXT, t TIMESTAMP)");
+    }
+
+    ~CopyTest() noexcept override {
+        conn_.drop<CopyTable>();
+    }
+
+    Connection conn_;
+};
+
+TEST_F(CopyTest, In) {
+    std::vector<CopyTable> in(3);
+    for (auto i = 0; i < 3; ++i) {
+        in[i].n = i + 1;
+        in[i].f = 1.5;
+        in[i].s = "foo";
+        in[i].t = TIME_POINT_SAMPLE;
+    }
+    in[1].m = 5;
+    ASSERT_EQ(3, conn_.copyIn(in.begin(), in.end()).effect());
+
+    std::vector<CopyTable> out{};
+    conn_.select(out);
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ(6, out[0].n + out[1].n + out[2].n);
+    ASSERT_EQ("foo", out[2].s);
+    ASSERT_EQ(TIME_POINT_SAMPLE, out[2].t);
+    ASSERT_EQ(1, conn_.exec("SELECT m FROM copy_test WHERE m = 5").size());
+}
+
+TEST_F(CopyTest, InWriter) {
+    CopyTable row{};
+    auto      wr = conn_.copyIn<CopyTable>();
+    for (auto i = 0; i < 1000; ++i) {
+        row.n = i;
+        wr << row;
+    }
+    ASSERT_EQ(1000, wr.size());
+    ASSERT_EQ(1000, wr.finish().effect());
+    ASSERT_THROW(wr.finish(), LogicError);
+    ASSERT_EQ(1000, conn_.exec("SELECT n FROM copy_test").size());
+}
+
+TEST_F(CopyTest, InAbort) {
+    {
+        auto wr = conn_.copyIn<CopyTable>();
+        wr << CopyTable{};
+    }
+    ASSERT_TRUE(conn_.exec("SELECT n FROM copy_test").isEmpty());
+}
+
+TEST_F(CopyTest, InBad) {
+    ASSERT_THROW(conn_.copyIn("COPY bad FROM STDIN (FORMAT BINARY)"), RuntimeError);
+
+    auto wr = conn_.copyIn("COPY copy_test (n) FROM STDIN (FORMAT BINARY)");
+    wr << CopyTable{};
+    ASSERT_THROW(wr.finish(), RuntimeError);
+    ASSERT_TRUE(conn_.exec("SELECT 1").isOk());
+}
+
+TEST_F(CopyTest, Out) {
+    std::vector<CopyTable> in(3);
+    for (auto i = 0; i < 3; ++i) {
+        in[i].n = i + 1;
+        in[i].f = 1.5;
+        in[i].s = std::string(static_cast<size_t>(i), 'a');
+        in[i].t = TIME_POINT_SAMPLE;
+    }
+    in[1].m = 5;
+    conn_.copyIn(in.begin(), in.end());
+
+    std::vector<CopyTable> out{};
+    auto const             res = conn_.copyOut<CopyTable>([&out](CopyTable const& row) {
+        out.push_back(row);
+    });
+    ASSERT_EQ(3, res.effect());
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ(6, out[0].n + out[1].n + out[2].n);
+    for (auto const& row : out) {
+        ASSERT_EQ(row.n == 2, row.m.has_value());
+        ASSERT_EQ(1.5, row.f);
+        ASSERT_EQ(static_cast<size_t>(row.n - 1), row.s.size());
+        ASSERT_EQ(TIME_POINT_SAMPLE, row.t);
+    }
+}
+
+TEST_F(CopyTest, OutReader) {
+    conn_.exec("INSERT INTO copy_test SELECT n, n, n, 'foo', now() FROM generate_series(1, 1000) n");
+
+    CopyTable row{};
+    auto      rd  = conn_.copyOut<CopyTable>();
+    auto      sum = int64_t{0};
+    while (rd.read(row)) {
+        sum += row.m.value();
+    }
+    ASSERT_FALSE(rd.read(row));
+    ASSERT_EQ(1000, rd.size());
+    ASSERT_EQ(500500, sum);
+    ASSERT_EQ(1000, rd.finish().effect());
+    ASSERT_THROW(rd.read(row), LogicError);
+}
+
+TEST_F(CopyTest, OutAbort) {
+    conn_.exec("INSERT INTO copy_test SELECT n FROM generate_series(1, 1000) n");
+    {
+        CopyTable row{};
+        auto      rd = conn_.copyOut<CopyTable>();
+        ASSERT_THROW(rd.read(row), LogicError);
+    }
+    ASSERT_EQ(1000, conn_.exec("SELECT n FROM copy_test").size());
+}
+
+TEST_F(CopyTest, OutBad) {
+    ASSERT_THROW(conn_.copyOut("COPY bad TO STDOUT (FORMAT BINARY)"), RuntimeError);
+    ASSERT_THROW(conn_.copyOut("COPY copy_test TO STDOUT"), RuntimeError);
+    ASSERT_TRUE(conn_.exec("SELECT 1").isOk());
+
+    conn_.exec("INSERT INTO copy_test (n) VALUES (1)");
+    CopyTable row{};
+    auto      rd = conn_.copyOut("COPY copy_test (n) TO STDOUT (FORMAT BINARY)");
+    ASSERT_THROW(rd.read(row), LogicError);
+}
+
+}  // namespace postgres
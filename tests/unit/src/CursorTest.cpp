@@ -0,0 +1,55 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Connection.h>
+#include <postgres/Cursor.h>
+#include <postgres/Error.h>
+#include "Samples.h"
+
+namespace postgres {
+
+TEST(CursorTest, Iter) {
+    Connection           conn{};
+    std::vector<int32_t> vals{};
+    std::vector<int>     sizes{};
+    for (auto const& res : conn.cursor(SELECT_MULTI_ROW, 2)) {
+        sizes.push_back(res.size());
+        for (auto const& row : res) {
+            vals.emplace_back();
+            row[0] >> vals.back();
+        }
+    }
+    ASSERT_EQ((std::vector<int32_t>{1, 2, 3}), vals);
+    ASSERT_EQ((std::vector<int>{2, 1}), sizes);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+TEST(CursorTest, Params) {
+    Connection conn{};
+    auto       cur = conn.cursor(Command{"SELECT generate_series(1, $1)", 10}, 4);
+    ASSERT_EQ(4, cur.fetch().size());
+    ASSERT_EQ(4, cur.fetch().size());
+    ASSERT_EQ(2, cur.fetch().size());
+    ASSERT_TRUE(cur.fetch().isEmpty());
+    cur.close();
+    ASSERT_THROW(cur.fetch(), LogicError);
+}
+
+TEST(CursorTest, Transaction) {
+    Connection conn{};
+    auto       tx = conn.begin();
+    {
+        auto cur = conn.cursor(SELECT_MULTI_ROW, 10);
+        ASSERT_EQ(3, cur.fetch().size());
+    }
+    ASSERT_EQ(PQTRANS_INTRANS, PQtransactionStatus(conn.native()));
+    tx.commit();
+}
+
+TEST(CursorTest, Bad) {
+    Connection conn{};
+    ASSERT_THROW(conn.cursor(SELECT_MULTI_ROW, 0), LogicError);
+    ASSERT_THROW(conn.cursor("BAD", 1), RuntimeError);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+}  // namespace postgres
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Numeric.h>
+#include <postgres/Command.h>
+#include <postgres/Decimal.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+
+namespace postgres::internal {
+
+static Decimal roundtrip(Decimal const val) {
+    char data[NUMERIC_MAX_LEN];
+    auto const len = writeNumeric(val, data);
+    return readNumeric(data, static_cast<int>(len));
+}
+
+TEST(DecimalTest, String) {
+    ASSERT_EQ("12.34", (Decimal{1234, 2}.toString()));
+    ASSERT_EQ("-0.05", (Decimal{-5, 2}.toString()));
+    ASSERT_EQ("0", (Decimal{0, 0}.toString()));
+    ASSERT_EQ("0.000", (Decimal{0, 3}.toString()));
+    ASSERT_EQ("-9223372036854775808", (Decimal{std::numeric_limits<int64_t>::min(), 0}.toString()));
+    ASSERT_DOUBLE_EQ(-12.5, (Decimal{-125, 1}.toDouble()));
+}
+
+TEST(DecimalTest, Encode) {
+    // 12345.678 is 1 2345 6780 with the weight of one and the scale of three.
+    Command const cmd{"STMT", Decimal{12345678, 3}};
+    ASSERT_EQ(Oid{NUMERICOID}, cmd.types()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+    ASSERT_EQ(8 + 3 * 2, cmd.lengths()[0]);
+
+    auto const data = cmd.values()[0];
+    ASSERT_EQ(3, orderBytes<int16_t>(data));
+    ASSERT_EQ(1, orderBytes<int16_t>(data + 2));
+    ASSERT_EQ(0, orderBytes<uint16_t>(data + 4));
+    ASSERT_EQ(3, orderBytes<int16_t>(data + 6));
+    ASSERT_EQ(1, orderBytes<int16_t>(data + 8));
+    ASSERT_EQ(2345, orderBytes<int16_t>(data + 10));
+    ASSERT_EQ(6780, orderBytes<int16_t>(data + 12));
+}
+
+TEST(DecimalTest, Roundtrip) {
+    for (auto const val : {Decimal{0, 0},
+                           Decimal{0, 5},
+                           Decimal{1, 0},
+                           Decimal{-1, 4},
+                           Decimal{10000, 0},
+                           Decimal{100000000, 8},
+                           Decimal{-123456789, 5},
+                           Decimal{std::numeric_limits<int64_t>::max(), 18},
+                           Decimal{std::numeric_limits<int64_t>::min(), 0}}) {
+        auto const res = roundtrip(val);
+        ASSERT_EQ(val.value, res.value) << val.toString();
+        ASSERT_EQ(val.scale, res.scale) << val.toString();
+    }
+}
+
+TEST(DecimalTest, Bad) {
+    char data[NUMERIC_MAX_LEN];
+    ASSERT_THROW(writeNumeric(Decimal{1, -1}, data), LogicError);
+    ASSERT_THROW(writeNumeric(Decimal{1, 19}, data), LogicError);
+    ASSERT_THROW(readNumeric(data, 4), RuntimeError);
+
+    // NaN.
+    auto const nan = orderBytes(uint16_t{0xC000});
+    writeNumeric(Decimal{}, data);
+    std::memcpy(data + 4, &nan, sizeof(nan));
+    ASSERT_THROW(readNumeric(data, 8), LogicError);
+
+    // Ten thousand to the power of five doesn't fit at the scale of zero.
+    auto const weight = orderBytes(int16_t{5});
+    auto const len    = writeNumeric(Decimal{1, 0}, data);
+    std::memcpy(data + 2, &weight, sizeof(weight));
+    ASSERT_THROW(readNumeric(data, static_cast<int>(len)), LogicError);
+}
+
+}  // namespace postgres::internal
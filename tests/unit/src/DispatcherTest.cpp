@@ -7,6 +7,7 @@
 
 using testing::_;
 using testing::Invoke;
+using testing::Return;
 
 namespace postgres::internal {
 
@@ -66,4 +67,16 @@ TEST(DispatcherTest, Scale) {
     disp.send<void>(noop).wait();
 }
 
+TEST(DispatcherTest, WarmUp) {
+    auto const mock = std::make_shared<ChannelMock>();
+    EXPECT_CALL(*mock, poll(_)).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mock, recycle(_)).Times(2);
+    EXPECT_CALL(*mock, quit(2)).Times(1);
+    Dispatcher disp{Context::Builder{}.uri("BAD")
+                                      .minConcurrency(2)
+                                      .maxConcurrency(2)
+                                      .waitWarmUp(true)
+                                      .share(), mock};
+}
+
 }  // namespace postgres::internal
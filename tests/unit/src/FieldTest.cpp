@@ -1,5 +1,8 @@
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
@@ -77,6 +80,28 @@ TEST(FieldTest, StrView) {
     ASSERT_EQ("foo", res[0][0].as<std::string_view>());
 }
 
+TEST(FieldTest, Bytes) {
+    std::vector<uint8_t> const bytes{0x00, 0xff, 0x00};
+    auto const                 res = Connection{}.exec(Command{"SELECT $1, ''::BYTEA, 'foo'", bytes});
+    ASSERT_EQ(bytes, res[0][0].as<std::vector<uint8_t>>());
+    ASSERT_TRUE(res[0][1].as<std::vector<uint8_t>>().empty());
+    ASSERT_THROW(res[0][2].as<std::vector<uint8_t>>(), LogicError);
+}
+
+TEST(FieldTest, Array) {
+    auto const res = Connection{}.exec(Command{"SELECT $1, $2, ARRAY[1, NULL], '{}'::INT[], 1",
+                                               std::vector<int32_t>{1, 2, 3},
+                                               std::vector<std::string>{"foo", "bar"}});
+    ASSERT_EQ((std::vector<int64_t>{1, 2, 3}), res[0][0].as<std::vector<int64_t>>());
+    ASSERT_EQ((std::vector<std::string>{"foo", "bar"}), res[0][1].as<std::vector<std::string>>());
+    ASSERT_TRUE(res[0][3].as<std::vector<int32_t>>().empty());
+    ASSERT_THROW(res[0][0].as<std::vector<int16_t>>(), LogicError);
+    ASSERT_THROW(res[0][0].as<std::vector<double>>(), LogicError);
+    ASSERT_THROW(res[0][0].as<std::vector<std::string>>(), LogicError);
+    ASSERT_THROW(res[0][2].as<std::vector<int32_t>>(), LogicError);
+    ASSERT_THROW(res[0][4].as<std::vector<int32_t>>(), LogicError);
+}
+
 TEST(FieldTest, Time) {
     auto const res = Connection{}.exec("SELECT '2017-08-25 13:03:35'::TIMESTAMP");
     auto const fld = res[0][0];
@@ -84,6 +109,56 @@ TEST(FieldTest, Time) {
     ASSERT_EQ(TIME_POINT_SAMPLE, fld.as<Time::Point>());
 }
 
+TEST(FieldTest, TimeZone) {
+    auto const res = Connection{}.exec("SELECT '2017-08-25 13:03:35+00'::TIMESTAMPTZ");
+    auto const fld = res[0][0];
+    ASSERT_EQ(TIME_POINT_SAMPLE, fld.as<Time::Point>());
+    ASSERT_TRUE(fld.as<Time>().hasZone());
+    ASSERT_EQ(TIME_SAMPLE, fld.as<Time>().toUnix());
+}
+
+TEST(FieldTest, Date) {
+    auto const res = Connection{}.exec("SELECT '2000-01-02'::DATE, '1999-12-31'::DATE");
+    ASSERT_EQ(Time::EPOCH_DATE + Time::Days{1}, res[0][0].as<Time::Date>());
+    ASSERT_EQ(Time::EPOCH_DATE - Time::Days{1}, res[0][1].as<Time::Date>());
+    ASSERT_THROW(res[0][0].as<Time::Point>(), LogicError);
+}
+
+TEST(FieldTest, Interval) {
+    auto const res = Connection{}.exec(Command{"SELECT '1 day 2 seconds'::INTERVAL, '1 month'::INTERVAL, $1",
+                                               std::chrono::milliseconds{1500}});
+    ASSERT_EQ(std::chrono::seconds{86402}, res[0][0].as<std::chrono::seconds>());
+    ASSERT_THROW(res[0][1].as<std::chrono::seconds>(), LogicError);
+    ASSERT_EQ(std::chrono::milliseconds{1500}, res[0][2].as<std::chrono::milliseconds>());
+    ASSERT_THROW(res[0][2].as<Time::Date>(), LogicError);
+}
+
+TEST(FieldTest, Numeric) {
+    auto const res = Connection{}.exec(Command{"SELECT 12.345::NUMERIC, -0.5::NUMERIC(10, 3), $1, 'NaN'::NUMERIC",
+                                               Decimal{-1000050, 2}});
+    ASSERT_EQ("12.345", res[0][0].as<Decimal>().toString());
+    ASSERT_EQ("-0.500", res[0][1].as<Decimal>().toString());
+    ASSERT_EQ("-10000.50", res[0][2].as<Decimal>().toString());
+    ASSERT_THROW(res[0][3].as<Decimal>(), LogicError);
+    ASSERT_THROW(res[0][0].as<double>(), LogicError);
+}
+
+TEST(FieldTest, Uuid) {
+    auto const id  = Uuid::parse("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    auto const res = Connection{}.exec(Command{"SELECT $1, 'A0EEBC99-9C0B-4EF8-BB6D-6BB9BD380A11'::UUID, 1", id});
+    ASSERT_EQ(id, res[0][0].as<Uuid>());
+    ASSERT_EQ(id, res[0][1].as<Uuid>());
+    ASSERT_THROW(res[0][2].as<Uuid>(), LogicError);
+}
+
+TEST(FieldTest, Jsonb) {
+    auto const res = Connection{}.exec(R"(SELECT '{"a": 1}'::JSONB, '{"a": 1}'::JSON)");
+    ASSERT_EQ(R"({"a": 1})", res[0][0].as<std::string>());
+    ASSERT_EQ(R"({"a": 1})", res[0][0].as<std::string_view>());
+    ASSERT_EQ(res[0][0].value() + 1, res[0][0].as<std::string_view>().data());
+    ASSERT_EQ(R"({"a": 1})", res[0][1].as<std::string>());
+}
+
 TEST(FieldTest, TimeBad) {
     ASSERT_THROW(Connection{}.exec("SELECT '2017-08-25 13:03:35'")[0][0].as<Time>().toUnix(),
                  LogicError);
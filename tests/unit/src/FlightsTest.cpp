@@ -0,0 +1,36 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Flights.h>
+#include <postgres/Command.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(FlightsTest, Key) {
+    auto const key = Flights::keyOf(Command{"SELECT $1, $2", 1, std::string{"foo"}});
+    ASSERT_EQ(key, Flights::keyOf(Command{"SELECT $1, $2", 1, std::string{"foo"}}));
+    ASSERT_EQ(key, Flights::keyOf(Command{"SELECT $1, $2", 1, "foo"}));
+    ASSERT_NE(key, Flights::keyOf(Command{"SELECT $1, $2", 2, std::string{"foo"}}));
+    ASSERT_NE(key, Flights::keyOf(Command{"SELECT $1, $2", int64_t{1}, std::string{"foo"}}));
+    ASSERT_NE(key, Flights::keyOf(Command{"SELECT $1, $2", 1, nullptr}));
+    ASSERT_NE(key, Flights::keyOf(Command{"SELECT $1,$2", 1, std::string{"foo"}}));
+}
+
+TEST(FlightsTest, Join) {
+    Flights              flights{};
+    std::promise<Result> first{};
+    std::promise<Result> second{};
+    auto const           flight = first.get_future().share();
+    auto const           other  = second.get_future().share();
+
+    ASSERT_TRUE(flights.join("key", flight).second);
+    auto const [joined, is_new] = flights.join("key", other);
+    ASSERT_FALSE(is_new);
+    first.set_exception(std::make_exception_ptr(LogicError{"first"}));
+    ASSERT_THROW(joined.get(), LogicError);
+
+    flights.land("key");
+    ASSERT_TRUE(flights.join("key", other).second);
+}
+
+}  // namespace postgres::internal
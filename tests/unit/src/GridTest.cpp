@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+struct GridTest : testing::Test {
+    GridTest() {
+        PGresAttDesc attrs[3]{};
+        attrs[0].name   = const_cast<char*>("a");
+        attrs[0].typid  = INT4OID;
+        attrs[0].format = 1;
+        attrs[1].name   = const_cast<char*>("b");
+        attrs[1].typid  = TEXTOID;
+        attrs[1].format = 1;
+        attrs[2].name   = const_cast<char*>("c");
+        attrs[2].typid  = INT8OID;
+        attrs[2].format = 0;
+        PQsetResultAttrs(res_, 3, attrs);
+
+        auto const a = internal::orderBytes(int32_t{42});
+        PQsetvalue(res_, 0, 0, const_cast<char*>(reinterpret_cast<char const*>(&a)), sizeof(a));
+        PQsetvalue(res_, 0, 1, const_cast<char*>("foo"), 3);
+        PQsetvalue(res_, 0, 2, const_cast<char*>("7"), 1);
+        PQsetvalue(res_, 1, 0, nullptr, -1);
+        PQsetvalue(res_, 1, 1, nullptr, -1);
+        PQsetvalue(res_, 1, 2, nullptr, -1);
+    }
+
+    PGresult* res_    = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    Result    result_ = Result::adopt(res_);
+};
+
+TEST_F(GridTest, Layout) {
+    auto const grid = result_.grid();
+    ASSERT_EQ(2, grid.rows());
+    ASSERT_EQ(3, grid.columns());
+    ASSERT_EQ(1, grid.column("b"));
+    ASSERT_THROW(grid.column("d"), LogicError);
+
+    auto const cell = grid(0, 1);
+    ASSERT_EQ(TEXTOID, cell.type());
+    ASSERT_EQ(1, cell.format());
+    ASSERT_EQ(3, cell.length());
+    ASSERT_EQ("foo", std::string_view(cell.value()));
+    ASSERT_FALSE(cell.isNull());
+    ASSERT_TRUE(grid(1, 1).isNull());
+}
+
+TEST_F(GridTest, As) {
+    auto const grid = result_.grid();
+    ASSERT_EQ(42, grid(0, 0).as<int32_t>());
+    ASSERT_EQ(42, grid(0, 0).as<int64_t>());
+    ASSERT_EQ("foo", grid(0, 1).as<std::string_view>());
+    ASSERT_EQ("foo", grid(0, 1).as<std::string>());
+    ASSERT_EQ("7", grid(0, 2).as<std::string>());
+    ASSERT_FALSE(grid(1, 0).as<std::optional<int32_t>>());
+    ASSERT_FALSE(grid(1, 1).as<std::optional<std::string_view>>());
+    ASSERT_THROW(grid(1, 0).as<int32_t>(), LogicError);
+}
+
+TEST_F(GridTest, Temporary) {
+    auto const cell = result_.grid()(0, 1);
+    ASSERT_EQ(TEXTOID, cell.type());
+    ASSERT_EQ(1, cell.format());
+    ASSERT_EQ("foo", cell.as<std::string_view>());
+}
+
+TEST_F(GridTest, At) {
+    auto const grid = result_.grid();
+    ASSERT_EQ(42, grid.at(0, 0).as<int32_t>());
+    ASSERT_EQ(42, grid.at(0, 0).field().as<int32_t>());
+    ASSERT_THROW(grid.at(2, 0), LogicError);
+    ASSERT_THROW(grid.at(0, 3), LogicError);
+    ASSERT_THROW(grid.at(-1, 0), LogicError);
+}
+
+}  // namespace postgres
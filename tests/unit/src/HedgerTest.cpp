@@ -0,0 +1,40 @@
+#include <future>
+#include <gtest/gtest.h>
+#include <postgres/internal/Hedger.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+TEST(HedgerTest, Delay) {
+    Hedger hedger{0.5};
+    for (auto i = 1; i < 16; ++i) {
+        hedger.record(std::chrono::milliseconds{i});
+    }
+    ASSERT_FALSE(hedger.delay());
+
+    hedger.record(16ms);
+    ASSERT_EQ(8ms, hedger.delay().value());
+}
+
+TEST(HedgerTest, Schedule) {
+    Hedger             hedger{0.9};
+    std::promise<void> called{};
+    auto               res = called.get_future();
+    hedger.schedule(Hedger::Clock::now() + 10ms, [&called] {
+        called.set_value();
+    });
+    ASSERT_EQ(std::future_status::ready, res.wait_for(1s));
+}
+
+TEST(HedgerTest, Stop) {
+    Hedger hedger{0.9};
+    auto   is_called = false;
+    hedger.schedule(Hedger::Clock::now() + 1h, [&is_called] {
+        is_called = true;
+    });
+    hedger.stop();
+    ASSERT_FALSE(is_called);
+}
+
+}  // namespace postgres::internal
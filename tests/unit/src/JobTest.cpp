@@ -0,0 +1,111 @@
+#include <array>
+#include <exception>
+#include <memory>
+#include <gtest/gtest.h>
+#include <postgres/internal/Job.h>
+
+namespace postgres::internal {
+
+template <size_t N>
+struct Mark {
+    void operator()(Connection&) const {
+    }
+
+    std::array<char, N> data{};
+    std::shared_ptr<int> val = std::make_shared<int>(1);
+};
+
+TEST(JobTest, Empty) {
+    ASSERT_FALSE(Job{});
+    ASSERT_FALSE(Job{nullptr});
+
+    Job job = Mark<1>{};
+    ASSERT_TRUE(job);
+    job = nullptr;
+    ASSERT_FALSE(job);
+}
+
+struct Failure {
+    void operator()(Connection&) const {
+    }
+
+    void fail(std::exception_ptr const& err) {
+        *res = err;
+    }
+
+    std::exception_ptr* res = nullptr;
+};
+
+TEST(JobTest, Fail) {
+    std::exception_ptr res{};
+    Job const          job = Failure{&res};
+    job.fail(std::make_exception_ptr(1));
+    ASSERT_TRUE(res);
+
+    // Nothing happens when not supported.
+    Job const other = Mark<1>{};
+    other.fail(std::make_exception_ptr(1));
+}
+
+TEST(JobTest, Target) {
+    Job const small = Mark<1>{};
+    Job const large = Mark<1024>{};
+    ASSERT_NE(nullptr, small.target<Mark<1>>());
+    ASSERT_EQ(nullptr, small.target<Mark<1024>>());
+    ASSERT_NE(nullptr, large.target<Mark<1024>>());
+    ASSERT_EQ(nullptr, large.target<Mark<1>>());
+}
+
+TEST(JobTest, PooledSize) {
+    Job const small = Mark<1>{};
+    Job const large = Mark<1024>{};
+    ASSERT_EQ(0, small.pooledSize());
+    ASSERT_EQ(sizeof(Mark<1024>), large.pooledSize());
+    ASSERT_EQ(0, Job{}.pooledSize());
+}
+
+TEST(JobTest, Move) {
+    auto const val = std::make_shared<int>(1);
+
+    Job small = Mark<1>{{}, val};
+    Job large = Mark<1024>{{}, val};
+    ASSERT_EQ(3, val.use_count());
+
+    Job other = std::move(small);
+    ASSERT_FALSE(small);
+    ASSERT_EQ(val, other.target<Mark<1>>()->val);
+
+    other = std::move(large);
+    ASSERT_FALSE(large);
+    ASSERT_EQ(2, val.use_count());
+    ASSERT_EQ(val, other.target<Mark<1024>>()->val);
+
+    other = nullptr;
+    ASSERT_EQ(1, val.use_count());
+}
+
+TEST(JobTest, Swap) {
+    Job small = Mark<1>{};
+    Job large = Mark<1024>{};
+    small.swap(large);
+    ASSERT_NE(nullptr, small.target<Mark<1024>>());
+    ASSERT_NE(nullptr, large.target<Mark<1>>());
+
+    Job empty{};
+    empty.swap(small);
+    ASSERT_FALSE(small);
+    ASSERT_NE(nullptr, empty.target<Mark<1024>>());
+}
+
+TEST(JobTest, Waited) {
+    Job job = Mark<1>{};
+    auto const now = Job::Clock::now();
+    ASSERT_EQ(Job::Clock::duration{}, job.waited(now));
+
+    job.stamp();
+    Job moved{std::move(job)};
+    ASSERT_LE(Job::Clock::duration{}, moved.waited(Job::Clock::now()));
+    ASSERT_GT(Job::Clock::duration{}, moved.waited(now));
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,52 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Lanes.h>
+
+namespace postgres::internal {
+
+template <char C>
+struct Mark {
+    void operator()(Connection&) const {
+    }
+};
+
+static std::string drain(Lanes& lanes) {
+    std::string res{};
+    while (!lanes.empty()) {
+        Job job{};
+        lanes.pop(job);
+        res += job.target<Mark<'H'>>() ? 'H' : job.target<Mark<'N'>>() ? 'N' : 'L';
+    }
+    return res;
+}
+
+static void fill(Lanes& lanes, int const count) {
+    for (auto i = 0; i < count; ++i) {
+        lanes.push(Mark<'L'>{}, Priority::LOW);
+        lanes.push(Mark<'N'>{}, Priority::NORMAL);
+        lanes.push(Mark<'H'>{}, Priority::HIGH);
+    }
+}
+
+TEST(LanesTest, Weighted) {
+    Lanes lanes{false};
+    fill(lanes, 8);
+    ASSERT_EQ(24u, lanes.size());
+    ASSERT_EQ("HHHHNNLHHHHNNLNNLNNLLLLL", drain(lanes));
+}
+
+TEST(LanesTest, Strict) {
+    Lanes lanes{true};
+    fill(lanes, 2);
+    ASSERT_EQ("HHNNLL", drain(lanes));
+}
+
+TEST(LanesTest, Clear) {
+    Lanes lanes{false};
+    fill(lanes, 2);
+    lanes.clear();
+    ASSERT_TRUE(lanes.empty());
+    ASSERT_EQ(0u, lanes.size());
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/LargeObject.h>
+
+namespace postgres {
+
+TEST(LargeObjectTest, ReadWrite) {
+    Connection conn{};
+    auto const id = conn.createLargeObject();
+    {
+        auto obj = conn.openLargeObject(id, LargeObject::Mode::READ_WRITE);
+        obj.write("hello world", 11);
+        obj.write(6, "there", 5);
+        ASSERT_EQ(11, obj.size());
+        ASSERT_EQ(11, obj.tell());
+
+        char buf[16]{};
+        ASSERT_EQ(5u, obj.read(0, buf, 5));
+        ASSERT_STREQ("hello", buf);
+        ASSERT_EQ(5u, obj.read(6, buf, sizeof(buf)));
+        ASSERT_EQ(0, std::memcmp("there", buf, 5));
+        ASSERT_EQ(0u, obj.read(buf, sizeof(buf)));
+
+        obj.truncate(5);
+        ASSERT_EQ(5, obj.size());
+    }
+
+    // Committed along with the object closed.
+    auto obj = conn.openLargeObject(id);
+    ASSERT_THROW(obj.write("x", 1), RuntimeError);
+    obj.close();
+    ASSERT_THROW(obj.tell(), LogicError);
+    conn.removeLargeObject(id);
+    ASSERT_THROW(conn.openLargeObject(id), RuntimeError);
+}
+
+TEST(LargeObjectTest, Chunks) {
+    Connection conn{};
+    auto const  id   = conn.createLargeObject();
+    std::string data(10000, 'a');
+    data.back() = 'b';
+
+    auto pos = size_t{0};
+    {
+        auto obj = conn.openLargeObject(id, LargeObject::Mode::WRITE);
+        ASSERT_EQ(10000, obj.writeChunks([&data, &pos](char* const buf, size_t const len) {
+            auto const part = std::min(len, data.size() - pos);
+            std::memcpy(buf, data.data() + pos, part);
+            pos += part;
+            return part;
+        }, 3000));
+    }
+
+    std::string out{};
+    auto        obj = conn.openLargeObject(id);
+    ASSERT_EQ(10000, obj.readChunks([&out](char const* const data, size_t const len) {
+        out.append(data, len);
+    }, 4096));
+    obj.close();
+    conn.removeLargeObject(id);
+    ASSERT_EQ(data, out);
+}
+
+}  // namespace postgres
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/Limiter.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+static void record(Limiter& lim, Limiter::Duration const latency, int const count) {
+    for (auto i = 0; i < count; ++i) {
+        lim.record(latency);
+    }
+}
+
+TEST(LimiterTest, Grow) {
+    Limiter lim{1, 3};
+    ASSERT_EQ(1, lim.limit());
+    record(lim, 1ms, 1);
+    ASSERT_EQ(2, lim.limit());
+    record(lim, 1ms, 2);
+    ASSERT_EQ(3, lim.limit());
+    record(lim, 1ms, 30);
+    ASSERT_EQ(3, lim.limit());
+}
+
+TEST(LimiterTest, Shrink) {
+    Limiter lim{2, 8};
+    record(lim, 1ms, 2 + 3 + 4 + 5 + 6 + 7);
+    ASSERT_EQ(8, lim.limit());
+    record(lim, 10ms, 8);
+    ASSERT_EQ(6, lim.limit());
+    record(lim, 10ms, 6);
+    ASSERT_EQ(4, lim.limit());
+}
+
+TEST(LimiterTest, Keep) {
+    Limiter lim{1, 2};
+    ASSERT_TRUE(lim.allows());
+    lim.enter();
+    ASSERT_FALSE(lim.allows());
+    lim.enter();
+    ASSERT_EQ(2, lim.running());
+    ASSERT_FALSE(lim.keep());
+    ASSERT_EQ(1, lim.running());
+    ASSERT_TRUE(lim.keep());
+    lim.leave();
+    ASSERT_EQ(0, lim.running());
+}
+
+TEST(LimiterTest, Bounds) {
+    Limiter lim{0, 0};
+    ASSERT_EQ(1, lim.limit());
+    record(lim, 1ms, 10);
+    ASSERT_EQ(1, lim.limit());
+}
+
+}  // namespace postgres::internal
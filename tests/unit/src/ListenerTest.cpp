@@ -0,0 +1,74 @@
+#include <atomic>
+#include <future>
+#include <thread>
+#include <utility>
+#include <gtest/gtest.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Listener.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+TEST(ListenerTest, Notify) {
+    std::promise<Notification> prom{};
+    Listener                   lis{};
+    lis.subscribe("listener_test", [&prom](Notification const& note) {
+        prom.set_value(note);
+    });
+    std::this_thread::sleep_for(100ms);
+
+    Connection conn{};
+    conn.exec("NOTIFY listener_test, 'spam'");
+    auto fut = prom.get_future();
+    ASSERT_EQ(std::future_status::ready, fut.wait_for(1s));
+
+    auto const note = fut.get();
+    ASSERT_EQ("listener_test", note.channel);
+    ASSERT_EQ("spam", note.payload);
+    ASSERT_EQ(PQbackendPID(conn.native()), note.pid);
+}
+
+TEST(ListenerTest, Unsubscribe) {
+    std::atomic<int> count{0};
+    Listener         lis{};
+    lis.subscribe("listener_test", [&count](Notification const&) {
+        ++count;
+    });
+    lis.subscribe("listener_other", [&count](Notification const&) {
+        count += 10;
+    });
+    std::this_thread::sleep_for(100ms);
+
+    Connection conn{};
+    conn.exec("NOTIFY listener_test");
+    conn.exec("NOTIFY listener_other");
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(11, count);
+
+    lis.unsubscribe("listener_other");
+    std::this_thread::sleep_for(100ms);
+    conn.exec("NOTIFY listener_test");
+    conn.exec("NOTIFY listener_other");
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(12, count);
+}
+
+TEST(ListenerTest, Gap) {
+    std::promise<void> prom{};
+    Listener           lis{Context::Builder{}.uri("postgresql://localhost:1/listener_test").build()};
+    lis.onGap([&prom, is_set = false]() mutable {
+        if (!std::exchange(is_set, true)) {
+            prom.set_value();
+        }
+    });
+    ASSERT_EQ(std::future_status::ready, prom.get_future().wait_for(3s));
+}
+
+TEST(ListenerTest, Bad) {
+    ASSERT_THROW((Listener{Context{}, 0}), LogicError);
+}
+
+}  // namespace postgres
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Parallel.h>
+
+namespace postgres::internal {
+
+TEST(ParallelTest, Split) {
+    std::vector<int> hits(1000);
+    std::atomic<int> parts{0};
+    parallelFor(static_cast<int>(hits.size()), 4, 10, [&hits, &parts](int const beg, int const end) {
+        ++parts;
+        for (auto i = beg; i < end; ++i) {
+            ++hits[i];
+        }
+    });
+    ASSERT_EQ(4, parts);
+    ASSERT_EQ(std::vector<int>(1000, 1), hits);
+}
+
+TEST(ParallelTest, Grain) {
+    auto const       id = std::this_thread::get_id();
+    std::atomic<int> parts{0};
+    parallelFor(100, 4, 60, [id, &parts](int const beg, int const end) {
+        ++parts;
+        ASSERT_EQ(id, std::this_thread::get_id());
+        ASSERT_EQ(0, beg);
+        ASSERT_EQ(100, end);
+    });
+    ASSERT_EQ(1, parts);
+
+    parallelFor(0, 4, 1, [&parts](int const beg, int const end) {
+        ++parts;
+        ASSERT_EQ(beg, end);
+    });
+    ASSERT_EQ(2, parts);
+}
+
+TEST(ParallelTest, Error) {
+    std::atomic<int> parts{0};
+    ASSERT_THROW(parallelFor(100, 4, 1, [&parts](int const beg, int) {
+        ++parts;
+        if (0 < beg) {
+            throw std::runtime_error{"failure"};
+        }
+    }), std::runtime_error);
+    ASSERT_EQ(4, parts);
+}
+
+}  // namespace postgres::internal
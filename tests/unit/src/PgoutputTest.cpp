@@ -0,0 +1,161 @@
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/Pgoutput.h>
+#include <postgres/Error.h>
+#include <postgres/Visitable.h>
+
+namespace postgres::internal {
+
+struct PgoutputTestTable {
+    int32_t                    id = 0;
+    std::optional<std::string> name;
+
+    POSTGRES_CXX_TABLE("pgoutput_test", id, name);
+};
+
+// Builds the messages as the server sends them.
+struct Message {
+    template <typename T>
+    Message& num(T const val) {
+        auto const ordered = orderBytes(val);
+        data.append(reinterpret_cast<char const*>(&ordered), sizeof(ordered));
+        return *this;
+    }
+
+    Message& byte(char const val) {
+        data.push_back(val);
+        return *this;
+    }
+
+    Message& str(std::string const& val) {
+        data.append(val.data(), val.size() + 1);
+        return *this;
+    }
+
+    Message& row(int32_t const id, char const* const name) {
+        num<int16_t>(2);
+        byte('b').num<int32_t>(sizeof(int32_t)).num(id);
+        if (name) {
+            byte('t').num(static_cast<int32_t>(std::string{name}.size()));
+            data.append(name);
+        } else {
+            byte('n');
+        }
+        return *this;
+    }
+
+    std::string data;
+};
+
+struct PgoutputTest : testing::Test {
+    PgoutputTest() {
+        auto const rel = Message{}.byte('R')
+                                  .num<uint32_t>(RELATION)
+                                  .str("public")
+                                  .str("pgoutput_test")
+                                  .byte('d')
+                                  .num<int16_t>(2)
+                                  .byte(1).str("id").num<uint32_t>(23).num<int32_t>(-1)
+                                  .byte(0).str("name").num<uint32_t>(25).num<int32_t>(-1);
+        decode(rel, 0);
+    }
+
+    void decode(Message const& msg, uint64_t const lsn) {
+        dec_.decode(msg.data.data(), msg.data.size(), lsn, out_);
+    }
+
+    static uint32_t constexpr RELATION = 16384;
+
+    Pgoutput           dec_;
+    std::deque<Change> out_;
+};
+
+TEST_F(PgoutputTest, Relation) {
+    ASSERT_TRUE(out_.empty());
+}
+
+TEST_F(PgoutputTest, Transaction) {
+    decode(Message{}.byte('B').num<uint64_t>(0x300).num<int64_t>(0).num<uint32_t>(42), 0x100);
+    decode(Message{}.byte('C').byte(0).num<uint64_t>(0x280).num<uint64_t>(0x300).num<int64_t>(0), 0x280);
+
+    ASSERT_EQ(2u, out_.size());
+    ASSERT_EQ(Change::Kind::BEGIN, out_[0].kind);
+    ASSERT_EQ(0x300u, out_[0].lsn);
+    ASSERT_EQ(42u, out_[0].xid);
+    ASSERT_EQ(Change::Kind::COMMIT, out_[1].kind);
+    ASSERT_EQ(0x300u, out_[1].lsn);
+}
+
+TEST_F(PgoutputTest, Insert) {
+    decode(Message{}.byte('I').num<uint32_t>(RELATION).byte('N').row(7, "seven"), 0x200);
+
+    ASSERT_EQ(1u, out_.size());
+    auto const& chg = out_[0];
+    ASSERT_EQ(Change::Kind::INSERT, chg.kind);
+    ASSERT_EQ(0x200u, chg.lsn);
+    ASSERT_EQ("public", chg.schema);
+    ASSERT_EQ("pgoutput_test", chg.table);
+    ASSERT_FALSE(chg.old);
+
+    auto const row = chg.as<PgoutputTestTable>();
+    ASSERT_EQ(7, row.id);
+    ASSERT_EQ("seven", row.name);
+}
+
+TEST_F(PgoutputTest, Update) {
+    decode(Message{}.byte('U').num<uint32_t>(RELATION).byte('O').row(7, "seven").byte('N').row(8, nullptr), 0x200);
+
+    ASSERT_EQ(1u, out_.size());
+    auto const& chg = out_[0];
+    ASSERT_EQ(Change::Kind::UPDATE, chg.kind);
+
+    auto const row = chg.as<PgoutputTestTable>();
+    ASSERT_EQ(8, row.id);
+    ASSERT_FALSE(row.name);
+
+    ASSERT_TRUE(chg.old);
+    PgoutputTestTable old{};
+    (*chg.old)[0] >> old;
+    ASSERT_EQ(7, old.id);
+    ASSERT_EQ("seven", old.name);
+}
+
+TEST_F(PgoutputTest, UpdateWithoutOld) {
+    decode(Message{}.byte('U').num<uint32_t>(RELATION).byte('N').row(8, "eight"), 0x200);
+
+    ASSERT_EQ(1u, out_.size());
+    ASSERT_FALSE(out_[0].old);
+    ASSERT_EQ(8, out_[0].as<PgoutputTestTable>().id);
+}
+
+TEST_F(PgoutputTest, Delete) {
+    decode(Message{}.byte('D').num<uint32_t>(RELATION).byte('K').row(7, nullptr), 0x200);
+
+    ASSERT_EQ(1u, out_.size());
+    auto const& chg = out_[0];
+    ASSERT_EQ(Change::Kind::DELETE, chg.kind);
+    ASSERT_FALSE(chg.row);
+    ASSERT_EQ(7, chg.as<PgoutputTestTable>().id);
+}
+
+TEST_F(PgoutputTest, Truncate) {
+    decode(Message{}.byte('T').num<int32_t>(1).byte(0).num<uint32_t>(RELATION), 0x200);
+
+    ASSERT_EQ(1u, out_.size());
+    ASSERT_EQ(Change::Kind::TRUNCATE, out_[0].kind);
+    ASSERT_EQ("pgoutput_test", out_[0].table);
+    ASSERT_THROW(out_[0].as<PgoutputTestTable>(), LogicError);
+}
+
+TEST_F(PgoutputTest, Unknown) {
+    ASSERT_THROW(decode(Message{}.byte('I').num<uint32_t>(RELATION + 1).byte('N').row(7, nullptr), 0), RuntimeError);
+    ASSERT_THROW(decode(Message{}.byte('I').num<uint32_t>(RELATION).byte('N').num<int16_t>(2), 0), RuntimeError);
+    decode(Message{}.byte('O').num<uint64_t>(0).str("origin"), 0);
+    ASSERT_TRUE(out_.empty());
+}
+
+}  // namespace postgres::internal
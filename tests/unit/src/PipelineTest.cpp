@@ -0,0 +1,89 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Consumer.h>
+#include <postgres/Error.h>
+#include <postgres/Pipeline.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+#include <postgres/Result.h>
+
+namespace postgres {
+
+TEST(PipelineTest, Receive) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    pipe.send(Command{"SELECT $1::INT", 1})
+        .send(Command{"SELECT $1::INT", 2})
+        .sync();
+    ASSERT_EQ(2, pipe.size());
+    ASSERT_EQ(1, pipe.receive()[0][0].as<int32_t>());
+    ASSERT_EQ(2, pipe.receive()[0][0].as<int32_t>());
+    ASSERT_EQ(0, pipe.size());
+    ASSERT_TRUE(pipe.receive().isDone());
+}
+
+TEST(PipelineTest, NoSync) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    pipe.send(Command{"SELECT 1::INT"});
+    ASSERT_EQ(1, pipe.receive()[0][0].as<int32_t>());
+    pipe.send(Command{"SELECT 2::INT"});
+}
+
+TEST(PipelineTest, Iter) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    for (auto i = 1; i <= 3; ++i) {
+        pipe.send(Command{"SELECT $1::INT", i});
+    }
+    pipe.sync();
+
+    std::vector<int32_t> vals{};
+    for (auto const& res : pipe) {
+        vals.push_back(res[0][0].as<int32_t>());
+    }
+    ASSERT_EQ(3u, vals.size());
+    ASSERT_EQ(1, vals[0]);
+    ASSERT_EQ(2, vals[1]);
+    ASSERT_EQ(3, vals[2]);
+}
+
+TEST(PipelineTest, Prepare) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    pipe.send(PrepareData{"select1", "SELECT $1::INT", {INT4OID}})
+        .send(PreparedCommand{"select1", 1})
+        .sync();
+    ASSERT_TRUE(pipe.receive().isOk());
+    ASSERT_EQ(1, pipe.receive()[0][0].as<int32_t>());
+}
+
+TEST(PipelineTest, Abort) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    pipe.send(Command{"BAD"})
+        .send(Command{"SELECT 1"})
+        .sync()
+        .send(Command{"SELECT 2::INT"})
+        .sync();
+    ASSERT_THROW(pipe.receive(), RuntimeError);
+    ASSERT_THROW(pipe.receive(), RuntimeError);
+    ASSERT_EQ(2, pipe.receive()[0][0].as<int32_t>());
+}
+
+TEST(PipelineTest, Cleanup) {
+    Connection conn{};
+    conn.pipeline().send(Command{"SELECT 1"}).send(Command{"SELECT 2"});
+    ASSERT_EQ(3, conn.exec("SELECT 3::INT")[0][0].as<int32_t>());
+}
+
+TEST(PipelineTest, Mix) {
+    Connection conn{};
+    auto       pipe = conn.pipeline();
+    ASSERT_THROW(conn.pipeline(), LogicError);
+    ASSERT_THROW(conn.sendRaw("SELECT 1"), RuntimeError);
+}
+
+}  // namespace postgres
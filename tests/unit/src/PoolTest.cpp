@@ -0,0 +1,37 @@
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Pool.h>
+
+namespace postgres::internal {
+
+TEST(PoolTest, Reuse) {
+    auto const ptr = Pool::allocate(40);
+    Pool::deallocate(ptr, 40);
+    ASSERT_EQ(ptr, Pool::allocate(48));
+    Pool::deallocate(ptr, 48);
+}
+
+TEST(PoolTest, Large) {
+    auto const ptr = Pool::allocate(1 << 20);
+    Pool::deallocate(ptr, 1 << 20);
+}
+
+TEST(PoolTest, Thread) {
+    void* ptr = nullptr;
+    std::thread{[&ptr] {
+        ptr = Pool::allocate(16);
+    }}.join();
+    Pool::deallocate(ptr, 16);
+    ASSERT_EQ(ptr, Pool::allocate(16));
+    Pool::deallocate(ptr, 16);
+}
+
+TEST(PoolTest, Allocator) {
+    std::vector<int, PoolAllocator<int>> vals{1, 2, 3};
+    vals.push_back(4);
+    ASSERT_EQ(4u, vals.size());
+    ASSERT_TRUE(PoolAllocator<int>{} == PoolAllocator<char>{});
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/Race.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(RaceTest, First) {
+    Race race{};
+    auto res = race.future();
+    ASSERT_FALSE(race.isOver());
+    ASSERT_TRUE(race.finish(std::make_exception_ptr(LogicError{"first"})));
+    ASSERT_TRUE(race.isOver());
+    ASSERT_FALSE(race.finish(std::make_exception_ptr(RuntimeError{"second"})));
+    ASSERT_THROW(res.get(), LogicError);
+}
+
+}  // namespace postgres::internal
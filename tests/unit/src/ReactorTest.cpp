@@ -0,0 +1,42 @@
+#include <future>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Reactor.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(ReactorTest, Load) {
+    auto constexpr                   N = 64;
+    Reactor                          reactor{Context::Builder{}.maxConcurrency(3).reactorThreads(2).share()};
+    std::vector<std::future<Result>> results{};
+    results.reserve(N);
+
+    for (auto i = 1; i <= N; ++i) {
+        results.push_back(reactor.send<Result>(Command{"SELECT $1::INT", i}, Priority::NORMAL));
+    }
+    auto sum = 0;
+    for (auto& res : results) {
+        sum += res.get()[0][0].as<int32_t>();
+    }
+    ASSERT_EQ(2080, sum);
+}
+
+TEST(ReactorTest, Error) {
+    Reactor reactor{Context::Builder{}.maxConcurrency(1).reactorThreads(1).share()};
+    auto    bad  = reactor.send<Status>(Command{"BAD"}, Priority::HIGH);
+    auto    good = reactor.send<Status>(Command{"SELECT 1"}, Priority::LOW);
+    ASSERT_THROW(bad.get(), RuntimeError);
+    ASSERT_TRUE(good.get().isOk());
+}
+
+TEST(ReactorTest, Connect) {
+    Reactor reactor{Context::Builder{}.uri("postgresql://localhost:1/reactor_test")
+                                      .maxConcurrency(1)
+                                      .reactorThreads(1)
+                                      .share()};
+    ASSERT_THROW(reactor.send<Status>(Command{"SELECT 1"}, Priority::NORMAL).get(), RuntimeError);
+}
+
+}  // namespace postgres::internal
@@ -1,5 +1,6 @@
 #include <vector>
 #include <gtest/gtest.h>
+#include <postgres/Command.h>
 #include <postgres/Connection.h>
 #include <postgres/PreparedCommand.h>
 #include <postgres/PrepareData.h>
@@ -116,6 +117,21 @@ TEST(ReceiverTest, Iter) {
     ASSERT_EQ(3, vals[2]);
 }
 
+TEST(ReceiverTest, IterChunk) {
+    std::vector<int32_t> vals{};
+    for (auto const& res : Connection{}.iter(SELECT_MULTI_ROW, 2)) {
+        for (auto const& row : res) {
+            vals.emplace_back();
+            row[0] >> vals.back();
+        }
+    }
+    ASSERT_EQ(3u, vals.size());
+    ASSERT_EQ(1, vals[0]);
+    ASSERT_EQ(2, vals[1]);
+    ASSERT_EQ(3, vals[2]);
+    ASSERT_THROW(Connection{}.iter(SELECT_MULTI_ROW, 0), LogicError);
+}
+
 TEST(ReceiverTest, IterEmpty) {
     auto n = 0;
     for (auto const& res : Connection{}.iter("SELECT 1 WHERE FALSE")) {
@@ -128,6 +144,38 @@ TEST(ReceiverTest, IterEmpty) {
     ASSERT_EQ(0, n);
 }
 
+TEST(ReceiverTest, IterAbandon) {
+    Connection conn{};
+    {
+        auto rec = conn.iter(Command{"SELECT generate_series(1, 100000000)"}, 100);
+        ASSERT_TRUE(rec.receive().isOk());
+    }
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+
+    // Streamed in a transaction block, the rows are drained to keep the transaction going.
+    ASSERT_TRUE(conn.exec("BEGIN").isOk());
+    {
+        auto rec = conn.iter(Command{"SELECT generate_series(1, 10)"}, 2);
+        ASSERT_TRUE(rec.receive().isOk());
+    }
+    ASSERT_TRUE(conn.exec("COMMIT").isOk());
+}
+
+TEST(ReceiverTest, IterBreak) {
+    Connection conn{};
+    auto       n = 0;
+    for (auto const& res : conn.iter(Command{"SELECT generate_series(1, 100000000)"}, 100)) {
+        if (res.isEmpty()) {
+            continue;
+        }
+        if (++n == 3) {
+            break;
+        }
+    }
+    ASSERT_EQ(3, n);
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+}
+
 TEST(ReceiverTest, Busy) {
     auto n   = 0;
     auto rec = Connection{}.send("SELECT 1");
@@ -137,6 +185,21 @@ TEST(ReceiverTest, Busy) {
     ASSERT_LT(0, n);
 }
 
+TEST(ReceiverTest, TryReceive) {
+    Connection conn{};
+    conn.setNonBlocking(true);
+    auto rec = conn.send("SELECT 1::INT");
+    while (!conn.flush()) {
+    }
+
+    auto res = rec.tryReceive();
+    while (!res) {
+        res = rec.tryReceive();
+    }
+    ASSERT_EQ(1, (*res)[0][0].as<int32_t>());
+    ASSERT_TRUE(rec.receive().isDone());
+}
+
 TEST(ReceiverTest, Cleanup) {
     Connection conn{};
     conn.send("SELECT 1::INT");
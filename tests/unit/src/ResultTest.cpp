@@ -1,6 +1,13 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
 #include <postgres/Result.h>
 #include "Samples.h"
 
@@ -18,6 +25,20 @@ TEST(ResultTest, Ok) {
     ASSERT_EQ(PGRES_TUPLES_OK, res.type());
 }
 
+TEST(ResultTest, Adopt) {
+    auto const handle = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PGresAttDesc attr{};
+    attr.name  = const_cast<char*>("a");
+    attr.typid = TEXTOID;
+    PQsetResultAttrs(handle, 1, &attr);
+    PQsetvalue(handle, 0, 0, const_cast<char*>("foo"), 3);
+
+    auto const res = Result::adopt(handle);
+    ASSERT_EQ(1, res.size());
+    ASSERT_EQ("foo", res[0]["a"].as<std::string>());
+    ASSERT_THROW(Result::adopt(PQmakeEmptyPGresult(nullptr, PGRES_FATAL_ERROR)), RuntimeError);
+}
+
 TEST(ResultTest, Empty) {
     auto const res = Connection{}.exec("SELECT 1 WHERE FALSE");
     ASSERT_TRUE(res.isOk());
@@ -74,4 +95,91 @@ TEST(ResultTest, Index) {
     ASSERT_THROW(res[-1][0].as<int32_t>(), LogicError);
 }
 
+TEST(ResultTest, Tuples) {
+    auto const res = Connection{}.exec("SELECT i, i::TEXT FROM generate_series(1, 3) i");
+
+    std::vector<int64_t>     ints{};
+    std::vector<std::string> strs{};
+    for (auto const [i, s] : res.as<std::tuple<int64_t, std::string>>()) {
+        ints.push_back(i);
+        strs.push_back(s);
+    }
+    ASSERT_EQ((std::vector<int64_t>{1, 2, 3}), ints);
+    ASSERT_EQ((std::vector<std::string>{"1", "2", "3"}), strs);
+    ASSERT_THROW((res.as<std::tuple<int64_t, std::string, int64_t>>()), LogicError);
+}
+
+TEST(ResultTest, View) {
+    auto const res = Connection{}.exec("SELECT i::INT8, NULLIF(i, 2)::INT4, i::TEXT FROM generate_series(1, 3) i");
+    auto const view = res.view<int64_t, std::optional<int32_t>, std::string_view>();
+    ASSERT_EQ(3, view.size());
+
+    std::vector<int64_t> ints{};
+    for (auto const cells : view) {
+        ints.push_back(cells.get<0>());
+    }
+    ASSERT_EQ((std::vector<int64_t>{1, 2, 3}), ints);
+    ASSERT_FALSE(view[1].get<1>());
+    ASSERT_EQ(3, view[2].get<1>());
+    ASSERT_EQ("3", view[2].get<2>());
+    ASSERT_EQ((std::tuple<int64_t, std::optional<int32_t>, std::string_view>{1, 1, "1"}), view[0].tuple());
+    ASSERT_THROW(view[3], LogicError);
+
+    ASSERT_THROW((res.view<int64_t, int32_t>()[1].get<1>()), LogicError);
+    ASSERT_THROW((res.view<int32_t>()), LogicError);
+    ASSERT_THROW((res.view<int64_t, int32_t, std::string_view, int64_t>()), LogicError);
+}
+
+TEST(ResultTest, Share) {
+    std::shared_ptr<PGresult const> data{};
+    std::string_view               view{};
+    {
+        auto const res = Connection{}.exec("SELECT repeat('x', 1000)");
+        data = res.share();
+        res[0][0] >> view;
+    }
+    ASSERT_EQ(std::string(1000, 'x'), view);
+    ASSERT_EQ(view.data(), PQgetvalue(data.get(), 0, 0));
+}
+
+TEST(ResultTest, Column) {
+    auto const res = Connection{}.exec("SELECT i, i::FLOAT8 d, i <> 2 b FROM generate_series(1, 3) i");
+
+    std::vector<int64_t> ints{0};
+    res.column(0, ints);
+    ASSERT_EQ((std::vector<int64_t>{0, 1, 2, 3}), ints);
+
+    std::vector<double> dbls{};
+    res.column("d", dbls);
+    ASSERT_EQ((std::vector<double>{1., 2., 3.}), dbls);
+
+    std::vector<bool> bools{true};
+    res.column("b", bools);
+    ASSERT_EQ((std::vector<bool>{true, true, false, true}), bools);
+
+    std::vector<int16_t> narrow{};
+    ASSERT_THROW(res.column(0, narrow), LogicError);
+    ASSERT_THROW(res.column(1, ints), LogicError);
+    ASSERT_THROW(res.column(0, bools), LogicError);
+    ASSERT_THROW(res.column(3, ints), LogicError);
+    ASSERT_THROW(res.column("bad", ints), LogicError);
+}
+
+TEST(ResultTest, ColumnNull) {
+    auto const res = Connection{}.exec("SELECT NULLIF(i, 2) FROM generate_series(1, 3) i");
+
+    std::vector<int32_t> vals{};
+    ASSERT_THROW(res.column(0, vals), LogicError);
+
+    std::vector<std::optional<int32_t>> opts{};
+    res.column(0, opts);
+    ASSERT_EQ((std::vector<std::optional<int32_t>>{1, std::nullopt, 3}), opts);
+
+    std::vector<uint64_t> dense{};
+    std::vector<bool>     nulls{};
+    res.column(0, dense, nulls);
+    ASSERT_EQ((std::vector<uint64_t>{1, 0, 3}), dense);
+    ASSERT_EQ((std::vector<bool>{false, true, false}), nulls);
+}
+
 }  // namespace postgres
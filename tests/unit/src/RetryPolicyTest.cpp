@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include <postgres/Error.h>
+#include <postgres/RetryPolicy.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+TEST(RetryPolicyTest, Transient) {
+    ASSERT_TRUE(RetryPolicy::isTransient(RuntimeError{"", "40001"}));
+    ASSERT_TRUE(RetryPolicy::isTransient(RuntimeError{"", "40P01"}));
+    ASSERT_FALSE(RetryPolicy::isTransient(RuntimeError{"", "42601"}));
+    ASSERT_FALSE(RetryPolicy::isTransient(RuntimeError{""}));
+}
+
+TEST(RetryPolicyTest, Backoff) {
+    RetryPolicy const policy{5, 1ms, 5ms};
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_LE(policy.backoff(1), 1ms);
+        ASSERT_LE(policy.backoff(2), 2ms);
+        ASSERT_LE(policy.backoff(10), 5ms);
+        ASSERT_LE(0us, policy.backoff(10));
+    }
+    ASSERT_EQ(0us, (RetryPolicy{5, 0us, 0us}.backoff(3)));
+}
+
+}  // namespace postgres
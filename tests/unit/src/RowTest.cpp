@@ -1,3 +1,8 @@
+#include <chrono>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
@@ -34,6 +39,75 @@ TEST(RowTest, Visit) {
     ASSERT_THROW(conn.exec("SELECT 1::INT")[0] >> tbl, LogicError);
 }
 
+TEST(RowTest, VisitMany) {
+    Connection                conn{};
+    std::vector<RowTestTable> out{};
+    for (auto row : conn.exec("SELECT n AS y, -n AS x FROM generate_series(1, 3) n")) {
+        row >> out.emplace_back();
+    }
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ(-3, out[2].x);
+    ASSERT_EQ(3, out[2].y);
+
+    auto const res = conn.exec("SELECT n AS x FROM generate_series(1, 3) n");
+    ASSERT_THROW(res[0] >> out[0], LogicError);
+    ASSERT_THROW(res[1] >> out[0], LogicError);
+}
+
+struct RowTestMixed {
+    int64_t                a = 0;
+    std::optional<double>  b;
+    int64_t                c = 0;
+    Time::Point            d;
+
+    POSTGRES_CXX_TABLE("row_test", a, b, c, d);
+};
+
+TEST(RowTest, VisitExact) {
+    std::vector<RowTestMixed> out{};
+    auto const res = Connection{}.exec("SELECT n::INT8 AS a, NULLIF(n, 2)::FLOAT8 AS b, n::INT2 AS c, "
+                                       "'2017-08-25T13:03:35'::TIMESTAMP AS d FROM generate_series(1, 3) n");
+    for (auto row : res) {
+        row >> out.emplace_back();
+    }
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ(3, out[2].a);
+    ASSERT_EQ(3., out[2].b);
+    ASSERT_FALSE(out[1].b);
+    ASSERT_EQ(3, out[2].c);
+    ASSERT_EQ(std::chrono::system_clock::from_time_t(1503666215), out[0].d);
+}
+
+TEST(RowTest, Refresh) {
+    auto const res = Connection{}.exec("SELECT n::INT8 AS a, NULLIF(n, 2)::FLOAT8 AS b, n::INT2 AS c, "
+                                       "'2017-08-25T13:03:35'::TIMESTAMP AS d FROM generate_series(1, 2) n");
+    RowTestMixed val{};
+    ASSERT_TRUE(res[0].refresh(val));
+    ASSERT_FALSE(res[0].refresh(val));
+    ASSERT_EQ(1., val.b);
+    ASSERT_TRUE(res[1].refresh(val));
+    ASSERT_FALSE(val.b);
+    ASSERT_EQ(2, val.c);
+    ASSERT_FALSE(res[1].refresh(val));
+}
+
+TEST(RowTest, Tuple) {
+    auto const res = Connection{}.exec("SELECT 1::INT8, 'foo'::TEXT, NULL::FLOAT8, 2::INT2");
+    auto       row = res[0];
+
+    auto const [a, b, c] = row.as<std::tuple<int64_t, std::string, std::optional<double>>>();
+    ASSERT_EQ(1, a);
+    ASSERT_EQ("foo", b);
+    ASSERT_FALSE(c);
+
+    std::tuple<int64_t, std::string> head{};
+    std::tuple<std::optional<double>, int32_t> tail{};
+    row >> head >> tail;
+    ASSERT_EQ(2, std::get<1>(tail));
+    ASSERT_THROW(row >> head, LogicError);
+    ASSERT_THROW((res[0].as<std::tuple<int64_t, std::string, double>>()), LogicError);
+}
+
 TEST(RowTest, Index) {
     auto const res = Connection{}.exec("SELECT 1::INT, 2::INT");
     auto const row = res[0];
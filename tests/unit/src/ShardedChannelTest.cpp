@@ -0,0 +1,150 @@
+#include <future>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/ShardedChannel.h>
+#include <postgres/internal/Worker.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+// Jobs are received but not run, since running requires a connection.
+struct Mark {
+    void operator()(Connection&) const {
+    }
+
+    int val = 0;
+};
+
+static std::vector<int> drain(IChannel& chan, Slot& slot) {
+    std::vector<int> res{};
+    while (true) {
+        chan.receive(slot);
+        auto const job = std::move(slot.job);
+        if (!job) {
+            break;
+        }
+        res.push_back(job.target<Mark>()->val);
+    }
+    return res;
+}
+
+TEST(ShardedChannelTest, Send) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    for (auto i = 1; i <= 3; ++i) {
+        auto const[is_sent, recycled] = chan->send(Mark{i});
+        ASSERT_FALSE(is_sent);
+        ASSERT_EQ(nullptr, recycled);
+    }
+    chan->quit(1);
+
+    Slot       slot{};
+    auto const res = drain(*chan, slot);
+    ASSERT_EQ(3u, res.size());
+    ASSERT_EQ(1, res[0]);
+    ASSERT_EQ(2, res[1]);
+    ASSERT_EQ(3, res[2]);
+}
+
+TEST(ShardedChannelTest, Wake) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    Slot slot{};
+    auto res = std::async(std::launch::async, [&chan, &slot] {
+        return drain(*chan, slot);
+    });
+
+    // Keep sending until the job is passed to the idle worker.
+    auto count = 1;
+    while (!std::get<0>(chan->send(Mark{count}))) {
+        std::this_thread::sleep_for(1ms);
+        ++count;
+    }
+    chan->quit(1);
+    ASSERT_EQ(count, static_cast<int>(res.get().size()));
+}
+
+TEST(ShardedChannelTest, Drop) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    for (auto i = 1; i <= 3; ++i) {
+        chan->send(Mark{i});
+    }
+    chan->drop();
+    chan->quit(1);
+
+    Slot slot{};
+    ASSERT_TRUE(drain(*chan, slot).empty());
+}
+
+TEST(ShardedChannelTest, Recycle) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    Worker worker{ctx, chan};
+    chan->recycle(worker);
+
+    auto const[is_sent, recycled] = chan->send(nullptr);
+    ASSERT_FALSE(is_sent);
+    ASSERT_EQ(&worker, recycled);
+}
+
+TEST(ShardedChannelTest, Timeout) {
+    auto const ctx  = Context::Builder{}.idleTimeout(1ns).queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    Slot slot{};
+    ASSERT_TRUE(drain(*chan, slot).empty());
+}
+
+TEST(ShardedChannelTest, Overflow) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+    chan->send(nullptr);
+    ASSERT_THROW(chan->send(nullptr), RuntimeError);
+}
+
+TEST(ShardedChannelTest, Concurrent) {
+    auto const ctx  = Context::Builder{}.queueShards(4).share();
+    auto const chan = std::make_shared<ShardedChannel>(ctx);
+
+    auto constexpr WORKERS = 4;
+    auto constexpr SENDERS = 8;
+    auto constexpr JOBS    = 10000;
+
+    std::vector<Slot>                           slots(WORKERS);
+    std::vector<std::future<std::vector<int>>> workers{};
+    for (auto& slot : slots) {
+        workers.push_back(std::async(std::launch::async, [&chan, &slot] {
+            return drain(*chan, slot);
+        }));
+    }
+
+    std::vector<std::thread> senders{};
+    for (auto i = 0; i < SENDERS; ++i) {
+        senders.emplace_back([&chan] {
+            for (auto j = 0; j < JOBS; ++j) {
+                chan->send(Mark{1});
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    chan->quit(WORKERS);
+
+    auto count = size_t{0};
+    for (auto& worker : workers) {
+        count += worker.get().size();
+    }
+    ASSERT_EQ(static_cast<size_t>(SENDERS * JOBS), count);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,61 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/ShardedClient.h>
+
+namespace postgres {
+
+namespace {
+
+std::vector<Context> makeShards(int const count) {
+    std::vector<Context> ctxs{};
+    for (auto i = 0; i < count; ++i) {
+        ctxs.emplace_back();
+    }
+    return ctxs;
+}
+
+}  // namespace
+
+TEST(ShardedClientTest, Route) {
+    ShardedClient<int> cl{makeShards(3), [](int const key) {
+        return static_cast<size_t>(key);
+    }};
+    ASSERT_EQ(3, cl.size());
+    ASSERT_EQ(&cl.shard(1), &cl.shard(4));
+    ASSERT_NE(&cl.shard(1), &cl.shard(2));
+
+    ShardedClient<std::string> hashed{makeShards(2)};
+    ASSERT_EQ(&hashed.shard("foo"), &hashed.shard("foo"));
+}
+
+TEST(ShardedClientTest, Bad) {
+    ASSERT_THROW(ShardedClient<int>{std::vector<Context>{}}, LogicError);
+}
+
+TEST(ShardedClientTest, Query) {
+    ShardedClient<int> cl{makeShards(2)};
+    ASSERT_EQ(7, cl.query(1, [](Connection& conn) {
+        return conn.exec(Command{"SELECT $1", 7});
+    }).get()[0][0].as<int32_t>());
+    ASSERT_TRUE(cl.exec(2, [](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }).get().isOk());
+}
+
+TEST(ShardedClientTest, Gather) {
+    ShardedClient<int> cl{makeShards(3)};
+    auto const         job = [](Connection& conn) {
+        return conn.exec("SELECT generate_series(1, 2)");
+    };
+    ASSERT_EQ(3, cl.gather(job).size());
+
+    auto const merged = cl.merge<int32_t>(job);
+    ASSERT_EQ((std::vector<int32_t>{1, 2, 1, 2, 1, 2}), merged);
+}
+
+}  // namespace postgres
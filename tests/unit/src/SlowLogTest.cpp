@@ -0,0 +1,93 @@
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/SlowLog.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+namespace {
+
+Trace make(std::string_view const stmt, SlowLog::Duration const total, std::string_view const code = "") {
+    Trace trace{};
+    trace.statement = stmt;
+    trace.total     = total;
+    trace.wait      = 1ms;
+    trace.rows      = 2;
+    trace.code      = code;
+    return trace;
+}
+
+}  // namespace
+
+TEST(SlowLogTest, Fingerprint) {
+    ASSERT_EQ("SELECT * FROM t WHERE id = ? AND name = ?",
+              SlowLog::fingerprint("  SELECT *\n FROM t\tWHERE id = 42 AND name = 'it''s'  "));
+    ASSERT_EQ("SELECT x1, \"col 7\" FROM t2 WHERE v > ?", SlowLog::fingerprint("SELECT x1, \"col 7\" FROM t2 WHERE v > 1.5e-3"));
+    ASSERT_EQ("SELECT ? WHERE id IN (?)", SlowLog::fingerprint("SELECT $1 WHERE id IN ($2, $3,$4)"));
+    ASSERT_EQ("INSERT INTO t (a, b) VALUES (?)", SlowLog::fingerprint("INSERT INTO t (a, b) VALUES (1, 'a'), (2, 'b'),(3, 'c')"));
+    ASSERT_EQ(SlowLog::fingerprint("SELECT 1"), SlowLog::fingerprint("SELECT 2"));
+}
+
+TEST(SlowLogTest, Aggregate) {
+    SlowLog log{};
+    log.trace(make("SELECT 1", 3ms));
+    log.trace(make("SELECT  2", 5ms, "42P01"));
+    log.trace(make("SELECT now()", 1ms));
+
+    auto const top = log.top(5);
+    ASSERT_EQ(2u, top.size());
+    ASSERT_EQ("SELECT ?", top[0].fingerprint);
+    ASSERT_EQ(2, top[0].calls);
+    ASSERT_EQ(1, top[0].errors);
+    ASSERT_EQ(4, top[0].rows);
+    ASSERT_EQ(6ms, top[0].max);
+    ASSERT_EQ(10ms, top[0].latency.total);
+    ASSERT_EQ(2ms, top[0].wait.total);
+    ASSERT_EQ("SELECT now()", top[1].fingerprint);
+
+    ASSERT_EQ(1u, log.top(1).size());
+    log.clear();
+    ASSERT_TRUE(log.top(5).empty());
+}
+
+TEST(SlowLogTest, Threshold) {
+    SlowLog log{5ms};
+    log.trace(make("SELECT 1", 3ms));
+    log.trace(make("SELECT 2", 4ms));
+    ASSERT_EQ(1, log.top(5).at(0).calls);
+}
+
+TEST(SlowLogTest, Prepared) {
+    SlowLog log{};
+    auto    trace = make("my_stmt_1", 1ms);
+    trace.is_prepared = true;
+    log.trace(trace);
+    ASSERT_EQ("my_stmt_1", log.top(1).at(0).fingerprint);
+}
+
+TEST(SlowLogTest, Bounded) {
+    SlowLog log{0ms, 16};
+    for (auto i = 0; i < 1000; ++i) {
+        auto const stmt = "SELECT * FROM t" + std::to_string(i);
+        log.trace(make(stmt, std::chrono::microseconds{i}));
+    }
+    auto const top = log.top(1000);
+    ASSERT_GE(16u, top.size());
+    ASSERT_EQ("SELECT * FROM t999", top.at(0).fingerprint);
+}
+
+TEST(SlowLogTest, Dump) {
+    SlowLog log{};
+    log.trace(make("SELECT 1", 3ms));
+
+    std::ostringstream out{};
+    log.dump(out, 10);
+    auto const text = out.str();
+    ASSERT_NE(std::string::npos, text.find("fingerprint"));
+    ASSERT_NE(std::string::npos, text.find("SELECT ?"));
+}
+
+}  // namespace postgres
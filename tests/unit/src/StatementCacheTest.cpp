@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/StatementCache.h>
+
+namespace postgres::internal {
+
+TEST(StatementCacheTest, Use) {
+    StatementCache cache{2};
+    std::string    stale{};
+
+    auto& entry = cache.use("A", stale);
+    ASSERT_EQ(1, entry.uses);
+    ASSERT_FALSE(entry.is_prepared);
+    ASSERT_FALSE(entry.name.empty());
+    ASSERT_EQ(&entry, &cache.use("A", stale));
+    ASSERT_EQ(2, entry.uses);
+    ASSERT_NE(entry.name, cache.use("B", stale).name);
+    ASSERT_TRUE(stale.empty());
+    ASSERT_EQ(2u, cache.size());
+}
+
+TEST(StatementCacheTest, Evict) {
+    StatementCache cache{2};
+    std::string    stale{};
+
+    auto const name = cache.use("A", stale).name;
+    cache.use("A", stale).is_prepared = true;
+    cache.use("B", stale);
+    cache.use("C", stale);
+    ASSERT_EQ(name, stale);
+    ASSERT_EQ(2u, cache.size());
+
+    // Unprepared statements are evicted silently.
+    stale.clear();
+    cache.use("D", stale);
+    ASSERT_TRUE(stale.empty());
+    ASSERT_EQ(2, cache.use("C", stale).uses);
+}
+
+TEST(StatementCacheTest, Recent) {
+    StatementCache cache{2};
+    std::string    stale{};
+
+    cache.use("A", stale);
+    cache.use("B", stale);
+    cache.use("A", stale);
+    cache.use("C", stale);
+    // The recently used A stays, while B is evicted and starts over.
+    ASSERT_EQ(3, cache.use("A", stale).uses);
+    ASSERT_EQ(1, cache.use("B", stale).uses);
+}
+
+TEST(StatementCacheTest, Clear) {
+    StatementCache cache{2};
+    std::string    stale{};
+
+    cache.use("A", stale).is_prepared = true;
+    cache.use("B", stale);
+    ASSERT_EQ(1u, cache.clear().size());
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(1, cache.use("A", stale).uses);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/StatementRegistry.h>
+#include <postgres/Visitable.h>
+
+namespace postgres {
+
+struct StatementRegistryTestTable {
+    int32_t     id = 0;
+    std::string s;
+
+    POSTGRES_CXX_TABLE("registry_test", id, s);
+};
+
+TEST(StatementRegistryTest, Add) {
+    StatementRegistry reg{};
+    reg.add(PrepareData{"select1", "SELECT 1"}).add(PrepareData{"select2", "SELECT 2"});
+    ASSERT_EQ(2u, reg.size());
+
+    auto const prep = reg.find("select1");
+    ASSERT_TRUE(prep);
+    ASSERT_EQ("SELECT 1", prep->statement);
+    ASSERT_EQ(prep, reg.find("select1"));
+    ASSERT_FALSE(reg.find("select3"));
+
+    auto const preps = reg.statements();
+    ASSERT_EQ(2u, preps.size());
+    ASSERT_EQ(prep, preps[0]);
+    ASSERT_EQ("select2", preps[1]->name);
+}
+
+TEST(StatementRegistryTest, Replace) {
+    StatementRegistry reg{};
+    reg.add(PrepareData{"select1", "SELECT 1"});
+    auto const old = reg.find("select1");
+    reg.add(PrepareData{"select1", "SELECT 2"});
+
+    ASSERT_EQ(1u, reg.size());
+    ASSERT_EQ("SELECT 2", reg.find("select1")->statement);
+    // Statements taken before stay valid.
+    ASSERT_EQ("SELECT 1", old->statement);
+}
+
+TEST(StatementRegistryTest, Tables) {
+    StatementRegistry reg{};
+    reg.addTables<StatementRegistryTestTable>();
+    ASSERT_EQ(3u, reg.size());
+    ASSERT_TRUE(reg.find("registry_test_insert"));
+    ASSERT_TRUE(reg.find("registry_test_update"));
+    ASSERT_TRUE(reg.find("registry_test_select"));
+}
+
+}  // namespace postgres
@@ -1,7 +1,9 @@
 #include <chrono>
+#include <deque>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
+#include <postgres/Oid.h>
 #include <postgres/Statement.h>
 #include <postgres/Visitable.h>
 
@@ -12,7 +14,29 @@ struct StatementTestTable {
     int b = 0;
     int c = 0;
 
-    POSTGRES_CXX_TABLE("stmt_test", a, b, c)
+    POSTGRES_CXX_TABLE("stmt_test", a, b, c);
+    POSTGRES_CXX_TABLE_KEY(a);
+};
+
+// Columns of the table are all generated by the server.
+struct StatementTestEmpty {
+    static auto constexpr _POSTGRES_CXX_VISITABLE  = true;
+    static auto constexpr _POSTGRES_CXX_TABLE_NAME = "stmt_empty";
+
+    template <typename V>
+    static constexpr void visitPostgresDefinition(V&) {
+    }
+};
+
+// Range statements are cached per type, so every test of the cache has a table of its own.
+template <int>
+struct StatementTestRange {
+    int a = 0;
+    int b = 0;
+    int c = 0;
+
+    POSTGRES_CXX_TABLE("stmt_test", a, b, c);
+    POSTGRES_CXX_TABLE_KEY(a);
 };
 
 struct StatementTestTable2 {
@@ -64,6 +88,31 @@ TEST(StatementTest, Update) {
     ASSERT_EQ("UPDATE stmt_test SET a=$1,b=$2,c=$3", Statement<StatementTestTable>::update());
 }
 
+TEST(StatementTest, Upsert) {
+    auto const query = "INSERT INTO stmt_test (a,b,c) SELECT * FROM unnest($1,$2,$3)"
+                       " ON CONFLICT (a) DO UPDATE SET b=EXCLUDED.b,c=EXCLUDED.c";
+    ASSERT_EQ(query, Statement<StatementTestTable>::upsert());
+}
+
+TEST(StatementTest, Pages) {
+    auto const query = "SELECT a,b,c FROM stmt_test"
+                       " WHERE ctid >= ('(' || $1::BIGINT || ',0)')::TID"
+                       " AND ctid < ('(' || $2::BIGINT || ',0)')::TID";
+    ASSERT_EQ(query, Statement<StatementTestTable>::selectPages());
+    ASSERT_EQ("SELECT pg_relation_size('stmt_test') / current_setting('block_size')::BIGINT",
+              Statement<StatementTestTable>::pages());
+}
+
+TEST(StatementTest, CopyIn) {
+    auto const query = "COPY stmt_test (a,b,c) FROM STDIN (FORMAT BINARY)";
+    ASSERT_EQ(query, Statement<StatementTestTable>::copyIn());
+}
+
+TEST(StatementTest, CopyOut) {
+    auto const query = "COPY stmt_test (a,b,c) TO STDOUT (FORMAT BINARY)";
+    ASSERT_EQ(query, Statement<StatementTestTable>::copyOut());
+}
+
 TEST(StatementTest, Parts) {
     ASSERT_EQ("a,b,c", Statement<StatementTestTable>::fields());
     ASSERT_EQ("$1,$2,$3", Statement<StatementTestTable>::placeholders());
@@ -72,6 +121,52 @@ TEST(StatementTest, Parts) {
     ASSERT_EQ("a=$2,b=$3,c=$4", Statement<StatementTestTable>::assignments(1));
 }
 
+TEST(StatementTest, Types) {
+    std::vector<Oid> const types{BOOLOID,
+                                 INT2OID,
+                                 INT4OID,
+                                 INT8OID,
+                                 INT2OID,
+                                 INT4OID,
+                                 INT8OID,
+                                 FLOAT4OID,
+                                 FLOAT8OID,
+                                 TEXTOID,
+                                 TIMESTAMPOID};
+    ASSERT_EQ(types, Statement<StatementTestTable2>::types());
+}
+
+TEST(StatementTest, PrepareData) {
+    auto const preps = Statement<StatementTestTable>::prepareData();
+    ASSERT_EQ(3u, preps.size());
+    ASSERT_EQ("stmt_test_insert", preps[0].name);
+    ASSERT_EQ(Statement<StatementTestTable>::insert(), preps[0].statement);
+    ASSERT_EQ((std::vector<Oid>{INT4OID, INT4OID, INT4OID}), preps[0].types);
+    ASSERT_EQ("stmt_test_update", preps[1].name);
+    ASSERT_EQ(Statement<StatementTestTable>::update(), preps[1].statement);
+    ASSERT_EQ(preps[0].types, preps[1].types);
+    ASSERT_EQ("stmt_test_select", preps[2].name);
+    ASSERT_EQ(Statement<StatementTestTable>::select(), preps[2].statement);
+    ASSERT_TRUE(preps[2].types.empty());
+}
+
+TEST(StatementTest, PrepareDataEmpty) {
+    auto const preps = Statement<StatementTestEmpty>::prepareData();
+    ASSERT_EQ(2u, preps.size());
+    ASSERT_EQ("stmt_empty_insert", preps[0].name);
+    ASSERT_EQ("stmt_empty_select", preps[1].name);
+}
+
+TEST(StatementTest, Constexpr) {
+    static_assert(Statement<StatementTestTable>::insert() == "INSERT INTO stmt_test (a,b,c) VALUES ($1,$2,$3)");
+    static_assert(Statement<StatementTestTable>::update() == "UPDATE stmt_test SET a=$1,b=$2,c=$3");
+    static_assert(Statement<StatementTestTable>::table() == "stmt_test");
+
+    // Statements are passed to libpq as null-terminated strings.
+    auto constexpr query = Statement<StatementTestTable>::select();
+    ASSERT_EQ('\0', query.data()[query.size()]);
+}
+
 TEST(StatementTest, Range) {
     auto const query = "INSERT INTO stmt_test (a,b,c) VALUES ($1,$2,$3),($4,$5,$6)";
 
@@ -80,4 +175,43 @@ TEST(StatementTest, Range) {
     ASSERT_EQ("($2,$3,$4),($5,$6,$7)", RangeStatement::placeholders(v.begin(), v.end(), 1));
 }
 
+TEST(StatementTest, RangeCached) {
+    std::vector<StatementTestRange<0>> const v(3);
+
+    auto const two = RangeStatement::insertCached(v.begin(), v.begin() + 2);
+    ASSERT_EQ(RangeStatement::insert(v.begin(), v.begin() + 2), two);
+    ASSERT_EQ(two.data(), RangeStatement::insertCached(v.begin() + 1, v.end()).data());
+
+    auto const three = RangeStatement::insertCached(v.begin(), v.end());
+    ASSERT_EQ(RangeStatement::insert(v.begin(), v.end()), three);
+    ASSERT_EQ('\0', three.data()[three.size()]);
+}
+
+TEST(StatementTest, RangeCachedFull) {
+    std::deque<StatementTestRange<1>> const v(100);
+
+    std::string spare{};
+    for (auto rows = 1; rows <= 64; ++rows) {
+        ASSERT_FALSE(RangeStatement::insertCached(v.begin(), v.begin() + rows, spare).empty());
+    }
+
+    // Once the cache is full, the text is built and left to the caller.
+    ASSERT_TRUE(RangeStatement::insertCached(v.begin(), v.end(), spare).empty());
+    ASSERT_EQ(RangeStatement::insert(v.begin(), v.end()), spare);
+}
+
+TEST(StatementTest, RangeUpdate) {
+    auto const query = "UPDATE stmt_test SET b=v.b,c=v.c"
+                       " FROM (SELECT a,b,c FROM stmt_test WHERE false"
+                       " UNION ALL SELECT $1,$2,$3 UNION ALL SELECT $4,$5,$6) AS v"
+                       " WHERE stmt_test.a=v.a";
+
+    std::vector<StatementTestRange<2>> const v(3);
+    ASSERT_EQ(query, RangeStatement::update(v.begin(), v.begin() + 2));
+
+    auto const two = RangeStatement::updateCached(v.begin() + 1, v.end());
+    ASSERT_EQ(query, two);
+    ASSERT_EQ(two.data(), RangeStatement::updateCached(v.begin(), v.begin() + 2).data());
+}
+
 }  // namespace postgres
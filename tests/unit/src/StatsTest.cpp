@@ -0,0 +1,137 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Stats.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+TEST(StatsTest, Jobs) {
+    Stats stats{};
+    for (auto i = 0; i < 3; ++i) {
+        stats.send();
+    }
+    stats.connect(1ms);
+    stats.start(2us);
+    stats.finish(3ms);
+    stats.start(2us);
+
+    auto const met = stats.snapshot();
+    ASSERT_EQ(3, met.sent);
+    ASSERT_EQ(1, met.queued);
+    ASSERT_EQ(2, met.started);
+    ASSERT_EQ(1, met.finished);
+    ASSERT_EQ(1, met.workers);
+    ASSERT_EQ(1, met.active);
+    ASSERT_EQ(0, met.idle);
+    ASSERT_EQ(2, met.wait.count);
+    ASSERT_EQ(1, met.exec.count);
+    ASSERT_EQ(3ms, met.exec.total);
+}
+
+TEST(StatsTest, Workers) {
+    Stats stats{};
+    stats.connect(1ms);
+    stats.connect(1ms);
+    stats.fail(5ms);
+    stats.recycle();
+    stats.send();
+    stats.drop();
+
+    auto const met = stats.snapshot();
+    ASSERT_EQ(3, met.connects);
+    ASSERT_EQ(1, met.failures);
+    ASSERT_EQ(1, met.recycled);
+    ASSERT_EQ(1, met.workers);
+    ASSERT_EQ(1, met.idle);
+    ASSERT_EQ(1, met.dropped);
+    ASSERT_EQ(0, met.queued);
+    ASSERT_EQ(3, met.connect.count);
+}
+
+TEST(StatsTest, Histogram) {
+    Stats stats{};
+    for (auto i = 0; i < 90; ++i) {
+        stats.finish(3us);
+    }
+    for (auto i = 0; i < 10; ++i) {
+        stats.finish(1ms);
+    }
+
+    auto const met = stats.snapshot();
+    ASSERT_EQ(100, met.exec.count);
+    ASSERT_EQ(4us, met.exec.quantile(0.5));
+    ASSERT_EQ(4us, met.exec.quantile(0.9));
+    ASSERT_EQ(1024us, met.exec.quantile(0.99));
+    ASSERT_EQ(102'700ns, met.exec.mean());
+    ASSERT_EQ(0ns, Histogram{}.mean());
+}
+
+TEST(StatsTest, Account) {
+    Stats stats{};
+    Stats other{};
+    ASSERT_EQ(nullptr, Stats::accounting());
+    {
+        Stats::Account const acc{stats};
+        ASSERT_EQ(&stats, Stats::accounting());
+        {
+            Stats::Account const nested{other};
+            ASSERT_EQ(&other, Stats::accounting());
+        }
+        ASSERT_EQ(&stats, Stats::accounting());
+        Stats::accounting()->command(100);
+        Stats::accounting()->command(20);
+        Stats::accounting()->result(300);
+        Stats::accounting()->job(0);
+    }
+    ASSERT_EQ(nullptr, Stats::accounting());
+
+    auto const met = stats.snapshot();
+    ASSERT_EQ(2, met.commands);
+    ASSERT_EQ(120, met.command_bytes);
+    ASSERT_EQ(1, met.results);
+    ASSERT_EQ(300, met.result_bytes);
+    ASSERT_EQ(1, met.jobs);
+    ASSERT_EQ(0, met.job_bytes);
+    ASSERT_EQ(0, other.snapshot().commands);
+}
+
+TEST(StatsTest, Threads) {
+    Stats                    stats{};
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < 8; ++i) {
+        threads.emplace_back([&stats] {
+            for (auto j = 0; j < 1000; ++j) {
+                stats.send();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(8000, stats.snapshot().sent);
+}
+
+TEST(StatsTest, Reporter) {
+    auto const       stats = std::make_shared<Stats>();
+    std::atomic<int> reports{0};
+    stats->send();
+    {
+        Reporter rep{stats, 1ms, [&reports](Metrics const& met) {
+            ASSERT_EQ(1, met.sent);
+            ++reports;
+        }};
+        while (reports < 3) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    auto const count = reports.load();
+    std::this_thread::sleep_for(5ms);
+    ASSERT_EQ(count, reports);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,149 @@
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/StealingChannel.h>
+#include <postgres/internal/Worker.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+// Jobs are received but not run, since running requires a connection.
+struct Mark {
+    void operator()(Connection&) const {
+    }
+
+    int val = 0;
+};
+
+static int receive(IChannel& chan, Slot& slot) {
+    chan.receive(slot);
+    auto const job = std::move(slot.job);
+    return job ? job.target<Mark>()->val : 0;
+}
+
+TEST(StealingChannelTest, Send) {
+    auto const ctx  = Context::Builder{}.workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    for (auto i = 1; i <= 3; ++i) {
+        auto const[is_sent, recycled] = chan->send(Mark{i});
+        ASSERT_FALSE(is_sent);
+        ASSERT_EQ(nullptr, recycled);
+    }
+    chan->quit(1);
+
+    Slot slot{};
+    ASSERT_EQ(1, receive(*chan, slot));
+    ASSERT_EQ(2, receive(*chan, slot));
+    ASSERT_EQ(3, receive(*chan, slot));
+    ASSERT_EQ(0, receive(*chan, slot));
+}
+
+TEST(StealingChannelTest, Steal) {
+    auto const ctx  = Context::Builder{}.maxConcurrency(2).workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    // This thread becomes a worker once receiving a job.
+    Slot own{};
+    chan->send(Mark{1});
+    ASSERT_EQ(1, receive(*chan, own));
+
+    chan->send(Mark{2});
+    chan->send(Mark{3});
+
+    Slot peer{};
+    ASSERT_EQ(2, std::async(std::launch::async, [&chan, &peer] {
+        return receive(*chan, peer);
+    }).get());
+    ASSERT_EQ(3, receive(*chan, own));
+
+    chan->quit(1);
+    ASSERT_EQ(0, receive(*chan, own));
+}
+
+TEST(StealingChannelTest, Drop) {
+    auto const ctx  = Context::Builder{}.workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    for (auto i = 1; i <= 3; ++i) {
+        chan->send(Mark{i});
+    }
+    chan->drop();
+    chan->quit(1);
+
+    Slot slot{};
+    ASSERT_EQ(0, receive(*chan, slot));
+}
+
+TEST(StealingChannelTest, Recycle) {
+    auto const ctx  = Context::Builder{}.workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    Worker worker{ctx, chan};
+    chan->recycle(worker);
+
+    auto const[is_sent, recycled] = chan->send(nullptr);
+    ASSERT_FALSE(is_sent);
+    ASSERT_EQ(&worker, recycled);
+}
+
+TEST(StealingChannelTest, Timeout) {
+    auto const ctx  = Context::Builder{}.idleTimeout(1ns).workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    Slot slot{};
+    ASSERT_EQ(0, receive(*chan, slot));
+}
+
+TEST(StealingChannelTest, Overflow) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+    chan->send(nullptr);
+    ASSERT_THROW(chan->send(nullptr), RuntimeError);
+}
+
+TEST(StealingChannelTest, Concurrent) {
+    auto constexpr WORKERS = 4;
+    auto constexpr ROOTS   = 1000;
+    auto constexpr DEPTH   = 4;
+
+    auto const ctx  = Context::Builder{}.maxConcurrency(WORKERS).workStealing(true).share();
+    auto const chan = std::make_shared<StealingChannel>(ctx);
+
+    // Every job fans out two more jobs from the worker thread.
+    std::atomic<int>         count{0};
+    std::vector<Slot>        slots(WORKERS);
+    std::vector<std::thread> workers{};
+    for (auto& slot : slots) {
+        workers.emplace_back([&chan, &slot, &count] {
+            while (auto const val = receive(*chan, slot)) {
+                if (1 < val) {
+                    chan->send(Mark{val - 1});
+                    chan->send(Mark{val - 1});
+                }
+                ++count;
+            }
+        });
+    }
+
+    for (auto i = 0; i < ROOTS; ++i) {
+        chan->send(Mark{DEPTH});
+    }
+
+    auto constexpr TOTAL = ROOTS * ((1 << DEPTH) - 1);
+    while (count < TOTAL) {
+        std::this_thread::sleep_for(1ms);
+    }
+    chan->quit(WORKERS);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    ASSERT_EQ(TOTAL, count);
+}
+
+}  // namespace postgres::internal
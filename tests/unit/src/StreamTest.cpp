@@ -0,0 +1,45 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Connection.h>
+#include <postgres/Stream.h>
+#include <postgres/Visitable.h>
+#include "Samples.h"
+
+namespace postgres {
+
+struct StreamTestTable {
+    int32_t x = 0;
+    int32_t y = 0;
+
+    POSTGRES_CXX_TABLE("stream_test", x, y);
+};
+
+TEST(StreamTest, Scalar) {
+    std::vector<int32_t> vals{};
+    for (auto const val : Connection{}.stream<int32_t>(SELECT_MULTI_ROW)) {
+        vals.push_back(val);
+    }
+    ASSERT_EQ((std::vector<int32_t>{1, 2, 3}), vals);
+}
+
+TEST(StreamTest, Visitable) {
+    std::vector<int32_t> vals{};
+    Connection           conn{};
+    auto                 strm = conn.stream<StreamTestTable>(
+        "SELECT i AS y, i * 10 AS x FROM generate_series(1, 5) i", 2);
+    for (auto const& row : strm) {
+        vals.push_back(row.x + row.y);
+    }
+    ASSERT_EQ((std::vector<int32_t>{11, 22, 33, 44, 55}), vals);
+}
+
+TEST(StreamTest, Empty) {
+    auto n = 0;
+    for (auto const val : Connection{}.stream<int32_t>("SELECT 1 WHERE FALSE")) {
+        static_cast<void>(val);
+        ++n;
+    }
+    ASSERT_EQ(0, n);
+}
+
+}  // namespace postgres
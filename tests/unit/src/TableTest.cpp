@@ -1,4 +1,9 @@
+#include <algorithm>
 #include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
@@ -12,6 +17,22 @@ struct Table {
     POSTGRES_CXX_TABLE("conn_test", n);
 };
 
+struct KeyedTable {
+    int32_t     id = 0;
+    std::string s;
+
+    POSTGRES_CXX_TABLE("conn_keyed_test", id, s);
+    POSTGRES_CXX_TABLE_KEY(id);
+};
+
+struct OptionalTable {
+    int32_t                id = 0;
+    std::optional<int32_t> n;
+
+    POSTGRES_CXX_TABLE("conn_optional_test", id, n);
+    POSTGRES_CXX_TABLE_KEY(id);
+};
+
 struct TableTest : testing::Test {
     TableTest() {
         conn_.create<Table>();
@@ -62,6 +83,79 @@ TEST_F(TableTest, MultiInsert) {
     ASSERT_EQ(6, out[0].n + out[1].n + out[2].n);
 }
 
+TEST_F(TableTest, MultiUpdate) {
+    conn_.create<KeyedTable>();
+    std::vector<KeyedTable> in(3);
+    for (auto i = 0; i < 3; ++i) {
+        in[i].id = i;
+        in[i].s  = "old";
+    }
+    ASSERT_TRUE(conn_.insert(in.begin(), in.end()).isOk());
+
+    in[0].s = "new";
+    in[2].s = "new";
+    auto const res = conn_.update(in.begin(), in.end());
+
+    std::vector<KeyedTable> out{};
+    conn_.select(out);
+    std::sort(out.begin(), out.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.id < rhs.id;
+    });
+    conn_.drop<KeyedTable>();
+    ASSERT_TRUE(res.isOk());
+    ASSERT_EQ(3, res.effect());
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ("new", out[0].s);
+    ASSERT_EQ("old", out[1].s);
+    ASSERT_EQ("new", out[2].s);
+}
+
+TEST_F(TableTest, MultiUpdateNull) {
+    ASSERT_TRUE(conn_.exec("CREATE TABLE conn_optional_test (id INT, n INT)").isOk());
+    std::vector<OptionalTable> in(2);
+    for (auto i = 0; i < 2; ++i) {
+        in[i].id = i;
+        in[i].n  = i;
+    }
+    ASSERT_TRUE(conn_.insert(in.begin(), in.end()).isOk());
+
+    // A column of NULLs only is sent without a type.
+    in[0].n.reset();
+    in[1].n.reset();
+    auto const res = conn_.update(in.begin(), in.end());
+
+    std::vector<OptionalTable> out{};
+    conn_.select(out);
+    conn_.exec("DROP TABLE conn_optional_test");
+    ASSERT_TRUE(res.isOk());
+    ASSERT_EQ(2, res.effect());
+    ASSERT_EQ(2u, out.size());
+    ASSERT_FALSE(out[0].n.has_value());
+    ASSERT_FALSE(out[1].n.has_value());
+}
+
+TEST_F(TableTest, Upsert) {
+    ASSERT_TRUE(conn_.exec("CREATE TABLE conn_keyed_test (id INT PRIMARY KEY, s TEXT)").isOk());
+    std::vector<KeyedTable> in(2);
+    in[0].id = 1;
+    in[0].s  = "old";
+    in[1].id = 2;
+    in[1].s  = "old";
+    ASSERT_TRUE(conn_.upsert(in.begin(), in.end()).isOk());
+
+    in[1].s  = "new";
+    in[0].id = 3;
+    in[0].s  = "new";
+    auto const res = conn_.upsert(in.begin(), in.end());
+
+    std::vector<KeyedTable> out{};
+    conn_.select(out);
+    conn_.drop<KeyedTable>();
+    ASSERT_TRUE(res.isOk());
+    ASSERT_EQ(2, res.effect());
+    ASSERT_EQ(3u, out.size());
+}
+
 TEST_F(TableTest, Select) {
     std::vector<Table> out{};
     ASSERT_TRUE(conn_.select(out).isOk());
@@ -76,4 +170,86 @@ TEST_F(TableTest, Select) {
     ASSERT_EQ(2u, out.size());
 }
 
+TEST_F(TableTest, SelectParallel) {
+    std::vector<Table> in(10000);
+    for (auto i = 0; i < static_cast<int>(in.size()); ++i) {
+        in[i].n = i;
+    }
+    ASSERT_TRUE(conn_.copyIn(in.begin(), in.end()).isOk());
+
+    std::vector<Table> out(1);
+    ASSERT_TRUE(conn_.select(out, 4).isOk());
+    ASSERT_EQ(in.size() + 1, out.size());
+    for (auto i = 0; i < static_cast<int>(in.size()); ++i) {
+        ASSERT_EQ(i, out[i + 1].n);
+    }
+    ASSERT_THROW(conn_.select(out, 0), LogicError);
+}
+
+struct RefreshTable {
+    int32_t                    n = 0;
+    std::string                s;
+    std::optional<std::string> o;
+
+    POSTGRES_CXX_TABLE("conn_refresh_test", n, s, o);
+};
+
+TEST(TableRefreshTest, Refresh) {
+    Connection conn{};
+    conn.exec("CREATE TEMP TABLE conn_refresh_test (n INT, s TEXT, o TEXT)");
+    conn.exec("INSERT INTO conn_refresh_test "
+              "SELECT n, repeat(chr(97 + n), 100), CASE WHEN n = 1 THEN 'opt' END FROM generate_series(0, 2) n");
+
+    std::vector<RefreshTable> out(1);
+    std::vector<size_t>       changed{};
+    ASSERT_TRUE(conn.refresh(out, &changed).isOk());
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ((std::vector<size_t>{0, 1, 2}), changed);
+    ASSERT_EQ(std::string(100, 'b'), out[1].s);
+    ASSERT_EQ("opt", out[1].o);
+    ASSERT_FALSE(out[2].o);
+
+    // Strings unchanged keep their storage.
+    auto const data = out[0].s.data();
+    conn.exec("UPDATE conn_refresh_test SET o = NULL WHERE n = 1");
+    changed.clear();
+    ASSERT_TRUE(conn.refresh(out, &changed).isOk());
+    ASSERT_EQ(std::vector<size_t>{1}, changed);
+    ASSERT_EQ(data, out[0].s.data());
+    ASSERT_FALSE(out[1].o);
+
+    conn.exec("DELETE FROM conn_refresh_test WHERE n = 2");
+    changed.clear();
+    ASSERT_TRUE(conn.refresh(out).isOk());
+    ASSERT_EQ(2u, out.size());
+}
+
+struct ArenaTable {
+    int32_t                          n = 0;
+    std::pmr::string                s;
+    std::optional<std::pmr::string> o;
+
+    POSTGRES_CXX_TABLE("conn_arena_test", n, s, o);
+};
+
+TEST(TableArenaTest, Select) {
+    Connection conn{};
+    conn.exec("CREATE TABLE conn_arena_test (n INT, s TEXT, o TEXT)");
+
+    conn.exec("INSERT INTO conn_arena_test "
+              "SELECT n, repeat(chr(97 + n), 100), CASE WHEN n = 1 THEN 'opt' END FROM generate_series(0, 2) n");
+
+    std::pmr::monotonic_buffer_resource arena{};
+    std::vector<ArenaTable>             out{};
+    ASSERT_TRUE(conn.select(out, arena).isOk());
+    conn.exec("DROP TABLE conn_arena_test");
+
+    ASSERT_EQ(3u, out.size());
+    for (auto const& row : out) {
+        ASSERT_EQ(std::string(100, static_cast<char>('a' + row.n)), std::string_view{row.s});
+        ASSERT_EQ(&arena, row.s.get_allocator().resource());
+        ASSERT_EQ(row.n == 1, row.o.has_value());
+    }
+}
+
 }  // namespace postgres
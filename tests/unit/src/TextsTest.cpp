@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/Texts.h>
+
+namespace postgres::internal {
+
+TEST(TextsTest, Add) {
+    Texts texts{2};
+    ASSERT_TRUE(texts.find(1).empty());
+
+    auto const one = texts.add(1, "ONE");
+    ASSERT_EQ("ONE", one);
+    ASSERT_EQ(one.data(), texts.find(1).data());
+    ASSERT_EQ(one.data(), texts.add(1, "OTHER").data());
+}
+
+TEST(TextsTest, Limit) {
+    Texts texts{2};
+    ASSERT_EQ("ONE", texts.add(1, "ONE"));
+    ASSERT_EQ("TWO", texts.add(2, "TWO"));
+    ASSERT_TRUE(texts.add(3, "THREE").empty());
+    ASSERT_TRUE(texts.find(3).empty());
+    ASSERT_EQ("ONE", texts.find(1));
+}
+
+}  // namespace postgres::internal
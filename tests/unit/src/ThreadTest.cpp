@@ -0,0 +1,57 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+#include <postgres/internal/Thread.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(ThreadTest, Default) {
+    auto is_run = false;
+    auto thread = Thread{Context{}, [&is_run] {
+        is_run = true;
+    }};
+    ASSERT_TRUE(thread.joinable());
+    thread.join();
+    ASSERT_FALSE(thread.joinable());
+    ASSERT_TRUE(is_run);
+    ASSERT_THROW(thread.join(), LogicError);
+}
+
+TEST(ThreadTest, Placement) {
+    auto const ctx = Context::Builder{}.threadName("my-pool-worker-thread")
+                                       .cpuAffinity({0}, true)
+                                       .stackSize(size_t{1} << 20)
+                                       .build();
+    std::string name{};
+    cpu_set_t   cpus{};
+    size_t      stack = 0;
+    auto        thread = Thread{ctx, [&] {
+        char buf[16]{};
+        pthread_getname_np(pthread_self(), buf, sizeof(buf));
+        name = buf;
+        sched_getaffinity(0, sizeof(cpus), &cpus);
+        pthread_attr_t attr{};
+        pthread_getattr_np(pthread_self(), &attr);
+        pthread_attr_getstacksize(&attr, &stack);
+        pthread_attr_destroy(&attr);
+    }};
+    thread.join();
+    ASSERT_EQ("my-pool-worker-", name);
+    ASSERT_EQ(1, CPU_COUNT(&cpus));
+    ASSERT_TRUE(CPU_ISSET(0, &cpus));
+    ASSERT_LE(size_t{1} << 20, stack);
+}
+
+TEST(ThreadTest, Move) {
+    auto thread = Thread{Context{}, [] {}};
+    auto other  = std::move(thread);
+    ASSERT_FALSE(thread.joinable());
+    ASSERT_TRUE(other.joinable());
+    other.detach();
+    ASSERT_FALSE(other.joinable());
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <postgres/internal/Throttle.h>
+
+namespace postgres::internal {
+
+using namespace std::chrono_literals;
+
+TEST(ThrottleTest, Cap) {
+    auto thr = Throttle{2, 0ms};
+    ASSERT_TRUE(thr.admit());
+    ASSERT_TRUE(thr.admit());
+    ASSERT_FALSE(thr.admit());
+    ASSERT_EQ(2, thr.pending());
+
+    thr.enter();
+    ASSERT_EQ(3, thr.pending());
+    thr.leave();
+    thr.leave();
+    ASSERT_TRUE(thr.admit());
+    ASSERT_FALSE(thr.admit());
+}
+
+TEST(ThrottleTest, Unlimited) {
+    auto thr = Throttle{0, 0ms};
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_TRUE(thr.admit());
+    }
+    ASSERT_EQ(100, thr.pending());
+}
+
+TEST(ThrottleTest, Idle) {
+    auto thr = Throttle{1, 0ms};
+    ASSERT_TRUE(thr.isIdle());
+    ASSERT_TRUE(thr.admit());
+    ASSERT_FALSE(thr.isIdle());
+
+    thr.open();
+    thr.leave();
+    ASSERT_FALSE(thr.isIdle());
+    thr.close();
+    ASSERT_TRUE(thr.isIdle());
+
+    ASSERT_TRUE(thr.admit());
+    thr.leave();
+    ASSERT_TRUE(thr.isIdle());
+}
+
+TEST(ThrottleTest, Pace) {
+    auto       thr = Throttle{0, 20ms};
+    auto const beg = Throttle::Clock::now();
+    for (auto i = 0; i < 4; ++i) {
+        thr.pace();
+    }
+    auto const elapsed = Throttle::Clock::now() - beg;
+    ASSERT_LE(60ms, elapsed);
+    ASSERT_GT(1s, elapsed);
+}
+
+}  // namespace postgres::internal
@@ -78,6 +78,26 @@ TEST(TimeTest, BadFmt) {
     ASSERT_THROW(Time{"2017-08-25 13:03:60"}, LogicError);
 }
 
+TEST(TimeTest, Parse) {
+    Time::Point pnt{};
+    ASSERT_TRUE(Time::parse("2000-02-29T00:00:00", pnt));
+    ASSERT_EQ(Time::EPOCH + std::chrono::hours{24 * 59}, pnt);
+    ASSERT_TRUE(Time::parse("1900-03-01 12:00:00.5", pnt));
+    ASSERT_EQ(Time::Clock::from_time_t(-2203848000) + std::chrono::milliseconds{500}, pnt);
+    ASSERT_FALSE(Time::parse("2017-08-25", pnt));
+    ASSERT_FALSE(Time::parse("2017-08-25 13:03:35.1234567890", pnt));
+    ASSERT_FALSE(Time::parse("2017-08-25 13:03:35+03", pnt));
+}
+
+TEST(TimeTest, Format) {
+    char buf[Time::MAX_STRING_LEN];
+    auto const t   = Time{TIME_POINT_SAMPLE + std::chrono::microseconds{5}};
+    auto const len = t.format(buf);
+    ASSERT_EQ("2017-08-25T13:03:35.000005000", std::string(buf, len));
+    ASSERT_EQ("1969-12-31T23:59:59.750000000", Time{Time::Clock::from_time_t(0) - std::chrono::milliseconds{250}}.toString());
+    ASSERT_EQ("2000-02-29T00:00:00", Time{"2000-02-29T00:00:00"}.toString());
+}
+
 TEST(TimeTest, Past) {
     static auto const fmt = "1817-08-25T13:03:35";
     auto const        t   = Time{fmt};
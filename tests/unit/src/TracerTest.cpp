@@ -0,0 +1,123 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/internal/Span.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+#include <postgres/Receiver.h>
+#include <postgres/Tracer.h>
+
+namespace postgres {
+
+// Keeps copies of the traces.
+struct TracerFake : Tracer {
+    struct Copy {
+        std::string statement;
+        bool        is_prepared;
+        int         params;
+        size_t      bytes;
+        int64_t     rows;
+        std::string code;
+    };
+
+    void trace(Trace const& trace) override {
+        ASSERT_LE(trace.first, trace.total);
+        traces.push_back({std::string{trace.statement},
+                          trace.is_prepared,
+                          trace.params,
+                          trace.bytes,
+                          trace.rows,
+                          std::string{trace.code}});
+    }
+
+    std::vector<Copy> traces;
+};
+
+static PGresult* makeRows(int const count) {
+    auto const   handle = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PGresAttDesc attr{};
+    attr.name  = const_cast<char*>("a");
+    attr.typid = INT4OID;
+    PQsetResultAttrs(handle, 1, &attr);
+    for (auto i = 0; i < count; ++i) {
+        PQsetvalue(handle, i, 0, const_cast<char*>("1"), 1);
+    }
+    return handle;
+}
+
+TEST(TracerTest, Span) {
+    auto const tracer = std::make_shared<TracerFake>();
+    {
+        internal::Span span{tracer, Command{"SELECT $1, $2, $3", int32_t{1}, "abc", static_cast<char const*>(nullptr)}, false};
+        auto const     first  = makeRows(2);
+        auto const     second = makeRows(3);
+        span.add(first);
+        span.add(second);
+        span.add(nullptr);
+        span.finish();
+        PQclear(first);
+        PQclear(second);
+    }
+
+    ASSERT_EQ(1, tracer->traces.size());
+    auto const& trace = tracer->traces[0];
+    ASSERT_EQ("SELECT $1, $2, $3", trace.statement);
+    ASSERT_FALSE(trace.is_prepared);
+    ASSERT_EQ(3, trace.params);
+    ASSERT_EQ(sizeof(int32_t) + 3, trace.bytes);
+    ASSERT_EQ(5, trace.rows);
+    ASSERT_TRUE(trace.code.empty());
+}
+
+TEST(TracerTest, Exec) {
+    auto const tracer = std::make_shared<TracerFake>();
+    auto       conn   = Context::Builder{}.tracer(tracer).build().connect();
+    conn.exec(Command{"SELECT generate_series(1, $1)", int32_t{3}});
+    conn.exec(PrepareData{"tracer_stmt", "SELECT 1"});
+    conn.exec(PreparedCommand{"tracer_stmt"});
+    conn.execRaw("SELECT 1");
+    ASSERT_THROW(conn.exec("SELECT * FROM tracer_none"), RuntimeError);
+
+    ASSERT_EQ(5, tracer->traces.size());
+    ASSERT_EQ(3, tracer->traces[0].rows);
+    ASSERT_EQ(1, tracer->traces[0].params);
+    ASSERT_EQ("SELECT 1", tracer->traces[1].statement);
+    ASSERT_EQ("tracer_stmt", tracer->traces[2].statement);
+    ASSERT_TRUE(tracer->traces[2].is_prepared);
+    ASSERT_EQ("SELECT 1", tracer->traces[3].statement);
+    ASSERT_EQ("42P01", tracer->traces[4].code);
+
+    conn.trace(nullptr);
+    conn.exec("SELECT 1");
+    ASSERT_EQ(5, tracer->traces.size());
+}
+
+TEST(TracerTest, Send) {
+    auto const tracer = std::make_shared<TracerFake>();
+    Connection conn{};
+    conn.trace(tracer);
+    {
+        auto rcvr = conn.send(Command{"SELECT generate_series(1, 4)"});
+        ASSERT_TRUE(tracer->traces.empty());
+        ASSERT_EQ(4, rcvr.receive().size());
+        ASSERT_TRUE(rcvr.receive().isDone());
+    }
+    {
+        auto rcvr = conn.iter(Command{"SELECT generate_series(1, 4)"});
+        for (auto const& res : rcvr) {
+            static_cast<void>(res);
+        }
+    }
+
+    ASSERT_EQ(2, tracer->traces.size());
+    ASSERT_EQ(4, tracer->traces[0].rows);
+    ASSERT_EQ(4, tracer->traces[1].rows);
+}
+
+}  // namespace postgres
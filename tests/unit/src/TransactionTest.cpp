@@ -1,6 +1,9 @@
+#include <chrono>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Transaction.h>
 
 namespace postgres {
@@ -23,6 +26,53 @@ TEST(TransactionTest, Bad) {
     ASSERT_EQ(0, conn.exec(SELECT).size());
 }
 
+TEST(TransactionTest, Result) {
+    Connection conn{};
+    conn.exec(CREATE);
+    auto const res = conn.transact(INSERT, Command{"SELECT count(*) + $1 FROM tx_test", int64_t{1}});
+    ASSERT_EQ(2, res[0][0].as<int64_t>());
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+TEST(TransactionTest, BadMiddle) {
+    Connection conn{};
+    conn.exec(CREATE);
+    ASSERT_THROW(conn.transact(INSERT, "BAD", INSERT), RuntimeError);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+    ASSERT_EQ(PQ_PIPELINE_OFF, PQpipelineStatus(conn.native()));
+    ASSERT_EQ(0, conn.exec(SELECT).size());
+}
+
+TEST(TransactionTest, Retry) {
+    Connection conn{};
+    conn.exec(CREATE);
+    auto const res = conn.transact(RetryPolicy{}, INSERT, SELECT);
+    ASSERT_EQ(1, res.size());
+
+    auto count = 0;
+    ASSERT_THROW(conn.retry(RetryPolicy{3, std::chrono::microseconds{10}}, [&count](Connection&) {
+        ++count;
+        throw RuntimeError{"conflict", "40001"};
+    }), RuntimeError);
+    ASSERT_EQ(3, count);
+
+    count = 0;
+    ASSERT_THROW(conn.retry(RetryPolicy{}, [&count](Connection& conn) {
+        ++count;
+        return conn.exec("BAD");
+    }), RuntimeError);
+    ASSERT_EQ(1, count);
+
+    count = 0;
+    ASSERT_EQ(2, conn.retry(RetryPolicy{}, [&count](Connection& conn) {
+        if (++count == 1) {
+            throw RuntimeError{"deadlock", "40P01"};
+        }
+        return conn.exec("SELECT 2::INT");
+    })[0][0].as<int32_t>());
+    ASSERT_EQ(2, count);
+}
+
 TEST(TransactionTest, Commit) {
     Connection conn{};
     conn.exec(CREATE);
@@ -0,0 +1,36 @@
+#include <cstring>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Uuid.h>
+
+namespace postgres {
+
+TEST(UuidTest, Parse) {
+    auto const id = Uuid::parse("A0EEBC99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    ASSERT_EQ(0xA0, id.bytes[0]);
+    ASSERT_EQ(0x11, id.bytes[15]);
+    ASSERT_EQ("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11", id.toString());
+    ASSERT_EQ(id, Uuid::parse(id.toString()));
+    ASSERT_NE(id, Uuid{});
+    ASSERT_EQ("00000000-0000-0000-0000-000000000000", Uuid{}.toString());
+}
+
+TEST(UuidTest, Bad) {
+    ASSERT_THROW(Uuid::parse(""), LogicError);
+    ASSERT_THROW(Uuid::parse("a0eebc999c0b4ef8bb6d6bb9bd380a11"), LogicError);
+    ASSERT_THROW(Uuid::parse("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a1g"), LogicError);
+    ASSERT_THROW(Uuid::parse("a0eebc99+9c0b-4ef8-bb6d-6bb9bd380a11"), LogicError);
+}
+
+TEST(UuidTest, Command) {
+    auto const    id = Uuid::parse("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    Command const cmd{"STMT", id};
+    ASSERT_EQ(Oid{UUIDOID}, cmd.types()[0]);
+    ASSERT_EQ(16, cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+    ASSERT_EQ(0, std::memcmp(id.bytes.data(), cmd.values()[0], 16));
+}
+
+}  // namespace postgres
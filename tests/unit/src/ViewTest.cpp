@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Time.h>
+#include <postgres/View.h>
+
+namespace postgres::internal {
+
+struct ViewTest : testing::Test {
+    ViewTest() {
+        PGresAttDesc attrs[3]{};
+        attrs[0].name   = const_cast<char*>("a");
+        attrs[0].typid  = INT8OID;
+        attrs[0].format = 1;
+        attrs[1].name   = const_cast<char*>("b");
+        attrs[1].typid  = TIMESTAMPOID;
+        attrs[1].format = 1;
+        attrs[2].name   = const_cast<char*>("c");
+        attrs[2].typid  = VARCHAROID;
+        attrs[2].format = 1;
+        PQsetResultAttrs(res_.get(), 3, attrs);
+
+        auto const a = orderBytes(int64_t{-42});
+        auto const b = orderBytes(int64_t{1000000});
+        PQsetvalue(res_.get(), 0, 0, const_cast<char*>(reinterpret_cast<char const*>(&a)), sizeof(a));
+        PQsetvalue(res_.get(), 0, 1, const_cast<char*>(reinterpret_cast<char const*>(&b)), sizeof(b));
+        PQsetvalue(res_.get(), 0, 2, const_cast<char*>("foo"), 3);
+        PQsetvalue(res_.get(), 1, 0, nullptr, -1);
+    }
+
+    std::unique_ptr<PGresult, void (*)(PGresult*)> res_{PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK),
+                                                        PQclear};
+};
+
+TEST_F(ViewTest, Accepts) {
+    ASSERT_TRUE(ViewCell<int64_t>::accepts(INT8OID));
+    ASSERT_FALSE(ViewCell<int64_t>::accepts(INT4OID));
+    ASSERT_TRUE(ViewCell<std::optional<double>>::accepts(FLOAT8OID));
+    ASSERT_TRUE(ViewCell<std::string_view>::accepts(VARCHAROID));
+    ASSERT_FALSE(ViewCell<std::string_view>::accepts(INT8OID));
+}
+
+TEST_F(ViewTest, Read) {
+    ASSERT_EQ(-42, ViewCell<int64_t>::read(*res_, 0, 0));
+    ASSERT_EQ(Time::EPOCH + std::chrono::seconds{1}, ViewCell<Time::Point>::read(*res_, 0, 1));
+    ASSERT_EQ("foo", ViewCell<std::string_view>::read(*res_, 0, 2));
+    ASSERT_EQ(-42, ViewCell<std::optional<int64_t>>::read(*res_, 0, 0));
+    ASSERT_FALSE(ViewCell<std::optional<int64_t>>::read(*res_, 1, 0));
+    ASSERT_THROW(ViewCell<int64_t>::read(*res_, 1, 0), LogicError);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,36 @@
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/internal/Watchdog.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+TEST(WatchdogTest, Cancel) {
+    Watchdog   dog{};
+    Connection conn{};
+    {
+        auto const watch = dog.watch(conn, std::chrono::steady_clock::now() + 100ms);
+        ASSERT_THROW(conn.exec("SELECT pg_sleep(10)"), RuntimeError);
+    }
+    ASSERT_TRUE(conn.exec("SELECT 1").isOk());
+}
+
+TEST(WatchdogTest, Forget) {
+    Watchdog   dog{};
+    Connection conn{};
+    {
+        auto const watch = dog.watch(conn, std::chrono::steady_clock::now() + 10ms);
+    }
+    ASSERT_TRUE(conn.exec("SELECT pg_sleep(0.1)").isOk());
+}
+
+TEST(WatchdogTest, Expired) {
+    Watchdog   dog{};
+    Connection conn{};
+    ASSERT_THROW(dog.watch(conn, std::chrono::steady_clock::now()), RuntimeError);
+}
+
+}  // namespace postgres::internal
@@ -1,4 +1,7 @@
+#include <chrono>
+#include <future>
 #include <gtest/gtest.h>
+#include <postgres/internal/Stats.h>
 #include <postgres/internal/Worker.h>
 #include <postgres/Connection.h>
 #include <postgres/Context.h>
@@ -8,6 +11,7 @@
 using testing::_;
 using testing::Invoke;
 using testing::Ref;
+using namespace std::chrono_literals;
 
 namespace postgres::internal {
 
@@ -15,10 +19,61 @@ TEST(WorkerTest, NoRun) {
     Worker{std::make_shared<Context>(), std::make_shared<ChannelMock>()};
 }
 
+// Gets the failure to connect instead of running.
+struct ConnectFailure {
+    void operator()(Connection&) const {
+    }
+
+    void fail(std::exception_ptr const& err) const {
+        prom->set_exception(err);
+    }
+
+    std::promise<void>* prom = nullptr;
+};
+
 TEST(WorkerTest, BadRun) {
-    Worker w{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()),
-             std::make_shared<ChannelMock>()};
-    ASSERT_THROW(w.run(), RuntimeError);
+    std::promise<void> prom{};
+    auto const         chan = std::make_shared<ChannelMock>();
+    EXPECT_CALL(*chan, poll(_)).WillOnce(Invoke([&prom](Slot& slot) {
+        slot.job = ConnectFailure{&prom};
+        return true;
+    }));
+    EXPECT_CALL(*chan, recycle(_)).Times(1);
+
+    Worker{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()), chan}.run();
+    ASSERT_THROW(prom.get_future().get(), RuntimeError);
+}
+
+TEST(WorkerTest, BadRunStats) {
+    std::promise<void> prom{};
+    auto const         chan  = std::make_shared<ChannelMock>();
+    auto const         stats = std::make_shared<Stats>();
+    EXPECT_CALL(*chan, poll(_)).WillOnce(Invoke([&prom](Slot& slot) {
+        slot.job = ConnectFailure{&prom};
+        return true;
+    }));
+    EXPECT_CALL(*chan, recycle(_)).Times(1);
+    {
+        Worker w{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()), chan};
+        w.reportTo(stats);
+        w.run();
+    }
+
+    auto const met = stats->snapshot();
+    ASSERT_EQ(1, met.connects);
+    ASSERT_EQ(1, met.failures);
+    ASSERT_EQ(1, met.dropped);
+    ASSERT_EQ(0, met.workers);
+    ASSERT_EQ(0, met.recycled);
+}
+
+TEST(WorkerTest, BadRunIdle) {
+    auto const chan = std::make_shared<ChannelMock>();
+    EXPECT_CALL(*chan, poll(_)).WillOnce(Invoke([](Slot&) {
+        return false;
+    }));
+    EXPECT_CALL(*chan, recycle(_)).Times(1);
+    Worker{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()), chan}.run();
 }
 
 TEST(WorkerTest, Rerun) {
@@ -46,6 +101,29 @@ TEST(WorkerTest, Job) {
     ASSERT_EQ(1, res);
 }
 
+TEST(WorkerTest, Reconnect) {
+    auto       pid  = 0;
+    auto       res  = 0;
+    auto const chan = std::make_shared<ChannelMock>();
+    EXPECT_CALL(*chan, receive(_)).WillOnce(Invoke([&pid](Slot& slot) {
+        slot.job = [&pid](Connection& conn) {
+            pid = conn.exec("SELECT pg_backend_pid()")[0][0].as<int32_t>();
+            conn.exec("SELECT pg_terminate_backend(pg_backend_pid())");
+        };
+    })).WillOnce(Invoke([&res](Slot& slot) {
+        slot.job = [&res](Connection& conn) {
+            res = conn.exec("SELECT pg_backend_pid()")[0][0].as<int32_t>();
+        };
+    })).WillOnce(Invoke([](Slot& slot) {
+        slot.job = nullptr;
+    }));
+    EXPECT_CALL(*chan, recycle(_)).Times(1);
+
+    Worker{std::make_shared<Context>(Context::Builder{}.reconnect(3, 1ms).build()), chan}.run();
+    ASSERT_NE(0, res);
+    ASSERT_NE(pid, res);
+}
+
 /*
 TEST(WorkerTest, Break) {
     // todo